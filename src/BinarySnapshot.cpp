@@ -0,0 +1,522 @@
+#include "BinarySnapshot.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(BinarySnapshot::ColumnEntry) == 24, "ColumnEntry debe ocupar 24 bytes en disco");
+
+const char BinarySnapshot::MAGIC[8] = {'I', 'N', 'V', 'S', 'N', 'A', 'P', '\0'};
+
+namespace {
+    // Posiciones de los campos de la cabecera
+    const std::size_t VERSION_AT = 8;
+    const std::size_t ENDIAN_AT = 12;
+    const std::size_t HEADER_SIZE_AT = 16;
+    const std::size_t FLAGS_AT = 20;
+    const std::size_t ROW_COUNT_AT = 24;
+    const std::size_t SOURCE_TAG_AT = 32;
+    const std::size_t DIRECTORY_AT = 40;
+    const std::size_t COLUMN_COUNT_AT = 48;
+    const std::size_t FILE_SIZE_AT = 56;
+    const std::size_t PAYLOAD_CHECKSUM_AT = 64;
+    const std::size_t HEADER_CHECKSUM_AT = 72;
+
+    std::size_t alignTo8(std::size_t value) {
+        return (value + 7) & ~static_cast<std::size_t>(7);
+    }
+
+    template <typename T>
+    void put(std::vector<unsigned char>& out, std::size_t at, T value) {
+        std::memcpy(out.data() + at, &value, sizeof(T));
+    }
+
+    template <typename T>
+    T get(const unsigned char* data, std::size_t at) {
+        T value;
+        std::memcpy(&value, data + at, sizeof(T));
+        return value;
+    }
+
+    std::uint64_t rotateLeft(std::uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    std::uint64_t read64(const unsigned char* data) {
+        std::uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    // Comprueba que una tabla de posiciones sea creciente y quede dentro del montón
+    bool validOffsets(const std::uint32_t* offsets, std::size_t entries, std::uint64_t heapLength) {
+        if (offsets[entries - 1] > heapLength) return false;
+        std::uint32_t descending = 0;
+        for (std::size_t i = 1; i < entries; ++i) {
+            descending |= offsets[i] < offsets[i - 1];
+        }
+        return descending == 0;
+    }
+
+    // Comprueba que todos los índices sean menores que el límite
+    bool validRefs(const std::uint32_t* refs, std::size_t count, std::size_t limit) {
+        std::uint32_t outOfRange = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            outOfRange |= refs[i] >= limit;
+        }
+        return outOfRange == 0;
+    }
+}
+
+std::uint64_t BinarySnapshot::checksum(const unsigned char* data, std::size_t size) {
+    // Resumen al estilo de xxHash64: cuatro acumuladores independientes de 8 bytes
+    const std::uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+    const std::uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+    const std::uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+    const std::uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+    const std::uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+    auto round = [&](std::uint64_t accumulator, std::uint64_t input) {
+        return rotateLeft(accumulator + input * PRIME2, 31) * PRIME1;
+    };
+
+    std::size_t i = 0;
+    std::uint64_t hash;
+
+    if (size >= 32) {
+        std::uint64_t v1 = PRIME1 + PRIME2, v2 = PRIME2, v3 = 0, v4 = 0 - PRIME1;
+        for (; i + 32 <= size; i += 32) {
+            v1 = round(v1, read64(data + i));
+            v2 = round(v2, read64(data + i + 8));
+            v3 = round(v3, read64(data + i + 16));
+            v4 = round(v4, read64(data + i + 24));
+        }
+        hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+        for (std::uint64_t lane : {v1, v2, v3, v4}) {
+            hash = (hash ^ round(0, lane)) * PRIME1 + PRIME4;
+        }
+    } else {
+        hash = PRIME5;
+    }
+
+    hash += size;
+    for (; i + 8 <= size; i += 8) {
+        hash = rotateLeft(hash ^ round(0, read64(data + i)), 27) * PRIME1 + PRIME4;
+    }
+    for (; i < size; ++i) {
+        hash = rotateLeft(hash ^ (data[i] * PRIME5), 11) * PRIME1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+// ---------------------------------------------------------------------------
+// Escritura
+// ---------------------------------------------------------------------------
+
+std::vector<unsigned char> BinarySnapshotWriter::serialize(const ComponentTable& table,
+                                                           std::uint64_t sourceTag, bool withIdIndex) {
+    using Column = BinarySnapshot::Column;
+    const std::size_t rows = table.size();
+    const auto& types = table.getTypeDictionary();
+    const auto& locations = table.getLocationDictionary();
+
+    // Montón de cadenas: nombres, luego tipos, luego ubicaciones
+    std::string heap;
+    std::vector<std::uint32_t> nameOffsets, typeOffsets, locationOffsets;
+    nameOffsets.reserve(rows + 1);
+    typeOffsets.reserve(types.size() + 1);
+    locationOffsets.reserve(locations.size() + 1);
+
+    auto appendString = [&heap](std::vector<std::uint32_t>& offsets, std::string_view text) {
+        offsets.push_back(static_cast<std::uint32_t>(heap.size()));
+        heap.append(text.data(), text.size());
+    };
+    for (std::size_t row = 0; row < rows; ++row) appendString(nameOffsets, table.getName(row));
+    nameOffsets.push_back(static_cast<std::uint32_t>(heap.size()));
+    for (const auto& type : types) appendString(typeOffsets, type.view());
+    typeOffsets.push_back(static_cast<std::uint32_t>(heap.size()));
+    for (const auto& location : locations) appendString(locationOffsets, location.view());
+    locationOffsets.push_back(static_cast<std::uint32_t>(heap.size()));
+
+    if (heap.size() > std::numeric_limits<std::uint32_t>::max() ||
+        rows > std::numeric_limits<std::uint32_t>::max()) {
+        std::cerr << "Snapshot demasiado grande para el formato binario" << std::endl;
+        return {};
+    }
+
+    std::vector<std::int32_t> ids(rows), quantities(rows);
+    std::vector<std::int64_t> purchaseDates(rows);
+    std::vector<std::uint32_t> typeRefs(rows), locationRefs(rows);
+    for (std::size_t row = 0; row < rows; ++row) {
+        ids[row] = table.getId(row);
+        quantities[row] = table.getQuantity(row);
+        purchaseDates[row] = table.getPurchaseDate(row);
+        typeRefs[row] = table.getTypeId(row);
+        locationRefs[row] = table.getLocationId(row);
+    }
+
+    std::vector<std::uint32_t> idIndex;
+    if (withIdIndex) {
+        idIndex.resize(rows);
+        std::iota(idIndex.begin(), idIndex.end(), 0u);
+        std::stable_sort(idIndex.begin(), idIndex.end(),
+                         [&ids](std::uint32_t a, std::uint32_t b) { return ids[a] < ids[b]; });
+    }
+
+    struct Block
+    {
+        Column column;
+        std::uint32_t elementSize;
+        const void* data;
+        std::size_t length;
+    };
+    std::vector<Block> blocks = {
+        {Column::Ids, 4, ids.data(), ids.size() * 4},
+        {Column::Quantities, 4, quantities.data(), quantities.size() * 4},
+        {Column::PurchaseDates, 8, purchaseDates.data(), purchaseDates.size() * 8},
+        {Column::NameOffsets, 4, nameOffsets.data(), nameOffsets.size() * 4},
+        {Column::TypeRefs, 4, typeRefs.data(), typeRefs.size() * 4},
+        {Column::LocationRefs, 4, locationRefs.data(), locationRefs.size() * 4},
+        {Column::TypeDictionary, 4, typeOffsets.data(), typeOffsets.size() * 4},
+        {Column::LocationDictionary, 4, locationOffsets.data(), locationOffsets.size() * 4},
+        {Column::StringHeap, 1, heap.data(), heap.size()},
+    };
+    if (withIdIndex) {
+        blocks.push_back({Column::IdIndex, 4, idIndex.data(), idIndex.size() * 4});
+    }
+
+    // Colocar los bloques tras la cabecera y el directorio al final
+    std::vector<BinarySnapshot::ColumnEntry> directory;
+    std::size_t offset = BinarySnapshot::HEADER_SIZE;
+    for (const auto& block : blocks) {
+        directory.push_back({static_cast<std::uint32_t>(block.column), block.elementSize,
+                             offset, block.length});
+        offset += alignTo8(block.length);
+    }
+    const std::size_t directoryOffset = offset;
+    const std::size_t fileSize = directoryOffset + directory.size() * sizeof(BinarySnapshot::ColumnEntry);
+
+    std::vector<unsigned char> out(fileSize, 0);
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        if (blocks[i].length > 0) {
+            std::memcpy(out.data() + directory[i].offset, blocks[i].data, blocks[i].length);
+        }
+    }
+    std::memcpy(out.data() + directoryOffset, directory.data(),
+                directory.size() * sizeof(BinarySnapshot::ColumnEntry));
+
+    std::memcpy(out.data(), BinarySnapshot::MAGIC, sizeof(BinarySnapshot::MAGIC));
+    put<std::uint32_t>(out, VERSION_AT, BinarySnapshot::FORMAT_VERSION);
+    put<std::uint32_t>(out, ENDIAN_AT, BinarySnapshot::ENDIAN_TAG);
+    put<std::uint32_t>(out, HEADER_SIZE_AT, static_cast<std::uint32_t>(BinarySnapshot::HEADER_SIZE));
+    put<std::uint32_t>(out, FLAGS_AT, withIdIndex ? BinarySnapshot::FLAG_ID_INDEX : 0);
+    put<std::uint64_t>(out, ROW_COUNT_AT, rows);
+    put<std::uint64_t>(out, SOURCE_TAG_AT, sourceTag);
+    put<std::uint64_t>(out, DIRECTORY_AT, directoryOffset);
+    put<std::uint32_t>(out, COLUMN_COUNT_AT, static_cast<std::uint32_t>(directory.size()));
+    put<std::uint64_t>(out, FILE_SIZE_AT, fileSize);
+    put<std::uint64_t>(out, PAYLOAD_CHECKSUM_AT,
+                       BinarySnapshot::checksum(out.data() + BinarySnapshot::HEADER_SIZE,
+                                                fileSize - BinarySnapshot::HEADER_SIZE));
+    put<std::uint64_t>(out, HEADER_CHECKSUM_AT, BinarySnapshot::checksum(out.data(), HEADER_CHECKSUM_AT));
+    return out;
+}
+
+bool BinarySnapshotWriter::write(const std::string& path, const ComponentTable& table,
+                                 std::uint64_t sourceTag, bool withIdIndex) {
+    std::vector<unsigned char> bytes = serialize(table, sourceTag, withIdIndex);
+    if (bytes.empty()) return false;
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Error al crear el snapshot: " << tempPath << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        file.flush();
+        if (!file) {
+            std::cerr << "Error al escribir el snapshot: " << tempPath << std::endl;
+            file.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+#ifdef _WIN32
+    // rename no reemplaza un archivo existente en Windows
+    std::remove(path.c_str());
+#endif
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error al reemplazar el snapshot: " << path << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool BinarySnapshotWriter::write(const std::string& path, const std::vector<Component>& components,
+                                 std::uint64_t sourceTag, bool withIdIndex) {
+    return write(path, ComponentTable::fromComponents(components), sourceTag, withIdIndex);
+}
+
+// ---------------------------------------------------------------------------
+// Lectura
+// ---------------------------------------------------------------------------
+
+BinarySnapshotReader::BinarySnapshotReader()
+    : data(nullptr), dataSize(0), mapping(nullptr), rowCount(0), sourceTag(0),
+      ids(nullptr), quantities(nullptr), purchaseDates(nullptr), nameOffsets(nullptr),
+      typeRefs(nullptr), locationRefs(nullptr), typeOffsets(nullptr), locationOffsets(nullptr),
+      typeCount(0), locationCount(0), heap(nullptr), idIndex(nullptr) {}
+
+BinarySnapshotReader::~BinarySnapshotReader() {
+    close();
+}
+
+bool BinarySnapshotReader::open(const std::string& path, bool verifyChecksum) {
+    close();
+    if (!load(path)) return false;
+    if (!parse(verifyChecksum)) {
+        std::cerr << "Snapshot binario inválido o dañado: " << path << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool BinarySnapshotReader::load(const std::string& path) {
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* region = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (region != MAP_FAILED) {
+        mapping = region;
+        data = static_cast<const unsigned char*>(region);
+        dataSize = static_cast<std::size_t>(info.st_size);
+        return true;
+    }
+#endif
+
+    // Sin mmap: leer el archivo completo
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+    std::streamoff length = file.tellg();
+    if (length <= 0) return false;
+    buffer.resize(static_cast<std::size_t>(length));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(buffer.data()), length)) {
+        buffer.clear();
+        return false;
+    }
+    data = buffer.data();
+    dataSize = buffer.size();
+    return true;
+}
+
+bool BinarySnapshotReader::parse(bool verifyChecksum) {
+    using Column = BinarySnapshot::Column;
+    const std::size_t headerSize = BinarySnapshot::HEADER_SIZE;
+
+    if (dataSize < headerSize) return false;
+    if (std::memcmp(data, BinarySnapshot::MAGIC, sizeof(BinarySnapshot::MAGIC)) != 0) return false;
+    if (get<std::uint32_t>(data, VERSION_AT) != BinarySnapshot::FORMAT_VERSION) return false;
+    if (get<std::uint32_t>(data, ENDIAN_AT) != BinarySnapshot::ENDIAN_TAG) return false;
+    if (get<std::uint32_t>(data, HEADER_SIZE_AT) != headerSize) return false;
+    if (get<std::uint64_t>(data, HEADER_CHECKSUM_AT) != BinarySnapshot::checksum(data, HEADER_CHECKSUM_AT)) return false;
+    if (get<std::uint64_t>(data, FILE_SIZE_AT) != dataSize) return false;
+
+    const std::uint64_t rows = get<std::uint64_t>(data, ROW_COUNT_AT);
+    const std::uint64_t directoryOffset = get<std::uint64_t>(data, DIRECTORY_AT);
+    const std::uint64_t columnCount = get<std::uint32_t>(data, COLUMN_COUNT_AT);
+    const std::uint32_t flags = get<std::uint32_t>(data, FLAGS_AT);
+
+    if (rows > std::numeric_limits<std::uint32_t>::max()) return false;
+    if (directoryOffset < headerSize || directoryOffset % 8 != 0) return false;
+    if (directoryOffset + columnCount * sizeof(BinarySnapshot::ColumnEntry) != dataSize) return false;
+
+    if (verifyChecksum &&
+        get<std::uint64_t>(data, PAYLOAD_CHECKSUM_AT) != BinarySnapshot::checksum(data + headerSize, dataSize - headerSize)) {
+        return false;
+    }
+
+    // Localizar columnas; las desconocidas se ignoran
+    const BinarySnapshot::ColumnEntry* located[11] = {};
+    for (std::uint64_t i = 0; i < columnCount; ++i) {
+        const auto* entry = reinterpret_cast<const BinarySnapshot::ColumnEntry*>(
+            data + directoryOffset + i * sizeof(BinarySnapshot::ColumnEntry));
+        if (entry->offset < headerSize || entry->offset % 8 != 0 ||
+            entry->length > directoryOffset || entry->offset > directoryOffset - entry->length) {
+            return false;
+        }
+        if (entry->column < sizeof(located) / sizeof(located[0])) {
+            located[entry->column] = entry;
+        }
+    }
+
+    // Cada columna conocida debe existir con el ancho y la longitud esperados
+    auto column = [&](Column id, std::uint32_t elementSize, std::uint64_t minElements) -> const void* {
+        const BinarySnapshot::ColumnEntry* entry = located[static_cast<std::uint32_t>(id)];
+        if (!entry || entry->elementSize != elementSize || entry->length % elementSize != 0) return nullptr;
+        if (entry->length / elementSize < minElements) return nullptr;
+        return data + entry->offset;
+    };
+    auto elementCount = [&](Column id) {
+        const BinarySnapshot::ColumnEntry* entry = located[static_cast<std::uint32_t>(id)];
+        return static_cast<std::size_t>(entry->length / entry->elementSize);
+    };
+
+    ids = static_cast<const std::int32_t*>(column(Column::Ids, 4, rows));
+    quantities = static_cast<const std::int32_t*>(column(Column::Quantities, 4, rows));
+    purchaseDates = static_cast<const std::int64_t*>(column(Column::PurchaseDates, 8, rows));
+    nameOffsets = static_cast<const std::uint32_t*>(column(Column::NameOffsets, 4, rows + 1));
+    typeRefs = static_cast<const std::uint32_t*>(column(Column::TypeRefs, 4, rows));
+    locationRefs = static_cast<const std::uint32_t*>(column(Column::LocationRefs, 4, rows));
+    typeOffsets = static_cast<const std::uint32_t*>(column(Column::TypeDictionary, 4, 1));
+    locationOffsets = static_cast<const std::uint32_t*>(column(Column::LocationDictionary, 4, 1));
+    heap = static_cast<const char*>(column(Column::StringHeap, 1, 0));
+    if (!ids || !quantities || !purchaseDates || !nameOffsets || !typeRefs || !locationRefs ||
+        !typeOffsets || !locationOffsets || !heap) {
+        return false;
+    }
+
+    rowCount = static_cast<std::size_t>(rows);
+    typeCount = elementCount(Column::TypeDictionary) - 1;
+    locationCount = elementCount(Column::LocationDictionary) - 1;
+    const std::uint64_t heapLength = located[static_cast<std::uint32_t>(Column::StringHeap)]->length;
+
+    // Las vistas devueltas no deben salirse del montón ni de los diccionarios
+    if (!validOffsets(nameOffsets, rowCount + 1, heapLength) ||
+        !validOffsets(typeOffsets, typeCount + 1, heapLength) ||
+        !validOffsets(locationOffsets, locationCount + 1, heapLength) ||
+        !validRefs(typeRefs, rowCount, typeCount) ||
+        !validRefs(locationRefs, rowCount, locationCount)) {
+        return false;
+    }
+
+    idIndex = nullptr;
+    if (flags & BinarySnapshot::FLAG_ID_INDEX) {
+        idIndex = static_cast<const std::uint32_t*>(column(Column::IdIndex, 4, rows));
+        if (!idIndex || !validRefs(idIndex, rowCount, rowCount)) return false;
+    }
+
+    sourceTag = get<std::uint64_t>(data, SOURCE_TAG_AT);
+    return true;
+}
+
+void BinarySnapshotReader::close() {
+#ifndef _WIN32
+    if (mapping) {
+        munmap(mapping, dataSize);
+    }
+#endif
+    mapping = nullptr;
+    buffer.clear();
+    buffer.shrink_to_fit();
+    data = nullptr;
+    dataSize = 0;
+    rowCount = 0;
+    sourceTag = 0;
+    ids = quantities = nullptr;
+    purchaseDates = nullptr;
+    nameOffsets = typeRefs = locationRefs = typeOffsets = locationOffsets = idIndex = nullptr;
+    typeCount = locationCount = 0;
+    heap = nullptr;
+}
+
+bool BinarySnapshotReader::isOpen() const {
+    return data != nullptr;
+}
+
+std::uint64_t BinarySnapshotReader::getSourceTag() const {
+    return sourceTag;
+}
+
+std::size_t BinarySnapshotReader::size() const {
+    return rowCount;
+}
+
+int BinarySnapshotReader::getId(std::size_t row) const { return ids[row]; }
+int BinarySnapshotReader::getQuantity(std::size_t row) const { return quantities[row]; }
+std::int64_t BinarySnapshotReader::getPurchaseDate(std::size_t row) const { return purchaseDates[row]; }
+
+std::string_view BinarySnapshotReader::stringAt(const std::uint32_t* offsets, std::size_t index) const {
+    return std::string_view(heap + offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+std::string_view BinarySnapshotReader::getName(std::size_t row) const {
+    return stringAt(nameOffsets, row);
+}
+
+std::string_view BinarySnapshotReader::getType(std::size_t row) const {
+    return stringAt(typeOffsets, typeRefs[row]);
+}
+
+std::string_view BinarySnapshotReader::getLocation(std::size_t row) const {
+    return stringAt(locationOffsets, locationRefs[row]);
+}
+
+long BinarySnapshotReader::findRow(int id) const {
+    if (idIndex) {
+        const std::uint32_t* end = idIndex + rowCount;
+        const std::uint32_t* it = std::lower_bound(idIndex, end, id,
+            [this](std::uint32_t row, int value) { return ids[row] < value; });
+        return (it != end && ids[*it] == id) ? static_cast<long>(*it) : -1;
+    }
+    for (std::size_t row = 0; row < rowCount; ++row) {
+        if (ids[row] == id) return static_cast<long>(row);
+    }
+    return -1;
+}
+
+const std::uint32_t* BinarySnapshotReader::getIdIndex() const {
+    return idIndex;
+}
+
+Component BinarySnapshotReader::componentAt(std::size_t row) const {
+    std::string_view name = getName(row);
+    return Component(ids[row], std::string(name), getType(row), quantities[row],
+                     getLocation(row), static_cast<std::time_t>(purchaseDates[row]));
+}
+
+std::vector<Component> BinarySnapshotReader::readComponents() const {
+    std::vector<InternedString> types, locations;
+    types.reserve(typeCount);
+    locations.reserve(locationCount);
+    for (std::size_t i = 0; i < typeCount; ++i) types.emplace_back(stringAt(typeOffsets, i));
+    for (std::size_t i = 0; i < locationCount; ++i) locations.emplace_back(stringAt(locationOffsets, i));
+
+    std::vector<Component> components;
+    components.reserve(rowCount);
+    for (std::size_t row = 0; row < rowCount; ++row) {
+        std::string_view name = getName(row);
+        components.emplace_back(ids[row], std::string(name), types[typeRefs[row]], quantities[row],
+                                locations[locationRefs[row]], static_cast<std::time_t>(purchaseDates[row]));
+    }
+    return components;
+}
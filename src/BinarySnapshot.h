@@ -0,0 +1,267 @@
+#ifndef BINARYSNAPSHOT_H
+#define BINARYSNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Component.h"
+#include "ComponentTable.h"
+
+/**
+ * @class BinarySnapshot
+ * @brief Definición del formato binario de snapshots del inventario.
+ *
+ * Un archivo de snapshot guarda el conjunto de componentes en columnas de ancho fijo
+ * más un montón de cadenas, de forma que se puede mapear en memoria y leer sin ningún
+ * análisis. Disposición (little-endian, bloques alineados a 8 bytes):
+ *
+ *  - Cabecera de HEADER_SIZE bytes: firma, versión, número de filas, etiqueta de origen,
+ *    posición del directorio, tamaño del archivo y sumas de verificación.
+ *  - Bloques de columna, uno tras otro.
+ *  - Directorio de columnas: una entrada (ColumnEntry) por bloque con su identificador,
+ *    ancho de elemento, posición y longitud. Los lectores ignoran columnas desconocidas,
+ *    lo que permite añadir columnas sin cambiar de versión.
+ *
+ * La suma de la cabecera cubre sus primeros 72 bytes y la del contenido todo lo que
+ * sigue a la cabecera.
+ */
+class BinarySnapshot
+{
+public:
+    static const char MAGIC[8]; /**< Firma al inicio del archivo. */
+    static constexpr std::uint32_t FORMAT_VERSION = 1; /**< Versión actual del formato. */
+    static constexpr std::uint32_t ENDIAN_TAG = 0x01020304; /**< Detecta archivos de otra endianness. */
+    static constexpr std::size_t HEADER_SIZE = 80; /**< Tamaño de la cabecera en bytes. */
+    static constexpr std::uint32_t FLAG_ID_INDEX = 1; /**< El archivo incluye el índice por ID. */
+
+    /**
+     * @brief Identificadores de las columnas del directorio.
+     */
+    enum class Column : std::uint32_t
+    {
+        Ids = 1, /**< int32 por fila. */
+        Quantities = 2, /**< int32 por fila. */
+        PurchaseDates = 3, /**< int64 por fila (segundos desde epoch). */
+        NameOffsets = 4, /**< uint32, filas + 1 posiciones en el montón de cadenas. */
+        TypeRefs = 5, /**< uint32 por fila: índice en el diccionario de tipos. */
+        LocationRefs = 6, /**< uint32 por fila: índice en el diccionario de ubicaciones. */
+        TypeDictionary = 7, /**< uint32, tipos + 1 posiciones en el montón de cadenas. */
+        LocationDictionary = 8, /**< uint32, ubicaciones + 1 posiciones en el montón de cadenas. */
+        StringHeap = 9, /**< Bytes de todas las cadenas, sin terminadores. */
+        IdIndex = 10 /**< uint32 por fila: filas ordenadas por ID (opcional). */
+    };
+
+    /**
+     * @brief Entrada del directorio de columnas, tal como se guarda en disco.
+     */
+    struct ColumnEntry
+    {
+        std::uint32_t column; /**< Identificador de la columna (Column). */
+        std::uint32_t elementSize; /**< Ancho de cada elemento en bytes. */
+        std::uint64_t offset; /**< Posición del bloque desde el inicio del archivo. */
+        std::uint64_t length; /**< Longitud del bloque en bytes, sin relleno. */
+    };
+
+    /**
+     * @brief Calcula la suma de verificación de 64 bits usada por el formato.
+     *
+     * @param data Bytes a resumir.
+     * @param size Número de bytes.
+     * @return Suma de verificación.
+     */
+    static std::uint64_t checksum(const unsigned char* data, std::size_t size);
+};
+
+/**
+ * @class BinarySnapshotWriter
+ * @brief Escribe snapshots binarios del inventario.
+ *
+ * El archivo se escribe primero con extensión .tmp y luego se renombra, de modo que un
+ * lector nunca ve un snapshot a medio escribir.
+ */
+class BinarySnapshotWriter
+{
+public:
+    /**
+     * @brief Escribe un snapshot a partir de una tabla columnar.
+     *
+     * @param path Ruta del archivo a crear o reemplazar.
+     * @param table Componentes a guardar, en el orden de la tabla.
+     * @param sourceTag Etiqueta libre que identifica el origen (p. ej. una generación de la base de datos).
+     * @param withIdIndex Si es true se incluye el índice por ID para búsquedas binarias.
+     * @return true si el archivo se escribió completo, false en caso contrario.
+     */
+    static bool write(const std::string& path, const ComponentTable& table,
+                      std::uint64_t sourceTag = 0, bool withIdIndex = true);
+
+    /**
+     * @brief Escribe un snapshot a partir de una lista de componentes.
+     *
+     * @param path Ruta del archivo a crear o reemplazar.
+     * @param components Componentes a guardar, en ese orden.
+     * @param sourceTag Etiqueta libre que identifica el origen.
+     * @param withIdIndex Si es true se incluye el índice por ID.
+     * @return true si el archivo se escribió completo, false en caso contrario.
+     */
+    static bool write(const std::string& path, const std::vector<Component>& components,
+                      std::uint64_t sourceTag = 0, bool withIdIndex = true);
+
+    /**
+     * @brief Serializa una tabla en memoria con el formato del snapshot.
+     *
+     * @param table Componentes a guardar.
+     * @param sourceTag Etiqueta libre que identifica el origen.
+     * @param withIdIndex Si es true se incluye el índice por ID.
+     * @return Bytes del archivo completo, o vacío si la tabla no cabe en el formato.
+     */
+    static std::vector<unsigned char> serialize(const ComponentTable& table,
+                                                std::uint64_t sourceTag = 0, bool withIdIndex = true);
+};
+
+/**
+ * @class BinarySnapshotReader
+ * @brief Lee snapshots binarios mapeándolos en memoria.
+ *
+ * Tras open() las columnas se leen directamente del mapeo: los accesos por fila no
+ * copian nada y las vistas devueltas son válidas hasta close() o la destrucción del
+ * lector. En plataformas sin mmap el archivo se lee entero a memoria.
+ */
+class BinarySnapshotReader
+{
+private:
+    const unsigned char* data; /**< Inicio del archivo en memoria. */
+    std::size_t dataSize; /**< Tamaño del archivo. */
+    void* mapping; /**< Región mapeada (nullptr si se usa el búfer). */
+    std::vector<unsigned char> buffer; /**< Contenido leído cuando no hay mmap. */
+
+    std::size_t rowCount; /**< Número de componentes. */
+    std::uint64_t sourceTag; /**< Etiqueta de origen de la cabecera. */
+    const std::int32_t* ids; /**< Columna de IDs. */
+    const std::int32_t* quantities; /**< Columna de cantidades. */
+    const std::int64_t* purchaseDates; /**< Columna de fechas. */
+    const std::uint32_t* nameOffsets; /**< Posiciones de los nombres en el montón. */
+    const std::uint32_t* typeRefs; /**< Índice de tipo por fila. */
+    const std::uint32_t* locationRefs; /**< Índice de ubicación por fila. */
+    const std::uint32_t* typeOffsets; /**< Posiciones de los tipos en el montón. */
+    const std::uint32_t* locationOffsets; /**< Posiciones de las ubicaciones en el montón. */
+    std::size_t typeCount; /**< Número de tipos distintos. */
+    std::size_t locationCount; /**< Número de ubicaciones distintas. */
+    const char* heap; /**< Montón de cadenas. */
+    const std::uint32_t* idIndex; /**< Filas ordenadas por ID, o nullptr. */
+
+    /**
+     * @brief Carga el archivo en memoria (mmap o lectura completa).
+     *
+     * @param path Ruta del archivo.
+     * @return true si el contenido quedó disponible.
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Valida la cabecera y el directorio y localiza las columnas.
+     *
+     * @param verifyChecksum Si es true se comprueba también la suma del contenido.
+     * @return true si el archivo es un snapshot válido.
+     */
+    bool parse(bool verifyChecksum);
+
+    /**
+     * @brief Obtiene una cadena del montón a partir de su tabla de posiciones.
+     *
+     * @param offsets Tabla de posiciones (nombres o diccionario).
+     * @param index Índice de la cadena.
+     * @return Vista sobre la cadena en el mapeo.
+     */
+    std::string_view stringAt(const std::uint32_t* offsets, std::size_t index) const;
+
+public:
+    /**
+     * @brief Constructor por defecto: lector sin archivo abierto.
+     */
+    BinarySnapshotReader();
+
+    /**
+     * @brief Destructor. Libera el mapeo si lo hay.
+     */
+    ~BinarySnapshotReader();
+
+    BinarySnapshotReader(const BinarySnapshotReader&) = delete;
+    BinarySnapshotReader& operator=(const BinarySnapshotReader&) = delete;
+
+    /**
+     * @brief Abre y valida un snapshot.
+     *
+     * @param path Ruta del archivo.
+     * @param verifyChecksum Si es true se recorre el contenido para comprobar su suma.
+     * @return true si el snapshot es válido y quedó abierto, false en caso contrario.
+     */
+    bool open(const std::string& path, bool verifyChecksum = true);
+
+    /**
+     * @brief Cierra el snapshot y libera la memoria.
+     */
+    void close();
+
+    /**
+     * @brief Indica si hay un snapshot abierto.
+     * @return true si está abierto.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Obtiene la etiqueta de origen escrita en la cabecera.
+     * @return Etiqueta de origen.
+     */
+    std::uint64_t getSourceTag() const;
+
+    /**
+     * @brief Obtiene el número de componentes.
+     * @return Número de filas.
+     */
+    std::size_t size() const;
+
+    int getId(std::size_t row) const; /**< ID de la fila. */
+    int getQuantity(std::size_t row) const; /**< Cantidad de la fila. */
+    std::int64_t getPurchaseDate(std::size_t row) const; /**< Fecha de compra de la fila. */
+    std::string_view getName(std::size_t row) const; /**< Nombre de la fila (vista al mapeo). */
+    std::string_view getType(std::size_t row) const; /**< Tipo de la fila (vista al mapeo). */
+    std::string_view getLocation(std::size_t row) const; /**< Ubicación de la fila (vista al mapeo). */
+
+    /**
+     * @brief Busca la fila de un ID.
+     *
+     * Usa búsqueda binaria si el archivo tiene índice por ID y un recorrido lineal si no.
+     *
+     * @param id ID a buscar.
+     * @return Fila del componente, o -1 si no existe.
+     */
+    long findRow(int id) const;
+
+    /**
+     * @brief Obtiene el índice por ID guardado en el archivo.
+     *
+     * @return Filas ordenadas por ID (size() elementos, ya validados), o nullptr si el archivo no lo incluye.
+     */
+    const std::uint32_t* getIdIndex() const;
+
+    /**
+     * @brief Reconstruye el componente de una fila.
+     *
+     * @param row Fila del componente.
+     * @return Componente equivalente.
+     */
+    Component componentAt(std::size_t row) const;
+
+    /**
+     * @brief Reconstruye todos los componentes, en el orden del archivo.
+     *
+     * Cada tipo y ubicación distintos se internan una sola vez.
+     *
+     * @return Componentes del snapshot.
+     */
+    std::vector<Component> readComponents() const;
+};
+
+#endif // BINARYSNAPSHOT_H
@@ -0,0 +1,279 @@
+#ifndef CHUNKEDVECTOR_H
+#define CHUNKEDVECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @class ChunkedVector
+ * @brief Secuencia troceada en bloques que las copias comparten (copia al escribir).
+ *
+ * Los elementos se guardan en bloques de entre 1 y 2 * CHUNK_SIZE elementos. Copiar un
+ * ChunkedVector solo copia los punteros a los bloques; insertar, eliminar o reemplazar
+ * un elemento duplica únicamente el bloque que lo contiene, y solo si otra copia lo
+ * comparte. Una versión nueva de una secuencia grande cuesta así O(n / CHUNK_SIZE)
+ * punteros más los bloques tocados, y la versión anterior queda intacta.
+ *
+ * Una instancia no admite escrituras concurrentes con lecturas; instancias distintas
+ * (aunque compartan bloques) pueden usarse desde hilos distintos.
+ */
+template <typename T>
+class ChunkedVector
+{
+public:
+    static constexpr std::size_t CHUNK_SIZE = 512; /**< Tamaño de los bloques al construir; se parten al doblarlo. */
+
+private:
+    using Chunk = std::vector<T>;
+
+    std::vector<std::shared_ptr<Chunk>> chunks; /**< Bloques, nunca vacíos. */
+    std::vector<std::size_t> offsets; /**< Posición del primer elemento de cada bloque; el último es el tamaño. */
+
+    /**
+     * @brief Localiza un elemento.
+     *
+     * @param index Posición del elemento (menor que size()).
+     * @return Bloque y posición dentro del bloque.
+     */
+    std::pair<std::size_t, std::size_t> locate(std::size_t index) const {
+        std::size_t chunk = static_cast<std::size_t>(
+            std::upper_bound(offsets.begin(), offsets.end(), index) - offsets.begin()) - 1;
+        return {chunk, index - offsets[chunk]};
+    }
+
+    /**
+     * @brief Obtiene un bloque modificable, duplicándolo si otra copia lo comparte.
+     *
+     * @param chunk Índice del bloque.
+     * @return Bloque propio de esta instancia.
+     */
+    Chunk& writable(std::size_t chunk) {
+        // Sin más dueños ningún otro hilo puede llegar a este bloque
+        if (chunks[chunk].use_count() != 1) chunks[chunk] = std::make_shared<Chunk>(*chunks[chunk]);
+        return *chunks[chunk];
+    }
+
+    /**
+     * @brief Desplaza las posiciones de los bloques siguientes a uno dado.
+     *
+     * @param chunk Último bloque que no se desplaza.
+     * @param grow true si se agregó un elemento, false si se quitó.
+     */
+    void shiftAfter(std::size_t chunk, bool grow) {
+        for (std::size_t i = chunk + 1; i < offsets.size(); ++i) {
+            grow ? ++offsets[i] : --offsets[i];
+        }
+    }
+
+public:
+    /**
+     * @class const_iterator
+     * @brief Iterador de solo lectura, en orden.
+     */
+    class const_iterator
+    {
+    private:
+        const std::vector<std::shared_ptr<Chunk>>* chunks; /**< Bloques recorridos. */
+        std::size_t chunk; /**< Bloque actual. */
+        std::size_t position; /**< Posición dentro del bloque. */
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator(const std::vector<std::shared_ptr<Chunk>>* chunks, std::size_t chunk)
+            : chunks(chunks), chunk(chunk), position(0) {}
+
+        reference operator*() const { return (*(*chunks)[chunk])[position]; }
+        pointer operator->() const { return &**this; }
+
+        const_iterator& operator++() {
+            if (++position == (*chunks)[chunk]->size()) {
+                ++chunk;
+                position = 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return chunk == other.chunk && position == other.position;
+        }
+
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief Constructor por defecto: secuencia vacía.
+     */
+    ChunkedVector() : offsets{0} {}
+
+    /**
+     * @brief Reparte los elementos de un vector en bloques.
+     *
+     * @param items Elementos, en orden.
+     */
+    explicit ChunkedVector(std::vector<T> items) : offsets{0} {
+        chunks.reserve(items.size() / CHUNK_SIZE + 1);
+        offsets.reserve(items.size() / CHUNK_SIZE + 2);
+        for (std::size_t start = 0; start < items.size(); start += CHUNK_SIZE) {
+            const std::size_t end = std::min(start + CHUNK_SIZE, items.size());
+            chunks.push_back(std::make_shared<Chunk>(std::make_move_iterator(items.begin() + start),
+                                                     std::make_move_iterator(items.begin() + end)));
+            offsets.push_back(end);
+        }
+    }
+
+    /**
+     * @brief Número de elementos.
+     * @return Tamaño de la secuencia.
+     */
+    std::size_t size() const { return offsets.back(); }
+
+    /**
+     * @brief Indica si la secuencia está vacía.
+     * @return true si no hay elementos.
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Accede a un elemento en O(log(n / CHUNK_SIZE)).
+     *
+     * @param index Posición (menor que size()).
+     * @return Referencia válida mientras el bloque siga vivo en esta u otra copia sin modificar.
+     */
+    const T& operator[](std::size_t index) const {
+        std::pair<std::size_t, std::size_t> where = locate(index);
+        return (*chunks[where.first])[where.second];
+    }
+
+    const_iterator begin() const { return const_iterator(&chunks, 0); }
+    const_iterator end() const { return const_iterator(&chunks, chunks.size()); }
+
+    /**
+     * @brief Número de bloques.
+     * @return Bloques de la secuencia.
+     */
+    std::size_t chunkCount() const { return chunks.size(); }
+
+    /**
+     * @brief Accede a un bloque completo.
+     *
+     * Una copia que no modificó el bloque devuelve el mismo objeto, así que su dirección
+     * sirve para saber qué bloques comparten dos copias vivas.
+     *
+     * @param chunk Índice del bloque (menor que chunkCount()).
+     * @return Elementos del bloque, en orden.
+     */
+    const std::vector<T>& chunkAt(std::size_t chunk) const { return *chunks[chunk]; }
+
+    /**
+     * @brief Posición del primer elemento de un bloque.
+     *
+     * @param chunk Índice del bloque (hasta chunkCount()).
+     * @return Posición en la secuencia.
+     */
+    std::size_t chunkOffset(std::size_t chunk) const { return offsets[chunk]; }
+
+    /**
+     * @brief Primera posición cuyo elemento no va antes que key.
+     *
+     * @param key Valor buscado.
+     * @param less Función bool(const T& element, const Key& key) del orden de la secuencia.
+     * @return Posición, o size() si todos van antes.
+     */
+    template <typename Key, typename Less>
+    std::size_t lowerBound(const Key& key, Less less) const {
+        auto chunk = std::partition_point(chunks.begin(), chunks.end(),
+            [&](const std::shared_ptr<Chunk>& candidate) { return less(candidate->back(), key); });
+        if (chunk == chunks.end()) return size();
+        const std::size_t index = static_cast<std::size_t>(chunk - chunks.begin());
+        auto inside = std::lower_bound((*chunk)->begin(), (*chunk)->end(), key, less);
+        return offsets[index] + static_cast<std::size_t>(inside - (*chunk)->begin());
+    }
+
+    /**
+     * @brief Inserta un elemento.
+     *
+     * @param index Posición que ocupará (hasta size()).
+     * @param value Elemento a insertar.
+     */
+    void insert(std::size_t index, T value) {
+        if (chunks.empty()) {
+            chunks.push_back(std::make_shared<Chunk>());
+            offsets.push_back(0);
+        }
+        // Al final se agrega al último bloque
+        std::pair<std::size_t, std::size_t> where = index == size()
+            ? std::make_pair(chunks.size() - 1, index - offsets[chunks.size() - 1])
+            : locate(index);
+        Chunk& chunk = writable(where.first);
+        chunk.insert(chunk.begin() + static_cast<std::ptrdiff_t>(where.second), std::move(value));
+        shiftAfter(where.first, true);
+
+        if (chunk.size() > 2 * CHUNK_SIZE) {
+            // Se parte en dos mitades para que copiar un bloque siga siendo barato
+            auto upper = std::make_shared<Chunk>(std::make_move_iterator(chunk.begin() + CHUNK_SIZE),
+                                                 std::make_move_iterator(chunk.end()));
+            chunk.resize(CHUNK_SIZE);
+            chunks.insert(chunks.begin() + static_cast<std::ptrdiff_t>(where.first) + 1, std::move(upper));
+            offsets.insert(offsets.begin() + static_cast<std::ptrdiff_t>(where.first) + 1,
+                           offsets[where.first] + CHUNK_SIZE);
+        }
+    }
+
+    /**
+     * @brief Elimina un elemento.
+     *
+     * @param index Posición del elemento (menor que size()).
+     */
+    void erase(std::size_t index) {
+        std::pair<std::size_t, std::size_t> where = locate(index);
+        if (chunks[where.first]->size() == 1) {
+            chunks.erase(chunks.begin() + static_cast<std::ptrdiff_t>(where.first));
+            offsets.erase(offsets.begin() + static_cast<std::ptrdiff_t>(where.first));
+            for (std::size_t i = where.first; i < offsets.size(); ++i) --offsets[i];
+            return;
+        }
+        Chunk& chunk = writable(where.first);
+        chunk.erase(chunk.begin() + static_cast<std::ptrdiff_t>(where.second));
+        shiftAfter(where.first, false);
+    }
+
+    /**
+     * @brief Reemplaza un elemento.
+     *
+     * @param index Posición del elemento (menor que size()).
+     * @param value Valor nuevo.
+     */
+    void replace(std::size_t index, T value) {
+        std::pair<std::size_t, std::size_t> where = locate(index);
+        writable(where.first)[where.second] = std::move(value);
+    }
+
+    /**
+     * @brief Copia la secuencia en un vector contiguo.
+     *
+     * @return Elementos, en orden.
+     */
+    std::vector<T> toVector() const {
+        std::vector<T> items;
+        items.reserve(size());
+        for (const std::shared_ptr<Chunk>& chunk : chunks) items.insert(items.end(), chunk->begin(), chunk->end());
+        return items;
+    }
+};
+
+#endif // CHUNKEDVECTOR_H
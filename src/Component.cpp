@@ -1,47 +1,88 @@
 #include "Component.h"
-#include <iomanip>
-#include <sstream>
+#include "DateFormatter.h"
+#include <cstring>
+#include <utility>
+
+namespace {
+    std::uint64_t mixHash(std::uint64_t hash, std::uint64_t value) {
+        hash ^= value * 0x9E3779B97F4A7C15ull;
+        hash = (hash ^ (hash >> 31)) * 0xBF58476D1CE4E5B9ull;
+        return hash ^ (hash >> 29);
+    }
+
+    std::uint64_t mixText(std::uint64_t hash, std::string_view text) {
+        hash = mixHash(hash, text.size());
+        std::size_t i = 0;
+        for (; i + 8 <= text.size(); i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, text.data() + i, sizeof(word));
+            hash = mixHash(hash, word);
+        }
+        if (i < text.size()) {
+            std::uint64_t word = 0;
+            std::memcpy(&word, text.data() + i, text.size() - i);
+            hash = mixHash(hash, word);
+        }
+        return hash;
+    }
+}
 
 Component::Component() 
-    : id(-1), name(""), type(""), quantity(0), location(""), purchaseDate(0) {}
+    : id(-1), name(""), type(), quantity(0), location(), purchaseDate(0) {}
+
+Component::Component(std::string name, std::string_view type, 
+                     int quantity, std::string_view location, 
+                     std::time_t purchaseDate)
+    : id(-1), name(std::move(name)), type(type), quantity(quantity), 
+      location(location), purchaseDate(purchaseDate) {}
 
-Component::Component(const std::string& name, const std::string& type, 
-                     int quantity, const std::string& location, 
+Component::Component(int id, std::string name, std::string_view type, 
+                     int quantity, std::string_view location, 
                      std::time_t purchaseDate)
-    : id(-1), name(name), type(type), quantity(quantity), 
+    : id(id), name(std::move(name)), type(type), quantity(quantity), 
       location(location), purchaseDate(purchaseDate) {}
 
-Component::Component(int id, const std::string& name, const std::string& type, 
-                     int quantity, const std::string& location, 
+Component::Component(int id, std::string name, InternedString type,
+                     int quantity, InternedString location,
                      std::time_t purchaseDate)
-    : id(id), name(name), type(type), quantity(quantity), 
+    : id(id), name(std::move(name)), type(type), quantity(quantity),
       location(location), purchaseDate(purchaseDate) {}
 
 // Getters
 int Component::getId() const { return id; }
-std::string Component::getName() const { return name; }
-std::string Component::getType() const { return type; }
+std::string_view Component::getName() const { return name; }
+std::string_view Component::getType() const { return type.view(); }
+InternedString Component::getTypeHandle() const { return type; }
 int Component::getQuantity() const { return quantity; }
-std::string Component::getLocation() const { return location; }
+std::string_view Component::getLocation() const { return location.view(); }
+InternedString Component::getLocationHandle() const { return location; }
 std::time_t Component::getPurchaseDate() const { return purchaseDate; }
 
 std::string Component::getPurchaseDateString() const {
     if (purchaseDate == 0) return "No date";
     
-    std::tm* ptm = std::localtime(&purchaseDate);
-    char buffer[32];
-    std::strftime(buffer, 32, "%Y-%m-%d", ptm);
-    return std::string(buffer);
+    return DateFormatter::formatDate(purchaseDate);
 }
 
 // Setters
 void Component::setId(int newId) { id = newId; }
-void Component::setName(const std::string& newName) { name = newName; }
-void Component::setType(const std::string& newType) { type = newType; }
+void Component::setName(std::string newName) { name = std::move(newName); }
+void Component::setType(std::string_view newType) { type = InternedString(newType); }
+void Component::setType(InternedString newType) { type = newType; }
 void Component::setQuantity(int newQuantity) { quantity = newQuantity; }
-void Component::setLocation(const std::string& newLocation) { location = newLocation; }
+void Component::setLocation(std::string_view newLocation) { location = InternedString(newLocation); }
+void Component::setLocation(InternedString newLocation) { location = newLocation; }
 void Component::setPurchaseDate(std::time_t newDate) { purchaseDate = newDate; }
 
 bool Component::isLowStock(int threshold) const {
     return quantity <= threshold;
+}
+
+std::uint64_t Component::contentHash() const {
+    std::uint64_t hash = mixHash(0, static_cast<std::uint32_t>(id) |
+                                    static_cast<std::uint64_t>(static_cast<std::uint32_t>(quantity)) << 32);
+    hash = mixHash(hash, static_cast<std::uint64_t>(purchaseDate));
+    hash = mixText(hash, getName());
+    hash = mixText(hash, getType());
+    return mixText(hash, getLocation());
 }
\ No newline at end of file
@@ -1,23 +1,27 @@
 #ifndef COMPONENT_H
 #define COMPONENT_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <ctime>
+#include "InternedString.h"
 
 /**
  * @class Component
  * @brief Representa un componente en el sistema de inventario.
  * 
  * La clase Component almacena información sobre un componente, incluyendo su ID, nombre, tipo, cantidad, ubicación y fecha de compra.
+ * El tipo y la ubicación se guardan internados (InternedString), ya que se repiten entre muchos componentes.
  */
 class Component
 {
 private:
     int id; /**< Identificador único del componente. */
     std::string name; /**< Nombre del componente. */
-    std::string type; /**< Tipo del componente. */
+    InternedString type; /**< Tipo del componente (internado). */
     int quantity; /**< Cantidad disponible del componente. */
-    std::string location; /**< Ubicación del componente en el inventario. */
+    InternedString location; /**< Ubicación del componente en el inventario (internada). */
     std::time_t purchaseDate; /**< Fecha de compra del componente. */
 
 public:
@@ -33,14 +37,14 @@ public:
      * 
      * Inicializa un objeto Component con los valores proporcionados.
      * 
-     * @param name Nombre del componente.
+     * @param name Nombre del componente (se mueve dentro del objeto).
      * @param type Tipo del componente.
      * @param quantity Cantidad disponible del componente.
      * @param location Ubicación del componente en el inventario.
      * @param purchaseDate Fecha de compra del componente.
      */
-    Component(const std::string& name, const std::string& type, 
-              int quantity, const std::string& location, 
+    Component(std::string name, std::string_view type, 
+              int quantity, std::string_view location, 
               std::time_t purchaseDate);
     
     /**
@@ -49,14 +53,31 @@ public:
      * Inicializa un objeto Component con los valores proporcionados, incluyendo el ID.
      * 
      * @param id Identificador único del componente.
-     * @param name Nombre del componente.
+     * @param name Nombre del componente (se mueve dentro del objeto).
      * @param type Tipo del componente.
      * @param quantity Cantidad disponible del componente.
      * @param location Ubicación del componente en el inventario.
      * @param purchaseDate Fecha de compra del componente.
      */
-    Component(int id, const std::string& name, const std::string& type, 
-              int quantity, const std::string& location, 
+    Component(int id, std::string name, std::string_view type, 
+              int quantity, std::string_view location, 
+              std::time_t purchaseDate);
+
+    /**
+     * @brief Constructor parametrizado con ID y tipo/ubicación ya internados.
+     * 
+     * Evita volver a buscar en el pool cuando el llamador ya tiene los manejadores,
+     * por ejemplo al decodificar filas de la base de datos.
+     * 
+     * @param id Identificador único del componente.
+     * @param name Nombre del componente (se mueve dentro del objeto).
+     * @param type Tipo del componente.
+     * @param quantity Cantidad disponible del componente.
+     * @param location Ubicación del componente en el inventario.
+     * @param purchaseDate Fecha de compra del componente.
+     */
+    Component(int id, std::string name, InternedString type,
+              int quantity, InternedString location,
               std::time_t purchaseDate);
     
     /**
@@ -67,15 +88,21 @@ public:
 
     /**
      * @brief Obtiene el nombre del componente.
-     * @return Nombre del componente.
+     * @return Vista sobre el nombre, válida mientras el componente exista y no se modifique.
      */
-    std::string getName() const;
+    std::string_view getName() const;
 
     /**
      * @brief Obtiene el tipo del componente.
-     * @return Tipo del componente.
+     * @return Vista sobre el tipo; apunta al pool de cadenas internadas y no caduca.
+     */
+    std::string_view getType() const;
+
+    /**
+     * @brief Obtiene el tipo del componente como manejador internado.
+     * @return Tipo del componente; dos tipos iguales tienen el mismo manejador.
      */
-    std::string getType() const;
+    InternedString getTypeHandle() const;
 
     /**
      * @brief Obtiene la cantidad disponible del componente.
@@ -85,9 +112,15 @@ public:
 
     /**
      * @brief Obtiene la ubicación del componente en el inventario.
-     * @return Ubicación del componente.
+     * @return Vista sobre la ubicación; apunta al pool de cadenas internadas y no caduca.
      */
-    std::string getLocation() const;
+    std::string_view getLocation() const;
+
+    /**
+     * @brief Obtiene la ubicación del componente como manejador internado.
+     * @return Ubicación del componente; dos ubicaciones iguales tienen el mismo manejador.
+     */
+    InternedString getLocationHandle() const;
 
     /**
      * @brief Obtiene la fecha de compra del componente.
@@ -111,13 +144,19 @@ public:
      * @brief Establece el nombre del componente.
      * @param newName Nuevo nombre del componente.
      */
-    void setName(const std::string& newName);
+    void setName(std::string newName);
 
     /**
      * @brief Establece el tipo del componente.
      * @param newType Nuevo tipo del componente.
      */
-    void setType(const std::string& newType);
+    void setType(std::string_view newType);
+
+    /**
+     * @brief Establece el tipo del componente a partir de un manejador internado.
+     * @param newType Nuevo tipo del componente.
+     */
+    void setType(InternedString newType);
 
     /**
      * @brief Establece la cantidad disponible del componente.
@@ -129,7 +168,13 @@ public:
      * @brief Establece la ubicación del componente en el inventario.
      * @param newLocation Nueva ubicación del componente.
      */
-    void setLocation(const std::string& newLocation);
+    void setLocation(std::string_view newLocation);
+
+    /**
+     * @brief Establece la ubicación del componente a partir de un manejador internado.
+     * @param newLocation Nueva ubicación del componente.
+     */
+    void setLocation(InternedString newLocation);
 
     /**
      * @brief Establece la fecha de compra del componente.
@@ -144,6 +189,17 @@ public:
      * @return true si el stock es menor o igual al umbral, false en caso contrario.
      */
     bool isLowStock(int threshold = 5) const;
+
+    /**
+     * @brief Calcula un resumen de todos los campos del componente.
+     *
+     * Dos componentes con los mismos valores tienen el mismo resumen en cualquier
+     * ejecución y plataforma: se guarda en disco (ReportManifest) para saber qué filas
+     * de un reporte cambiaron.
+     *
+     * @return Resumen de 64 bits de ID, nombre, tipo, cantidad, ubicación y fecha de compra.
+     */
+    std::uint64_t contentHash() const;
 };
 
 #endif // COMPONENT_H
\ No newline at end of file
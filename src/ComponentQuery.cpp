@@ -0,0 +1,340 @@
+#include "ComponentQuery.h"
+#include <algorithm>
+#include "InventorySnapshot.h"
+
+namespace {
+    std::shared_ptr<ComponentQuery::Predicate> makePredicate(ComponentQuery::Predicate::Kind kind) {
+        auto predicate = std::make_shared<ComponentQuery::Predicate>();
+        predicate->kind = kind;
+        predicate->low = 0;
+        predicate->high = 0;
+        return predicate;
+    }
+
+    // Escapa los comodines de LIKE para que el texto se compare literalmente
+    std::string escapeLike(const std::string& text) {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (char c : text) {
+            if (c == '%' || c == '_' || c == '\\') escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    bool startsWithIgnoreCase(std::string_view text, std::string_view prefix) {
+        if (prefix.size() > text.size()) return false;
+        for (std::size_t i = 0; i < prefix.size(); ++i) {
+            char a = text[i], b = prefix[i];
+            if (a >= 'A' && a <= 'Z') a = static_cast<char>(a - 'A' + 'a');
+            if (b >= 'A' && b <= 'Z') b = static_cast<char>(b - 'A' + 'a');
+            if (a != b) return false;
+        }
+        return true;
+    }
+
+    const char* sortColumn(ComponentQuery::SortKey key) {
+        switch (key) {
+            case ComponentQuery::SortKey::Id: return "id";
+            case ComponentQuery::SortKey::Name: return "name";
+            case ComponentQuery::SortKey::Type: return "type";
+            case ComponentQuery::SortKey::Quantity: return "quantity";
+            // NULL se ordena como en memoria: ubicación vacía y fecha 0
+            case ComponentQuery::SortKey::Location: return "IFNULL(location, '')";
+            case ComponentQuery::SortKey::PurchaseDate: return "IFNULL(purchase_date, 0)";
+        }
+        return "id";
+    }
+
+    // Devuelve <0, 0 o >0 según el campo indicado
+    int compareBy(ComponentQuery::SortKey key, const Component& a, const Component& b) {
+        switch (key) {
+            case ComponentQuery::SortKey::Id:
+                return (a.getId() > b.getId()) - (a.getId() < b.getId());
+            case ComponentQuery::SortKey::Name:
+                return a.getName().compare(b.getName());
+            case ComponentQuery::SortKey::Type:
+                return a.getTypeHandle() == b.getTypeHandle()
+                    ? 0 : a.getType().compare(b.getType());
+            case ComponentQuery::SortKey::Quantity:
+                return (a.getQuantity() > b.getQuantity()) - (a.getQuantity() < b.getQuantity());
+            case ComponentQuery::SortKey::Location:
+                return a.getLocationHandle() == b.getLocationHandle()
+                    ? 0 : a.getLocation().compare(b.getLocation());
+            case ComponentQuery::SortKey::PurchaseDate:
+                return (a.getPurchaseDate() > b.getPurchaseDate()) - (a.getPurchaseDate() < b.getPurchaseDate());
+        }
+        return 0;
+    }
+}
+
+ComponentQuery::ComponentQuery() : maxResults(0) {}
+
+ComponentQuery::PredicatePtr ComponentQuery::typeIn(std::vector<std::string> types) {
+    auto predicate = makePredicate(Predicate::Kind::TypeIn);
+    predicate->texts = std::move(types);
+    for (const auto& type : predicate->texts) {
+        predicate->handles.emplace_back(type);
+    }
+    return predicate;
+}
+
+ComponentQuery::PredicatePtr ComponentQuery::locationPrefix(std::string prefix) {
+    auto predicate = makePredicate(Predicate::Kind::LocationPrefix);
+    predicate->texts.push_back(std::move(prefix));
+    return predicate;
+}
+
+ComponentQuery::PredicatePtr ComponentQuery::quantityBetween(int minimum, int maximum) {
+    auto predicate = makePredicate(Predicate::Kind::QuantityRange);
+    predicate->low = minimum;
+    predicate->high = maximum;
+    return predicate;
+}
+
+ComponentQuery::PredicatePtr ComponentQuery::purchasedBetween(std::time_t from, std::time_t to) {
+    auto predicate = makePredicate(Predicate::Kind::DateRange);
+    predicate->low = static_cast<long long>(from);
+    predicate->high = static_cast<long long>(to);
+    return predicate;
+}
+
+ComponentQuery::PredicatePtr ComponentQuery::nameContains(std::string text) {
+    auto predicate = makePredicate(Predicate::Kind::NameContains);
+    predicate->texts.push_back(std::move(text));
+    return predicate;
+}
+
+ComponentQuery::PredicatePtr ComponentQuery::typeContains(std::string text) {
+    auto predicate = makePredicate(Predicate::Kind::TypeContains);
+    predicate->texts.push_back(std::move(text));
+    return predicate;
+}
+
+ComponentQuery::PredicatePtr ComponentQuery::locationContains(std::string text) {
+    auto predicate = makePredicate(Predicate::Kind::LocationContains);
+    predicate->texts.push_back(std::move(text));
+    return predicate;
+}
+
+ComponentQuery::PredicatePtr ComponentQuery::matchesKeyword(const std::string& text) {
+    // Tipo y ubicación primero: con MatchMemo cuestan una consulta a una tabla, y si
+    // coinciden ya no hace falta recorrer el nombre
+    return anyOf({typeContains(text), locationContains(text), nameContains(text)});
+}
+
+ComponentQuery::PredicatePtr ComponentQuery::allOf(std::vector<PredicatePtr> operands) {
+    auto predicate = makePredicate(Predicate::Kind::And);
+    predicate->children = std::move(operands);
+    return predicate;
+}
+
+ComponentQuery::PredicatePtr ComponentQuery::anyOf(std::vector<PredicatePtr> operands) {
+    auto predicate = makePredicate(Predicate::Kind::Or);
+    predicate->children = std::move(operands);
+    return predicate;
+}
+
+ComponentQuery::PredicatePtr ComponentQuery::negate(PredicatePtr operand) {
+    auto predicate = makePredicate(Predicate::Kind::Not);
+    predicate->children.push_back(std::move(operand));
+    return predicate;
+}
+
+ComponentQuery& ComponentQuery::where(PredicatePtr predicate) {
+    filter = std::move(predicate);
+    return *this;
+}
+
+ComponentQuery& ComponentQuery::orderBy(SortKey key, bool descending) {
+    sortKeys.push_back({key, descending});
+    return *this;
+}
+
+ComponentQuery& ComponentQuery::limit(std::size_t count) {
+    maxResults = count;
+    return *this;
+}
+
+std::size_t ComponentQuery::getLimit() const {
+    return maxResults;
+}
+
+ComponentQuery::PredicatePtr ComponentQuery::getFilter() const {
+    return filter;
+}
+
+bool ComponentQuery::matches(const Component& component) const {
+    return !filter || evaluate(*filter, component, nullptr);
+}
+
+bool ComponentQuery::matches(const Component& component, MatchMemo& memo) const {
+    return !filter || evaluate(*filter, component, &memo);
+}
+
+bool ComponentQuery::evaluateInterned(const Predicate& predicate, InternedString value, MatchMemo* memo) {
+    auto compare = [&predicate](std::string_view text) {
+        return predicate.kind == Predicate::Kind::LocationPrefix
+            ? startsWithIgnoreCase(text, predicate.texts.front())
+            : InventorySnapshot::containsIgnoreCase(text, predicate.texts.front());
+    };
+    if (!memo) return compare(value.view());
+
+    // Pocos predicados de texto por consulta: basta una búsqueda lineal
+    std::size_t slot = 0;
+    while (slot < memo->leaves.size() && memo->leaves[slot] != &predicate) ++slot;
+    if (slot == memo->leaves.size()) {
+        memo->leaves.push_back(&predicate);
+        memo->results.emplace_back();
+    }
+    std::vector<std::uint8_t>& known = memo->results[slot];
+    if (value.id() >= known.size()) known.resize(std::max<std::size_t>(InternedString::poolSize(), value.id() + 1), 0);
+    if (known[value.id()] == 0) known[value.id()] = compare(value.view()) ? 1 : 2;
+    return known[value.id()] == 1;
+}
+
+bool ComponentQuery::evaluate(const Predicate& predicate, const Component& component, MatchMemo* memo) {
+    switch (predicate.kind) {
+        case Predicate::Kind::TypeIn:
+            return std::find(predicate.handles.begin(), predicate.handles.end(),
+                             component.getTypeHandle()) != predicate.handles.end();
+        case Predicate::Kind::LocationPrefix:
+        case Predicate::Kind::LocationContains:
+            return evaluateInterned(predicate, component.getLocationHandle(), memo);
+        case Predicate::Kind::TypeContains:
+            return evaluateInterned(predicate, component.getTypeHandle(), memo);
+        case Predicate::Kind::QuantityRange:
+            return component.getQuantity() >= predicate.low && component.getQuantity() <= predicate.high;
+        case Predicate::Kind::DateRange:
+            return component.getPurchaseDate() >= predicate.low && component.getPurchaseDate() <= predicate.high;
+        case Predicate::Kind::NameContains:
+            return InventorySnapshot::containsIgnoreCase(component.getName(), predicate.texts.front());
+        case Predicate::Kind::And:
+            for (const auto& child : predicate.children) {
+                if (!evaluate(*child, component, memo)) return false;
+            }
+            return true;
+        case Predicate::Kind::Or:
+            for (const auto& child : predicate.children) {
+                if (evaluate(*child, component, memo)) return true;
+            }
+            return false;
+        case Predicate::Kind::Not:
+            return !evaluate(*predicate.children.front(), component, memo);
+    }
+    return false;
+}
+
+bool ComponentQuery::hasDefaultOrder() const {
+    return sortKeys.empty() ||
+           (sortKeys.size() == 1 && sortKeys[0].key == SortKey::Name && !sortKeys[0].descending);
+}
+
+bool ComponentQuery::orderBefore(const Component& a, const Component& b) const {
+    if (sortKeys.empty()) return InventorySnapshot::orderBefore(a, b);
+    for (const auto& spec : sortKeys) {
+        int cmp = compareBy(spec.key, a, b);
+        if (cmp != 0) return spec.descending ? cmp > 0 : cmp < 0;
+    }
+    // Desempate estable por ID, igual que en SQL
+    return a.getId() < b.getId();
+}
+
+void ComponentQuery::sortResults(std::vector<Component>& result) const {
+    auto less = [this](const Component& a, const Component& b) { return orderBefore(a, b); };
+    if (maxResults > 0 && maxResults < result.size()) {
+        std::partial_sort(result.begin(), result.begin() + maxResults, result.end(), less);
+        result.resize(maxResults);
+    } else {
+        std::sort(result.begin(), result.end(), less);
+    }
+}
+
+void ComponentQuery::appendSql(const Predicate& predicate, std::string& sql, std::vector<SqlParam>& params) {
+    switch (predicate.kind) {
+        case Predicate::Kind::TypeIn:
+            if (predicate.texts.empty()) {
+                sql += "0";
+                break;
+            }
+            sql += "type IN (";
+            for (std::size_t i = 0; i < predicate.texts.size(); ++i) {
+                sql += i == 0 ? "?" : ", ?";
+                params.push_back({true, 0, predicate.texts[i]});
+            }
+            sql += ")";
+            break;
+        // Las columnas que admiten NULL valen lo mismo que en memoria (cadena vacía y 0):
+        // si no, NOT sobre ellas descartaría la fila en SQL y la aceptaría en memoria
+        case Predicate::Kind::LocationPrefix:
+            sql += "IFNULL(location, '') LIKE ? ESCAPE '\\'";
+            params.push_back({true, 0, escapeLike(predicate.texts.front()) + "%"});
+            break;
+        case Predicate::Kind::QuantityRange:
+            sql += "quantity BETWEEN ? AND ?";
+            params.push_back({false, predicate.low, ""});
+            params.push_back({false, predicate.high, ""});
+            break;
+        case Predicate::Kind::DateRange:
+            sql += "IFNULL(purchase_date, 0) BETWEEN ? AND ?";
+            params.push_back({false, predicate.low, ""});
+            params.push_back({false, predicate.high, ""});
+            break;
+        case Predicate::Kind::NameContains:
+            sql += "name LIKE ? ESCAPE '\\'";
+            params.push_back({true, 0, "%" + escapeLike(predicate.texts.front()) + "%"});
+            break;
+        case Predicate::Kind::TypeContains:
+            sql += "type LIKE ? ESCAPE '\\'";
+            params.push_back({true, 0, "%" + escapeLike(predicate.texts.front()) + "%"});
+            break;
+        case Predicate::Kind::LocationContains:
+            sql += "IFNULL(location, '') LIKE ? ESCAPE '\\'";
+            params.push_back({true, 0, "%" + escapeLike(predicate.texts.front()) + "%"});
+            break;
+        case Predicate::Kind::And:
+        case Predicate::Kind::Or:
+            if (predicate.children.empty()) {
+                sql += predicate.kind == Predicate::Kind::And ? "1" : "0";
+                break;
+            }
+            sql += "(";
+            for (std::size_t i = 0; i < predicate.children.size(); ++i) {
+                if (i > 0) sql += predicate.kind == Predicate::Kind::And ? " AND " : " OR ";
+                appendSql(*predicate.children[i], sql, params);
+            }
+            sql += ")";
+            break;
+        case Predicate::Kind::Not:
+            sql += "NOT (";
+            appendSql(*predicate.children.front(), sql, params);
+            sql += ")";
+            break;
+    }
+}
+
+std::string ComponentQuery::toSql(std::vector<SqlParam>& params) const {
+    params.clear();
+    std::string sql = "SELECT id, name, type, quantity, location, purchase_date FROM components";
+
+    if (filter) {
+        sql += " WHERE ";
+        appendSql(*filter, sql, params);
+    }
+
+    sql += " ORDER BY ";
+    if (sortKeys.empty()) {
+        sql += "name, id";
+    } else {
+        for (const auto& spec : sortKeys) {
+            sql += sortColumn(spec.key);
+            sql += spec.descending ? " DESC, " : ", ";
+        }
+        sql += "id";
+    }
+
+    // LIMIT siempre presente para que la forma no dependa de si hay límite
+    sql += " LIMIT ?";
+    params.push_back({false, maxResults > 0 ? static_cast<long long>(maxResults) : -1, ""});
+    return sql;
+}
@@ -0,0 +1,294 @@
+#ifndef COMPONENTQUERY_H
+#define COMPONENTQUERY_H
+
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Component.h"
+
+/**
+ * @class ComponentQuery
+ * @brief Consulta componible sobre el inventario: filtro, orden y límite.
+ *
+ * Un filtro es un árbol de predicados (tipo dentro de un conjunto, prefijo de ubicación,
+ * rango de cantidades, rango de fechas de compra, subcadena del nombre, del tipo o de la
+ * ubicación) combinados con Y/O/NO. La misma consulta puede evaluarse en memoria sobre un vector de componentes
+ * (apply) o traducirse a una sentencia SQL parametrizada (toSql) cuyo texto depende solo
+ * de la forma de la consulta, no de sus valores, para poder reutilizar la sentencia
+ * preparada.
+ *
+ * Las comparaciones de texto (subcadena y prefijo) ignoran mayúsculas y minúsculas ASCII,
+ * igual que LIKE en SQLite. Una ubicación o fecha de compra NULL en la base vale lo mismo
+ * que al cargarla en memoria (cadena vacía y 0), también al negar un predicado y al ordenar.
+ */
+class ComponentQuery
+{
+public:
+    /**
+     * @brief Campos por los que se puede ordenar.
+     */
+    enum class SortKey { Id, Name, Type, Quantity, Location, PurchaseDate };
+
+    /**
+     * @brief Nodo del árbol de predicados.
+     */
+    struct Predicate
+    {
+        enum class Kind {
+            TypeIn, LocationPrefix, QuantityRange, DateRange, NameContains, TypeContains, LocationContains,
+            And, Or, Not
+        };
+
+        Kind kind; /**< Tipo de nodo. */
+        std::vector<std::string> texts; /**< Tipos aceptados, prefijo o subcadena. */
+        std::vector<InternedString> handles; /**< Tipos aceptados ya internados (TypeIn). */
+        long long low; /**< Límite inferior inclusivo de los rangos. */
+        long long high; /**< Límite superior inclusivo de los rangos. */
+        std::vector<std::shared_ptr<const Predicate>> children; /**< Operandos de Y/O/NO. */
+    };
+
+    using PredicatePtr = std::shared_ptr<const Predicate>;
+
+    /**
+     * @brief Resultados ya calculados de los predicados de texto sobre tipos y ubicaciones.
+     *
+     * Tipos y ubicaciones son cadenas internadas que se repiten mucho: con un MatchMemo,
+     * matches() compara cada valor distinto una sola vez por predicado. Un MatchMemo sirve
+     * para una sola consulta y no se comparte entre hilos.
+     */
+    class MatchMemo
+    {
+    private:
+        friend class ComponentQuery;
+        std::vector<const Predicate*> leaves; /**< Predicados con resultados recordados. */
+        std::vector<std::vector<std::uint8_t>> results; /**< Por predicado e ID de cadena: 0 sin calcular, 1 sí, 2 no. */
+    };
+
+    /**
+     * @brief Parámetro de una sentencia SQL generada.
+     */
+    struct SqlParam
+    {
+        bool isText; /**< true si el valor es texto, false si es entero. */
+        long long number; /**< Valor entero. */
+        std::string text; /**< Valor de texto. */
+    };
+
+private:
+    /**
+     * @brief Criterio de orden.
+     */
+    struct SortSpec
+    {
+        SortKey key; /**< Campo de orden. */
+        bool descending; /**< true para orden descendente. */
+    };
+
+    PredicatePtr filter; /**< Filtro de la consulta (nullptr = todos). */
+    std::vector<SortSpec> sortKeys; /**< Criterios de orden (vacío = por nombre). */
+    std::size_t maxResults; /**< Número máximo de resultados (0 = sin límite). */
+
+    /**
+     * @brief Evalúa un predicado sobre un componente.
+     *
+     * @param memo Resultados recordados de los predicados de texto (nullptr = sin recordar).
+     */
+    static bool evaluate(const Predicate& predicate, const Component& component, MatchMemo* memo);
+
+    /**
+     * @brief Evalúa un predicado de texto sobre un tipo o una ubicación internados.
+     */
+    static bool evaluateInterned(const Predicate& predicate, InternedString value, MatchMemo* memo);
+
+    /**
+     * @brief Añade a sql la condición equivalente a un predicado y sus parámetros.
+     */
+    static void appendSql(const Predicate& predicate, std::string& sql, std::vector<SqlParam>& params);
+
+    /**
+     * @brief Indica si el orden pedido coincide con el de un snapshot (nombre, ID).
+     */
+    bool hasDefaultOrder() const;
+
+    /**
+     * @brief Ordena y recorta los resultados según el orden y el límite de la consulta.
+     *
+     * @param result Componentes que cumplen el filtro.
+     */
+    void sortResults(std::vector<Component>& result) const;
+
+public:
+    /**
+     * @brief Constructor por defecto: todos los componentes ordenados por nombre.
+     */
+    ComponentQuery();
+
+    // Predicados
+
+    /**
+     * @brief El tipo del componente es uno de los dados.
+     * @param types Tipos aceptados (un conjunto vacío no acepta ninguno).
+     */
+    static PredicatePtr typeIn(std::vector<std::string> types);
+
+    /**
+     * @brief La ubicación empieza por el prefijo dado.
+     * @param prefix Prefijo de ubicación.
+     */
+    static PredicatePtr locationPrefix(std::string prefix);
+
+    /**
+     * @brief La cantidad está en el rango [minimum, maximum].
+     * @param minimum Cantidad mínima.
+     * @param maximum Cantidad máxima.
+     */
+    static PredicatePtr quantityBetween(int minimum, int maximum = std::numeric_limits<int>::max());
+
+    /**
+     * @brief La fecha de compra está en el rango [from, to].
+     * @param from Fecha inicial.
+     * @param to Fecha final.
+     */
+    static PredicatePtr purchasedBetween(std::time_t from, std::time_t to);
+
+    /**
+     * @brief El nombre contiene el texto dado.
+     * @param text Subcadena a buscar.
+     */
+    static PredicatePtr nameContains(std::string text);
+
+    /**
+     * @brief El tipo contiene el texto dado.
+     * @param text Subcadena a buscar.
+     */
+    static PredicatePtr typeContains(std::string text);
+
+    /**
+     * @brief La ubicación contiene el texto dado.
+     * @param text Subcadena a buscar.
+     */
+    static PredicatePtr locationContains(std::string text);
+
+    /**
+     * @brief El nombre, el tipo o la ubicación contienen el texto dado (el criterio de la
+     * caja de búsqueda).
+     * @param text Subcadena a buscar.
+     */
+    static PredicatePtr matchesKeyword(const std::string& text);
+
+    /**
+     * @brief Se cumplen todos los predicados (conjunción vacía = verdadero).
+     * @param operands Predicados a combinar.
+     */
+    static PredicatePtr allOf(std::vector<PredicatePtr> operands);
+
+    /**
+     * @brief Se cumple alguno de los predicados (disyunción vacía = falso).
+     * @param operands Predicados a combinar.
+     */
+    static PredicatePtr anyOf(std::vector<PredicatePtr> operands);
+
+    /**
+     * @brief Negación de un predicado.
+     * @param operand Predicado a negar.
+     */
+    static PredicatePtr negate(PredicatePtr operand);
+
+    // Construcción de la consulta
+
+    /**
+     * @brief Establece el filtro de la consulta.
+     * @param predicate Predicado raíz.
+     * @return Referencia a esta consulta.
+     */
+    ComponentQuery& where(PredicatePtr predicate);
+
+    /**
+     * @brief Añade un criterio de orden (se aplican en el orden en que se añaden).
+     * @param key Campo de orden.
+     * @param descending true para orden descendente.
+     * @return Referencia a esta consulta.
+     */
+    ComponentQuery& orderBy(SortKey key, bool descending = false);
+
+    /**
+     * @brief Limita el número de resultados.
+     * @param count Número máximo de resultados (0 = sin límite).
+     * @return Referencia a esta consulta.
+     */
+    ComponentQuery& limit(std::size_t count);
+
+    /**
+     * @brief Obtiene el límite de resultados.
+     * @return Número máximo de resultados (0 = sin límite).
+     */
+    std::size_t getLimit() const;
+
+    /**
+     * @brief Obtiene el filtro de la consulta.
+     * @return Predicado raíz (nullptr = todos).
+     */
+    PredicatePtr getFilter() const;
+
+    // Evaluación
+
+    /**
+     * @brief Comprueba si un componente cumple el filtro.
+     * @param component Componente a comprobar.
+     * @return true si lo cumple.
+     */
+    bool matches(const Component& component) const;
+
+    /**
+     * @brief Comprueba si un componente cumple el filtro, recordando los resultados de
+     * los predicados de texto sobre tipos y ubicaciones.
+     * @param component Componente a comprobar.
+     * @param memo Resultados recordados de esta consulta.
+     * @return true si lo cumple.
+     */
+    bool matches(const Component& component, MatchMemo& memo) const;
+
+    /**
+     * @brief Evalúa la consulta en memoria.
+     *
+     * @param components Componentes ordenados por (nombre, ID): un InventorySnapshot o
+     *        cualquier secuencia que se pueda recorrer con un for de rango.
+     * @return Componentes que cumplen el filtro, ordenados y limitados.
+     */
+    template <typename Range>
+    std::vector<Component> apply(const Range& components) const {
+        std::vector<Component> result;
+        const bool presorted = hasDefaultOrder();
+        MatchMemo memo;
+        for (const Component& component : components) {
+            if (!matches(component, memo)) continue;
+            result.push_back(component);
+            // Con el orden del snapshot los primeros que cumplen son ya la respuesta
+            if (presorted && maxResults > 0 && result.size() == maxResults) break;
+        }
+        if (!presorted) sortResults(result);
+        return result;
+    }
+
+    /**
+     * @brief Compara dos componentes según el orden de la consulta.
+     * @return true si a va antes que b.
+     */
+    bool orderBefore(const Component& a, const Component& b) const;
+
+    /**
+     * @brief Traduce la consulta a SQL parametrizado.
+     *
+     * El texto devuelto depende solo de la forma de la consulta, así que sirve como clave
+     * para cachear la sentencia preparada.
+     *
+     * @param params Recibe los valores a enlazar, en orden.
+     * @return Sentencia SELECT sobre la tabla components.
+     */
+    std::string toSql(std::vector<SqlParam>& params) const;
+};
+
+#endif // COMPONENTQUERY_H
@@ -0,0 +1,394 @@
+#include "ComponentTable.h"
+#include <atomic>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define COMPONENTTABLE_SSE2 1
+#if defined(__GNUC__) || defined(__clang__)
+#include <immintrin.h>
+#define COMPONENTTABLE_AVX2 1
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define COMPONENTTABLE_NEON 1
+#endif
+
+namespace {
+    // Kernels sobre el arreglo de cantidades. Todos comparan "q <= threshold" como
+    // "q < threshold + 1", por lo que el llamador resuelve antes threshold == INT_MAX.
+
+#if defined(COMPONENTTABLE_AVX2)
+    bool cpuHasAvx2() {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    __attribute__((target("avx2")))
+    std::size_t countBelowAvx2(const std::int32_t* data, std::size_t n, std::int32_t limit) {
+        const __m256i bound = _mm256_set1_epi32(limit);
+        __m256i acc = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i q = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            // La máscara vale -1 en las filas que cumplen: restarla suma 1
+            acc = _mm256_sub_epi32(acc, _mm256_cmpgt_epi32(bound, q));
+        }
+        alignas(32) std::uint32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        std::size_t count = 0;
+        for (std::uint32_t lane : lanes) count += lane;
+        for (; i < n; ++i) count += data[i] < limit;
+        return count;
+    }
+
+    __attribute__((target("avx2")))
+    long long sumAvx2(const std::int32_t* data, std::size_t n) {
+        __m256i acc = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(lo));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(hi));
+        }
+        alignas(32) long long lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        long long sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        for (; i < n; ++i) sum += data[i];
+        return sum;
+    }
+
+    __attribute__((target("avx2")))
+    void filterBelowAvx2(const std::int32_t* data, std::size_t n, std::int32_t limit,
+                         std::vector<std::uint32_t>& rows) {
+        const __m256i bound = _mm256_set1_epi32(limit);
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i q = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            unsigned bits = static_cast<unsigned>(
+                _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(bound, q))));
+            while (bits) {
+                rows.push_back(static_cast<std::uint32_t>(i + __builtin_ctz(bits)));
+                bits &= bits - 1;
+            }
+        }
+        for (; i < n; ++i) {
+            if (data[i] < limit) rows.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+#endif
+
+#if defined(COMPONENTTABLE_SSE2)
+    std::size_t countBelowSse2(const std::int32_t* data, std::size_t n, std::int32_t limit) {
+        const __m128i bound = _mm_set1_epi32(limit);
+        __m128i acc = _mm_setzero_si128();
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i q = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            acc = _mm_sub_epi32(acc, _mm_cmplt_epi32(q, bound));
+        }
+        alignas(16) std::uint32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        std::size_t count = std::size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+        for (; i < n; ++i) count += data[i] < limit;
+        return count;
+    }
+
+    long long sumSse2(const std::int32_t* data, std::size_t n) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i acc = _mm_setzero_si128();
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i q = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            // SSE2 no tiene extensión de signo 32->64: se intercala con la máscara de signo
+            __m128i sign = _mm_cmpgt_epi32(zero, q);
+            acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(q, sign));
+            acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(q, sign));
+        }
+        alignas(16) long long lanes[2];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        long long sum = lanes[0] + lanes[1];
+        for (; i < n; ++i) sum += data[i];
+        return sum;
+    }
+
+    void filterBelowSse2(const std::int32_t* data, std::size_t n, std::int32_t limit,
+                         std::vector<std::uint32_t>& rows) {
+        const __m128i bound = _mm_set1_epi32(limit);
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i q = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            unsigned bits = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(q, bound))));
+            for (unsigned lane = 0; lane < 4; ++lane) {
+                if (bits & (1u << lane)) rows.push_back(static_cast<std::uint32_t>(i + lane));
+            }
+        }
+        for (; i < n; ++i) {
+            if (data[i] < limit) rows.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+#endif
+
+#if defined(COMPONENTTABLE_NEON)
+    std::size_t countBelowNeon(const std::int32_t* data, std::size_t n, std::int32_t limit) {
+        const int32x4_t bound = vdupq_n_s32(limit);
+        uint32x4_t acc = vdupq_n_u32(0);
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            acc = vsubq_u32(acc, vcltq_s32(vld1q_s32(data + i), bound));
+        }
+        std::size_t count = std::size_t(vgetq_lane_u32(acc, 0)) + vgetq_lane_u32(acc, 1) +
+                            vgetq_lane_u32(acc, 2) + vgetq_lane_u32(acc, 3);
+        for (; i < n; ++i) count += data[i] < limit;
+        return count;
+    }
+
+    long long sumNeon(const std::int32_t* data, std::size_t n) {
+        int64x2_t acc = vdupq_n_s64(0);
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            acc = vpadalq_s32(acc, vld1q_s32(data + i));
+        }
+        long long sum = vgetq_lane_s64(acc, 0) + vgetq_lane_s64(acc, 1);
+        for (; i < n; ++i) sum += data[i];
+        return sum;
+    }
+#endif
+
+    // Referencia escalar: el resto de los kernels deben dar exactamente lo mismo
+    std::size_t countBelowScalar(const std::int32_t* data, std::size_t n, std::int32_t limit) {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < n; ++i) count += data[i] < limit;
+        return count;
+    }
+
+    long long sumScalar(const std::int32_t* data, std::size_t n) {
+        long long sum = 0;
+        for (std::size_t i = 0; i < n; ++i) sum += data[i];
+        return sum;
+    }
+
+    void filterBelowScalar(const std::int32_t* data, std::size_t n, std::int32_t limit,
+                           std::vector<std::uint32_t>& rows) {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (data[i] < limit) rows.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    std::atomic<ComponentTable::Kernel> selectedKernel(ComponentTable::Kernel::Auto);
+
+    // Implementación que corresponde a la elegida en esta compilación y esta CPU
+    ComponentTable::Kernel activeKernel() {
+        ComponentTable::Kernel kernel = selectedKernel.load(std::memory_order_relaxed);
+        if (kernel != ComponentTable::Kernel::Auto) return kernel;
+#if defined(COMPONENTTABLE_AVX2)
+        if (cpuHasAvx2()) return ComponentTable::Kernel::Avx2;
+#endif
+#if defined(COMPONENTTABLE_SSE2)
+        return ComponentTable::Kernel::Sse2;
+#elif defined(COMPONENTTABLE_NEON)
+        return ComponentTable::Kernel::Neon;
+#else
+        return ComponentTable::Kernel::Scalar;
+#endif
+    }
+
+    std::size_t countBelow(const std::int32_t* data, std::size_t n, std::int32_t limit) {
+        switch (activeKernel()) {
+#if defined(COMPONENTTABLE_AVX2)
+            case ComponentTable::Kernel::Avx2:
+                return countBelowAvx2(data, n, limit);
+#endif
+#if defined(COMPONENTTABLE_SSE2)
+            case ComponentTable::Kernel::Sse2:
+                return countBelowSse2(data, n, limit);
+#endif
+#if defined(COMPONENTTABLE_NEON)
+            case ComponentTable::Kernel::Neon:
+                return countBelowNeon(data, n, limit);
+#endif
+            default:
+                return countBelowScalar(data, n, limit);
+        }
+    }
+
+    long long sumAll(const std::int32_t* data, std::size_t n) {
+        switch (activeKernel()) {
+#if defined(COMPONENTTABLE_AVX2)
+            case ComponentTable::Kernel::Avx2:
+                return sumAvx2(data, n);
+#endif
+#if defined(COMPONENTTABLE_SSE2)
+            case ComponentTable::Kernel::Sse2:
+                return sumSse2(data, n);
+#endif
+#if defined(COMPONENTTABLE_NEON)
+            case ComponentTable::Kernel::Neon:
+                return sumNeon(data, n);
+#endif
+            default:
+                return sumScalar(data, n);
+        }
+    }
+
+    // No hay filtro NEON: en ARM el filtro es escalar
+    void filterBelow(const std::int32_t* data, std::size_t n, std::int32_t limit,
+                     std::vector<std::uint32_t>& rows) {
+        switch (activeKernel()) {
+#if defined(COMPONENTTABLE_AVX2)
+            case ComponentTable::Kernel::Avx2:
+                filterBelowAvx2(data, n, limit, rows);
+                return;
+#endif
+#if defined(COMPONENTTABLE_SSE2)
+            case ComponentTable::Kernel::Sse2:
+                filterBelowSse2(data, n, limit, rows);
+                return;
+#endif
+            default:
+                filterBelowScalar(data, n, limit, rows);
+        }
+    }
+
+    std::uint32_t encode(InternedString value,
+                         std::unordered_map<std::uint32_t, std::uint32_t>& codes,
+                         std::vector<InternedString>& dictionary) {
+        auto inserted = codes.emplace(value.id(), static_cast<std::uint32_t>(dictionary.size()));
+        if (inserted.second) {
+            dictionary.push_back(value);
+        }
+        return inserted.first->second;
+    }
+}
+
+bool ComponentTable::setKernel(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Sse2:
+#if defined(COMPONENTTABLE_SSE2)
+            break;
+#else
+            return false;
+#endif
+        case Kernel::Avx2:
+#if defined(COMPONENTTABLE_AVX2)
+            if (!cpuHasAvx2()) return false;
+            break;
+#else
+            return false;
+#endif
+        case Kernel::Neon:
+#if defined(COMPONENTTABLE_NEON)
+            break;
+#else
+            return false;
+#endif
+        default:
+            break;
+    }
+    selectedKernel.store(kernel);
+    return true;
+}
+
+ComponentTable::Kernel ComponentTable::getKernel() {
+    return selectedKernel.load();
+}
+
+ComponentTable::ComponentTable() {
+    nameOffsets.push_back(0);
+}
+
+ComponentTable ComponentTable::fromComponents(const std::vector<Component>& components) {
+    ComponentTable table;
+    table.reserve(components.size());
+    for (const auto& component : components) {
+        table.append(component);
+    }
+    return table;
+}
+
+void ComponentTable::reserve(std::size_t rows) {
+    ids.reserve(rows);
+    quantities.reserve(rows);
+    purchaseDates.reserve(rows);
+    typeIds.reserve(rows);
+    locationIds.reserve(rows);
+    nameOffsets.reserve(rows + 1);
+}
+
+void ComponentTable::append(int id, std::string_view name, std::string_view type, int quantity,
+                            std::string_view location, std::int64_t purchaseDate) {
+    append(id, name, InternedString(type), quantity, InternedString(location), purchaseDate);
+}
+
+void ComponentTable::append(int id, std::string_view name, InternedString type, int quantity,
+                            InternedString location, std::int64_t purchaseDate) {
+    ids.push_back(id);
+    quantities.push_back(quantity);
+    purchaseDates.push_back(purchaseDate);
+    typeIds.push_back(encode(type, typeCodes, typeDictionary));
+    locationIds.push_back(encode(location, locationCodes, locationDictionary));
+    nameArena.append(name.data(), name.size());
+    nameOffsets.push_back(static_cast<std::uint32_t>(nameArena.size()));
+}
+
+void ComponentTable::append(const Component& component) {
+    append(component.getId(), component.getName(), component.getTypeHandle(), component.getQuantity(),
+           component.getLocationHandle(), static_cast<std::int64_t>(component.getPurchaseDate()));
+}
+
+std::size_t ComponentTable::size() const {
+    return ids.size();
+}
+
+int ComponentTable::getId(std::size_t row) const { return ids[row]; }
+int ComponentTable::getQuantity(std::size_t row) const { return quantities[row]; }
+std::int64_t ComponentTable::getPurchaseDate(std::size_t row) const { return purchaseDates[row]; }
+std::uint32_t ComponentTable::getTypeId(std::size_t row) const { return typeIds[row]; }
+std::uint32_t ComponentTable::getLocationId(std::size_t row) const { return locationIds[row]; }
+
+std::string_view ComponentTable::getName(std::size_t row) const {
+    return std::string_view(nameArena.data() + nameOffsets[row], nameOffsets[row + 1] - nameOffsets[row]);
+}
+
+std::string_view ComponentTable::getType(std::size_t row) const {
+    return typeDictionary[typeIds[row]].view();
+}
+
+std::string_view ComponentTable::getLocation(std::size_t row) const {
+    return locationDictionary[locationIds[row]].view();
+}
+
+Component ComponentTable::componentAt(std::size_t row) const {
+    return Component(ids[row], std::string(getName(row)), typeDictionary[typeIds[row]], quantities[row],
+                     locationDictionary[locationIds[row]], static_cast<std::time_t>(purchaseDates[row]));
+}
+
+const std::vector<InternedString>& ComponentTable::getTypeDictionary() const {
+    return typeDictionary;
+}
+
+const std::vector<InternedString>& ComponentTable::getLocationDictionary() const {
+    return locationDictionary;
+}
+
+std::size_t ComponentTable::countAtOrBelow(int threshold) const {
+    if (threshold == std::numeric_limits<int>::max()) return quantities.size();
+    return countBelow(quantities.data(), quantities.size(), threshold + 1);
+}
+
+std::vector<std::uint32_t> ComponentTable::filterAtOrBelow(int threshold) const {
+    std::vector<std::uint32_t> rows;
+    if (threshold == std::numeric_limits<int>::max()) {
+        rows.resize(quantities.size());
+        for (std::size_t i = 0; i < rows.size(); ++i) rows[i] = static_cast<std::uint32_t>(i);
+        return rows;
+    }
+    rows.reserve(countAtOrBelow(threshold));
+    filterBelow(quantities.data(), quantities.size(), threshold + 1, rows);
+    return rows;
+}
+
+long long ComponentTable::sumQuantities() const {
+    return sumAll(quantities.data(), quantities.size());
+}
@@ -0,0 +1,211 @@
+#ifndef COMPONENTTABLE_H
+#define COMPONENTTABLE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Component.h"
+
+/**
+ * @class ComponentTable
+ * @brief Inventario en formato columnar (struct-of-arrays) para recorridos analíticos.
+ *
+ * Cada campo se guarda en su propio arreglo contiguo: IDs y cantidades como int32, fechas
+ * como int64, tipo y ubicación codificados como índices de diccionario y los nombres en un
+ * único bloque de texto. Contar stock bajo o sumar cantidades recorre solo 4 bytes por
+ * componente en lugar de objetos Component completos, y los kernels usan SSE2/AVX2 (o
+ * NEON en ARM) cuando están disponibles.
+ *
+ * La fila i de la tabla corresponde al componente i del vector del que se construyó.
+ */
+class ComponentTable
+{
+private:
+    std::vector<std::int32_t> ids; /**< IDs de los componentes. */
+    std::vector<std::int32_t> quantities; /**< Cantidades disponibles. */
+    std::vector<std::int64_t> purchaseDates; /**< Fechas de compra (segundos desde epoch). */
+    std::vector<std::uint32_t> typeIds; /**< Índice de cada tipo en typeDictionary. */
+    std::vector<std::uint32_t> locationIds; /**< Índice de cada ubicación en locationDictionary. */
+    std::vector<InternedString> typeDictionary; /**< Tipos distintos, en orden de aparición. */
+    std::vector<InternedString> locationDictionary; /**< Ubicaciones distintas, en orden de aparición. */
+    std::string nameArena; /**< Todos los nombres concatenados. */
+    std::vector<std::uint32_t> nameOffsets; /**< Inicio de cada nombre en nameArena (n + 1 entradas). */
+    std::unordered_map<std::uint32_t, std::uint32_t> typeCodes; /**< ID internado del tipo -> índice (solo al construir). */
+    std::unordered_map<std::uint32_t, std::uint32_t> locationCodes; /**< ID internado de la ubicación -> índice (solo al construir). */
+
+public:
+    /**
+     * @brief Implementación de los kernels analíticos.
+     */
+    enum class Kernel
+    {
+        Auto, /**< La más rápida disponible: AVX2, SSE2, NEON o escalar. */
+        Scalar, /**< Una fila por paso. */
+        Sse2, /**< 4 filas por paso. */
+        Avx2, /**< 8 filas por paso. */
+        Neon /**< 4 filas por paso (ARM). */
+    };
+
+    /**
+     * @brief Elige la implementación de los kernels para todas las tablas.
+     *
+     * El resultado es el mismo con cualquiera de ellas; existe para poder comparar las
+     * implementaciones entre sí (pruebas y mediciones).
+     *
+     * @param kernel Implementación a usar (por defecto Auto).
+     * @return false si no está disponible en esta compilación o en esta CPU (no cambia nada).
+     */
+    static bool setKernel(Kernel kernel);
+
+    /**
+     * @brief Obtiene la implementación de los kernels elegida.
+     * @return Implementación actual.
+     */
+    static Kernel getKernel();
+
+    /**
+     * @brief Constructor por defecto: tabla vacía.
+     */
+    ComponentTable();
+
+    /**
+     * @brief Construye la tabla a partir de un vector de componentes.
+     *
+     * @param components Componentes a convertir.
+     * @return Tabla con una fila por componente, en el mismo orden.
+     */
+    static ComponentTable fromComponents(const std::vector<Component>& components);
+
+    /**
+     * @brief Reserva espacio para un número de filas.
+     * @param rows Número de filas esperado.
+     */
+    void reserve(std::size_t rows);
+
+    /**
+     * @brief Añade una fila al final de la tabla.
+     *
+     * @param id ID del componente.
+     * @param name Nombre del componente.
+     * @param type Tipo del componente.
+     * @param quantity Cantidad disponible.
+     * @param location Ubicación del componente.
+     * @param purchaseDate Fecha de compra.
+     */
+    void append(int id, std::string_view name, std::string_view type, int quantity,
+                std::string_view location, std::int64_t purchaseDate);
+
+    /**
+     * @brief Añade una fila con tipo y ubicación ya internados.
+     *
+     * El diccionario se indexa por el ID del pool, así que no se hashea ni se copia texto.
+     *
+     * @param id ID del componente.
+     * @param name Nombre del componente.
+     * @param type Tipo del componente.
+     * @param quantity Cantidad disponible.
+     * @param location Ubicación del componente.
+     * @param purchaseDate Fecha de compra.
+     */
+    void append(int id, std::string_view name, InternedString type, int quantity,
+                InternedString location, std::int64_t purchaseDate);
+
+    /**
+     * @brief Añade un componente al final de la tabla.
+     * @param component Componente a añadir.
+     */
+    void append(const Component& component);
+
+    /**
+     * @brief Obtiene el número de filas.
+     * @return Número de componentes en la tabla.
+     */
+    std::size_t size() const;
+
+    // Acceso por fila
+
+    /**
+     * @brief Obtiene el ID de una fila.
+     */
+    int getId(std::size_t row) const;
+
+    /**
+     * @brief Obtiene la cantidad de una fila.
+     */
+    int getQuantity(std::size_t row) const;
+
+    /**
+     * @brief Obtiene la fecha de compra de una fila.
+     */
+    std::int64_t getPurchaseDate(std::size_t row) const;
+
+    /**
+     * @brief Obtiene el nombre de una fila (vista sobre el bloque de nombres).
+     */
+    std::string_view getName(std::size_t row) const;
+
+    /**
+     * @brief Obtiene el tipo de una fila.
+     */
+    std::string_view getType(std::size_t row) const;
+
+    /**
+     * @brief Obtiene la ubicación de una fila.
+     */
+    std::string_view getLocation(std::size_t row) const;
+
+    /**
+     * @brief Obtiene el código de diccionario del tipo de una fila.
+     */
+    std::uint32_t getTypeId(std::size_t row) const;
+
+    /**
+     * @brief Obtiene el código de diccionario de la ubicación de una fila.
+     */
+    std::uint32_t getLocationId(std::size_t row) const;
+
+    /**
+     * @brief Reconstruye el Component de una fila.
+     * @param row Índice de la fila.
+     * @return Componente equivalente.
+     */
+    Component componentAt(std::size_t row) const;
+
+    /**
+     * @brief Obtiene los tipos distintos de la tabla.
+     * @return Diccionario de tipos, indexado por getTypeId.
+     */
+    const std::vector<InternedString>& getTypeDictionary() const;
+
+    /**
+     * @brief Obtiene las ubicaciones distintas de la tabla.
+     * @return Diccionario de ubicaciones, indexado por getLocationId.
+     */
+    const std::vector<InternedString>& getLocationDictionary() const;
+
+    // Kernels analíticos
+
+    /**
+     * @brief Cuenta los componentes con cantidad menor o igual al umbral.
+     * @param threshold Umbral de stock bajo.
+     * @return Número de filas que cumplen la condición.
+     */
+    std::size_t countAtOrBelow(int threshold) const;
+
+    /**
+     * @brief Obtiene las filas con cantidad menor o igual al umbral.
+     * @param threshold Umbral de stock bajo.
+     * @return Índices de las filas que cumplen la condición, en orden.
+     */
+    std::vector<std::uint32_t> filterAtOrBelow(int threshold) const;
+
+    /**
+     * @brief Suma todas las cantidades.
+     * @return Cantidad total del inventario.
+     */
+    long long sumQuantities() const;
+};
+
+#endif // COMPONENTTABLE_H
@@ -0,0 +1,196 @@
+#include "CompressionPipeline.h"
+#include <iostream>
+#include <zlib.h>
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+    const std::size_t OUTPUT_SIZE = 256 * 1024; // Búfer de salida del compresor
+
+    bool endsWith(const std::string& text, const char* suffix) {
+        const std::size_t length = std::char_traits<char>::length(suffix);
+        return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+    }
+}
+
+struct CompressionPipeline::Encoder
+{
+    Codec codec;
+    z_stream zlib{};
+    bool zlibReady = false;
+#ifdef HAVE_ZSTD
+    ZSTD_CCtx* zstd = nullptr;
+#endif
+    std::unique_ptr<unsigned char[]> output{new unsigned char[OUTPUT_SIZE]};
+
+    explicit Encoder(Codec codec) : codec(codec) {}
+
+    ~Encoder() {
+        if (zlibReady) {
+            deflateEnd(&zlib);
+        }
+#ifdef HAVE_ZSTD
+        ZSTD_freeCCtx(zstd);
+#endif
+    }
+};
+
+bool CompressionPipeline::codecFor(const std::string& path, Codec& codec) {
+    if (endsWith(path, ".gz")) {
+        codec = Codec::Gzip;
+        return true;
+    }
+    if (endsWith(path, ".zst")) {
+        codec = Codec::Zstd;
+        return true;
+    }
+    return false;
+}
+
+bool CompressionPipeline::isAvailable(Codec codec) {
+#ifdef HAVE_ZSTD
+    (void)codec;
+    return true;
+#else
+    return codec == Codec::Gzip;
+#endif
+}
+
+CompressionPipeline::CompressionPipeline()
+    : file(nullptr), blockCapacity(0), finishing(false), failed(false) {}
+
+CompressionPipeline::~CompressionPipeline() {
+    close();
+}
+
+bool CompressionPipeline::open(const std::string& path, Codec codec, std::size_t capacity) {
+    close();
+    if (!isAvailable(codec)) {
+        std::cerr << "Compresión zstd no disponible en esta compilación: " << path << std::endl;
+        return false;
+    }
+
+    auto state = std::make_unique<Encoder>(codec);
+    if (codec == Codec::Gzip) {
+        // 15 + 16: ventana máxima con cabecera gzip; el nivel rápido mantiene el ritmo del formateo
+        if (deflateInit2(&state->zlib, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return false;
+        }
+        state->zlibReady = true;
+    }
+#ifdef HAVE_ZSTD
+    else {
+        state->zstd = ZSTD_createCCtx();
+        if (!state->zstd) return false;
+        ZSTD_CCtx_setParameter(state->zstd, ZSTD_c_compressionLevel, ZSTD_CLEVEL_DEFAULT);
+    }
+#endif
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    encoder = std::move(state);
+    blockCapacity = capacity;
+    pending.clear();
+    spare.clear();
+    finishing = false;
+    failed = false;
+    worker = std::thread(&CompressionPipeline::run, this);
+    return true;
+}
+
+std::unique_ptr<char[]> CompressionPipeline::exchange(std::unique_ptr<char[]> block, std::size_t size) {
+    std::unique_ptr<char[]> next;
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        spaceCondition.wait(lock, [this]() { return pending.size() < MAX_PENDING; });
+        pending.push_back({std::move(block), size});
+        if (!spare.empty()) {
+            next = std::move(spare.back());
+            spare.pop_back();
+        }
+    }
+    queueCondition.notify_one();
+
+    if (!next) next.reset(new char[blockCapacity]);
+    return next;
+}
+
+bool CompressionPipeline::close() {
+    if (!worker.joinable()) return !failed;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        finishing = true;
+    }
+    queueCondition.notify_one();
+    worker.join();
+
+    encoder.reset();
+    if (std::fclose(file) != 0) failed = true;
+    file = nullptr;
+    spare.clear();
+    return !failed;
+}
+
+void CompressionPipeline::run() {
+    for (;;) {
+        Block block;
+        bool skip;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this]() { return finishing || !pending.empty(); });
+            if (pending.empty()) break;
+            block = std::move(pending.front());
+            pending.pop_front();
+            skip = failed;
+        }
+        spaceCondition.notify_one();
+
+        // Tras un error se siguen recibiendo bloques (para no bloquear a exchange) sin escribirlos
+        const bool ok = skip || compress(block.data.get(), block.size, false);
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (!ok) failed = true;
+        spare.push_back(std::move(block.data));
+    }
+
+    if (!failed && !compress(nullptr, 0, true)) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        failed = true;
+    }
+}
+
+bool CompressionPipeline::compress(const char* data, std::size_t size, bool finish) {
+    unsigned char* output = encoder->output.get();
+
+    if (encoder->codec == Codec::Gzip) {
+        z_stream& stream = encoder->zlib;
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        stream.avail_in = static_cast<uInt>(size);
+        // Mientras deflate llene la salida puede quedar más por sacar; con Z_FINISH el
+        // bucle termina cuando el flujo está cerrado
+        do {
+            stream.next_out = output;
+            stream.avail_out = static_cast<uInt>(OUTPUT_SIZE);
+            if (deflate(&stream, finish ? Z_FINISH : Z_NO_FLUSH) == Z_STREAM_ERROR) return false;
+            const std::size_t produced = OUTPUT_SIZE - stream.avail_out;
+            if (produced > 0 && std::fwrite(output, 1, produced, file) != produced) return false;
+        } while (stream.avail_out == 0);
+        return true;
+    }
+
+#ifdef HAVE_ZSTD
+    ZSTD_inBuffer input{data, size, 0};
+    for (;;) {
+        ZSTD_outBuffer out{output, OUTPUT_SIZE, 0};
+        const std::size_t remaining = ZSTD_compressStream2(encoder->zstd, &out, &input,
+                                                           finish ? ZSTD_e_end : ZSTD_e_continue);
+        if (ZSTD_isError(remaining)) return false;
+        if (out.pos > 0 && std::fwrite(output, 1, out.pos, file) != out.pos) return false;
+        if (finish ? remaining == 0 : input.pos == input.size) return true;
+    }
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,134 @@
+#ifndef COMPRESSIONPIPELINE_H
+#define COMPRESSIONPIPELINE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class CompressionPipeline
+ * @brief Comprime bloques de salida en un hilo propio y los escribe en un archivo.
+ *
+ * OutputBuffer entrega cada búfer lleno con exchange() y sigue formateando sobre otro
+ * mientras este hilo lo comprime (gzip con zlib o, si se compiló con HAVE_ZSTD, zstd) y
+ * lo escribe. Como mucho hay MAX_PENDING bloques en espera: si la compresión va más lenta
+ * que el formateo, exchange() espera en lugar de acumular memoria.
+ */
+class CompressionPipeline
+{
+public:
+    /**
+     * @brief Formatos de compresión.
+     */
+    enum class Codec
+    {
+        Gzip, /**< Archivo .gz (zlib, nivel rápido). */
+        Zstd /**< Archivo .zst (solo si se compiló con HAVE_ZSTD). */
+    };
+
+    static constexpr std::size_t MAX_PENDING = 3; /**< Bloques en espera antes de que exchange() se detenga. */
+
+private:
+    /**
+     * @brief Bloque lleno pendiente de comprimir.
+     */
+    struct Block
+    {
+        std::unique_ptr<char[]> data; /**< Contenido. */
+        std::size_t size; /**< Bytes usados. */
+    };
+
+    struct Encoder; /**< Estado del compresor (zlib o zstd), definido en el .cpp. */
+
+    std::FILE* file; /**< Archivo comprimido (nullptr si está cerrado). */
+    std::unique_ptr<Encoder> encoder; /**< Compresor; solo lo usa el hilo. */
+    std::size_t blockCapacity; /**< Tamaño de los búferes que se intercambian. */
+    std::deque<Block> pending; /**< Bloques en espera, en orden. */
+    std::vector<std::unique_ptr<char[]>> spare; /**< Búferes ya comprimidos, listos para reutilizar. */
+    std::mutex queueMutex; /**< Protege pending, spare, finishing y failed. */
+    std::condition_variable queueCondition; /**< Despierta al hilo cuando hay bloques o al cerrar. */
+    std::condition_variable spaceCondition; /**< Despierta a exchange() cuando hay sitio en la cola. */
+    bool finishing; /**< Indica que no llegarán más bloques. */
+    bool failed; /**< true si falló la compresión o la escritura. */
+    std::thread worker; /**< Hilo que comprime y escribe. */
+
+    /**
+     * @brief Bucle principal del hilo compresor.
+     */
+    void run();
+
+    /**
+     * @brief Comprime datos y escribe la salida en el archivo.
+     *
+     * @param data Datos a comprimir.
+     * @param size Número de bytes.
+     * @param finish Si es true cierra el flujo comprimido (data puede estar vacío).
+     * @return true si se comprimió y escribió todo, false en caso contrario.
+     */
+    bool compress(const char* data, std::size_t size, bool finish);
+
+public:
+    /**
+     * @brief Obtiene el formato de compresión que corresponde a una ruta.
+     *
+     * @param path Ruta del archivo.
+     * @param codec Recibe el formato si la ruta termina en .gz o .zst.
+     * @return true si la ruta indica un archivo comprimido, false en caso contrario.
+     */
+    static bool codecFor(const std::string& path, Codec& codec);
+
+    /**
+     * @brief Indica si un formato de compresión está disponible en esta compilación.
+     *
+     * @param codec Formato a consultar.
+     * @return true si se puede usar.
+     */
+    static bool isAvailable(Codec codec);
+
+    /**
+     * @brief Constructor. El archivo se abre con open().
+     */
+    CompressionPipeline();
+
+    /**
+     * @brief Destructor. Cierra el archivo si sigue abierto.
+     */
+    ~CompressionPipeline();
+
+    CompressionPipeline(const CompressionPipeline&) = delete;
+    CompressionPipeline& operator=(const CompressionPipeline&) = delete;
+
+    /**
+     * @brief Crea (o trunca) el archivo comprimido y arranca el hilo compresor.
+     *
+     * @param path Ruta del archivo.
+     * @param codec Formato de compresión.
+     * @param blockCapacity Tamaño de los búferes que devolverá exchange().
+     * @return true si el archivo se abrió, false en caso contrario.
+     */
+    bool open(const std::string& path, Codec codec, std::size_t blockCapacity);
+
+    /**
+     * @brief Entrega un bloque lleno y obtiene un búfer vacío para seguir escribiendo.
+     *
+     * @param block Búfer con los datos (de al menos blockCapacity bytes).
+     * @param size Bytes usados del búfer.
+     * @return Búfer libre de blockCapacity bytes.
+     */
+    std::unique_ptr<char[]> exchange(std::unique_ptr<char[]> block, std::size_t size);
+
+    /**
+     * @brief Comprime lo pendiente, cierra el flujo y el archivo, y detiene el hilo.
+     *
+     * @return true si todo el contenido llegó al archivo, false si hubo algún error.
+     */
+    bool close();
+};
+
+#endif // COMPRESSIONPIPELINE_H
@@ -0,0 +1,122 @@
+#include "CronSchedule.h"
+#include <charconv>
+#include <sstream>
+#include <vector>
+#include "DateFormatter.h"
+
+namespace {
+    const std::uint64_t ALL_BITS = ~std::uint64_t(0);
+    const int MAX_STEPS = 4000; // Unos once años saltando días, más las horas y minutos del día que coincide
+
+    // Lee un entero completo de text; false si sobra algo o no es un número
+    bool parseNumber(std::string_view text, int& value) {
+        if (text.empty()) return false;
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    bool hasBit(std::uint64_t bits, int index) {
+        return (bits >> index) & 1u;
+    }
+}
+
+CronSchedule::CronSchedule()
+    : minutes(ALL_BITS), hours(ALL_BITS), daysOfMonth(ALL_BITS), months(ALL_BITS), daysOfWeek(ALL_BITS),
+      anyDayOfMonth(true), anyDayOfWeek(true) {}
+
+bool CronSchedule::parse(const std::string& expression, CronSchedule& schedule) {
+    std::string text = expression;
+    if (text == "@hourly") text = "0 * * * *";
+    else if (text == "@daily" || text == "@midnight") text = "0 0 * * *";
+    else if (text == "@weekly") text = "0 0 * * 0";
+    else if (text == "@monthly") text = "0 0 1 * *";
+
+    std::istringstream stream(text);
+    std::vector<std::string> fields;
+    for (std::string field; stream >> field;) fields.push_back(field);
+    if (fields.size() != 5) return false;
+
+    CronSchedule parsed;
+    if (!parseField(fields[0], 0, 59, parsed.minutes) ||
+        !parseField(fields[1], 0, 23, parsed.hours) ||
+        !parseField(fields[2], 1, 31, parsed.daysOfMonth) ||
+        !parseField(fields[3], 1, 12, parsed.months) ||
+        !parseField(fields[4], 0, 7, parsed.daysOfWeek)) {
+        return false;
+    }
+    // El 7 también es domingo
+    if (hasBit(parsed.daysOfWeek, 7)) parsed.daysOfWeek = (parsed.daysOfWeek | 1u) & ~(std::uint64_t(1) << 7);
+    parsed.anyDayOfMonth = fields[2] == "*";
+    parsed.anyDayOfWeek = fields[4] == "*";
+
+    schedule = parsed;
+    return true;
+}
+
+bool CronSchedule::parseField(std::string_view field, int first, int last, std::uint64_t& bits) {
+    bits = 0;
+    while (!field.empty()) {
+        const std::size_t comma = field.find(',');
+        std::string_view item = field.substr(0, comma);
+        field = comma == std::string_view::npos ? std::string_view() : field.substr(comma + 1);
+        if (item.empty()) return false;
+
+        int step = 1;
+        const std::size_t slash = item.find('/');
+        if (slash != std::string_view::npos) {
+            if (!parseNumber(item.substr(slash + 1), step) || step < 1) return false;
+            item = item.substr(0, slash);
+        }
+
+        int low = first, high = last;
+        if (item != "*") {
+            const std::size_t dash = item.find('-');
+            if (dash == std::string_view::npos) {
+                if (!parseNumber(item, low)) return false;
+                // "a/n" recorre desde a hasta el final, como en cron
+                high = slash == std::string_view::npos ? low : last;
+            } else if (!parseNumber(item.substr(0, dash), low) || !parseNumber(item.substr(dash + 1), high)) {
+                return false;
+            }
+        }
+        if (low < first || high > last || low > high) return false;
+
+        for (int value = low; value <= high; value += step) bits |= std::uint64_t(1) << value;
+    }
+    return bits != 0;
+}
+
+bool CronSchedule::matchesDay(int year, int month, int day) const {
+    if (!hasBit(months, month)) return false;
+    // 1970-01-01 fue jueves (4)
+    const std::int64_t days = DateFormatter::daysFromCivil(year, month, day);
+    const int weekday = static_cast<int>(((days + 4) % 7 + 7) % 7);
+    const bool dayOfMonth = hasBit(daysOfMonth, day);
+    const bool dayOfWeek = hasBit(daysOfWeek, weekday);
+    if (!anyDayOfMonth && !anyDayOfWeek) return dayOfMonth || dayOfWeek;
+    return dayOfMonth && dayOfWeek;
+}
+
+bool CronSchedule::matches(std::time_t time) const {
+    const DateFormatter::CivilTime local = DateFormatter::toLocal(time);
+    return hasBit(minutes, local.minute) && hasBit(hours, local.hour) && matchesDay(local.year, local.month, local.day);
+}
+
+std::time_t CronSchedule::nextAfter(std::time_t time) const {
+    // Desde el comienzo del minuto siguiente; los días y horas que no coinciden se saltan enteros
+    std::time_t candidate = time - ((time % 60) + 60) % 60 + 60;
+    for (int step = 0; step < MAX_STEPS; ++step) {
+        const DateFormatter::CivilTime local = DateFormatter::toLocal(candidate);
+        const int secondOfDay = local.hour * 3600 + local.minute * 60 + local.second;
+        if (!matchesDay(local.year, local.month, local.day)) {
+            candidate += 86400 - secondOfDay;
+        } else if (!hasBit(hours, local.hour)) {
+            candidate += 3600 - local.minute * 60 - local.second;
+        } else if (!hasBit(minutes, local.minute)) {
+            candidate += 60 - local.second;
+        } else {
+            return candidate;
+        }
+    }
+    return static_cast<std::time_t>(-1);
+}
@@ -0,0 +1,87 @@
+#ifndef CRONSCHEDULE_H
+#define CRONSCHEDULE_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <string_view>
+
+/**
+ * @class CronSchedule
+ * @brief Programación periódica con la sintaxis de cron, evaluada en hora local.
+ *
+ * Acepta las cinco columnas clásicas (minuto, hora, día del mes, mes y día de la
+ * semana), cada una con "*", valores, rangos "a-b", listas separadas por comas y pasos
+ * "/n", además de los atajos @hourly, @daily (o @midnight), @weekly y @monthly. El
+ * domingo es 0 o 7. Como en cron, si se restringen tanto el día del mes como el de la
+ * semana, basta con que coincida uno de los dos.
+ *
+ * Cada columna se guarda como una máscara de bits, así que comprobar un instante son
+ * unas pocas operaciones y nextAfter() salta días u horas enteras que no coinciden.
+ */
+class CronSchedule
+{
+private:
+    std::uint64_t minutes; /**< Bit m: minuto m (0-59). */
+    std::uint64_t hours; /**< Bit h: hora h (0-23). */
+    std::uint64_t daysOfMonth; /**< Bit d: día d del mes (1-31). */
+    std::uint64_t months; /**< Bit m: mes m (1-12). */
+    std::uint64_t daysOfWeek; /**< Bit d: día d de la semana (0 = domingo). */
+    bool anyDayOfMonth; /**< La columna del día del mes era "*". */
+    bool anyDayOfWeek; /**< La columna del día de la semana era "*". */
+
+    /**
+     * @brief Interpreta una columna de la expresión.
+     *
+     * @param field Texto de la columna.
+     * @param first Valor mínimo admitido.
+     * @param last Valor máximo admitido.
+     * @param bits Recibe la máscara de valores.
+     * @return true si la columna es válida, false en caso contrario.
+     */
+    static bool parseField(std::string_view field, int first, int last, std::uint64_t& bits);
+
+    /**
+     * @brief Indica si un día (en hora local) cumple las columnas de día y mes.
+     *
+     * @param year Año.
+     * @param month Mes (1-12).
+     * @param day Día del mes (1-31).
+     * @return true si el día coincide.
+     */
+    bool matchesDay(int year, int month, int day) const;
+
+public:
+    /**
+     * @brief Constructor por defecto: todos los minutos ("* * * * *").
+     */
+    CronSchedule();
+
+    /**
+     * @brief Interpreta una expresión de cron.
+     *
+     * @param expression Expresión de cinco columnas o atajo (p. ej. "0 2 * * *" o "@daily").
+     * @param schedule Recibe la programación si la expresión es válida.
+     * @return true si la expresión es válida, false en caso contrario.
+     */
+    static bool parse(const std::string& expression, CronSchedule& schedule);
+
+    /**
+     * @brief Indica si un instante cae en un minuto programado.
+     *
+     * @param time Instante a comprobar.
+     * @return true si coincide (los segundos se ignoran).
+     */
+    bool matches(std::time_t time) const;
+
+    /**
+     * @brief Obtiene el siguiente minuto programado estrictamente posterior a un instante.
+     *
+     * @param time Instante de referencia.
+     * @return Comienzo del siguiente minuto programado, o -1 si no hay ninguno en los
+     *         próximos años (p. ej. "0 0 30 2 *").
+     */
+    std::time_t nextAfter(std::time_t time) const;
+};
+
+#endif // CRONSCHEDULE_H
@@ -1,8 +1,26 @@
 #include "DatabaseManager.h"
+#include "DateFormatter.h"
 #include <iostream>
 #include <algorithm>
 #include <cstring>
 #include <iomanip> 
+#include <limits>
+#include <string_view>
+#include <utility>
+
+namespace {
+    // Texto de una columna como vista sobre el búfer de SQLite (válida hasta el siguiente paso)
+    std::string_view columnText(sqlite3_stmt* stmt, int column) {
+        const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, column));
+        int length = sqlite3_column_bytes(stmt, column);
+        return text ? std::string_view(text, static_cast<std::size_t>(length)) : std::string_view();
+    }
+    
+    // Enlaza una vista sin copiarla; el texto debe seguir vivo hasta ejecutar la sentencia
+    int bindText(sqlite3_stmt* stmt, int index, std::string_view text) {
+        return sqlite3_bind_text(stmt, index, text.data(), static_cast<int>(text.size()), SQLITE_STATIC);
+    }
+}
 
 DatabaseManager::DatabaseManager() : db(nullptr), databasePath("inventory.db") {}
 
@@ -18,31 +36,73 @@ bool DatabaseManager::connect() {
 }
 
 bool DatabaseManager::connect(const std::string& path) {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
     if (isConnected()) {
         disconnect();
     }
     
+    databasePath = path;
     int rc = sqlite3_open(path.c_str(), &db);
     if (rc != SQLITE_OK) {
         std::cerr << "Error al abrir la base de datos: " << sqlite3_errmsg(db) << std::endl;
         return false;
     }
     
+    // Otro proceso escribiendo no debe hacer fallar al instante BEGIN IMMEDIATE ni COMMIT
+    sqlite3_busy_timeout(db, DEFAULT_BUSY_TIMEOUT_MS);
+    
     // Inicializar la base de datos
     return initializeDatabase();
 }
 
 void DatabaseManager::disconnect() {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
+    clearStatementCache();
     if (db) {
         sqlite3_close(db);
         db = nullptr;
     }
 }
 
+const std::string& DatabaseManager::getDatabasePath() const {
+    return databasePath;
+}
+
 bool DatabaseManager::isConnected() const {
     return db != nullptr;
 }
 
+std::unique_lock<std::recursive_mutex> DatabaseManager::lockConnection() const {
+    return std::unique_lock<std::recursive_mutex>(connectionMutex);
+}
+
+bool DatabaseManager::setBusyTimeout(int milliseconds) {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
+    if (!isConnected()) return false;
+    return sqlite3_busy_timeout(db, milliseconds) == SQLITE_OK;
+}
+
+bool DatabaseManager::beginTransaction() {
+    return executeQuery("BEGIN IMMEDIATE;");
+}
+
+bool DatabaseManager::beginReadTransaction() {
+    return executeQuery("BEGIN DEFERRED;");
+}
+
+bool DatabaseManager::commitTransaction() {
+    return executeQuery("COMMIT;");
+}
+
+bool DatabaseManager::rollbackTransaction() {
+    return executeQuery("ROLLBACK;");
+}
+
+bool DatabaseManager::isInTransaction() const {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
+    return isConnected() && sqlite3_get_autocommit(db) == 0;
+}
+
 bool DatabaseManager::initializeDatabase() {
     if (!isConnected()) return false;
     
@@ -61,10 +121,99 @@ bool DatabaseManager::initializeDatabase() {
         "CREATE INDEX IF NOT EXISTS idx_type ON components(type);\n"
         "CREATE INDEX IF NOT EXISTS idx_location ON components(location);";
     
-    return executeQuery(createTableSQL);
+    return executeQuery(createTableSQL) && createChangeTracking();
+}
+
+bool DatabaseManager::createChangeTracking() {
+    std::string trackingSQL =
+        "CREATE TABLE IF NOT EXISTS inventory_meta (\n"
+        "    key TEXT PRIMARY KEY,\n"
+        "    value INTEGER NOT NULL\n"
+        ");\n"
+        "INSERT OR IGNORE INTO inventory_meta (key, value) VALUES ('generation', 0);\n"
+        "\n"
+        "CREATE TRIGGER IF NOT EXISTS trg_components_insert AFTER INSERT ON components BEGIN\n"
+        "    UPDATE inventory_meta SET value = value + 1 WHERE key = 'generation';\n"
+        "END;\n"
+        "CREATE TRIGGER IF NOT EXISTS trg_components_update AFTER UPDATE ON components BEGIN\n"
+        "    UPDATE inventory_meta SET value = value + 1 WHERE key = 'generation';\n"
+        "END;\n"
+        "CREATE TRIGGER IF NOT EXISTS trg_components_delete AFTER DELETE ON components BEGIN\n"
+        "    UPDATE inventory_meta SET value = value + 1 WHERE key = 'generation';\n"
+        "END;\n"
+        "\n"
+        // Registro de cambios: una fila por componente modificado, con los valores de antes
+        // y de después (NULL si no existía o ya no existe)
+        "CREATE TABLE IF NOT EXISTS component_changes (\n"
+        "    seq INTEGER PRIMARY KEY AUTOINCREMENT,\n"
+        "    changed_at INTEGER NOT NULL,\n"
+        "    component_id INTEGER NOT NULL,\n"
+        "    old_name TEXT, old_type TEXT, old_quantity INTEGER, old_location TEXT, old_purchase_date INTEGER,\n"
+        "    new_name TEXT, new_type TEXT, new_quantity INTEGER, new_location TEXT, new_purchase_date INTEGER\n"
+        ");\n"
+        "CREATE INDEX IF NOT EXISTS idx_component_changes_time ON component_changes(changed_at);\n"
+        "INSERT OR IGNORE INTO inventory_meta (key, value) VALUES ('changes_since', CAST(strftime('%s', 'now') AS INTEGER));\n"
+        "INSERT OR IGNORE INTO inventory_meta (key, value) VALUES ('changes_retention', " +
+        std::to_string(static_cast<long long>(DEFAULT_CHANGE_RETENTION_DAYS) * SECONDS_PER_DAY) + ");\n"
+        "\n"
+        // Retención: los cambios más antiguos que changes_retention segundos (0 = sin límite)
+        // se borran en la misma transacción que los registra. Solo se poda cuando el inicio del
+        // registro queda un día por detrás del límite, así que casi ninguna escritura borra nada
+        "CREATE TRIGGER IF NOT EXISTS trg_component_changes_retention AFTER INSERT ON component_changes\n"
+        "WHEN (SELECT value FROM inventory_meta WHERE key = 'changes_retention') > 0\n"
+        "  AND NEW.changed_at - (SELECT value FROM inventory_meta WHERE key = 'changes_retention')\n"
+        "      >= (SELECT value FROM inventory_meta WHERE key = 'changes_since') + " + std::to_string(SECONDS_PER_DAY) + " BEGIN\n"
+        "    DELETE FROM component_changes\n"
+        "    WHERE changed_at < NEW.changed_at - (SELECT value FROM inventory_meta WHERE key = 'changes_retention');\n"
+        "    UPDATE inventory_meta\n"
+        "    SET value = NEW.changed_at - (SELECT value FROM inventory_meta WHERE key = 'changes_retention')\n"
+        "    WHERE key = 'changes_since';\n"
+        "END;\n"
+        "\n"
+        "CREATE TRIGGER IF NOT EXISTS trg_components_log_insert AFTER INSERT ON components BEGIN\n"
+        "    INSERT INTO component_changes (changed_at, component_id,\n"
+        "        new_name, new_type, new_quantity, new_location, new_purchase_date)\n"
+        "    VALUES (CAST(strftime('%s', 'now') AS INTEGER), NEW.id,\n"
+        "        NEW.name, NEW.type, NEW.quantity, NEW.location, NEW.purchase_date);\n"
+        "END;\n"
+        "CREATE TRIGGER IF NOT EXISTS trg_components_log_update AFTER UPDATE ON components\n"
+        "WHEN OLD.name IS NOT NEW.name OR OLD.type IS NOT NEW.type OR OLD.quantity IS NOT NEW.quantity\n"
+        "  OR OLD.location IS NOT NEW.location OR OLD.purchase_date IS NOT NEW.purchase_date BEGIN\n"
+        "    INSERT INTO component_changes (changed_at, component_id,\n"
+        "        old_name, old_type, old_quantity, old_location, old_purchase_date,\n"
+        "        new_name, new_type, new_quantity, new_location, new_purchase_date)\n"
+        "    VALUES (CAST(strftime('%s', 'now') AS INTEGER), NEW.id,\n"
+        "        OLD.name, OLD.type, OLD.quantity, OLD.location, OLD.purchase_date,\n"
+        "        NEW.name, NEW.type, NEW.quantity, NEW.location, NEW.purchase_date);\n"
+        "END;\n"
+        "CREATE TRIGGER IF NOT EXISTS trg_components_log_delete AFTER DELETE ON components BEGIN\n"
+        "    INSERT INTO component_changes (changed_at, component_id,\n"
+        "        old_name, old_type, old_quantity, old_location, old_purchase_date)\n"
+        "    VALUES (CAST(strftime('%s', 'now') AS INTEGER), OLD.id,\n"
+        "        OLD.name, OLD.type, OLD.quantity, OLD.location, OLD.purchase_date);\n"
+        "END;";
+    
+    return executeQuery(trackingSQL);
+}
+
+bool DatabaseManager::setChangeRetentionDays(int days) {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
+    if (!isConnected() || days < 0) return false;
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, "UPDATE inventory_meta SET value = ? WHERE key = 'changes_retention'", -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Error al cambiar la retención del registro de cambios: " << sqlite3_errmsg(db) << std::endl;
+        return false;
+    }
+    
+    sqlite3_bind_int64(stmt, 1, static_cast<sqlite3_int64>(days) * SECONDS_PER_DAY);
+    int rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    return rc == SQLITE_DONE;
 }
 
 bool DatabaseManager::executeQuery(const std::string& query) {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
     if (!isConnected()) return false;
     
     char* errorMessage = nullptr;
@@ -80,23 +229,14 @@ bool DatabaseManager::executeQuery(const std::string& query) {
 }
 
 bool DatabaseManager::addComponent(const Component& component) {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
     if (!isConnected()) {
-        std::cout << "DEBUG addComponent: No hay conexión a la base de datos" << std::endl;
+        std::cerr << "addComponent: No hay conexión a la base de datos" << std::endl;
         return false;
     }
     
-    std::cout << "\n=== DEBUG DatabaseManager::addComponent (VERSIÓN CORREGIDA) ===" << std::endl;
-    std::cout << "INFORMACIÓN DEL COMPONENTE A GUARDAR:" << std::endl;
-    std::cout << "  Nombre: '" << component.getName() << "'" << std::endl;
-    std::cout << "  Tipo: '" << component.getType() << "'" << std::endl;
-    std::cout << "  Cantidad: " << component.getQuantity() << std::endl;
-    std::cout << "  Ubicación: '" << component.getLocation() << "'" << std::endl;
-    
-    // USAR SQL SIMPLE en lugar de raw string
     std::string sql = "INSERT INTO components (name, type, quantity, location, purchase_date) VALUES (?, ?, ?, ?, ?)";
     
-    std::cout << "\nSQL: " << sql << std::endl;
-    
     sqlite3_stmt* stmt;
     int rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr);
     
@@ -105,74 +245,32 @@ bool DatabaseManager::addComponent(const Component& component) {
         return false;
     }
     
-    // Bind de parámetros con VERIFICACIÓN EXTRA
-    std::cout << "\nRealizando bind de parámetros:" << std::endl;
-    
-    // Parámetro 1: name
-    std::string name = component.getName();
-    std::cout << "  Parámetro 1 (name): '" << name << "'" << std::endl;
-    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
-    
-    // Parámetro 2: type
-    std::string type = component.getType();
-    std::cout << "  Parámetro 2 (type): '" << type << "'" << std::endl;
-    sqlite3_bind_text(stmt, 2, type.c_str(), -1, SQLITE_TRANSIENT);
-    
-    // Parámetro 3: quantity
-    int quantity = component.getQuantity();
-    std::cout << "  Parámetro 3 (quantity): " << quantity << std::endl;
-    sqlite3_bind_int(stmt, 3, quantity);
-    
-    // Parámetro 4: location
-    std::string location = component.getLocation();
-    std::cout << "  Parámetro 4 (location): '" << location << "'" << std::endl;
-    sqlite3_bind_text(stmt, 4, location.c_str(), -1, SQLITE_TRANSIENT);
-    
-    // Parámetro 5: purchase_date
-    std::time_t purchaseDate = component.getPurchaseDate();
-    std::cout << "  Parámetro 5 (purchase_date): " << purchaseDate << std::endl;
-    sqlite3_bind_int64(stmt, 5, static_cast<sqlite3_int64>(purchaseDate));
+    // Los textos se enlazan directamente desde el componente, que vive hasta el final
+    bindText(stmt, 1, component.getName());
+    bindText(stmt, 2, component.getType());
+    sqlite3_bind_int(stmt, 3, component.getQuantity());
+    bindText(stmt, 4, component.getLocation());
+    sqlite3_bind_int64(stmt, 5, static_cast<sqlite3_int64>(component.getPurchaseDate()));
     
-    // Ejecutar
-    std::cout << "\nEjecutando consulta..." << std::endl;
     rc = sqlite3_step(stmt);
     
-    std::cout << "Resultado sqlite3_step: " << rc;
-    if (rc == SQLITE_DONE) {
-        std::cout << " (SQLITE_DONE - ÉXITO)" << std::endl;
-    } else {
-        std::cout << " (ERROR: " << sqlite3_errmsg(db) << ")" << std::endl;
+    if (rc != SQLITE_DONE) {
+        std::cerr << "ERROR insertando componente: " << sqlite3_errmsg(db) << std::endl;
     }
     
     sqlite3_finalize(stmt);
     
-    if (rc == SQLITE_DONE) {
-        std::cout << "Último ID insertado: " << sqlite3_last_insert_rowid(db) << std::endl;
-        return true;
-    }
-    
-    return false;
+    return rc == SQLITE_DONE;
 }
 bool DatabaseManager::updateComponent(const Component& component) {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
     if (!isConnected()) {
-        std::cout << "DEBUG updateComponent: No hay conexión a la base de datos" << std::endl;
+        std::cerr << "updateComponent: No hay conexión a la base de datos" << std::endl;
         return false;
     }
     
-    std::cout << "\n=== DEBUG DatabaseManager::updateComponent ===" << std::endl;
-    std::cout << "ACTUALIZANDO COMPONENTE ID: " << component.getId() << std::endl;
-    std::cout << "Nuevos valores:" << std::endl;
-    std::cout << "  Nombre: '" << component.getName() << "'" << std::endl;
-    std::cout << "  Tipo: '" << component.getType() << "'" << std::endl;
-    std::cout << "  Cantidad: " << component.getQuantity() << std::endl;
-    std::cout << "  Ubicación: '" << component.getLocation() << "'" << std::endl;
-    std::cout << "  Fecha: " << component.getPurchaseDate() << std::endl;
-    
-    // Usar SQL simple (no raw string)
     std::string sql = "UPDATE components SET name = ?, type = ?, quantity = ?, location = ?, purchase_date = ? WHERE id = ?";
     
-    std::cout << "\nSQL: " << sql << std::endl;
-    
     sqlite3_stmt* stmt;
     int rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr);
     
@@ -181,47 +279,18 @@ bool DatabaseManager::updateComponent(const Component& component) {
         return false;
     }
     
-    // Crear COPIA de los strings para asegurar que persistan
-    std::string name_copy = component.getName();
-    std::string type_copy = component.getType();
-    std::string location_copy = component.getLocation();
-    
-    std::cout << "\nRealizando bind de parámetros:" << std::endl;
-    
-    // Parámetro 1: name
-    std::cout << "  Parámetro 1 (name): '" << name_copy << "'" << std::endl;
-    sqlite3_bind_text(stmt, 1, name_copy.c_str(), -1, SQLITE_STATIC);
-    
-    // Parámetro 2: type
-    std::cout << "  Parámetro 2 (type): '" << type_copy << "'" << std::endl;
-    sqlite3_bind_text(stmt, 2, type_copy.c_str(), -1, SQLITE_STATIC);
-    
-    // Parámetro 3: quantity
-    std::cout << "  Parámetro 3 (quantity): " << component.getQuantity() << std::endl;
+    // Los textos se enlazan directamente desde el componente, que vive hasta el final
+    bindText(stmt, 1, component.getName());
+    bindText(stmt, 2, component.getType());
     sqlite3_bind_int(stmt, 3, component.getQuantity());
-    
-    // Parámetro 4: location
-    std::cout << "  Parámetro 4 (location): '" << location_copy << "'" << std::endl;
-    sqlite3_bind_text(stmt, 4, location_copy.c_str(), -1, SQLITE_STATIC);
-    
-    // Parámetro 5: purchase_date
-    std::cout << "  Parámetro 5 (purchase_date): " << component.getPurchaseDate() << std::endl;
+    bindText(stmt, 4, component.getLocation());
     sqlite3_bind_int64(stmt, 5, static_cast<sqlite3_int64>(component.getPurchaseDate()));
-    
-    // Parámetro 6: id (WHERE clause)
-    std::cout << "  Parámetro 6 (id): " << component.getId() << std::endl;
     sqlite3_bind_int(stmt, 6, component.getId());
     
-    // Ejecutar
-    std::cout << "\nEjecutando consulta..." << std::endl;
     rc = sqlite3_step(stmt);
     
-    std::cout << "Resultado sqlite3_step: " << rc;
-    if (rc == SQLITE_DONE) {
-        std::cout << " (SQLITE_DONE - ÉXITO)" << std::endl;
-        std::cout << "Filas afectadas: " << sqlite3_changes(db) << std::endl;
-    } else {
-        std::cout << " (ERROR: " << sqlite3_errmsg(db) << ")" << std::endl;
+    if (rc != SQLITE_DONE) {
+        std::cerr << "ERROR actualizando componente: " << sqlite3_errmsg(db) << std::endl;
     }
     
     sqlite3_finalize(stmt);
@@ -229,6 +298,7 @@ bool DatabaseManager::updateComponent(const Component& component) {
     return rc == SQLITE_DONE;
 }
 bool DatabaseManager::deleteComponent(int id) {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
     if (!isConnected()) return false;
     
     std::string sql = "DELETE FROM components WHERE id = ?";
@@ -249,7 +319,58 @@ bool DatabaseManager::deleteComponent(int id) {
     return rc == SQLITE_DONE;
 }
 
+int DatabaseManager::getLastInsertId() const {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
+    if (!isConnected()) return -1;
+    return static_cast<int>(sqlite3_last_insert_rowid(db));
+}
+
+int DatabaseManager::getChangedRows() const {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
+    if (!isConnected()) return -1;
+    return sqlite3_changes(db);
+}
+
+std::int64_t DatabaseManager::getChangeCounter() const {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
+    if (!isConnected()) return -1;
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, "SELECT value FROM inventory_meta WHERE key = 'generation'", -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Error al leer la generación: " << sqlite3_errmsg(db) << std::endl;
+        return -1;
+    }
+    
+    std::int64_t generation = -1;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        generation = static_cast<std::int64_t>(sqlite3_column_int64(stmt, 0));
+    }
+    
+    sqlite3_finalize(stmt);
+    return generation;
+}
+
+std::int64_t DatabaseManager::getDataVersion() const {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
+    if (!isConnected()) return -1;
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, "PRAGMA data_version", -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Error al leer data_version: " << sqlite3_errmsg(db) << std::endl;
+        return -1;
+    }
+    
+    std::int64_t version = -1;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        version = static_cast<std::int64_t>(sqlite3_column_int64(stmt, 0));
+    }
+    
+    sqlite3_finalize(stmt);
+    return version;
+}
+
 Component DatabaseManager::getComponent(int id) {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
     if (!isConnected()) return Component();
     
     std::string sql = "SELECT * FROM components WHERE id = ?";
@@ -276,6 +397,7 @@ Component DatabaseManager::getComponent(int id) {
 }
 
 std::vector<Component> DatabaseManager::getAllComponents() {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
     std::vector<Component> components;
     
     if (!isConnected()) return components;
@@ -301,64 +423,164 @@ std::vector<Component> DatabaseManager::getAllComponents() {
     return components;
 }
 std::vector<Component> DatabaseManager::searchComponents(const std::string& keyword) {
+    return queryComponents(ComponentQuery().where(ComponentQuery::matchesKeyword(keyword)));
+}
+
+std::vector<Component> DatabaseManager::getLowStockComponents(int threshold) {
+    return queryComponents(ComponentQuery()
+                               .where(ComponentQuery::quantityBetween(std::numeric_limits<int>::min(), threshold))
+                               .orderBy(ComponentQuery::SortKey::Quantity));
+}
+
+std::vector<Component> DatabaseManager::queryComponents(const ComponentQuery& query) {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
     std::vector<Component> components;
     
     if (!isConnected()) return components;
     
-    std::string sql = R"(
-        SELECT id, name, type, quantity, location, purchase_date 
-        FROM components 
-        WHERE name LIKE ? OR type LIKE ? OR location LIKE ?
-        ORDER BY name
-    )";
+    std::vector<ComponentQuery::SqlParam> params;
+    sqlite3_stmt* stmt = getCachedStatement(query.toSql(params));
+    if (!stmt) return components;
+    
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        int index = static_cast<int>(i) + 1;
+        if (params[i].isText) {
+            sqlite3_bind_text(stmt, index, params[i].text.c_str(), -1, SQLITE_TRANSIENT);
+        } else {
+            sqlite3_bind_int64(stmt, index, static_cast<sqlite3_int64>(params[i].number));
+        }
+    }
+    
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        components.push_back(createComponentFromRow(stmt));
+    }
+    
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    return components;
+}
+
+bool DatabaseManager::loadComponentTable(ComponentTable& table) {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
+    if (!isConnected()) return false;
+    
+    std::string sql = "SELECT id, name, type, quantity, location, purchase_date FROM components ORDER BY name, id";
     
     sqlite3_stmt* stmt;
     int rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr);
     
     if (rc != SQLITE_OK) {
         std::cerr << "Error al preparar consulta: " << sqlite3_errmsg(db) << std::endl;
-        return components;
+        return false;
     }
     
-    std::string searchPattern = "%" + keyword + "%";
-    sqlite3_bind_text(stmt, 1, searchPattern.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 2, searchPattern.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(stmt, 3, searchPattern.c_str(), -1, SQLITE_STATIC);
-    
     while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
-        components.push_back(createComponentFromRow(stmt));
+        table.append(sqlite3_column_int(stmt, 0), columnText(stmt, 1), columnText(stmt, 2),
+                     sqlite3_column_int(stmt, 3), columnText(stmt, 4),
+                     static_cast<std::int64_t>(sqlite3_column_int64(stmt, 5)));
     }
     
     sqlite3_finalize(stmt);
-    return components;
+    return rc == SQLITE_DONE;
 }
 
-std::vector<Component> DatabaseManager::getLowStockComponents(int threshold) {
-    std::vector<Component> components;
-    
-    if (!isConnected()) return components;
+bool DatabaseManager::forEachChange(std::time_t since, std::time_t until,
+                                    const std::function<bool(const ComponentChange&)>& visitor) {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
+    if (!isConnected()) return false;
     
-    std::string sql = "SELECT id, name, type, quantity, location, purchase_date FROM components WHERE quantity <= ? ORDER BY quantity";
+    // idx_component_changes_time limita la lectura a las filas del periodo
+    std::string sql = "SELECT seq, changed_at, component_id, "
+                      "old_name, old_type, old_quantity, old_location, old_purchase_date, "
+                      "new_name, new_type, new_quantity, new_location, new_purchase_date "
+                      "FROM component_changes WHERE changed_at >= ? AND changed_at < ? ORDER BY seq";
     
     sqlite3_stmt* stmt;
     int rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr);
     
     if (rc != SQLITE_OK) {
         std::cerr << "Error al preparar consulta: " << sqlite3_errmsg(db) << std::endl;
-        return components;
+        return false;
     }
     
-    sqlite3_bind_int(stmt, 1, threshold);
+    sqlite3_bind_int64(stmt, 1, static_cast<sqlite3_int64>(since));
+    sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(until));
+    
+    // Los valores de antes (columnas 3-7) o de después (8-12) son NULL si el componente no existía
+    auto readSide = [stmt](int first, int id, Component& component) {
+        if (sqlite3_column_type(stmt, first) == SQLITE_NULL) return false;
+        component.setId(id);
+        component.setName(std::string(columnText(stmt, first)));
+        component.setType(columnText(stmt, first + 1));
+        component.setQuantity(sqlite3_column_int(stmt, first + 2));
+        component.setLocation(columnText(stmt, first + 3));
+        component.setPurchaseDate(static_cast<std::time_t>(sqlite3_column_int64(stmt, first + 4)));
+        return true;
+    };
     
+    ComponentChange change;
     while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
-        components.push_back(createComponentFromRow(stmt));
+        change.sequence = static_cast<std::int64_t>(sqlite3_column_int64(stmt, 0));
+        change.changedAt = static_cast<std::time_t>(sqlite3_column_int64(stmt, 1));
+        change.componentId = sqlite3_column_int(stmt, 2);
+        change.existedBefore = readSide(3, change.componentId, change.before);
+        change.existsAfter = readSide(8, change.componentId, change.after);
+        if (!visitor(change)) break;
     }
     
     sqlite3_finalize(stmt);
-    return components;
+    return rc == SQLITE_DONE;
+}
+
+std::time_t DatabaseManager::getChangeTrackingStart() const {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
+    if (!isConnected()) return -1;
+    
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, "SELECT value FROM inventory_meta WHERE key = 'changes_since'", -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Error al leer el inicio del registro de cambios: " << sqlite3_errmsg(db) << std::endl;
+        return -1;
+    }
+    
+    std::time_t start = -1;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        start = static_cast<std::time_t>(sqlite3_column_int64(stmt, 0));
+    }
+    
+    sqlite3_finalize(stmt);
+    return start;
+}
+
+sqlite3_stmt* DatabaseManager::getCachedStatement(const std::string& sql) {
+    auto it = statementCache.find(sql);
+    if (it != statementCache.end()) {
+        return it->second;
+    }
+    
+    // Las formas posibles son pocas; si la caché crece sin control se vacía entera
+    if (statementCache.size() >= 64) {
+        clearStatementCache();
+    }
+    
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v3(db, sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Error al preparar consulta: " << sqlite3_errmsg(db) << std::endl;
+        return nullptr;
+    }
+    
+    statementCache.emplace(sql, stmt);
+    return stmt;
+}
+
+void DatabaseManager::clearStatementCache() {
+    for (auto& entry : statementCache) {
+        sqlite3_finalize(entry.second);
+    }
+    statementCache.clear();
 }
 
 int DatabaseManager::getComponentCount() const {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
     if (!isConnected()) return 0;
     
     std::string sql = "SELECT COUNT(*) FROM components";
@@ -383,6 +605,7 @@ int DatabaseManager::getComponentCount() const {
 }
 
 std::vector<std::string> DatabaseManager::getComponentTypes() const {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
     std::vector<std::string> types;
     
     if (!isConnected()) return types;
@@ -408,6 +631,7 @@ std::vector<std::string> DatabaseManager::getComponentTypes() const {
     return types;
 }
 void DatabaseManager::debugTableInfo() {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
     if (!isConnected()) {
         std::cout << "DEBUG: No hay conexión a la base de datos" << std::endl;
         return;
@@ -539,6 +763,7 @@ void DatabaseManager::debugTableInfo() {
     std::cout << "=== FIN DEBUG ===\n" << std::endl;
 }
 bool DatabaseManager::recreateTable() {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
     if (!isConnected()) return false;
     
     std::cout << "\n=== RECREANDO TABLA COMPONENTS ===" << std::endl;
@@ -589,6 +814,9 @@ bool DatabaseManager::recreateTable() {
     executeQuery("CREATE INDEX idx_type ON components(type);");
     executeQuery("CREATE INDEX idx_location ON components(location);");
     
+    // Los triggers se eliminan con la tabla; volver a crearlos antes de restaurar
+    createChangeTracking();
+    
     std::cout << "Tabla recreada exitosamente" << std::endl;
     
     // 6. Restaurar datos si los había
@@ -600,12 +828,18 @@ bool DatabaseManager::recreateTable() {
         std::cout << "Datos restaurados exitosamente" << std::endl;
     }
     
+    // Los triggers registraron cada fila restaurada como agregada, y los IDs pueden haber
+    // cambiado: el registro anterior ya no corresponde a la tabla, así que empieza de nuevo
+    executeQuery("DELETE FROM component_changes;"
+                 "UPDATE inventory_meta SET value = CAST(strftime('%s', 'now') AS INTEGER) WHERE key = 'changes_since';");
+    
     // 7. Verificar nueva estructura
     debugTableInfo();
     
     return true;
 }
 void DatabaseManager::verifyLastInsert() {
+    std::lock_guard<std::recursive_mutex> lock(connectionMutex);
     if (!isConnected()) return;
     
     std::cout << "\n=== VERIFICANDO ÚLTIMA INSERCIÓN ===" << std::endl;
@@ -639,10 +873,7 @@ void DatabaseManager::verifyLastInsert() {
                             std::cout << timestamp << " (";
                             
                             // Convertir timestamp a fecha legible
-                            char buffer[80];
-                            std::tm* timeinfo = std::localtime(&timestamp);
-                            std::strftime(buffer, 80, "%Y-%m-%d %H:%M:%S", timeinfo);
-                            std::cout << buffer << ")";
+                            std::cout << DateFormatter::formatDateTime(timestamp) << ")";
                         } else {
                             std::cout << sqlite3_column_int64(stmt, i);
                         }
@@ -676,56 +907,40 @@ Component DatabaseManager::createComponentFromRow(sqlite3_stmt* stmt) {
     // Variables para almacenar los datos
     int id = -1;
     std::string name;
-    std::string type;
+    InternedString type;
     int quantity = 0;
-    std::string location;
+    InternedString location;
     std::time_t purchaseDate = 0;
     
     // Obtener número de columnas
     int colCount = sqlite3_column_count(stmt);
     
-    // DEPURACIÓN: Mostrar lo que estamos leyendo
-    std::cout << "\n=== DEBUG createComponentFromRow (NUEVO) ===" << std::endl;
-    std::cout << "Número de columnas: " << colCount << std::endl;
-    
-    // Buscar cada columna por nombre
+    // Buscar cada columna por nombre. El tipo y la ubicación se internan directamente
+    // desde el búfer de SQLite, sin pasar por un std::string temporal.
     for (int i = 0; i < colCount; i++) {
         const char* colName = sqlite3_column_name(stmt, i);
-        std::string columnName = colName ? colName : "";
+        if (!colName) continue;
         
-        std::cout << "Columna [" << i << "]: " << columnName << " = ";
-        
-        if (columnName == "id") {
+        if (std::strcmp(colName, "id") == 0) {
             id = sqlite3_column_int(stmt, i);
-            std::cout << id << std::endl;
         }
-        else if (columnName == "name") {
-            const char* value = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
-            name = value ? std::string(value) : "";
-            std::cout << "'" << name << "'" << std::endl;
+        else if (std::strcmp(colName, "name") == 0) {
+            std::string_view value = columnText(stmt, i);
+            name.assign(value.data(), value.size());
         }
-        else if (columnName == "type") {
-            const char* value = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
-            type = value ? std::string(value) : "";
-            std::cout << "'" << type << "'" << std::endl;
+        else if (std::strcmp(colName, "type") == 0) {
+            type = InternedString(columnText(stmt, i));
         }
-        else if (columnName == "quantity") {
+        else if (std::strcmp(colName, "quantity") == 0) {
             quantity = sqlite3_column_int(stmt, i);
-            std::cout << quantity << std::endl;
         }
-        else if (columnName == "location") {
-            const char* value = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
-            location = value ? std::string(value) : "";
-            std::cout << "'" << location << "'" << std::endl;
+        else if (std::strcmp(colName, "location") == 0) {
+            location = InternedString(columnText(stmt, i));
         }
-        else if (columnName == "purchase_date") {
+        else if (std::strcmp(colName, "purchase_date") == 0) {
             purchaseDate = static_cast<std::time_t>(sqlite3_column_int64(stmt, i));
-            std::cout << purchaseDate << std::endl;
-        }
-        else {
-            std::cout << "(columna desconocida)" << std::endl;
         }
     }
     
-    return Component(id, name, type, quantity, location, purchaseDate);
+    return Component(id, std::move(name), type, quantity, location, purchaseDate);
 }
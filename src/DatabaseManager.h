@@ -1,9 +1,18 @@
 #ifndef DATABASEMANAGER_H
 #define DATABASEMANAGER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <string>
 #include <vector>
+#include <mutex>
+#include <unordered_map>
 #include <sqlite3.h>
 #include "Component.h"
+#include "ComponentQuery.h"
+#include "ComponentTable.h"
 
 /**
  * @class DatabaseManager
@@ -17,6 +26,8 @@ class DatabaseManager
 private:
     sqlite3* db; /**< Puntero a la base de datos SQLite. */
     std::string databasePath; /**< Ruta del archivo de la base de datos. */
+    mutable std::recursive_mutex connectionMutex; /**< Serializa el uso de la conexión entre hilos. */
+    std::unordered_map<std::string, sqlite3_stmt*> statementCache; /**< Sentencias preparadas por forma de consulta. */
 
     /**
      * @brief Ejecuta una consulta SQL en la base de datos.
@@ -33,7 +44,38 @@ private:
      */
     bool initializeDatabase();
 
+    /**
+     * @brief Crea la tabla inventory_meta, el registro de cambios y sus triggers.
+     * 
+     * Cada fila insertada, actualizada o eliminada en components incrementa la
+     * generación guardada en inventory_meta y añade una fila a component_changes con
+     * los valores de antes y de después, dentro de la misma transacción. En esa misma
+     * transacción se borran los cambios más antiguos que la retención configurada
+     * (setChangeRetentionDays), a lo sumo una vez por día.
+     * 
+     * @return true si el esquema se crea correctamente, false en caso contrario.
+     */
+    bool createChangeTracking();
+
 public:
+    static constexpr int DEFAULT_CHANGE_RETENTION_DAYS = 365; /**< Días que se conservan los cambios por defecto. */
+    static constexpr long long SECONDS_PER_DAY = 24 * 60 * 60; /**< Segundos de un día. */
+    static constexpr int DEFAULT_BUSY_TIMEOUT_MS = 5000; /**< Espera máxima por el candado de escritura de otro proceso. */
+
+    /**
+     * @brief Cambio de un componente leído del registro de cambios.
+     */
+    struct ComponentChange
+    {
+        std::int64_t sequence = 0; /**< Orden del cambio en el registro. */
+        std::time_t changedAt = 0; /**< Momento del cambio. */
+        int componentId = 0; /**< ID del componente cambiado. */
+        bool existedBefore = false; /**< false si el cambio es una inserción. */
+        bool existsAfter = false; /**< false si el cambio es un borrado. */
+        Component before; /**< Valores anteriores (solo si existedBefore). */
+        Component after; /**< Valores nuevos (solo si existsAfter). */
+    };
+
     /**
      * @brief Constructor por defecto.
      * 
@@ -60,6 +102,9 @@ public:
     /**
      * @brief Conecta a la base de datos usando la ruta especificada en el constructor.
      * 
+     * La conexión espera hasta DEFAULT_BUSY_TIMEOUT_MS cuando otro proceso tiene la base
+     * bloqueada, en lugar de fallar al instante (ver setBusyTimeout).
+     * 
      * @return true si la conexión se establece correctamente, false en caso contrario.
      */
     bool connect();
@@ -72,6 +117,13 @@ public:
      */
     bool connect(const std::string& path);
 
+    /**
+     * @brief Obtiene la ruta del archivo de la base de datos.
+     * 
+     * @return Ruta usada en la última conexión (o la indicada en el constructor).
+     */
+    const std::string& getDatabasePath() const;
+
     /**
      * @brief Desconecta de la base de datos.
      */
@@ -84,6 +136,68 @@ public:
      */
     bool isConnected() const;
 
+    /**
+     * @brief Toma la conexión en exclusiva para el hilo actual.
+     * 
+     * Permite agrupar varias operaciones (por ejemplo, una transacción completa) sin que
+     * otro hilo intercale sentencias. El candado es recursivo, por lo que los métodos de
+     * esta clase pueden llamarse mientras se mantiene.
+     * 
+     * @return Candado que libera la conexión al destruirse.
+     */
+    std::unique_lock<std::recursive_mutex> lockConnection() const;
+
+    /**
+     * @brief Cambia la espera máxima cuando otro proceso tiene la base bloqueada.
+     * 
+     * @param milliseconds Espera en milisegundos (0 para fallar al instante con SQLITE_BUSY).
+     * @return true si se aplicó, false si no hay conexión.
+     */
+    bool setBusyTimeout(int milliseconds);
+
+    // Transacciones
+
+    /**
+     * @brief Inicia una transacción (BEGIN IMMEDIATE).
+     * 
+     * @return true si la transacción se inicia correctamente, false en caso contrario.
+     */
+    bool beginTransaction();
+
+    /**
+     * @brief Inicia una transacción de solo lectura (BEGIN DEFERRED).
+     * 
+     * Las consultas hasta el commit ven la misma versión de la base aunque otro proceso
+     * la modifique. No bloquea a otros lectores.
+     * 
+     * @return true si la transacción se inicia correctamente, false en caso contrario.
+     */
+    bool beginReadTransaction();
+
+    /**
+     * @brief Confirma la transacción en curso.
+     * 
+     * @return true si la transacción se confirma correctamente, false en caso contrario.
+     */
+    bool commitTransaction();
+
+    /**
+     * @brief Revierte la transacción en curso.
+     * 
+     * @return true si la transacción se revierte correctamente, false en caso contrario.
+     */
+    bool rollbackTransaction();
+
+    /**
+     * @brief Indica si hay una transacción abierta en la conexión.
+     * 
+     * Algunos errores (disco lleno, RAISE(ROLLBACK), etc.) hacen que SQLite deshaga la
+     * transacción entera por su cuenta; después de un error esto dice si sigue abierta.
+     * 
+     * @return true si hay una transacción abierta.
+     */
+    bool isInTransaction() const;
+
     // Operaciones CRUD
 
     /**
@@ -110,6 +224,44 @@ public:
      */
     bool deleteComponent(int id);
 
+    /**
+     * @brief Obtiene el ID generado por la última inserción en esta conexión.
+     * 
+     * @return ID del último componente insertado.
+     */
+    int getLastInsertId() const;
+
+    /**
+     * @brief Obtiene cuántas filas cambió la última sentencia INSERT, UPDATE o DELETE.
+     * 
+     * Un UPDATE o DELETE sobre un ID que no existe termina bien pero no cambia nada.
+     * 
+     * @return Filas cambiadas, o -1 si no hay conexión.
+     */
+    int getChangedRows() const;
+
+    /**
+     * @brief Obtiene la generación persistente de la tabla de componentes.
+     * 
+     * A diferencia de PRAGMA data_version, que solo vale para la conexión actual, la
+     * generación se guarda en la base de datos y crece con cada fila modificada por
+     * cualquier proceso, por lo que permite saber si una copia guardada sigue vigente.
+     * 
+     * @return Generación actual, o -1 si no se puede leer.
+     */
+    std::int64_t getChangeCounter() const;
+
+    /**
+     * @brief Obtiene PRAGMA data_version de la conexión.
+     * 
+     * El valor solo cambia cuando otra conexión (normalmente otro proceso) confirma
+     * cambios en la base; las escrituras de esta conexión no lo modifican. Leerlo no
+     * recorre ninguna tabla.
+     * 
+     * @return Versión de datos actual, o -1 si no se puede leer.
+     */
+    std::int64_t getDataVersion() const;
+
     /**
      * @brief Obtiene un componente de la base de datos por su ID.
      * 
@@ -128,8 +280,10 @@ public:
     /**
      * @brief Busca componentes en la base de datos que coincidan con una palabra clave.
      * 
-     * @param keyword Palabra clave para buscar en los componentes.
-     * @return Vector con los componentes que coinciden con la palabra clave.
+     * Mismo criterio que la búsqueda en memoria (ComponentQuery::matchesKeyword).
+     * 
+     * @param keyword Palabra clave para buscar en el nombre, el tipo o la ubicación.
+     * @return Vector con los componentes que coinciden con la palabra clave, por nombre.
      */
     std::vector<Component> searchComponents(const std::string& keyword);
 
@@ -137,10 +291,62 @@ public:
      * @brief Obtiene los componentes con bajo stock.
      * 
      * @param threshold Umbral de stock bajo (por defecto es 5).
-     * @return Vector con los componentes cuyo stock es menor o igual al umbral.
+     * @return Vector con los componentes cuyo stock es menor o igual al umbral, por cantidad.
      */
     std::vector<Component> getLowStockComponents(int threshold = 5);
 
+    /**
+     * @brief Ejecuta una consulta componible en la base de datos.
+     * 
+     * La sentencia preparada se reutiliza para todas las consultas con la misma forma.
+     * 
+     * @param query Consulta a ejecutar.
+     * @return Vector con los componentes que cumplen la consulta, en su orden.
+     */
+    std::vector<Component> queryComponents(const ComponentQuery& query);
+
+    /**
+     * @brief Carga todos los componentes directamente en una tabla columnar.
+     * 
+     * Decodifica cada fila en las columnas de la tabla sin crear objetos Component.
+     * 
+     * @param table Tabla donde se añaden las filas, ordenadas por nombre.
+     * @return true si la consulta se ejecuta correctamente, false en caso contrario.
+     */
+    bool loadComponentTable(ComponentTable& table);
+
+    /**
+     * @brief Recorre el registro de cambios de un periodo, en el orden en que ocurrieron.
+     * 
+     * Solo se leen las filas del periodo (hay un índice por fecha), así que el coste
+     * depende del número de cambios y no del tamaño del inventario.
+     * 
+     * @param since Comienzo del periodo (incluido).
+     * @param until Fin del periodo (excluido).
+     * @param visitor Recibe cada cambio; si devuelve false el recorrido se detiene.
+     * @return true si se recorrieron todas las filas, false si hubo un error o se detuvo.
+     */
+    bool forEachChange(std::time_t since, std::time_t until,
+                       const std::function<bool(const ComponentChange&)>& visitor);
+
+    /**
+     * @brief Obtiene el momento desde el que se registran los cambios en esta base.
+     * 
+     * @return Momento en que se creó el registro de cambios, o -1 si no se puede leer.
+     */
+    std::time_t getChangeTrackingStart() const;
+
+    /**
+     * @brief Cambia cuántos días se conservan los cambios registrados.
+     * 
+     * La poda se hace al registrar el siguiente cambio, y el inicio del registro
+     * (getChangeTrackingStart) avanza con ella. El valor se guarda en la base.
+     * 
+     * @param days Días a conservar; 0 conserva todos los cambios.
+     * @return true si se guardó, false si no hay conexión o days es negativo.
+     */
+    bool setChangeRetentionDays(int days);
+
     // Métodos utilitarios
 
     /**
@@ -165,6 +371,9 @@ public:
     /**
      * @brief Recrea la tabla de componentes en la base de datos.
      * 
+     * Las filas se restauran con IDs nuevos, así que el registro de cambios se vacía y
+     * su inicio pasa a ser el momento de la reconstrucción.
+     * 
      * @return true si la tabla se recrea correctamente, false en caso contrario.
      */
     bool recreateTable();
@@ -182,6 +391,19 @@ private:
      * @return Objeto Component creado a partir de la fila.
      */
     Component createComponentFromRow(sqlite3_stmt* stmt);
+
+    /**
+     * @brief Obtiene una sentencia preparada de la caché, preparándola si no existe.
+     * 
+     * @param sql Texto de la sentencia.
+     * @return Sentencia lista para enlazar parámetros, o nullptr si hubo un error.
+     */
+    sqlite3_stmt* getCachedStatement(const std::string& sql);
+
+    /**
+     * @brief Finaliza y descarta todas las sentencias de la caché.
+     */
+    void clearStatementCache();
 };
 
 #endif // DATABASEMANAGER_H
\ No newline at end of file
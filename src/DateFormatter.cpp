@@ -0,0 +1,186 @@
+#include "DateFormatter.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    const std::int64_t SECONDS_PER_DAY = 86400;
+    const std::int64_t TRANSITION_STEP = 900; // Los cambios de horario caen en múltiplos de 15 min
+
+    const std::size_t OFFSET_CACHE_SIZE = 2048; // Unos cinco años de días UTC consecutivos
+    const std::size_t DAY_MEMO_SIZE = 256;
+
+    /**
+     * Desfases de un día UTC: offsetBefore hasta el segundo transition del día y
+     * offsetAfter desde ahí (transition == SECONDS_PER_DAY si no hay cambio de horario).
+     * Sin inicializadores para que las tablas por hilo vivan en memoria a cero y no
+     * necesiten inicialización dinámica.
+     */
+    struct DayOffsets
+    {
+        bool valid;
+        std::int64_t day;
+        std::int32_t transition;
+        std::int32_t offsetBefore;
+        std::int32_t offsetAfter;
+    };
+
+    struct FormattedDay
+    {
+        bool valid;
+        std::int64_t day;
+        char text[DateFormatter::DATE_LENGTH];
+    };
+
+    // Tablas por hilo: no necesitan candados y cada hilo calienta las suyas
+    thread_local DayOffsets offsetCache[OFFSET_CACHE_SIZE];
+    thread_local FormattedDay dayMemo[DAY_MEMO_SIZE];
+
+    std::int64_t floorDiv(std::int64_t value, std::int64_t divisor) {
+        std::int64_t quotient = value / divisor;
+        return quotient - ((value % divisor) < 0);
+    }
+
+    void writeTwoDigits(char* out, int value) {
+        out[0] = static_cast<char>('0' + value / 10);
+        out[1] = static_cast<char>('0' + value % 10);
+    }
+
+    void writeCivilDate(std::int64_t days, char* out) {
+        int year, month, day;
+        DateFormatter::civilFromDays(days, year, month, day);
+        year = std::min(std::max(year, 0), 9999);
+        writeTwoDigits(out, year / 100);
+        writeTwoDigits(out + 2, year % 100);
+        out[4] = '-';
+        writeTwoDigits(out + 5, month);
+        out[7] = '-';
+        writeTwoDigits(out + 8, day);
+    }
+
+    // Escribe "YYYY-MM-DD" para un día local, consultando antes la memoria del hilo
+    void writeLocalDate(std::int64_t localDays, char* out) {
+        FormattedDay& entry = dayMemo[static_cast<std::uint64_t>(localDays) % DAY_MEMO_SIZE];
+        if (!entry.valid || entry.day != localDays) {
+            writeCivilDate(localDays, entry.text);
+            entry.day = localDays;
+            entry.valid = true;
+        }
+        std::memcpy(out, entry.text, DateFormatter::DATE_LENGTH);
+    }
+
+    // Desfase UTC según la base de datos de zonas del sistema (camino lento)
+    std::int32_t systemUtcOffset(std::int64_t time) {
+        std::time_t value = static_cast<std::time_t>(time);
+        std::tm local{};
+#ifdef _WIN32
+        if (localtime_s(&local, &value) != 0) return 0;
+#else
+        if (!localtime_r(&value, &local)) return 0;
+#endif
+        std::int64_t localSeconds =
+            DateFormatter::daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday) * SECONDS_PER_DAY +
+            local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec;
+        return static_cast<std::int32_t>(localSeconds - time);
+    }
+
+    // Calcula los desfases de un día UTC; si cambian dentro del día, busca el instante del cambio
+    void loadDayOffsets(std::int64_t day, DayOffsets& entry) {
+        const std::int64_t start = day * SECONDS_PER_DAY;
+        entry.offsetBefore = systemUtcOffset(start);
+        entry.offsetAfter = systemUtcOffset(start + SECONDS_PER_DAY - 1);
+        entry.transition = static_cast<std::int32_t>(SECONDS_PER_DAY);
+
+        if (entry.offsetBefore != entry.offsetAfter) {
+            std::int64_t low = 0, high = SECONDS_PER_DAY / TRANSITION_STEP;
+            while (low + 1 < high) {
+                std::int64_t middle = (low + high) / 2;
+                if (systemUtcOffset(start + middle * TRANSITION_STEP) == entry.offsetBefore) {
+                    low = middle;
+                } else {
+                    high = middle;
+                }
+            }
+            entry.transition = static_cast<std::int32_t>(high * TRANSITION_STEP);
+        }
+
+        entry.day = day;
+        entry.valid = true;
+    }
+}
+
+void DateFormatter::civilFromDays(std::int64_t days, int& year, int& month, int& day) {
+    // Algoritmo civil_from_days de Howard Hinnant: solo aritmética entera
+    days += 719468;
+    const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const std::int64_t dayOfEra = days - era * 146097;
+    const std::int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const std::int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const std::int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+
+    day = static_cast<int>(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1);
+    month = static_cast<int>(shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9);
+    year = static_cast<int>(yearOfEra + era * 400 + (month <= 2));
+}
+
+std::int64_t DateFormatter::daysFromCivil(int year, int month, int day) {
+    const std::int64_t y = static_cast<std::int64_t>(year) - (month <= 2);
+    const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const std::int64_t yearOfEra = y - era * 400;
+    const std::int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const std::int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+long DateFormatter::utcOffset(std::time_t time) {
+    const std::int64_t seconds = static_cast<std::int64_t>(time);
+    const std::int64_t day = floorDiv(seconds, SECONDS_PER_DAY);
+    DayOffsets& entry = offsetCache[static_cast<std::uint64_t>(day) % OFFSET_CACHE_SIZE];
+    if (!entry.valid || entry.day != day) {
+        loadDayOffsets(day, entry);
+    }
+    return (seconds - day * SECONDS_PER_DAY) < entry.transition ? entry.offsetBefore : entry.offsetAfter;
+}
+
+DateFormatter::CivilTime DateFormatter::toLocal(std::time_t time) {
+    const std::int64_t localSeconds = static_cast<std::int64_t>(time) + utcOffset(time);
+    const std::int64_t days = floorDiv(localSeconds, SECONDS_PER_DAY);
+    const int secondOfDay = static_cast<int>(localSeconds - days * SECONDS_PER_DAY);
+
+    CivilTime result;
+    civilFromDays(days, result.year, result.month, result.day);
+    result.hour = secondOfDay / 3600;
+    result.minute = secondOfDay / 60 % 60;
+    result.second = secondOfDay % 60;
+    return result;
+}
+
+std::size_t DateFormatter::formatDate(std::time_t time, char* out) {
+    const std::int64_t localSeconds = static_cast<std::int64_t>(time) + utcOffset(time);
+    writeLocalDate(floorDiv(localSeconds, SECONDS_PER_DAY), out);
+    return DATE_LENGTH;
+}
+
+std::string DateFormatter::formatDate(std::time_t time) {
+    char buffer[DATE_LENGTH];
+    return std::string(buffer, formatDate(time, buffer));
+}
+
+std::size_t DateFormatter::formatDateTime(std::time_t time, char* out) {
+    const std::int64_t localSeconds = static_cast<std::int64_t>(time) + utcOffset(time);
+    const std::int64_t days = floorDiv(localSeconds, SECONDS_PER_DAY);
+    const int secondOfDay = static_cast<int>(localSeconds - days * SECONDS_PER_DAY);
+
+    writeLocalDate(days, out);
+    out[10] = ' ';
+    writeTwoDigits(out + 11, secondOfDay / 3600);
+    out[13] = ':';
+    writeTwoDigits(out + 14, secondOfDay / 60 % 60);
+    out[16] = ':';
+    writeTwoDigits(out + 17, secondOfDay % 60);
+    return DATE_TIME_LENGTH;
+}
+
+std::string DateFormatter::formatDateTime(std::time_t time) {
+    char buffer[DATE_TIME_LENGTH];
+    return std::string(buffer, formatDateTime(time, buffer));
+}
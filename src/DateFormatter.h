@@ -0,0 +1,115 @@
+#ifndef DATEFORMATTER_H
+#define DATEFORMATTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+/**
+ * @class DateFormatter
+ * @brief Conversión y formateo de fechas en hora local, sin estado global y seguro entre hilos.
+ *
+ * Sustituye a std::localtime + strftime en los caminos calientes (tablas e informes).
+ * La fecha civil se calcula con aritmética entera sin ramas (algoritmo days-to-civil de
+ * Howard Hinnant) y solo el desfase respecto a UTC se obtiene del sistema, con
+ * localtime_r (localtime_s en Windows). Cada hilo guarda:
+ *  - una tabla de desfases UTC por día, con el instante del cambio de horario (DST) si
+ *    lo hay, que se localiza en pasos de 15 minutos como ocurre en todas las zonas, y
+ *  - una pequeña memoria de los últimos días ya formateados.
+ *
+ * Los años fuera de 0-9999 se recortan a ese rango al formatear. Los cambios de zona
+ * horaria del proceso (TZ) después de la primera consulta no se reflejan en los
+ * desfases ya guardados.
+ */
+class DateFormatter
+{
+public:
+    /**
+     * @brief Fecha y hora civiles (calendario gregoriano proléptico).
+     */
+    struct CivilTime
+    {
+        int year; /**< Año completo (p. ej. 2024). */
+        int month; /**< Mes, 1-12. */
+        int day; /**< Día del mes, 1-31. */
+        int hour; /**< Hora, 0-23. */
+        int minute; /**< Minuto, 0-59. */
+        int second; /**< Segundo, 0-59. */
+    };
+
+    static constexpr std::size_t DATE_LENGTH = 10; /**< Longitud de "YYYY-MM-DD". */
+    static constexpr std::size_t DATE_TIME_LENGTH = 19; /**< Longitud de "YYYY-MM-DD HH:MM:SS". */
+
+    /**
+     * @brief Convierte días desde 1970-01-01 en fecha civil.
+     *
+     * @param days Días desde la época Unix (pueden ser negativos).
+     * @param year Año resultante.
+     * @param month Mes resultante (1-12).
+     * @param day Día resultante (1-31).
+     */
+    static void civilFromDays(std::int64_t days, int& year, int& month, int& day);
+
+    /**
+     * @brief Convierte una fecha civil en días desde 1970-01-01.
+     *
+     * @param year Año.
+     * @param month Mes (1-12).
+     * @param day Día (1-31).
+     * @return Días desde la época Unix.
+     */
+    static std::int64_t daysFromCivil(int year, int month, int day);
+
+    /**
+     * @brief Obtiene el desfase de la hora local respecto a UTC en un instante.
+     *
+     * @param time Instante a consultar.
+     * @return Segundos que hay que sumar a la hora UTC para obtener la local.
+     */
+    static long utcOffset(std::time_t time);
+
+    /**
+     * @brief Descompone un instante en fecha y hora locales.
+     *
+     * @param time Instante a convertir.
+     * @return Fecha y hora locales.
+     */
+    static CivilTime toLocal(std::time_t time);
+
+    /**
+     * @brief Escribe la fecha local como "YYYY-MM-DD".
+     *
+     * @param time Instante a formatear.
+     * @param out Búfer de al menos DATE_LENGTH caracteres (no se añade terminador nulo).
+     * @return Número de caracteres escritos.
+     */
+    static std::size_t formatDate(std::time_t time, char* out);
+
+    /**
+     * @brief Formatea la fecha local como "YYYY-MM-DD".
+     *
+     * @param time Instante a formatear.
+     * @return Fecha formateada.
+     */
+    static std::string formatDate(std::time_t time);
+
+    /**
+     * @brief Escribe la fecha y hora locales como "YYYY-MM-DD HH:MM:SS".
+     *
+     * @param time Instante a formatear.
+     * @param out Búfer de al menos DATE_TIME_LENGTH caracteres (no se añade terminador nulo).
+     * @return Número de caracteres escritos.
+     */
+    static std::size_t formatDateTime(std::time_t time, char* out);
+
+    /**
+     * @brief Formatea la fecha y hora locales como "YYYY-MM-DD HH:MM:SS".
+     *
+     * @param time Instante a formatear.
+     * @return Fecha y hora formateadas.
+     */
+    static std::string formatDateTime(std::time_t time);
+};
+
+#endif // DATEFORMATTER_H
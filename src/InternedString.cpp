@@ -0,0 +1,67 @@
+#include "InternedString.h"
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace {
+    /**
+     * Pool global. Las entradas viven en un deque, que nunca mueve los elementos ya
+     * insertados, así que las claves string_view del índice apuntan a su propio texto y
+     * se puede buscar por vista sin construir un std::string temporal.
+     */
+    struct StringPool
+    {
+        std::shared_mutex mutex;
+        std::deque<InternedString::Entry> entries;
+        std::unordered_map<std::string_view, const InternedString::Entry*> index;
+        const InternedString::Entry* empty;
+
+        StringPool() {
+            entries.push_back({std::string(), 0});
+            empty = &entries.back();
+            index.emplace(std::string_view(empty->text), empty);
+        }
+    };
+
+    StringPool& pool() {
+        static StringPool instance;
+        return instance;
+    }
+
+    const InternedString::Entry* emptyEntry() {
+        // La cadena vacía existe desde que se crea el pool: no hace falta tomar el candado
+        static const InternedString::Entry* const empty = pool().empty;
+        return empty;
+    }
+}
+
+InternedString::InternedString() : entry(emptyEntry()) {}
+
+InternedString::InternedString(std::string_view text) : entry(intern(text)) {}
+
+const InternedString::Entry* InternedString::intern(std::string_view text) {
+    StringPool& strings = pool();
+
+    // Camino habitual: el texto ya existe y basta con un candado compartido
+    {
+        std::shared_lock<std::shared_mutex> lock(strings.mutex);
+        auto it = strings.index.find(text);
+        if (it != strings.index.end()) return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(strings.mutex);
+    auto it = strings.index.find(text);
+    if (it != strings.index.end()) return it->second;
+
+    strings.entries.push_back({std::string(text), static_cast<std::uint32_t>(strings.entries.size())});
+    const Entry* created = &strings.entries.back();
+    strings.index.emplace(std::string_view(created->text), created);
+    return created;
+}
+
+std::size_t InternedString::poolSize() {
+    StringPool& strings = pool();
+    std::shared_lock<std::shared_mutex> lock(strings.mutex);
+    return strings.entries.size();
+}
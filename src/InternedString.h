@@ -0,0 +1,89 @@
+#ifndef INTERNEDSTRING_H
+#define INTERNEDSTRING_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @class InternedString
+ * @brief Manejador compacto de una cadena almacenada una sola vez en un pool global.
+ *
+ * Pensado para valores que se repiten mucho, como el tipo y la ubicación de los
+ * componentes: todas las apariciones del mismo texto comparten una única copia, el
+ * manejador ocupa lo mismo que un puntero y la igualdad es una comparación de punteros.
+ *
+ * Las entradas del pool nunca se liberan, por lo que un manejador (y las vistas que se
+ * obtengan de él) es válido durante toda la ejecución y puede usarse desde cualquier hilo.
+ */
+class InternedString
+{
+public:
+    /**
+     * @brief Entrada del pool: el texto y su identificador numérico.
+     */
+    struct Entry
+    {
+        std::string text; /**< Texto interno. */
+        std::uint32_t id; /**< Identificador denso, asignado en orden de creación (0 = ""). */
+    };
+
+private:
+    const Entry* entry; /**< Entrada del pool (nunca nula). */
+
+    /**
+     * @brief Busca o crea la entrada de un texto en el pool.
+     *
+     * @param text Texto a internar.
+     * @return Entrada única para ese texto.
+     */
+    static const Entry* intern(std::string_view text);
+
+public:
+    /**
+     * @brief Constructor por defecto: cadena vacía.
+     */
+    InternedString();
+
+    /**
+     * @brief Interna un texto.
+     *
+     * @param text Texto a internar; no es necesario que termine en nulo.
+     */
+    explicit InternedString(std::string_view text);
+
+    /**
+     * @brief Obtiene el texto como referencia a la copia del pool.
+     * @return Texto interno.
+     */
+    const std::string& str() const { return entry->text; }
+
+    /**
+     * @brief Obtiene el texto como vista.
+     * @return Vista sobre el texto interno.
+     */
+    std::string_view view() const { return entry->text; }
+
+    /**
+     * @brief Obtiene el identificador numérico del texto.
+     * @return Identificador denso y único del texto en el pool.
+     */
+    std::uint32_t id() const { return entry->id; }
+
+    /**
+     * @brief Indica si el texto está vacío.
+     * @return true si el texto es "".
+     */
+    bool empty() const { return entry->text.empty(); }
+
+    /**
+     * @brief Obtiene el número de textos distintos internados hasta ahora.
+     * @return Tamaño del pool.
+     */
+    static std::size_t poolSize();
+
+    friend bool operator==(InternedString a, InternedString b) { return a.entry == b.entry; }
+    friend bool operator!=(InternedString a, InternedString b) { return a.entry != b.entry; }
+};
+
+#endif // INTERNEDSTRING_H
@@ -1,48 +1,249 @@
 #include "InventoryManager.h"
+#include <cstdio>
+#include "BinarySnapshot.h"
 
-InventoryManager::InventoryManager() : dbManager(nullptr) {}
+namespace {
+    std::atomic<std::uint64_t> nextInstanceId{1};
+
+    /**
+     * Caché por hilo del último snapshot leído. Mientras la versión publicada no cambie,
+     * los lectores lo recuperan de su propia referencia débil en lugar de pasar por el
+     * candado de std::atomic_load. La referencia débil no mantiene vivo el snapshot: un
+     * hilo que deja de leer no retiene versiones antiguas del inventario.
+     */
+    struct ReaderCache
+    {
+        std::uint64_t owner = 0;
+        std::uint64_t version = 0;
+        std::weak_ptr<const InventorySnapshot> snapshot;
+    };
+
+    ReaderCache& readerCache() {
+        thread_local ReaderCache cache;
+        return cache;
+    }
+
+    template <typename T>
+    std::future<T> failedWrite(T value) {
+        std::promise<T> result;
+        result.set_value(value);
+        return result.get_future();
+    }
+}
+
+InventoryManager::InventoryManager()
+    : dbManager(nullptr),
+      current(std::make_shared<const InventorySnapshot>(std::vector<Component>(), 0)),
+      publishedVersion(0), instanceId(nextInstanceId++), syncedGeneration(-1) {}
 
 InventoryManager::InventoryManager(DatabaseManager* dbManager) 
-    : dbManager(dbManager) {}
+    : dbManager(dbManager),
+      current(std::make_shared<const InventorySnapshot>(std::vector<Component>(), 0)),
+      publishedVersion(0), instanceId(nextInstanceId++), syncedGeneration(-1) {
+    attachDatabase();
+}
 
 InventoryManager::~InventoryManager() {
-    // No eliminamos dbManager aquí, ya que es manejado externamente
+    // No eliminamos dbManager aquí, ya que es manejado externamente.
+    // saveImage confirma las escrituras que queden en cola antes de guardar.
+    saveImage();
+    writer.reset();
+}
+
+void InventoryManager::attachDatabase() {
+    if (!dbManager) return;
+    writer.reset(new WriteCoalescer(dbManager, 256, std::chrono::milliseconds(20),
+        [this](const std::vector<WriteCoalescer::CommittedWrite>& writes) {
+            onWritesCommitted(writes);
+        }));
+
+    const std::string& databasePath = dbManager->getDatabasePath();
+    bool fileDatabase = !databasePath.empty() && databasePath != ":memory:";
+    imagePath = fileDatabase ? databasePath + ".image" : std::string();
+
+    if (!loadImage()) {
+        reload();
+    }
+}
+
+bool InventoryManager::loadImage() {
+    if (imagePath.empty()) return false;
+
+    auto connectionLock = dbManager->lockConnection();
+    std::int64_t generation = dbManager->getChangeCounter();
+    if (generation < 0) return false;
+
+    BinarySnapshotReader reader;
+    if (!reader.open(imagePath)) return false;
+    if (reader.getSourceTag() != static_cast<std::uint64_t>(generation)) return false;
+
+    // La imagen se escribió en el orden del snapshot y con su índice por ID: no se reordena nada
+    std::lock_guard<std::mutex> lock(publishMutex);
+    auto base = std::atomic_load_explicit(&current, std::memory_order_acquire);
+    publish(InventorySnapshot::fromImage(reader, base->getVersion() + 1));
+    syncedGeneration.store(generation, std::memory_order_release);
+    return true;
+}
+
+bool InventoryManager::saveImage() {
+    if (!dbManager || imagePath.empty()) return false;
+    flushPendingWrites();
+
+    auto connectionLock = dbManager->lockConnection();
+    std::int64_t generation = dbManager->getChangeCounter();
+    if (generation < 0 || generation != syncedGeneration.load(std::memory_order_acquire)) {
+        // El snapshot no refleja la base: una imagen vieja solo obligaría a descartarla
+        std::remove(imagePath.c_str());
+        return false;
+    }
+
+    auto image = snapshot();
+    return BinarySnapshotWriter::write(imagePath, image->getTable(), static_cast<std::uint64_t>(generation));
+}
+
+std::shared_ptr<const InventorySnapshot> InventoryManager::currentSnapshot() const {
+    ReaderCache& cache = readerCache();
+    std::uint64_t version = publishedVersion.load(std::memory_order_acquire);
+    if (cache.owner == instanceId && cache.version == version) {
+        std::shared_ptr<const InventorySnapshot> cached = cache.snapshot.lock();
+        if (cached) return cached;
+    }
+    std::shared_ptr<const InventorySnapshot> loaded = std::atomic_load_explicit(&current, std::memory_order_acquire);
+    cache.snapshot = loaded;
+    cache.owner = instanceId;
+    cache.version = loaded->getVersion();
+    return loaded;
 }
 
-bool InventoryManager::addComponent(const Component& component) {
-    if (!dbManager) return false;
-    return dbManager->addComponent(component);
+std::shared_ptr<const InventorySnapshot> InventoryManager::snapshot() const {
+    return std::atomic_load_explicit(&current, std::memory_order_acquire);
+}
+
+void InventoryManager::publish(std::shared_ptr<const InventorySnapshot> snapshot) {
+    std::uint64_t version = snapshot->getVersion();
+    std::atomic_store_explicit(&current, std::move(snapshot), std::memory_order_release);
+    publishedVersion.store(version, std::memory_order_release);
+}
+
+void InventoryManager::onWritesCommitted(const std::vector<WriteCoalescer::CommittedWrite>& writes) {
+    std::lock_guard<std::mutex> lock(publishMutex);
+    auto base = std::atomic_load_explicit(&current, std::memory_order_acquire);
+    publish(base->withWrites(writes, base->getVersion() + 1));
+    // El lote se aplica con la conexión tomada y cada fila cambiada suma uno a la generación.
+    // Si subió más que el lote, otro proceso escribió antes y el snapshot no lo refleja
+    std::int64_t synced = syncedGeneration.load(std::memory_order_acquire);
+    std::int64_t generation = dbManager->getChangeCounter();
+    bool onlyThisBatch = synced >= 0 && generation == synced + static_cast<std::int64_t>(writes.size());
+    syncedGeneration.store(onlyThisBatch ? generation : -1, std::memory_order_release);
+    if (commitListener) commitListener(writes);
+}
+
+void InventoryManager::reload() {
+    if (!dbManager) return;
+    // Con la conexión tomada ningún lote puede confirmarse entre la lectura y la publicación
+    auto connectionLock = dbManager->lockConnection();
+    std::int64_t generation = dbManager->getChangeCounter();
+    std::vector<Component> components = dbManager->getAllComponents();
+
+    std::lock_guard<std::mutex> lock(publishMutex);
+    auto base = std::atomic_load_explicit(&current, std::memory_order_acquire);
+    publish(std::make_shared<const InventorySnapshot>(std::move(components), base->getVersion() + 1));
+    syncedGeneration.store(generation, std::memory_order_release);
+}
+
+bool InventoryManager::addComponent(const Component& component, int* newId) {
+    int id = -1;
+    if (writer) {
+        std::future<int> result = writer->enqueueAdd(component);
+        writer->flush();
+        id = result.get();
+    }
+    if (newId) *newId = id;
+    return id != -1;
 }
 
 bool InventoryManager::updateComponent(const Component& component) {
-    if (!dbManager) return false;
-    return dbManager->updateComponent(component);
+    if (!writer) return false;
+    std::future<bool> result = writer->enqueueUpdate(component);
+    writer->flush();
+    return result.get();
 }
 
 bool InventoryManager::deleteComponent(int id) {
-    if (!dbManager) return false;
-    return dbManager->deleteComponent(id);
+    if (!writer) return false;
+    std::future<bool> result = writer->enqueueDelete(id);
+    writer->flush();
+    return result.get();
+}
+
+std::future<int> InventoryManager::addComponentAsync(const Component& component) {
+    if (!writer) return failedWrite(-1);
+    return writer->enqueueAdd(component);
+}
+
+std::future<bool> InventoryManager::updateComponentAsync(const Component& component) {
+    if (!writer) return failedWrite(false);
+    return writer->enqueueUpdate(component);
+}
+
+std::future<bool> InventoryManager::deleteComponentAsync(int id) {
+    if (!writer) return failedWrite(false);
+    return writer->enqueueDelete(id);
 }
 
-std::vector<Component> InventoryManager::getAllComponents() {
-    if (!dbManager) return {};
-    return dbManager->getAllComponents();
+void InventoryManager::flushPendingWrites() {
+    if (writer) writer->flush();
 }
 
-std::vector<Component> InventoryManager::searchComponents(const std::string& keyword) {
-    if (!dbManager) return {};
-    return dbManager->searchComponents(keyword);
+std::vector<Component> InventoryManager::getAllComponents() const {
+    return currentSnapshot()->toVector();
 }
 
-std::vector<Component> InventoryManager::getLowStockComponents(int threshold) {
-    if (!dbManager) return {};
-    return dbManager->getLowStockComponents(threshold);
+bool InventoryManager::getComponent(int id, Component& component) const {
+    std::shared_ptr<const InventorySnapshot> latest = currentSnapshot();
+    const Component* found = latest->findById(id);
+    if (!found) return false;
+    component = *found;
+    return true;
+}
+
+std::vector<Component> InventoryManager::searchComponents(const std::string& keyword) const {
+    return query(ComponentQuery().where(ComponentQuery::matchesKeyword(keyword)));
+}
+
+std::vector<Component> InventoryManager::getLowStockComponents(int threshold) const {
+    return currentSnapshot()->getLowStock(threshold);
+}
+
+std::size_t InventoryManager::countLowStock(int threshold) const {
+    return currentSnapshot()->countAtOrBelow(threshold);
+}
+
+std::vector<Component> InventoryManager::query(const ComponentQuery& query) const {
+    return query.apply(*currentSnapshot());
 }
 
 void InventoryManager::setDatabaseManager(DatabaseManager* dbManager) {
+    // Confirmar lo pendiente contra el gestor anterior (y guardar su imagen) antes de cambiarlo
+    saveImage();
+    writer.reset();
     this->dbManager = dbManager;
+    imagePath.clear();
+    syncedGeneration.store(-1, std::memory_order_release);
+    if (dbManager) {
+        attachDatabase();
+    } else {
+        std::lock_guard<std::mutex> lock(publishMutex);
+        auto base = std::atomic_load_explicit(&current, std::memory_order_acquire);
+        publish(std::make_shared<const InventorySnapshot>(std::vector<Component>(), base->getVersion() + 1));
+    }
 }
 
 DatabaseManager* InventoryManager::getDatabaseManager() const {
     return dbManager;
-}
\ No newline at end of file
+}
+
+void InventoryManager::setCommitListener(WriteCoalescer::CommitListener listener) {
+    std::lock_guard<std::mutex> lock(publishMutex);
+    commitListener = std::move(listener);
+}
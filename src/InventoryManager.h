@@ -3,8 +3,15 @@
 
 #include <vector>
 #include <memory>
+#include <future>
+#include <atomic>
+#include <mutex>
+#include <string>
 #include "Component.h"
+#include "ComponentQuery.h"
 #include "DatabaseManager.h"
+#include "InventorySnapshot.h"
+#include "WriteCoalescer.h"
 
 /**
  * @class InventoryManager
@@ -12,11 +19,71 @@
  * 
  * La clase InventoryManager proporciona métodos para gestionar componentes en memoria,
  * realizar búsquedas y consultas, y sincronizar los datos con la base de datos.
+ * 
+ * Las escrituras pasan por un WriteCoalescer que las agrupa en transacciones. Las
+ * lecturas se sirven desde un InventorySnapshot inmutable que el hilo escritor sustituye
+ * atómicamente tras cada lote confirmado (esquema RCU): los lectores nunca toman un
+ * candado ni esperan a las escrituras, y pueden usarse desde cualquier hilo. Una escritura
+ * es visible para las lecturas en cuanto su future (o la llamada síncrona) termina.
+ * 
+ * Al destruirse, el gestor guarda el snapshot en una imagen binaria junto a la base de
+ * datos (BinarySnapshot), etiquetada con la generación de la base. En el siguiente
+ * arranque, si la generación no ha cambiado, el snapshot se carga desde la imagen
+ * mapeada en memoria en lugar de decodificar todas las filas con SQL.
  */
 class InventoryManager
 {
 private:
     DatabaseManager* dbManager; /**< Puntero al gestor de la base de datos. */
+    std::unique_ptr<WriteCoalescer> writer; /**< Agrupa las escrituras en transacciones. */
+
+    std::shared_ptr<const InventorySnapshot> current; /**< Snapshot publicado (acceso atómico). */
+    std::atomic<std::uint64_t> publishedVersion; /**< Versión de current, para la caché de lectores. */
+    std::mutex publishMutex; /**< Serializa a los escritores de snapshots (nunca a los lectores). */
+    const std::uint64_t instanceId; /**< Identifica a esta instancia en la caché por hilo. */
+    std::string imagePath; /**< Ruta de la imagen de arranque rápido (vacía si no se usa). */
+    std::atomic<std::int64_t> syncedGeneration; /**< Generación de la base que refleja current (-1 si se desconoce). */
+    WriteCoalescer::CommitListener commitListener; /**< Recibe cada lote ya publicado (protegido por publishMutex). */
+
+    /**
+     * @brief Obtiene el snapshot vigente sin pasar por el candado de std::atomic_load.
+     * 
+     * Usa una caché por hilo con una referencia débil, que solo se renueva cuando cambia
+     * la versión publicada; la caché nunca mantiene vivo un snapshot antiguo.
+     * 
+     * @return Snapshot vigente.
+     */
+    std::shared_ptr<const InventorySnapshot> currentSnapshot() const;
+
+    /**
+     * @brief Publica un snapshot nuevo.
+     * 
+     * @param snapshot Snapshot a publicar.
+     */
+    void publish(std::shared_ptr<const InventorySnapshot> snapshot);
+
+    /**
+     * @brief Aplica al snapshot un lote de escrituras confirmadas (hilo escritor).
+     * 
+     * Si la generación de la base subió más que las filas del lote, otra conexión escribió
+     * antes y el snapshot no la refleja: syncedGeneration pasa a -1 hasta el próximo reload().
+     * 
+     * @param writes Escrituras confirmadas.
+     */
+    void onWritesCommitted(const std::vector<WriteCoalescer::CommittedWrite>& writes);
+
+    /**
+     * @brief Crea el escritor y carga el snapshot inicial desde la imagen o la base de datos.
+     */
+    void attachDatabase();
+
+    /**
+     * @brief Publica el snapshot guardado en la imagen si sigue vigente.
+     * 
+     * @return true si la imagen existía, era válida y su generación coincide con la de
+     *         la base de datos; false si hay que cargar desde la base.
+     */
+    bool loadImage();
 
 public:
     /**
@@ -46,9 +113,10 @@ public:
      * @brief Agrega un componente al inventario.
      * 
      * @param component Componente a agregar.
+     * @param newId Recibe el ID asignado, o -1 si falla (opcional).
      * @return true si el componente se agrega correctamente, false en caso contrario.
      */
-    bool addComponent(const Component& component);
+    bool addComponent(const Component& component, int* newId = nullptr);
     
     /**
      * @brief Actualiza un componente en el inventario.
@@ -66,12 +134,80 @@ public:
      */
     bool deleteComponent(int id);
     
+    /**
+     * @brief Encola la inserción de un componente sin esperar a que se confirme.
+     * 
+     * La inserción se agrupa con otras escrituras cercanas en una sola transacción.
+     * 
+     * @param component Componente a agregar.
+     * @return Future con el ID asignado cuando la inserción queda confirmada, o -1 si falla.
+     */
+    std::future<int> addComponentAsync(const Component& component);
+    
+    /**
+     * @brief Encola la actualización de un componente sin esperar a que se confirme.
+     * 
+     * @param component Componente con los datos actualizados.
+     * @return Future que vale true cuando la actualización queda confirmada.
+     */
+    std::future<bool> updateComponentAsync(const Component& component);
+    
+    /**
+     * @brief Encola la eliminación de un componente sin esperar a que se confirme.
+     * 
+     * @param id ID del componente a eliminar.
+     * @return Future que vale true cuando la eliminación queda confirmada.
+     */
+    std::future<bool> deleteComponentAsync(int id);
+    
+    /**
+     * @brief Confirma inmediatamente todas las escrituras encoladas.
+     */
+    void flushPendingWrites();
+    
     /**
      * @brief Obtiene todos los componentes del inventario.
      * 
-     * @return Vector con todos los componentes en memoria.
+     * @return Vector con todos los componentes en memoria (copia del snapshot vigente).
+     */
+    std::vector<Component> getAllComponents() const;
+    
+    /**
+     * @brief Obtiene un componente por su ID.
+     * 
+     * @param id ID del componente.
+     * @param component Recibe el componente si existe.
+     * @return true si el componente existe, false en caso contrario.
+     */
+    bool getComponent(int id, Component& component) const;
+    
+    /**
+     * @brief Obtiene el snapshot inmutable vigente del inventario.
+     * 
+     * Puede conservarse y leerse desde cualquier hilo mientras se necesite; las escrituras
+     * posteriores no lo modifican.
+     * 
+     * @return Puntero compartido al snapshot vigente.
+     */
+    std::shared_ptr<const InventorySnapshot> snapshot() const;
+    
+    /**
+     * @brief Vuelve a cargar el snapshot completo desde la base de datos.
+     * 
+     * Útil cuando otro proceso ha modificado la base de datos.
+     */
+    void reload();
+
+    /**
+     * @brief Guarda el snapshot vigente como imagen de arranque rápido.
+     * 
+     * Confirma antes las escrituras pendientes. Si el snapshot no refleja la generación
+     * actual de la base (por ejemplo, porque otro proceso la modificó), no se guarda y se
+     * elimina la imagen anterior. Se llama automáticamente al destruir el gestor.
+     * 
+     * @return true si la imagen quedó escrita, false en caso contrario.
      */
-    std::vector<Component> getAllComponents();
+    bool saveImage();
     
     /**
      * @brief Busca componentes en el inventario que coincidan con una palabra clave.
@@ -79,7 +215,7 @@ public:
      * @param keyword Palabra clave para buscar en los componentes.
      * @return Vector con los componentes que coinciden con la palabra clave.
      */
-    std::vector<Component> searchComponents(const std::string& keyword);
+    std::vector<Component> searchComponents(const std::string& keyword) const;
     
     /**
      * @brief Obtiene los componentes con bajo stock.
@@ -87,7 +223,30 @@ public:
      * @param threshold Umbral de stock bajo (por defecto es 5).
      * @return Vector con los componentes cuyo stock es menor o igual al umbral.
      */
-    std::vector<Component> getLowStockComponents(int threshold = 5);
+    std::vector<Component> getLowStockComponents(int threshold = 5) const;
+    
+    /**
+     * @brief Cuenta los componentes con bajo stock sin copiarlos.
+     * 
+     * Recorre solo la columna de cantidades de las tablas por bloque del snapshot, que
+     * cada escritura hereda del snapshot anterior salvo en los bloques que toca.
+     * 
+     * @param threshold Umbral de stock bajo (por defecto es 5).
+     * @return Número de componentes cuyo stock es menor o igual al umbral.
+     */
+    std::size_t countLowStock(int threshold = 5) const;
+    
+    /**
+     * @brief Ejecuta una consulta componible sobre el inventario.
+     * 
+     * Se evalúa en memoria sobre el snapshot vigente, que siempre está cargado y evita
+     * la ida y vuelta a SQLite; DatabaseManager::queryComponents ejecuta la misma
+     * consulta en SQL para quien no tenga snapshot.
+     * 
+     * @param query Consulta a ejecutar.
+     * @return Vector con los componentes que cumplen la consulta, en su orden.
+     */
+    std::vector<Component> query(const ComponentQuery& query) const;
     
     /**
      * @brief Establece el gestor de base de datos.
@@ -102,6 +261,18 @@ public:
      * @return Puntero al gestor de base de datos.
      */
     DatabaseManager* getDatabaseManager() const;
+
+    /**
+     * @brief Establece la función que recibe cada lote de escrituras confirmado.
+     * 
+     * Se llama desde el hilo escritor, después de publicar el snapshot que incluye el
+     * lote (snapshot() ya lo devuelve). No debe escribir en el inventario ni esperar a
+     * otro hilo que lo haga. Al reemplazarla o quitarla (nullptr) se espera a que
+     * termine la llamada en curso.
+     * 
+     * @param listener Receptor de lotes, o nullptr para quitarlo.
+     */
+    void setCommitListener(WriteCoalescer::CommitListener listener);
 };
 
 #endif // INVENTORYMANAGER_H
\ No newline at end of file
@@ -0,0 +1,317 @@
+#include "InventorySnapshot.h"
+#include "BinarySnapshot.h"
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+
+namespace {
+    char toLowerAscii(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    std::shared_ptr<const std::vector<std::uint64_t>> hashChunk(const std::vector<Component>& items) {
+        auto chunkHashes = std::make_shared<std::vector<std::uint64_t>>();
+        chunkHashes->reserve(items.size());
+        for (const Component& component : items) chunkHashes->push_back(component.contentHash());
+        return chunkHashes;
+    }
+
+    // Construye los datos por bloque de next: un bloque que el lote no copió es el mismo
+    // objeto en los dos snapshots, así que sus datos se reutilizan; el resto se construye con build
+    template <typename Block, typename Build>
+    void inheritBlocks(const ChunkedVector<Component>& previous,
+                       const std::vector<std::shared_ptr<const Block>>& previousBlocks,
+                       const ChunkedVector<Component>& next, std::vector<std::shared_ptr<const Block>>& nextBlocks,
+                       const Build& build) {
+        std::unordered_map<const std::vector<Component>*, std::shared_ptr<const Block>> reusable;
+        reusable.reserve(previousBlocks.size());
+        for (std::size_t chunk = 0; chunk < previousBlocks.size(); ++chunk) {
+            reusable.emplace(&previous.chunkAt(chunk), previousBlocks[chunk]);
+        }
+        nextBlocks.reserve(next.chunkCount());
+        for (std::size_t chunk = 0; chunk < next.chunkCount(); ++chunk) {
+            const std::vector<Component>& items = next.chunkAt(chunk);
+            auto found = reusable.find(&items);
+            nextBlocks.push_back(found != reusable.end() ? found->second : build(items));
+        }
+    }
+}
+
+InventorySnapshot::InventorySnapshot(std::vector<Component> components, std::uint64_t version)
+    : version(version) {
+    if (!std::is_sorted(components.begin(), components.end(), orderBefore)) {
+        std::sort(components.begin(), components.end(), orderBefore);
+    }
+
+    std::vector<IdEntry> entries;
+    entries.reserve(components.size());
+    for (const Component& component : components) {
+        entries.push_back({component.getId(), std::string(component.getName())});
+    }
+    std::sort(entries.begin(), entries.end(), [](const IdEntry& a, const IdEntry& b) { return a.id < b.id; });
+
+    this->components = ChunkedVector<Component>(std::move(components));
+    ids = ChunkedVector<IdEntry>(std::move(entries));
+}
+
+InventorySnapshot::InventorySnapshot(ChunkedVector<Component> components, ChunkedVector<IdEntry> ids,
+                                     std::uint64_t version)
+    : components(std::move(components)), ids(std::move(ids)), version(version) {}
+
+InventorySnapshot::InventorySnapshot(ChunkedVector<Component> components, std::vector<std::uint32_t> rowsById,
+                                     std::uint64_t version)
+    : components(std::move(components)), rowsById(std::move(rowsById)), version(version) {}
+
+std::shared_ptr<const InventorySnapshot> InventorySnapshot::fromImage(const BinarySnapshotReader& reader,
+                                                                      std::uint64_t version) {
+    std::vector<Component> rows = reader.readComponents();
+    const std::uint32_t* rowsById = reader.getIdIndex();
+    if (!rowsById) return std::make_shared<const InventorySnapshot>(std::move(rows), version);
+
+    return std::shared_ptr<const InventorySnapshot>(new InventorySnapshot(
+        ChunkedVector<Component>(std::move(rows)), std::vector<std::uint32_t>(rowsById, rowsById + reader.size()),
+        version));
+}
+
+std::uint64_t InventorySnapshot::getVersion() const {
+    return version;
+}
+
+std::size_t InventorySnapshot::size() const {
+    return components.size();
+}
+
+bool InventorySnapshot::empty() const {
+    return components.empty();
+}
+
+const Component& InventorySnapshot::at(std::size_t row) const {
+    return components[row];
+}
+
+InventorySnapshot::const_iterator InventorySnapshot::begin() const {
+    return components.begin();
+}
+
+InventorySnapshot::const_iterator InventorySnapshot::end() const {
+    return components.end();
+}
+
+std::vector<Component> InventorySnapshot::toVector() const {
+    return components.toVector();
+}
+
+std::size_t InventorySnapshot::lowerBound(const Component& component) const {
+    return components.lowerBound(component, orderBefore);
+}
+
+const ChunkedVector<InventorySnapshot::IdEntry>& InventorySnapshot::idIndex() const {
+    // rowsById no cambia tras construir el snapshot, así que leerlo no necesita candado
+    if (!rowsById.empty()) {
+        std::call_once(idsOnce, [this]() {
+            // Se recorren los componentes en orden y cada entrada va a su puesto por ID:
+            // acceder a components por posición saltando costaría una búsqueda por fila
+            std::vector<std::uint32_t> rankOfRow(rowsById.size());
+            for (std::size_t rank = 0; rank < rowsById.size(); ++rank) {
+                rankOfRow[rowsById[rank]] = static_cast<std::uint32_t>(rank);
+            }
+            std::vector<IdEntry> entries(rowsById.size());
+            std::size_t row = 0;
+            for (const Component& component : components) {
+                IdEntry& entry = entries[rankOfRow[row++]];
+                entry.id = component.getId();
+                entry.name = component.getName();
+            }
+            ids = ChunkedVector<IdEntry>(std::move(entries));
+        });
+    }
+    return ids;
+}
+
+std::size_t InventorySnapshot::idPosition(int id) const {
+    return idIndex().lowerBound(id, [](const IdEntry& entry, int key) { return entry.id < key; });
+}
+
+const Component* InventorySnapshot::findById(int id) const {
+    std::size_t position = idPosition(id);
+    const ChunkedVector<IdEntry>& index = idIndex();
+    if (position == index.size() || index[position].id != id) return nullptr;
+
+    // El nombre del índice da la posición del componente en el orden del snapshot
+    const IdEntry& key = index[position];
+    std::size_t row = components.lowerBound(key, [](const Component& component, const IdEntry& entry) {
+        int byName = component.getName().compare(entry.name);
+        if (byName != 0) return byName < 0;
+        return component.getId() < entry.id;
+    });
+    return &components[row];
+}
+
+const ComponentTable& InventorySnapshot::getTable() const {
+    std::call_once(tableOnce, [this]() {
+        table.reset(new ComponentTable());
+        table->reserve(components.size());
+        for (const Component& component : components) {
+            table->append(component);
+        }
+    });
+    return *table;
+}
+
+const std::vector<std::shared_ptr<const ComponentTable>>& InventorySnapshot::columnBlocks() const {
+    std::call_once(blocksOnce, [this]() {
+        blocks.reserve(components.chunkCount());
+        for (std::size_t chunk = 0; chunk < components.chunkCount(); ++chunk) {
+            blocks.push_back(std::make_shared<const ComponentTable>(
+                ComponentTable::fromComponents(components.chunkAt(chunk))));
+        }
+        blocksReady.store(true, std::memory_order_release);
+    });
+    return blocks;
+}
+
+const std::vector<std::shared_ptr<const std::vector<std::uint64_t>>>& InventorySnapshot::hashBlocks() const {
+    std::call_once(hashesOnce, [this]() {
+        hashes.reserve(components.chunkCount());
+        for (std::size_t chunk = 0; chunk < components.chunkCount(); ++chunk) {
+            hashes.push_back(hashChunk(components.chunkAt(chunk)));
+        }
+        hashesReady.store(true, std::memory_order_release);
+    });
+    return hashes;
+}
+
+std::size_t InventorySnapshot::countAtOrBelow(int threshold) const {
+    std::size_t count = 0;
+    for (const auto& block : columnBlocks()) count += block->countAtOrBelow(threshold);
+    return count;
+}
+
+std::vector<std::uint32_t> InventorySnapshot::filterAtOrBelow(int threshold) const {
+    const auto& tables = columnBlocks();
+    std::vector<std::uint32_t> rows;
+    for (std::size_t chunk = 0; chunk < tables.size(); ++chunk) {
+        const std::uint32_t first = static_cast<std::uint32_t>(components.chunkOffset(chunk));
+        for (std::uint32_t row : tables[chunk]->filterAtOrBelow(threshold)) rows.push_back(first + row);
+    }
+    return rows;
+}
+
+long long InventorySnapshot::sumQuantities() const {
+    long long sum = 0;
+    for (const auto& block : columnBlocks()) sum += block->sumQuantities();
+    return sum;
+}
+
+std::vector<Component> InventorySnapshot::search(const std::string& keyword) const {
+    std::vector<Component> result;
+    for (const Component& component : components) {
+        if (containsIgnoreCase(component.getName(), keyword) ||
+            containsIgnoreCase(component.getType(), keyword) ||
+            containsIgnoreCase(component.getLocation(), keyword)) {
+            result.push_back(component);
+        }
+    }
+    return result;
+}
+
+std::vector<Component> InventorySnapshot::getLowStock(int threshold) const {
+    std::vector<Component> result;
+    std::copy_if(components.begin(), components.end(), std::back_inserter(result),
+                 [threshold](const Component& c) { return c.getQuantity() <= threshold; });
+    std::stable_sort(result.begin(), result.end(), [](const Component& a, const Component& b) {
+        return a.getQuantity() < b.getQuantity();
+    });
+    return result;
+}
+
+std::shared_ptr<const InventorySnapshot> InventorySnapshot::withWrites(
+    const std::vector<WriteCoalescer::CommittedWrite>& writes,
+    std::uint64_t newVersion) const {
+    using WriteKind = WriteCoalescer::WriteKind;
+
+    // Estado final de cada ID tocado por el lote, partiendo del de este snapshot;
+    // nullptr significa "no existe"
+    std::unordered_map<int, const Component*> touched;
+    for (const auto& write : writes) {
+        touched.emplace(write.id, findById(write.id));
+    }
+
+    // Reproducir el lote en orden; un UPDATE sobre un ID inexistente no crea la fila
+    for (const auto& write : writes) {
+        const Component*& state = touched[write.id];
+        switch (write.kind) {
+            case WriteKind::Add:
+                state = &write.component;
+                break;
+            case WriteKind::Update:
+                if (state) state = &write.component;
+                break;
+            case WriteKind::Delete:
+                state = nullptr;
+                break;
+        }
+    }
+
+    // Las copias comparten todos los bloques; solo se duplican los que se modifican
+    ChunkedVector<Component> nextComponents = components;
+    ChunkedVector<IdEntry> nextIds = idIndex();
+    for (const auto& entry : touched) {
+        const Component* before = findById(entry.first);
+        const Component* after = entry.second;
+        if (before == after) continue;
+
+        const std::size_t idAt = nextIds.lowerBound(entry.first,
+            [](const IdEntry& indexed, int key) { return indexed.id < key; });
+        if (before && after && before->getName() == after->getName()) {
+            // Mismo nombre: conserva su posición
+            nextComponents.replace(nextComponents.lowerBound(*before, orderBefore), *after);
+            continue;
+        }
+        if (before) nextComponents.erase(nextComponents.lowerBound(*before, orderBefore));
+        if (after) {
+            nextComponents.insert(nextComponents.lowerBound(*after, orderBefore), *after);
+            IdEntry indexed{entry.first, std::string(after->getName())};
+            if (before) {
+                nextIds.replace(idAt, std::move(indexed));
+            } else {
+                nextIds.insert(idAt, std::move(indexed));
+            }
+        } else {
+            nextIds.erase(idAt);
+        }
+    }
+
+    std::shared_ptr<InventorySnapshot> next(
+        new InventorySnapshot(std::move(nextComponents), std::move(nextIds), newVersion));
+
+    if (blocksReady.load(std::memory_order_acquire)) {
+        std::call_once(next->blocksOnce, [&]() {
+            inheritBlocks(components, blocks, next->components, next->blocks,
+                          [](const std::vector<Component>& items) {
+                              return std::make_shared<const ComponentTable>(ComponentTable::fromComponents(items));
+                          });
+            next->blocksReady.store(true, std::memory_order_release);
+        });
+    }
+    if (hashesReady.load(std::memory_order_acquire)) {
+        std::call_once(next->hashesOnce, [&]() {
+            inheritBlocks(components, hashes, next->components, next->hashes, hashChunk);
+            next->hashesReady.store(true, std::memory_order_release);
+        });
+    }
+    return next;
+}
+
+bool InventorySnapshot::orderBefore(const Component& a, const Component& b) {
+    int byName = a.getName().compare(b.getName());
+    if (byName != 0) return byName < 0;
+    return a.getId() < b.getId();
+}
+
+bool InventorySnapshot::containsIgnoreCase(std::string_view text, std::string_view keyword) {
+    if (keyword.empty()) return true;
+    auto it = std::search(text.begin(), text.end(), keyword.begin(), keyword.end(),
+                          [](char a, char b) { return toLowerAscii(a) == toLowerAscii(b); });
+    return it != text.end();
+}
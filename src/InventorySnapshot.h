@@ -0,0 +1,291 @@
+#ifndef INVENTORYSNAPSHOT_H
+#define INVENTORYSNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ChunkedVector.h"
+#include "Component.h"
+#include "ComponentTable.h"
+#include "WriteCoalescer.h"
+
+class BinarySnapshotReader;
+
+/**
+ * @class InventorySnapshot
+ * @brief Copia inmutable del inventario en un instante dado.
+ *
+ * Un snapshot nunca se modifica después de construido, por lo que cualquier número de
+ * hilos puede leerlo a la vez sin sincronización. Cada escritura confirmada produce un
+ * snapshot nuevo (withWrites) que sustituye al anterior; quien aún tenga el antiguo
+ * sigue viéndolo intacto hasta soltarlo.
+ *
+ * Los componentes se guardan ordenados por nombre y, a igualdad de nombre, por ID, el
+ * mismo orden que devuelve DatabaseManager::getAllComponents.
+ *
+ * Los componentes y un índice por ID se guardan en bloques (ChunkedVector) que el snapshot
+ * siguiente comparte: withWrites solo copia los bloques que toca el lote, así que una
+ * escritura cuesta O(n / ChunkedVector::CHUNK_SIZE) punteros y no una copia del inventario.
+ * La vista columnar de los recuentos (countAtOrBelow, sumQuantities...) y los resúmenes
+ * de contenido (forEachWithHash) también van por bloques: uno por bloque de componentes,
+ * y withWrites reutiliza los de los bloques que no cambiaron.
+ */
+class InventorySnapshot
+{
+private:
+    /**
+     * @brief Entrada del índice por ID: la clave para encontrar el componente.
+     */
+    struct IdEntry
+    {
+        int id; /**< ID del componente. */
+        std::string name; /**< Nombre, que junto con el ID da su posición. */
+    };
+
+    ChunkedVector<Component> components; /**< Componentes ordenados por (nombre, ID). */
+    mutable ChunkedVector<IdEntry> ids; /**< Índice ordenado por ID (usar idIndex()). */
+    std::vector<std::uint32_t> rowsById; /**< Filas ordenadas por ID de una imagen; ids se construye con ellas al primer uso. */
+    mutable std::once_flag idsOnce; /**< Construcción única de ids a partir de rowsById. */
+    std::uint64_t version; /**< Número de versión, creciente con cada publicación. */
+    mutable std::once_flag tableOnce; /**< Construcción única de la tabla columnar. */
+    mutable std::unique_ptr<ComponentTable> table; /**< Vista columnar, creada al primer uso. */
+    mutable std::once_flag blocksOnce; /**< Construcción única de blocks. */
+    mutable std::atomic<bool> blocksReady{false}; /**< blocks ya está construido y withWrites puede reutilizarlo. */
+    mutable std::vector<std::shared_ptr<const ComponentTable>> blocks; /**< Tabla columnar de cada bloque de components. */
+    mutable std::once_flag hashesOnce; /**< Construcción única de hashes. */
+    mutable std::atomic<bool> hashesReady{false}; /**< hashes ya está construido y withWrites puede reutilizarlo. */
+    mutable std::vector<std::shared_ptr<const std::vector<std::uint64_t>>> hashes; /**< Resúmenes de contenido de cada bloque. */
+
+    /**
+     * @brief Constructor a partir de bloques ya ordenados (para withWrites).
+     *
+     * @param components Componentes ordenados por (nombre, ID).
+     * @param ids Índice ordenado por ID.
+     * @param version Número de versión del snapshot.
+     */
+    InventorySnapshot(ChunkedVector<Component> components, ChunkedVector<IdEntry> ids, std::uint64_t version);
+
+    /**
+     * @brief Constructor a partir de las filas de una imagen (para fromImage).
+     *
+     * @param components Componentes ordenados por (nombre, ID).
+     * @param rowsById Posiciones de los componentes ordenadas por ID.
+     * @param version Número de versión del snapshot.
+     */
+    InventorySnapshot(ChunkedVector<Component> components, std::vector<std::uint32_t> rowsById, std::uint64_t version);
+
+    /**
+     * @brief Obtiene el índice por ID, construyéndolo si el snapshot viene de una imagen.
+     *
+     * @return Índice ordenado por ID.
+     */
+    const ChunkedVector<IdEntry>& idIndex() const;
+
+    /**
+     * @brief Obtiene las tablas columnares por bloque, construyéndolas si hace falta.
+     *
+     * @return Una tabla por bloque de components, en orden.
+     */
+    const std::vector<std::shared_ptr<const ComponentTable>>& columnBlocks() const;
+
+    /**
+     * @brief Obtiene los resúmenes de contenido por bloque, calculándolos si hace falta.
+     *
+     * @return Un vector por bloque de components, con el resumen de cada componente en orden.
+     */
+    const std::vector<std::shared_ptr<const std::vector<std::uint64_t>>>& hashBlocks() const;
+
+    /**
+     * @brief Busca la posición de un ID en el índice.
+     *
+     * @param id ID buscado.
+     * @return Posición de la primera entrada con ID mayor o igual.
+     */
+    std::size_t idPosition(int id) const;
+
+public:
+    using const_iterator = ChunkedVector<Component>::const_iterator; /**< Recorre los componentes en orden. */
+
+    /**
+     * @brief Constructor parametrizado.
+     *
+     * @param components Componentes del inventario (se ordenan si no lo están).
+     * @param version Número de versión del snapshot.
+     */
+    InventorySnapshot(std::vector<Component> components, std::uint64_t version);
+
+    /**
+     * @brief Construye un snapshot a partir de una imagen escrita con la tabla de otro snapshot.
+     *
+     * Las filas de la imagen ya están en el orden del snapshot y su índice por ID da el
+     * orden del índice, así que no se reordena nada: solo se decodifican las filas. Las
+     * entradas del índice por ID (una copia de cada nombre) se crean la primera vez que se
+     * necesitan (findById o withWrites), no al cargar. Si la imagen no trae índice por ID
+     * se construye como con el constructor público.
+     *
+     * @param reader Imagen abierta (getTable() de otro snapshot escrito con BinarySnapshotWriter).
+     * @param version Número de versión del snapshot.
+     * @return Snapshot con los componentes de la imagen.
+     */
+    static std::shared_ptr<const InventorySnapshot> fromImage(const BinarySnapshotReader& reader, std::uint64_t version);
+
+    /**
+     * @brief Obtiene la versión del snapshot.
+     * @return Número de versión.
+     */
+    std::uint64_t getVersion() const;
+
+    /**
+     * @brief Número de componentes.
+     * @return Componentes del snapshot.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Indica si el snapshot no tiene componentes.
+     * @return true si está vacío.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Obtiene el componente de una posición, en O(log n).
+     *
+     * @param row Posición en el orden del snapshot (menor que size()).
+     * @return Referencia válida mientras viva el snapshot.
+     */
+    const Component& at(std::size_t row) const;
+
+    const_iterator begin() const; /**< Primer componente, en orden por (nombre, ID). */
+    const_iterator end() const; /**< Fin del recorrido. */
+
+    /**
+     * @brief Copia todos los componentes en un vector.
+     * @return Componentes ordenados por nombre.
+     */
+    std::vector<Component> toVector() const;
+
+    /**
+     * @brief Posición que ocupa (u ocuparía) un componente en el orden del snapshot.
+     *
+     * @param component Componente buscado (se usan su nombre y su ID).
+     * @return Primera posición que no va antes que component.
+     */
+    std::size_t lowerBound(const Component& component) const;
+
+    /**
+     * @brief Busca un componente por su ID, en O(log n) mediante el índice por ID.
+     *
+     * @param id ID del componente.
+     * @return Puntero al componente dentro del snapshot, o nullptr si no existe.
+     */
+    const Component* findById(int id) const;
+
+    /**
+     * @brief Obtiene la vista columnar completa del snapshot en una sola tabla.
+     *
+     * Se construye una sola vez, la primera vez que se pide, recorriendo todo el snapshot;
+     * la fila i corresponde al componente at(i). Sirve para serializar el snapshot entero
+     * (imagen de arranque); para contar o sumar, countAtOrBelow y sumQuantities usan las
+     * tablas por bloque, que no se rehacen en cada escritura.
+     *
+     * @return Tabla columnar del snapshot.
+     */
+    const ComponentTable& getTable() const;
+
+    /**
+     * @brief Cuenta los componentes con cantidad menor o igual al umbral.
+     *
+     * @param threshold Umbral de stock bajo.
+     * @return Número de componentes que cumplen la condición.
+     */
+    std::size_t countAtOrBelow(int threshold) const;
+
+    /**
+     * @brief Obtiene las posiciones de los componentes con cantidad menor o igual al umbral.
+     *
+     * @param threshold Umbral de stock bajo.
+     * @return Posiciones (para at()) en orden creciente.
+     */
+    std::vector<std::uint32_t> filterAtOrBelow(int threshold) const;
+
+    /**
+     * @brief Suma las cantidades de todos los componentes.
+     * @return Cantidad total del inventario.
+     */
+    long long sumQuantities() const;
+
+    /**
+     * @brief Recorre los componentes en orden junto con su resumen de contenido.
+     *
+     * Los resúmenes (Component::contentHash) se guardan por bloques, como las tablas
+     * columnares: se calculan la primera vez que se piden y withWrites hereda los de los
+     * bloques que no cambiaron, así que tras una escritura solo se calculan los de los
+     * bloques copiados.
+     *
+     * @param visitor Recibe (componente, resumen) por cada componente.
+     */
+    template <typename Visitor>
+    void forEachWithHash(const Visitor& visitor) const {
+        const auto& blocks = hashBlocks();
+        for (std::size_t chunk = 0; chunk < blocks.size(); ++chunk) {
+            const std::vector<Component>& items = components.chunkAt(chunk);
+            const std::vector<std::uint64_t>& itemHashes = *blocks[chunk];
+            for (std::size_t i = 0; i < items.size(); ++i) visitor(items[i], itemHashes[i]);
+        }
+    }
+
+    /**
+     * @brief Busca componentes cuyo nombre, tipo o ubicación contengan la palabra clave.
+     *
+     * La comparación ignora mayúsculas y minúsculas ASCII, igual que LIKE en SQLite.
+     *
+     * @param keyword Palabra clave a buscar.
+     * @return Componentes que coinciden, ordenados por nombre.
+     */
+    std::vector<Component> search(const std::string& keyword) const;
+
+    /**
+     * @brief Obtiene los componentes con stock menor o igual al umbral.
+     *
+     * @param threshold Umbral de stock bajo.
+     * @return Componentes con stock bajo, ordenados por cantidad.
+     */
+    std::vector<Component> getLowStock(int threshold) const;
+
+    /**
+     * @brief Construye un snapshot nuevo aplicando un lote de escrituras confirmadas.
+     *
+     * Cada componente tocado se quita de su posición anterior y se inserta en la nueva;
+     * el resto de los bloques se comparte con este snapshot. Si este snapshot ya tiene sus
+     * tablas por bloque, el nuevo las hereda y solo construye las de los bloques copiados.
+     *
+     * @param writes Escrituras confirmadas, en orden.
+     * @param newVersion Versión del snapshot resultante.
+     * @return Snapshot nuevo; el actual no se modifica.
+     */
+    std::shared_ptr<const InventorySnapshot> withWrites(
+        const std::vector<WriteCoalescer::CommittedWrite>& writes,
+        std::uint64_t newVersion) const;
+
+    /**
+     * @brief Orden de los componentes dentro de un snapshot.
+     *
+     * @return true si a va antes que b (por nombre y luego por ID).
+     */
+    static bool orderBefore(const Component& a, const Component& b);
+
+    /**
+     * @brief Comprueba si un texto contiene otro ignorando mayúsculas ASCII.
+     *
+     * @param text Texto donde buscar.
+     * @param keyword Texto a buscar.
+     * @return true si keyword aparece en text.
+     */
+    static bool containsIgnoreCase(std::string_view text, std::string_view keyword);
+};
+
+#endif // INVENTORYSNAPSHOT_H
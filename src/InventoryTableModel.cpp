@@ -0,0 +1,195 @@
+#include "InventoryTableModel.h"
+#include <QBrush>
+#include <QColor>
+#include <QString>
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <utility>
+#include "DateFormatter.h"
+
+namespace {
+    // Convierte una vista UTF-8 en QString sin pasar por un std::string intermedio
+    QString toQString(std::string_view text) {
+        return QString::fromUtf8(text.data(), static_cast<int>(text.size()));
+    }
+}
+
+InventoryTableModel::InventoryTableModel(QObject* parent)
+    : QAbstractTableModel(parent) {}
+
+void InventoryTableModel::setSnapshot(std::shared_ptr<const InventorySnapshot> newSnapshot) {
+    beginResetModel();
+    snapshot = std::move(newSnapshot);
+    results.clear();
+    results.shrink_to_fit();
+    endResetModel();
+}
+
+void InventoryTableModel::setComponents(std::vector<Component> components) {
+    beginResetModel();
+    snapshot.reset();
+    results = std::move(components);
+    endResetModel();
+}
+
+void InventoryTableModel::appendComponents(std::vector<Component> components) {
+    if (components.empty()) return;
+    if (snapshot) {
+        // Se mostraba un snapshot: la lista propia empieza con sus filas
+        results = snapshot->toVector();
+        snapshot.reset();
+    }
+    const int first = static_cast<int>(results.size());
+    beginInsertRows(QModelIndex(), first, first + static_cast<int>(components.size()) - 1);
+    results.insert(results.end(), std::make_move_iterator(components.begin()),
+                   std::make_move_iterator(components.end()));
+    endInsertRows();
+}
+
+std::size_t InventoryTableModel::rowTotal() const {
+    return snapshot ? snapshot->size() : results.size();
+}
+
+int InventoryTableModel::findRow(const Component& component) const {
+    if (snapshot) {
+        std::size_t row = snapshot->lowerBound(component);
+        if (row == snapshot->size() || snapshot->at(row).getId() != component.getId()) return -1;
+        return static_cast<int>(row);
+    }
+    auto it = std::lower_bound(results.begin(), results.end(), component, InventorySnapshot::orderBefore);
+    if (it == results.end() || it->getId() != component.getId()) return -1;
+    return static_cast<int>(it - results.begin());
+}
+
+template <typename Change>
+void InventoryTableModel::notifyRowChange(int oldRow, int newRow, Change&& change) {
+    if (oldRow >= 0 && newRow == oldRow) {
+        change();
+        emit dataChanged(index(oldRow, 0), index(oldRow, ColumnCount - 1));
+    } else if (oldRow >= 0 && newRow >= 0) {
+        // Para Qt el destino es la fila delante de la cual queda, contada antes de quitarla
+        beginMoveRows(QModelIndex(), oldRow, oldRow, QModelIndex(), newRow > oldRow ? newRow + 1 : newRow);
+        change();
+        endMoveRows();
+        emit dataChanged(index(newRow, 0), index(newRow, ColumnCount - 1));
+    } else if (oldRow >= 0) {
+        beginRemoveRows(QModelIndex(), oldRow, oldRow);
+        change();
+        endRemoveRows();
+    } else if (newRow >= 0) {
+        beginInsertRows(QModelIndex(), newRow, newRow);
+        change();
+        endInsertRows();
+    } else {
+        change();
+    }
+}
+
+void InventoryTableModel::applyChange(std::shared_ptr<const InventorySnapshot> next, const Component* previous,
+                                      const Component* current) {
+    // previous puede apuntar a una fila del propio modelo: se copia antes de tocar nada
+    const bool hadPrevious = previous != nullptr;
+    const Component before = hadPrevious ? *previous : Component();
+    const int oldRow = hadPrevious ? findRow(before) : -1;
+
+    if (snapshot) {
+        const std::size_t expected = snapshot->size() - (oldRow >= 0 ? 1 : 0) + (current ? 1 : 0);
+        int newRow = -1;
+        if (current) {
+            std::size_t row = next->lowerBound(*current);
+            if (row < next->size() && next->at(row).getId() == current->getId()) newRow = static_cast<int>(row);
+        }
+        if (next->size() != expected || (hadPrevious && oldRow < 0) || (current && newRow < 0)) {
+            setSnapshot(std::move(next));
+            return;
+        }
+        notifyRowChange(oldRow, newRow, [&]() { snapshot = std::move(next); });
+        return;
+    }
+
+    // Lista propia: se modifica en su sitio
+    int newRow = -1;
+    if (current) {
+        auto it = std::lower_bound(results.begin(), results.end(), *current, InventorySnapshot::orderBefore);
+        newRow = static_cast<int>(it - results.begin());
+        // La posición se cuenta sin la fila anterior, que se quita
+        if (oldRow >= 0 && oldRow < newRow) --newRow;
+    }
+    notifyRowChange(oldRow, newRow, [&]() {
+        if (oldRow >= 0 && newRow == oldRow) {
+            results[static_cast<std::size_t>(oldRow)] = *current;
+            return;
+        }
+        if (oldRow >= 0) results.erase(results.begin() + oldRow);
+        if (newRow >= 0) results.insert(results.begin() + newRow, *current);
+    });
+}
+
+const Component* InventoryTableModel::componentAt(int row) const {
+    if (row < 0 || static_cast<std::size_t>(row) >= rowTotal()) return nullptr;
+    if (snapshot) return &snapshot->at(static_cast<std::size_t>(row));
+    return &results[static_cast<std::size_t>(row)];
+}
+
+int InventoryTableModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(rowTotal());
+}
+
+int InventoryTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant InventoryTableModel::data(const QModelIndex& index, int role) const {
+    const Component* component = componentAt(index.row());
+    if (!component) return QVariant();
+
+    switch (role) {
+        case Qt::DisplayRole:
+            switch (index.column()) {
+                case IdColumn: return component->getId();
+                case NameColumn: return toQString(component->getName());
+                case TypeColumn: return toQString(component->getType());
+                case QuantityColumn: return component->getQuantity();
+                case LocationColumn: return toQString(component->getLocation());
+                case DateColumn: {
+                    if (component->getPurchaseDate() == 0) return QString("No date");
+                    char date[DateFormatter::DATE_LENGTH];
+                    std::size_t length = DateFormatter::formatDate(component->getPurchaseDate(), date);
+                    return QString::fromLatin1(date, static_cast<int>(length));
+                }
+                default: return QVariant();
+            }
+
+        // Stock bajo: cantidad en rojo sobre fondo rojo claro, y también el nombre en rojo
+        case Qt::BackgroundRole:
+            if (index.column() == QuantityColumn && component->isLowStock()) {
+                return QBrush(QColor(255, 200, 200));
+            }
+            return QVariant();
+
+        case Qt::ForegroundRole:
+            if ((index.column() == QuantityColumn || index.column() == NameColumn) && component->isLowStock()) {
+                return QBrush(Qt::red);
+            }
+            return QVariant();
+
+        default:
+            return QVariant();
+    }
+}
+
+QVariant InventoryTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole) return QVariant();
+    if (orientation == Qt::Vertical) return section + 1;
+
+    switch (section) {
+        case IdColumn: return QString("ID");
+        case NameColumn: return QString("Nombre");
+        case TypeColumn: return QString("Tipo");
+        case QuantityColumn: return QString("Cantidad");
+        case LocationColumn: return QString("Ubicación");
+        case DateColumn: return QString("Fecha Compra");
+        default: return QVariant();
+    }
+}
@@ -0,0 +1,162 @@
+#ifndef INVENTORYTABLEMODEL_H
+#define INVENTORYTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <memory>
+#include <vector>
+#include "Component.h"
+#include "InventorySnapshot.h"
+
+/**
+ * @class InventoryTableModel
+ * @brief Modelo de la tabla de componentes de la ventana principal.
+ *
+ * Las filas no se copian ni se convierten de antemano: el modelo apunta a los
+ * componentes de un snapshot (o a un vector propio, para los resultados de una
+ * búsqueda) y la vista pide con data() solo las celdas visibles. Cambiar de snapshot
+ * es un reinicio del modelo que no depende del número de componentes.
+ *
+ * El color de stock bajo se entrega con los roles BackgroundRole y ForegroundRole, así
+ * que tampoco se guarda por celda.
+ */
+class InventoryTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+private:
+    std::shared_ptr<const InventorySnapshot> snapshot; /**< Snapshot mostrado (nulo si se muestra results). */
+    std::vector<Component> results; /**< Componentes propios (resultados de búsqueda). */
+
+    /**
+     * @brief Número de filas mostradas: las del snapshot o las de results.
+     *
+     * @return Filas del modelo.
+     */
+    std::size_t rowTotal() const;
+
+    /**
+     * @brief Busca la fila de un componente (por nombre e ID) en las filas mostradas.
+     *
+     * @param component Componente a buscar.
+     * @return Fila del componente, o -1 si no está.
+     */
+    int findRow(const Component& component) const;
+
+    /**
+     * @brief Notifica el cambio de una fila y hace el cambio de datos entre las notificaciones.
+     *
+     * @param oldRow Fila anterior (-1 si el componente no estaba).
+     * @param newRow Fila final (-1 si el componente ya no está).
+     * @param change Modifica los datos del modelo.
+     */
+    template <typename Change>
+    void notifyRowChange(int oldRow, int newRow, Change&& change);
+
+public:
+    /**
+     * @brief Columnas de la tabla.
+     */
+    enum Column
+    {
+        IdColumn, /**< ID del componente. */
+        NameColumn, /**< Nombre. */
+        TypeColumn, /**< Tipo. */
+        QuantityColumn, /**< Cantidad (marcada si hay stock bajo). */
+        LocationColumn, /**< Ubicación. */
+        DateColumn, /**< Fecha de compra. */
+        ColumnCount /**< Número de columnas. */
+    };
+
+    static constexpr int SIZE_SAMPLE_ROWS = 200; /**< Filas que mide la vista para ajustar el ancho de las columnas. */
+
+    /**
+     * @brief Constructor. El modelo empieza vacío.
+     *
+     * @param parent Objeto padre.
+     */
+    explicit InventoryTableModel(QObject* parent = nullptr);
+
+    /**
+     * @brief Muestra todos los componentes de un snapshot, sin copiarlos.
+     *
+     * @param snapshot Snapshot a mostrar.
+     */
+    void setSnapshot(std::shared_ptr<const InventorySnapshot> snapshot);
+
+    /**
+     * @brief Muestra una lista de componentes propia (p. ej. el resultado de una búsqueda).
+     *
+     * @param components Componentes a mostrar, en orden.
+     */
+    void setComponents(std::vector<Component> components);
+
+    /**
+     * @brief Agrega componentes al final de la lista propia (p. ej. otra página de resultados).
+     *
+     * Solo se notifican las filas nuevas: la selección y el desplazamiento se conservan.
+     *
+     * @param components Componentes a agregar, en orden y detrás de los ya mostrados.
+     */
+    void appendComponents(std::vector<Component> components);
+
+    /**
+     * @brief Aplica el cambio de un solo componente sin recargar la tabla.
+     *
+     * La fila se inserta, elimina, actualiza o mueve en su posición ordenada (búsqueda
+     * binaria por nombre e ID), con las notificaciones de filas de Qt: la vista conserva
+     * la selección y el desplazamiento y solo vuelve a pedir las celdas afectadas. Si el
+     * modelo muestra un snapshot completo y next no difiere de él solo en este cambio (por
+     * ejemplo, porque otro proceso también escribió), se muestra next completo.
+     *
+     * @param next Snapshot con el cambio ya aplicado.
+     * @param previous Valores anteriores del componente, o nullptr si es nuevo.
+     * @param current Valores nuevos, o nullptr si se eliminó o ya no debe mostrarse.
+     */
+    void applyChange(std::shared_ptr<const InventorySnapshot> next, const Component* previous,
+                     const Component* current);
+
+    /**
+     * @brief Obtiene el componente de una fila.
+     *
+     * @param row Fila de la tabla.
+     * @return Componente, o nullptr si la fila no existe.
+     */
+    const Component* componentAt(int row) const;
+
+    /**
+     * @brief Número de filas.
+     *
+     * @param parent Índice padre (la tabla no tiene jerarquía).
+     * @return Componentes mostrados.
+     */
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    /**
+     * @brief Número de columnas.
+     *
+     * @param parent Índice padre (la tabla no tiene jerarquía).
+     * @return ColumnCount.
+     */
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    /**
+     * @brief Obtiene el dato de una celda para un rol.
+     *
+     * @param index Celda.
+     * @param role Rol pedido por la vista (texto, fondo o color del texto).
+     * @return Dato de la celda, o un QVariant vacío si el rol no se usa.
+     */
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Obtiene el título de una columna.
+     *
+     * @param section Columna (o fila, para la cabecera vertical).
+     * @param orientation Orientación de la cabecera.
+     * @param role Rol pedido por la vista.
+     * @return Título de la columna.
+     */
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+};
+
+#endif // INVENTORYTABLEMODEL_H
@@ -0,0 +1,111 @@
+#include "LiveSearch.h"
+#include <chrono>
+#include <iostream>
+
+LiveSearch::LiveSearch(SnapshotSource snapshotSource, Listener listener)
+    : snapshotSource(std::move(snapshotSource)), listener(std::move(listener)),
+      pendingGeneration(0), stopping(false), generation(0) {
+    worker = std::thread([this]() { workerLoop(); });
+}
+
+LiveSearch::~LiveSearch() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        // La búsqueda en curso se detiene en el siguiente bloque de filas
+        ++generation;
+    }
+    condition.notify_all();
+    worker.join();
+}
+
+LiveSearch::Generation LiveSearch::search(const std::string& keyword) {
+    return search(ComponentQuery().where(ComponentQuery::matchesKeyword(keyword)));
+}
+
+LiveSearch::Generation LiveSearch::search(ComponentQuery query) {
+    Generation requested;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requested = ++generation;
+        pendingQuery = std::move(query);
+        pendingGeneration = requested;
+    }
+    condition.notify_one();
+    return requested;
+}
+
+void LiveSearch::cancel() {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++generation;
+    pendingGeneration = 0;
+}
+
+LiveSearch::Generation LiveSearch::currentGeneration() const {
+    return generation.load();
+}
+
+void LiveSearch::workerLoop() {
+    for (;;) {
+        ComponentQuery query;
+        Generation searchGeneration;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || pendingGeneration != 0; });
+            if (stopping) return;
+            query = std::move(pendingQuery);
+            searchGeneration = pendingGeneration;
+            pendingGeneration = 0;
+        }
+
+        try {
+            run(query, searchGeneration);
+        } catch (const std::exception& e) {
+            std::cerr << "Error en la búsqueda: " << e.what() << std::endl;
+        }
+    }
+}
+
+void LiveSearch::run(const ComponentQuery& query, Generation searchGeneration) {
+    using Clock = std::chrono::steady_clock;
+
+    std::shared_ptr<const InventorySnapshot> snapshot = snapshotSource();
+
+    // Tipos y ubicaciones se repiten mucho: cada valor distinto se compara una vez
+    ComponentQuery::MatchMemo memo;
+
+    ResultPage page{searchGeneration, {}, true, false, 0};
+    std::size_t pageRows = FIRST_PAGE_ROWS;
+    Clock::time_point lastDelivery = Clock::now();
+
+    auto deliver = [&](bool last) {
+        page.last = last;
+        if (listener) listener(std::move(page));
+        page.components.clear();
+        page.first = false;
+        pageRows = PAGE_ROWS;
+        lastDelivery = Clock::now();
+    };
+
+    std::size_t scanned = 0;
+    for (const Component& component : *snapshot) {
+        if (++scanned % CHECK_ROWS == 0) {
+            if (generation.load() != searchGeneration) return;
+            // Una búsqueda con pocas coincidencias no hace esperar a las que ya tiene
+            if (!page.components.empty() &&
+                Clock::now() - lastDelivery >= std::chrono::milliseconds(PAGE_INTERVAL_MS)) {
+                deliver(false);
+            }
+        }
+
+        if (query.matches(component, memo)) {
+            page.components.push_back(component);
+            ++page.matched;
+            if (page.matched == query.getLimit()) break;
+            if (page.components.size() >= pageRows) deliver(false);
+        }
+    }
+
+    if (generation.load() != searchGeneration) return;
+    deliver(true);
+}
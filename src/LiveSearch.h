@@ -0,0 +1,132 @@
+#ifndef LIVESEARCH_H
+#define LIVESEARCH_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Component.h"
+#include "ComponentQuery.h"
+#include "InventorySnapshot.h"
+
+/**
+ * @class LiveSearch
+ * @brief Búsqueda en un hilo propio, para buscar mientras se escribe.
+ *
+ * Cada llamada a search() sustituye a la búsqueda anterior: si aún no había empezado se
+ * descarta, y si estaba recorriendo el snapshot se detiene en el siguiente bloque de
+ * filas. Solo existe un hilo, así que escribir deprisa nunca acumula búsquedas.
+ *
+ * Los resultados se entregan por páginas en el orden del snapshot (nombre e ID): la
+ * primera en cuanto hay filas suficientes para llenar la tabla, y las siguientes por
+ * bloques o cuando pasa un rato sin entregar nada. El criterio es una ComponentQuery (por
+ * texto, ComponentQuery::matchesKeyword); de ella se usan el filtro y el límite. El
+ * resultado de comparar el tipo y la ubicación se recuerda por cadena internada
+ * (ComponentQuery::MatchMemo), de modo que cada valor distinto se compara una sola vez.
+ *
+ * Las páginas se entregan al Listener desde el hilo de búsqueda; una interfaz gráfica
+ * debe reenviarlas a su propio hilo y descartar las de una generación que ya no sea la
+ * actual (currentGeneration()).
+ */
+class LiveSearch
+{
+public:
+    using Generation = std::uint64_t; /**< Identificador de una búsqueda (nunca 0). */
+
+    /**
+     * @brief Bloque de resultados de una búsqueda.
+     */
+    struct ResultPage
+    {
+        Generation generation; /**< Búsqueda a la que pertenece. */
+        std::vector<Component> components; /**< Componentes encontrados, en orden. */
+        bool first; /**< Primera página: sustituye a lo que se mostraba. */
+        bool last; /**< Última página: la búsqueda terminó. */
+        std::size_t matched; /**< Componentes encontrados hasta ahora, incluida esta página. */
+    };
+
+    using Listener = std::function<void(ResultPage page)>; /**< Recibe las páginas de resultados. */
+    using SnapshotSource = std::function<std::shared_ptr<const InventorySnapshot>()>; /**< Obtiene el snapshot vigente. */
+
+    static constexpr std::size_t FIRST_PAGE_ROWS = 200; /**< Filas de la primera página (más que una pantalla). */
+    static constexpr std::size_t PAGE_ROWS = 16384; /**< Filas de las páginas siguientes. */
+    static constexpr std::size_t CHECK_ROWS = 4096; /**< Filas recorridas entre comprobaciones de cancelación. */
+    static constexpr int PAGE_INTERVAL_MS = 100; /**< Espera máxima para entregar lo encontrado. */
+
+private:
+    SnapshotSource snapshotSource; /**< Obtiene el snapshot en que se busca. */
+    Listener listener; /**< Receptor de páginas. */
+    std::mutex mutex; /**< Protege pendingQuery, pendingGeneration y stopping. */
+    std::condition_variable condition; /**< Despierta al hilo cuando hay búsqueda nueva o al parar. */
+    ComponentQuery pendingQuery; /**< Consulta de la búsqueda que aún no ha empezado. */
+    Generation pendingGeneration; /**< Generación de la búsqueda pendiente (0 si no hay). */
+    bool stopping; /**< Indica que el objeto se está destruyendo. */
+    std::atomic<Generation> generation; /**< Última búsqueda pedida; las anteriores se detienen. */
+    std::thread worker; /**< Hilo de búsqueda. */
+
+    /**
+     * @brief Bucle del hilo de búsqueda.
+     */
+    void workerLoop();
+
+    /**
+     * @brief Recorre el snapshot vigente y entrega las páginas de una búsqueda.
+     *
+     * @param query Consulta a buscar.
+     * @param searchGeneration Generación de la búsqueda; se detiene si deja de ser la actual.
+     */
+    void run(const ComponentQuery& query, Generation searchGeneration);
+
+public:
+    /**
+     * @brief Constructor. Arranca el hilo de búsqueda.
+     *
+     * @param snapshotSource Devuelve el snapshot vigente del inventario (p. ej. InventoryManager::snapshot).
+     * @param listener Receptor de páginas; se llama desde el hilo de búsqueda.
+     */
+    LiveSearch(SnapshotSource snapshotSource, Listener listener);
+
+    /**
+     * @brief Destructor. Detiene la búsqueda en curso y espera al hilo.
+     */
+    ~LiveSearch();
+
+    LiveSearch(const LiveSearch&) = delete;
+    LiveSearch& operator=(const LiveSearch&) = delete;
+
+    /**
+     * @brief Pide una búsqueda nueva, que sustituye a la pendiente o en curso.
+     *
+     * @param keyword Texto a buscar en el nombre, el tipo o la ubicación (ComponentQuery::matchesKeyword).
+     * @return Generación de la búsqueda.
+     */
+    Generation search(const std::string& keyword);
+
+    /**
+     * @brief Pide una búsqueda nueva con una consulta, que sustituye a la pendiente o en curso.
+     *
+     * @param query Consulta; los resultados siguen el orden del snapshot, no el de la consulta.
+     * @return Generación de la búsqueda.
+     */
+    Generation search(ComponentQuery query);
+
+    /**
+     * @brief Detiene la búsqueda pendiente o en curso sin pedir otra.
+     */
+    void cancel();
+
+    /**
+     * @brief Obtiene la generación de la última búsqueda pedida (o cancelada).
+     *
+     * @return Generación actual; las páginas de otras generaciones están obsoletas.
+     */
+    Generation currentGeneration() const;
+};
+
+#endif // LIVESEARCH_H
@@ -0,0 +1,89 @@
+#include "LowStockMonitor.h"
+#include <memory>
+#include "DatabaseManager.h"
+
+namespace {
+    std::int64_t readDataVersion(InventoryManager* inventoryManager) {
+        DatabaseManager* dbManager = inventoryManager->getDatabaseManager();
+        return dbManager ? dbManager->getDataVersion() : -1;
+    }
+}
+
+LowStockMonitor::LowStockMonitor(InventoryManager* inventoryManager, Listener listener, int threshold)
+    : inventoryManager(inventoryManager), listener(std::move(listener)), threshold(threshold),
+      dataVersion(readDataVersion(inventoryManager)) {
+    LowStockEvent initial;
+    rebuild(initial);
+    inventoryManager->setCommitListener([this](const std::vector<WriteCoalescer::CommittedWrite>& writes) {
+        onWritesCommitted(writes);
+    });
+}
+
+LowStockMonitor::~LowStockMonitor() {
+    inventoryManager->setCommitListener(nullptr);
+}
+
+void LowStockMonitor::onWritesCommitted(const std::vector<WriteCoalescer::CommittedWrite>& writes) {
+    using WriteKind = WriteCoalescer::WriteKind;
+    LowStockEvent event;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const WriteCoalescer::CommittedWrite& write : writes) {
+            const int id = write.kind == WriteKind::Add ? write.component.getId() : write.id;
+            const bool wasLow = lowStock.count(id) != 0;
+            const bool isLow = write.kind != WriteKind::Delete && write.component.getQuantity() <= threshold;
+            if (isLow && !wasLow) {
+                lowStock.insert(id);
+                event.entered.push_back(write.component);
+            } else if (!isLow && wasLow) {
+                lowStock.erase(id);
+                event.left.push_back(id);
+            }
+        }
+        event.count = lowStock.size();
+    }
+    notify(event);
+}
+
+void LowStockMonitor::rebuild(LowStockEvent& event) {
+    std::lock_guard<std::mutex> lock(mutex);
+    // El snapshot se toma con el candado: un lote publicado después se aplicará encima, y
+    // uno ya incluido en el snapshot deja el mismo resultado si se vuelve a aplicar
+    std::shared_ptr<const InventorySnapshot> snapshot = inventoryManager->snapshot();
+
+    std::unordered_set<int> current;
+    for (const Component& component : *snapshot) {
+        if (component.getQuantity() > threshold) continue;
+        current.insert(component.getId());
+        if (lowStock.count(component.getId()) == 0) event.entered.push_back(component);
+    }
+    for (int id : lowStock) {
+        if (current.count(id) == 0) event.left.push_back(id);
+    }
+    lowStock.swap(current);
+    event.count = lowStock.size();
+}
+
+void LowStockMonitor::notify(const LowStockEvent& event) const {
+    if (listener && (!event.entered.empty() || !event.left.empty())) listener(event);
+}
+
+bool LowStockMonitor::checkExternalChanges() {
+    std::int64_t version = readDataVersion(inventoryManager);
+    if (version < 0 || version == dataVersion.exchange(version)) return false;
+
+    inventoryManager->reload();
+    LowStockEvent event;
+    rebuild(event);
+    notify(event);
+    return true;
+}
+
+std::size_t LowStockMonitor::count() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lowStock.size();
+}
+
+int LowStockMonitor::getThreshold() const {
+    return threshold;
+}
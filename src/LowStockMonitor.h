@@ -0,0 +1,119 @@
+#ifndef LOWSTOCKMONITOR_H
+#define LOWSTOCKMONITOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+#include "Component.h"
+#include "InventoryManager.h"
+#include "InventorySnapshot.h"
+#include "WriteCoalescer.h"
+
+/**
+ * @class LowStockMonitor
+ * @brief Mantiene el conjunto de componentes con stock bajo sin consultar periódicamente.
+ *
+ * Las escrituras de este proceso llegan con cada lote confirmado del InventoryManager
+ * y actualizan el conjunto por ID, sin recorrer el inventario. Los cambios de otros
+ * procesos se detectan con checkExternalChanges(), que solo lee PRAGMA data_version:
+ * si la base cambió, se recarga el inventario y el conjunto se reconstruye.
+ *
+ * El Listener solo se llama cuando el conjunto cambia (entra o sale algún componente),
+ * no cuando cambia la cantidad de uno que ya tenía stock bajo. Se llama desde el hilo
+ * escritor del inventario o desde el que llama a checkExternalChanges(); una interfaz
+ * gráfica debe reenviar los eventos a su propio hilo.
+ */
+class LowStockMonitor
+{
+public:
+    /**
+     * @brief Cambio del conjunto de componentes con stock bajo.
+     */
+    struct LowStockEvent
+    {
+        std::size_t count; /**< Componentes con stock bajo tras el cambio. */
+        std::vector<Component> entered; /**< Componentes que pasaron a tener stock bajo. */
+        std::vector<int> left; /**< IDs que dejaron de tener stock bajo (o se eliminaron). */
+    };
+
+    using Listener = std::function<void(const LowStockEvent&)>; /**< Recibe los cambios del conjunto. */
+
+    static constexpr int DEFAULT_THRESHOLD = 5; /**< Umbral por defecto, el de Component::isLowStock. */
+
+private:
+    InventoryManager* inventoryManager; /**< Inventario vigilado. */
+    Listener listener; /**< Receptor de cambios (puede estar vacío). */
+    int threshold; /**< Cantidad máxima que se considera stock bajo. */
+    mutable std::mutex mutex; /**< Protege lowStock. */
+    std::unordered_set<int> lowStock; /**< IDs con stock bajo. */
+    std::atomic<std::int64_t> dataVersion; /**< Último PRAGMA data_version visto (-1 si no hay base). */
+
+    /**
+     * @brief Aplica un lote de escrituras confirmadas al conjunto (hilo escritor).
+     *
+     * @param writes Escrituras del lote, en orden.
+     */
+    void onWritesCommitted(const std::vector<WriteCoalescer::CommittedWrite>& writes);
+
+    /**
+     * @brief Reconstruye el conjunto a partir del snapshot vigente.
+     *
+     * @param event Recibe los componentes que entraron y los IDs que salieron.
+     */
+    void rebuild(LowStockEvent& event);
+
+    /**
+     * @brief Entrega un evento al receptor, si lo hay y el conjunto cambió.
+     *
+     * @param event Evento a entregar.
+     */
+    void notify(const LowStockEvent& event) const;
+
+public:
+    /**
+     * @brief Constructor. Calcula el conjunto inicial y se suscribe a los lotes confirmados.
+     *
+     * @param inventoryManager Inventario a vigilar; debe vivir más que el monitor.
+     * @param listener Receptor de cambios del conjunto.
+     * @param threshold Cantidad máxima que se considera stock bajo.
+     */
+    LowStockMonitor(InventoryManager* inventoryManager, Listener listener, int threshold = DEFAULT_THRESHOLD);
+
+    /**
+     * @brief Destructor. Se desuscribe del inventario (espera al lote en curso).
+     */
+    ~LowStockMonitor();
+
+    LowStockMonitor(const LowStockMonitor&) = delete;
+    LowStockMonitor& operator=(const LowStockMonitor&) = delete;
+
+    /**
+     * @brief Comprueba si otro proceso modificó la base de datos.
+     *
+     * Si PRAGMA data_version cambió desde la última comprobación, recarga el inventario
+     * (InventoryManager::reload) y reconstruye el conjunto. En otro caso no lee nada más.
+     *
+     * @return true si la base cambió y el inventario se recargó.
+     */
+    bool checkExternalChanges();
+
+    /**
+     * @brief Obtiene el número de componentes con stock bajo.
+     *
+     * @return Tamaño del conjunto.
+     */
+    std::size_t count() const;
+
+    /**
+     * @brief Obtiene el umbral de stock bajo.
+     *
+     * @return Cantidad máxima que se considera stock bajo.
+     */
+    int getThreshold() const;
+};
+
+#endif // LOWSTOCKMONITOR_H
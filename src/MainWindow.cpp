@@ -3,27 +3,49 @@
 #include <QHBoxLayout>
 #include <QFormLayout>
 #include <QHeaderView>
+#include <QItemSelectionModel>
 #include <QFileDialog>
 #include <QGroupBox>
 #include <QTextStream>
 #include <QDir>
 #include <QTimer>
+#include <QFileSystemWatcher>
 #include <QFileInfo>
 #include <QDialog>
+#include <QDateTime>
 #include <QLabel>
 #include <QComboBox>
 #include <QSpinBox>
+#include <QCheckBox>
+#include <QSettings>
 #include <QDialogButtonBox>
 #include <QDesktopServices>
 #include <QUrl>
 #include <QMessageBox>
+#include <QMetaObject>
 #include <iostream>
 #include <ctime>
 #include <algorithm>
+#include <string_view>
+#include <utility>
+#include "CompressionPipeline.h"
+#include "CronSchedule.h"
+#include "DateFormatter.h"
 #include "ReportGenerator.h"
 
+namespace {
+    // Clave de la preferencia de la alerta nocturna de stock bajo
+    const char* const NIGHTLY_ALERT_SETTING = "reportes/alerta_nocturna";
+
+    // Convierte una vista UTF-8 en QString sin pasar por un std::string intermedio
+    QString toQString(std::string_view text) {
+        return QString::fromUtf8(text.data(), static_cast<int>(text.size()));
+    }
+}
+
 MainWindow::MainWindow(QWidget *parent)
-    : QMainWindow(parent), selectedId(-1), dbManager(nullptr), inventoryManager(nullptr)
+    : QMainWindow(parent), dbManager(nullptr), inventoryManager(nullptr), selectedId(-1),
+      searchRunning(false), nightlySchedule(0)
 {
     // Inicializar managers
     dbManager = new DatabaseManager();
@@ -33,16 +55,50 @@ MainWindow::MainWindow(QWidget *parent)
     
     inventoryManager = new InventoryManager(dbManager);
     
+    // Los reportes se escriben en un hilo propio; sus eventos vuelven al hilo de la interfaz
+    reportScheduler = std::make_unique<ReportScheduler>(
+        [this]() { return inventoryManager->snapshot(); },
+        [this](const ReportScheduler::JobEvent& event) {
+            QMetaObject::invokeMethod(this, [this, event]() { onReportJobEvent(event); }, Qt::QueuedConnection);
+        });
+    
+    // El stock bajo se recalcula con cada escritura confirmada, no consultando cada cierto tiempo
+    lowStockMonitor = std::make_unique<LowStockMonitor>(inventoryManager,
+        [this](const LowStockMonitor::LowStockEvent& event) {
+            QMetaObject::invokeMethod(this, [this, event]() { onLowStockEvent(event); }, Qt::QueuedConnection);
+        });
+    
+    // La búsqueda mientras se escribe también corre en su propio hilo
+    liveSearch = std::make_unique<LiveSearch>(
+        [this]() { return inventoryManager->snapshot(); },
+        [this](LiveSearch::ResultPage page) {
+            QMetaObject::invokeMethod(this, [this, page = std::move(page)]() mutable {
+                onSearchPage(std::move(page));
+            }, Qt::QueuedConnection);
+        });
+    
     setupUI();
     loadComponents();
     
+    // La alerta nocturna solo se programa si el usuario la activó (queda guardada entre sesiones)
+    QSettings settings("GestorInventario", "GestorInventario");
+    nightlyAlertCheck->setChecked(settings.value(NIGHTLY_ALERT_SETTING, false).toBool());
+    
     // Conectar señales y slots
-    connect(tableWidget, &QTableWidget::itemSelectionChanged, 
+    connect(tableView->selectionModel(), &QItemSelectionModel::selectionChanged, 
             this, &MainWindow::onTableSelectionChanged);
+    // Al recargar la tabla se pierde la selección (el reinicio del modelo no lo notifica)
+    connect(tableModel, &QAbstractItemModel::modelReset, this, [this]() {
+        if (selectedId != -1) clearForm();
+    });
 }
 
 MainWindow::~MainWindow()
 {
+    // Detener los reportes y la búsqueda antes de destruir el inventario del que leen
+    reportScheduler.reset();
+    liveSearch.reset();
+    lowStockMonitor.reset();
     delete inventoryManager;
     delete dbManager;
 }
@@ -53,14 +109,17 @@ void MainWindow::setupUI()
     QWidget *centralWidget = new QWidget(this);
     QVBoxLayout *mainLayout = new QVBoxLayout(centralWidget);
     
-    // Crear tabla
-    tableWidget = new QTableWidget(this);
-    tableWidget->setColumnCount(6);
-    QStringList headers = {"ID", "Nombre", "Tipo", "Cantidad", "Ubicación", "Fecha Compra"};
-    tableWidget->setHorizontalHeaderLabels(headers);
-    tableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
-    tableWidget->setSelectionMode(QAbstractItemView::SingleSelection);
-    tableWidget->horizontalHeader()->setStretchLastSection(true);
+    // Crear tabla: la vista solo pide al modelo las filas visibles
+    tableModel = new InventoryTableModel(this);
+    tableView = new QTableView(this);
+    tableView->setModel(tableModel);
+    tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    tableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    tableView->horizontalHeader()->setStretchLastSection(true);
+    // El ancho de las columnas se calcula con una muestra de filas, no con todas
+    tableView->horizontalHeader()->setResizeContentsPrecision(InventoryTableModel::SIZE_SAMPLE_ROWS);
+    // Filas de alto fijo: la vista no mide cada fila para saber dónde está
+    tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
     
     // Formulario
     QGroupBox *formGroup = new QGroupBox("Componente", this);
@@ -105,7 +164,11 @@ void MainWindow::setupUI()
     updateButton = new QPushButton("Actualizar", this);
     deleteButton = new QPushButton("Eliminar", this);
     reportButton = new QPushButton("Generar Reporte", this);
+    cancelReportButton = new QPushButton("Cancelar Reporte", this);
+    cancelReportButton->setEnabled(false);
     QPushButton *clearButton = new QPushButton("Limpiar", this);
+    nightlyAlertCheck = new QCheckBox("Alerta nocturna de stock bajo", this);
+    nightlyAlertCheck->setToolTip("Genera cada noche a las 2:00 un reporte de stock bajo en ~/Reportes_Inventario");
     
     updateButton->setEnabled(false);
     deleteButton->setEnabled(false);
@@ -114,8 +177,10 @@ void MainWindow::setupUI()
     buttonLayout->addWidget(updateButton);
     buttonLayout->addWidget(deleteButton);
     buttonLayout->addWidget(reportButton);
+    buttonLayout->addWidget(cancelReportButton);
     buttonLayout->addWidget(clearButton);
     buttonLayout->addStretch();
+    buttonLayout->addWidget(nightlyAlertCheck);
     
     // Búsqueda
     QHBoxLayout *searchLayout = new QHBoxLayout();
@@ -129,6 +194,11 @@ void MainWindow::setupUI()
     searchLayout->addWidget(searchButton);
     searchLayout->addWidget(showAllButton);
     
+    // Buscar mientras se escribe, cuando el texto deja de cambiar un momento
+    searchTimer = new QTimer(this);
+    searchTimer->setSingleShot(true);
+    searchTimer->setInterval(SEARCH_DELAY_MS);
+    
     // Estado
     statusLabel = new QLabel("Listo", this);
     statusLabel->setStyleSheet("padding: 5px; background-color: #f0f0f0; border: 1px solid #ccc;");
@@ -138,15 +208,24 @@ void MainWindow::setupUI()
     connect(updateButton, &QPushButton::clicked, this, &MainWindow::updateComponent);
     connect(deleteButton, &QPushButton::clicked, this, &MainWindow::deleteComponent);
     connect(searchButton, &QPushButton::clicked, this, &MainWindow::searchComponents);
+    connect(searchEdit, &QLineEdit::returnPressed, this, &MainWindow::searchComponents);
+    connect(searchEdit, &QLineEdit::textChanged, searchTimer, QOverload<>::of(&QTimer::start));
+    connect(searchTimer, &QTimer::timeout, this, [this]() {
+        // Volver al mismo texto antes de que venza la espera no repite la búsqueda
+        if (searchEdit->text().toStdString() != activeKeyword) searchComponents();
+    });
     connect(showAllButton, &QPushButton::clicked, this, [this]() { 
         searchEdit->clear(); 
+        searchTimer->stop();
         loadComponents(); 
     });
     connect(reportButton, &QPushButton::clicked, this, &MainWindow::generateReport);
+    connect(cancelReportButton, &QPushButton::clicked, this, &MainWindow::cancelReports);
     connect(clearButton, &QPushButton::clicked, this, &MainWindow::clearForm);
+    connect(nightlyAlertCheck, &QCheckBox::toggled, this, &MainWindow::setNightlyAlert);
     
     // Agregar widgets al layout principal
-    mainLayout->addWidget(tableWidget);
+    mainLayout->addWidget(tableView);
     mainLayout->addWidget(formGroup);
     mainLayout->addLayout(buttonLayout);
     mainLayout->addLayout(searchLayout);
@@ -156,52 +235,39 @@ void MainWindow::setupUI()
     setWindowTitle("Gestor de Inventario - Hogar/Laboratorio");
     resize(900, 650);
     
-    // Verificar stock bajo periódicamente
-    QTimer *timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, &MainWindow::checkLowStock);
-    timer->start(30000); // Cada 30 segundos
+    // Cambios de otros procesos: el archivo de la base avisa al modificarse y solo entonces
+    // se consulta PRAGMA data_version (sin actividad mientras nadie escribe)
+    databaseWatcher = new QFileSystemWatcher(this);
+    externalCheckTimer = new QTimer(this);
+    externalCheckTimer->setSingleShot(true);
+    externalCheckTimer->setInterval(EXTERNAL_CHECK_DELAY_MS);
+    const QString databasePath = QString::fromStdString(dbManager->getDatabasePath());
+    if (!databasePath.isEmpty() && databasePath != ":memory:" && QFileInfo::exists(databasePath)) {
+        databaseWatcher->addPath(databasePath);
+    }
+    connect(databaseWatcher, &QFileSystemWatcher::fileChanged, externalCheckTimer, QOverload<>::of(&QTimer::start));
+    connect(externalCheckTimer, &QTimer::timeout, this, &MainWindow::checkExternalChanges);
+    
+    // Los avisos de stock bajo se agrupan para no mostrar más de uno por intervalo
+    lowStockNoticeTimer = new QTimer(this);
+    lowStockNoticeTimer->setSingleShot(true);
+    connect(lowStockNoticeTimer, &QTimer::timeout, this, &MainWindow::showLowStockNotice);
 }
 
 void MainWindow::loadComponents()
 {
-    tableWidget->setRowCount(0);
-    
-    auto components = inventoryManager->getAllComponents();
+    liveSearch->cancel();
+    searchRunning = false;
+    activeKeyword.clear();
+    activeQuery = ComponentQuery();
     
-    for (const auto& component : components) {
-        int row = tableWidget->rowCount();
-        tableWidget->insertRow(row);
-        
-        // ID
-        tableWidget->setItem(row, 0, new QTableWidgetItem(QString::number(component.getId())));
-        
-        // Nombre
-        QTableWidgetItem *nameItem = new QTableWidgetItem(QString::fromStdString(component.getName()));
-        tableWidget->setItem(row, 1, nameItem);
-        
-        // Tipo
-        tableWidget->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(component.getType())));
-        
-        // Cantidad con color para stock bajo
-        QTableWidgetItem *quantityItem = new QTableWidgetItem(QString::number(component.getQuantity()));
-        if (component.isLowStock()) {
-            quantityItem->setBackground(QColor(255, 200, 200));  // Rojo claro
-            quantityItem->setForeground(Qt::red);
-            nameItem->setForeground(Qt::red);  // También marcar el nombre
-        }
-        tableWidget->setItem(row, 3, quantityItem);
-        
-        // Ubicación
-        tableWidget->setItem(row, 4, new QTableWidgetItem(QString::fromStdString(component.getLocation())));
-        
-        // Fecha
-        tableWidget->setItem(row, 5, new QTableWidgetItem(QString::fromStdString(component.getPurchaseDateString())));
-    }
+    // El modelo apunta al snapshot directamente, sin copiar los componentes
+    tableModel->setSnapshot(inventoryManager->snapshot());
     
-    // Ajustar columnas al contenido
-    tableWidget->resizeColumnsToContents();
+    // Ajustar columnas al contenido de una muestra de filas (ver setResizeContentsPrecision)
+    tableView->resizeColumnsToContents();
     
-    statusLabel->setText(QString("Cargados %1 componentes").arg(components.size()));
+    statusLabel->setText(QString("Cargados %1 componentes").arg(tableModel->rowCount()));
     checkLowStock();
 }
 
@@ -219,9 +285,13 @@ void MainWindow::addComponent()
         return;
     }
     
-    if (inventoryManager->addComponent(component)) {
+    int newId = -1;
+    if (inventoryManager->addComponent(component, &newId)) {
+        // Se inserta solo la fila del nuevo, localizado por el ID que le asignó la base
+        std::shared_ptr<const InventorySnapshot> next = inventoryManager->snapshot();
+        const Component* added = next->findById(newId);
         clearForm();
-        loadComponents();
+        applyTableChange(next, nullptr, added);
         statusLabel->setText("Componente agregado exitosamente");
         statusLabel->setStyleSheet("padding: 5px; background-color: #d4edda; border: 1px solid #c3e6cb; color: #155724;");
     } else {
@@ -248,8 +318,19 @@ void MainWindow::updateComponent()
         return;
     }
     
+    // Valores que muestra la tabla antes del cambio, para ubicar la fila
+    QModelIndexList selectedRows = tableView->selectionModel()->selectedRows();
+    const Component* shown = selectedRows.isEmpty() ? nullptr : tableModel->componentAt(selectedRows.first().row());
+    const bool found = shown && shown->getId() == selectedId;
+    const Component previous = found ? *shown : Component();
+    
     if (inventoryManager->updateComponent(component)) {
-        loadComponents();
+        // La fila se actualiza o se mueve a su nueva posición; la selección la sigue
+        if (found) {
+            applyTableChange(inventoryManager->snapshot(), &previous, &component);
+        } else {
+            loadComponents();
+        }
         statusLabel->setText("Componente actualizado exitosamente");
         statusLabel->setStyleSheet("padding: 5px; background-color: #d4edda; border: 1px solid #c3e6cb; color: #155724;");
     } else {
@@ -269,9 +350,18 @@ void MainWindow::deleteComponent()
                                   QMessageBox::Yes | QMessageBox::No);
     
     if (reply == QMessageBox::Yes) {
+        QModelIndexList selectedRows = tableView->selectionModel()->selectedRows();
+        const Component* shown = selectedRows.isEmpty() ? nullptr : tableModel->componentAt(selectedRows.first().row());
+        const bool found = shown && shown->getId() == selectedId;
+        const Component previous = found ? *shown : Component();
+        
         if (inventoryManager->deleteComponent(selectedId)) {
             clearForm();
-            loadComponents();
+            if (found) {
+                applyTableChange(inventoryManager->snapshot(), &previous, nullptr);
+            } else {
+                loadComponents();
+            }
             statusLabel->setText("Componente eliminado exitosamente");
             statusLabel->setStyleSheet("padding: 5px; background-color: #d4edda; border: 1px solid #c3e6cb; color: #155724;");
         } else {
@@ -284,68 +374,82 @@ void MainWindow::deleteComponent()
 
 void MainWindow::searchComponents()
 {
+    searchTimer->stop();
     std::string keyword = searchEdit->text().toStdString();
     if (keyword.empty()) {
         loadComponents();
         return;
     }
     
-    tableWidget->setRowCount(0);
-    auto components = inventoryManager->searchComponents(keyword);
+    // La tabla sigue mostrando lo anterior hasta que llega la primera página
+    activeQuery = ComponentQuery().where(ComponentQuery::matchesKeyword(keyword));
+    liveSearch->search(activeQuery);
+    activeKeyword = std::move(keyword);
+    searchRunning = true;
     
-    for (const auto& component : components) {
-        int row = tableWidget->rowCount();
-        tableWidget->insertRow(row);
-        
-        tableWidget->setItem(row, 0, new QTableWidgetItem(QString::number(component.getId())));
-        
-        QTableWidgetItem *nameItem = new QTableWidgetItem(QString::fromStdString(component.getName()));
-        tableWidget->setItem(row, 1, nameItem);
-        
-        tableWidget->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(component.getType())));
-        
-        QTableWidgetItem *quantityItem = new QTableWidgetItem(QString::number(component.getQuantity()));
-        if (component.isLowStock()) {
-            quantityItem->setBackground(QColor(255, 200, 200));
-            quantityItem->setForeground(Qt::red);
-            nameItem->setForeground(Qt::red);
-        }
-        tableWidget->setItem(row, 3, quantityItem);
-        
-        tableWidget->setItem(row, 4, new QTableWidgetItem(QString::fromStdString(component.getLocation())));
-        tableWidget->setItem(row, 5, new QTableWidgetItem(QString::fromStdString(component.getPurchaseDateString())));
+    statusLabel->setText("Buscando...");
+    statusLabel->setStyleSheet("padding: 5px; background-color: #d1ecf1; border: 1px solid #bee5eb; color: #0c5460;");
+}
+
+void MainWindow::onSearchPage(LiveSearch::ResultPage page)
+{
+    // Página de una búsqueda ya sustituida o cancelada
+    if (page.generation != liveSearch->currentGeneration()) return;
+    
+    if (page.first) {
+        tableModel->setComponents(std::move(page.components));
+    } else {
+        tableModel->appendComponents(std::move(page.components));
     }
     
-    statusLabel->setText(QString("Encontrados %1 componentes").arg(components.size()));
-    statusLabel->setStyleSheet("padding: 5px; background-color: #d1ecf1; border: 1px solid #bee5eb; color: #0c5460;");
+    if (page.last) {
+        searchRunning = false;
+        statusLabel->setText(QString("Encontrados %1 componentes").arg(page.matched));
+    } else {
+        statusLabel->setText(QString("Buscando... %1 encontrados").arg(page.matched));
+    }
+}
+
+void MainWindow::applyTableChange(std::shared_ptr<const InventorySnapshot> next, const Component* previous,
+                                  const Component* current)
+{
+    if (searchRunning) {
+        // Las páginas que faltan saldrían del snapshot anterior: se repite la búsqueda
+        liveSearch->search(activeQuery);
+    } else {
+        tableModel->applyChange(std::move(next), previous, current && matchesSearch(*current) ? current : nullptr);
+    }
+    checkLowStock();
+}
+
+bool MainWindow::matchesSearch(const Component& component) const
+{
+    // La misma consulta que recorre LiveSearch
+    return activeQuery.matches(component);
 }
 
 void MainWindow::onTableSelectionChanged()
 {
-    QList<QTableWidgetItem*> selectedItems = tableWidget->selectedItems();
-    if (selectedItems.isEmpty()) {
+    QModelIndexList selectedRows = tableView->selectionModel()->selectedRows();
+    const Component* selected = selectedRows.isEmpty() ? nullptr : tableModel->componentAt(selectedRows.first().row());
+    if (!selected) {
         clearForm();
         return;
     }
     
-    int row = selectedItems.first()->row();
-    selectedId = tableWidget->item(row, 0)->text().toInt();
-    
-    // Buscar el componente por ID
-    auto components = inventoryManager->getAllComponents();
-    auto it = std::find_if(components.begin(), components.end(),
-                          [this](const Component& c) { return c.getId() == selectedId; });
+    selectedId = selected->getId();
     
-    if (it != components.end()) {
-        populateForm(*it);
+    // Buscar el componente por ID en el snapshot vigente
+    Component component;
+    if (inventoryManager->getComponent(selectedId, component)) {
+        populateForm(component);
     }
 }
 
 void MainWindow::generateReport()
 {
-    auto components = inventoryManager->getAllComponents();
-    
-    if (components.empty()) {
+    // El snapshot solo se consulta para saber si hay componentes
+    if (inventoryManager->snapshot()->empty()) {
         QMessageBox::information(this, "Información", 
                                  "No hay componentes para generar reporte.");
         return;
@@ -366,6 +470,14 @@ void MainWindow::generateReport()
     combo.addItem("📈 Reporte CSV");
     combo.addItem("📝 Reporte de Texto");
     combo.addItem("⚠️  Reporte de Stock Bajo (HTML)");
+    combo.addItem("📦 Paquete Completo (HTML, CSV, Texto y Stock Bajo)");
+    combo.addItem("📑 HTML Paginado (índice y páginas de 1000 componentes)");
+    combo.addItem("🏷️  HTML Paginado por Tipo");
+    combo.addItem("📍 HTML Paginado por Ubicación");
+    combo.addItem("🧾 Exportación JSON Lines (para análisis)");
+    combo.addItem("🗃️  Exportación Columnar Binaria (para análisis)");
+    combo.addItem("📄 Reporte Completo (PDF)");
+    combo.addItem("🔄 Reporte de Cambios (desde una fecha)");
     combo.setCurrentIndex(0);
     layout.addWidget(&combo);
     
@@ -382,10 +494,31 @@ void MainWindow::generateReport()
     thresholdLayout.addStretch();
     layout.addLayout(&thresholdLayout);
     
+    // Comienzo del periodo para el reporte de cambios
+    QHBoxLayout sinceLayout;
+    QLabel sinceLabel("Cambios desde:", &dialog);
+    QDateEdit sinceEdit(QDate::currentDate().addDays(-7), &dialog);
+    sinceEdit.setCalendarPopup(true);
+    sinceEdit.setDisplayFormat("dd/MM/yyyy");
+    sinceEdit.setEnabled(false);
+    
+    sinceLayout.addWidget(&sinceLabel);
+    sinceLayout.addWidget(&sinceEdit);
+    sinceLayout.addStretch();
+    layout.addLayout(&sinceLayout);
+    
+    // Limitar el reporte a los componentes de la búsqueda de la tabla
+    QCheckBox searchOnlyCheck(QString("Solo los componentes de la búsqueda \"%1\"")
+                                  .arg(QString::fromStdString(activeKeyword)), &dialog);
+    searchOnlyCheck.setEnabled(!activeKeyword.empty());
+    layout.addWidget(&searchOnlyCheck);
+    
     // Conectar para habilitar/deshabilitar umbral
     QObject::connect(&combo, QOverload<int>::of(&QComboBox::currentIndexChanged),
                      [&](int index) {
-                         thresholdSpin.setEnabled(index == 3); // Solo para reporte de stock bajo
+                         thresholdSpin.setEnabled(index == 3 || index == 4); // Solo para reportes con stock bajo
+                         sinceEdit.setEnabled(index == 11);
+                         searchOnlyCheck.setEnabled(!activeKeyword.empty() && index != 11); // Cambios: no filtra
                      });
     
     QDialogButtonBox buttons(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog);
@@ -402,6 +535,22 @@ void MainWindow::generateReport()
     QString defaultDir = QDir::homePath() + "/Reportes_Inventario/";
     QDir().mkpath(defaultDir);
     
+    const ComponentQuery::PredicatePtr rowFilter = searchOnlyCheck.isEnabled() && searchOnlyCheck.isChecked()
+        ? activeQuery.getFilter() : nullptr;
+    
+    if (combo.currentIndex() == 4) {
+        generateReportBundle(defaultDir, thresholdSpin.value(), rowFilter);
+        return;
+    }
+    
+    if (combo.currentIndex() >= 5 && combo.currentIndex() <= 7) {
+        const ReportGenerator::PageGrouping groupings[] = {ReportGenerator::PageGrouping::Fixed,
+                                                           ReportGenerator::PageGrouping::ByType,
+                                                           ReportGenerator::PageGrouping::ByLocation};
+        generatePagedReport(defaultDir + "reporte_paginado/", groupings[combo.currentIndex() - 5], rowFilter);
+        return;
+    }
+    
     QString defaultName;
     QString filter;
     
@@ -412,16 +561,41 @@ void MainWindow::generateReport()
             break;
         case 1:  // CSV
             defaultName = defaultDir + "reporte_inventario.csv";
-            filter = "Archivos CSV (*.csv)";
+            filter = "Archivos CSV (*.csv);;CSV comprimido con gzip (*.csv.gz)";
+            if (CompressionPipeline::isAvailable(CompressionPipeline::Codec::Zstd)) {
+                filter += ";;CSV comprimido con zstd (*.csv.zst)";
+            }
             break;
         case 2:  // Texto
             defaultName = defaultDir + "reporte_inventario.txt";
-            filter = "Archivos de Texto (*.txt)";
+            filter = "Archivos de Texto (*.txt);;Texto comprimido con gzip (*.txt.gz)";
+            if (CompressionPipeline::isAvailable(CompressionPipeline::Codec::Zstd)) {
+                filter += ";;Texto comprimido con zstd (*.txt.zst)";
+            }
             break;
         case 3:  // Stock bajo HTML
             defaultName = defaultDir + "alerta_stock_bajo.html";
             filter = "Archivos HTML (*.html *.htm)";
             break;
+        case 8:  // JSON Lines
+            defaultName = defaultDir + "inventario.jsonl";
+            filter = "Archivos JSON Lines (*.jsonl);;JSON Lines comprimido con gzip (*.jsonl.gz)";
+            if (CompressionPipeline::isAvailable(CompressionPipeline::Codec::Zstd)) {
+                filter += ";;JSON Lines comprimido con zstd (*.jsonl.zst)";
+            }
+            break;
+        case 9:  // Columnar binario
+            defaultName = defaultDir + "inventario.invsnap";
+            filter = "Snapshot columnar (*.invsnap)";
+            break;
+        case 10:  // PDF
+            defaultName = defaultDir + "reporte_inventario.pdf";
+            filter = "Documentos PDF (*.pdf)";
+            break;
+        case 11:  // Cambios
+            defaultName = defaultDir + "cambios_inventario.html";
+            filter = "Archivos HTML (*.html *.htm);;Archivos CSV (*.csv)";
+            break;
     }
     
     // Diálogo para guardar
@@ -434,81 +608,250 @@ void MainWindow::generateReport()
         return;
     }
     
-    bool success = false;
+    if (combo.currentIndex() == 11) {
+        generateChangeReport(fileName, sinceEdit.date());
+        return;
+    }
+    
     QString message;
+    ReportGenerator::ReportSink sink{ReportGenerator::ReportFormat::HTML, fileName.toStdString(), thresholdSpin.value()};
     
     // Generar reporte según tipo seleccionado
     switch (combo.currentIndex()) {
         case 0:  // HTML completo
-            success = ReportGenerator::generateHTMLReport(components, 
-                                                        fileName.toStdString());
             message = "Reporte HTML generado exitosamente";
             break;
             
         case 1:  // CSV
-            success = ReportGenerator::generateCSVReport(components, 
-                                                       fileName.toStdString());
+            sink.format = ReportGenerator::ReportFormat::CSV;
             message = "Reporte CSV generado exitosamente";
             break;
             
         case 2:  // Texto
-            success = ReportGenerator::generateTextReport(components, 
-                                                        fileName.toStdString());
+            sink.format = ReportGenerator::ReportFormat::Text;
             message = "Reporte de texto generado exitosamente";
             break;
             
         case 3:  // Stock bajo HTML
-            success = ReportGenerator::generateLowStockReport(components, 
-                                                            fileName.toStdString(), 
-                                                            thresholdSpin.value());
+            sink.format = ReportGenerator::ReportFormat::LowStock;
             message = "Reporte de stock bajo (HTML) generado exitosamente";
             break;
+            
+        case 8:  // JSON Lines
+            sink.format = ReportGenerator::ReportFormat::JSONLines;
+            message = "Exportación JSON Lines generada exitosamente";
+            break;
+            
+        case 9:  // Columnar binario
+            sink.format = ReportGenerator::ReportFormat::Columnar;
+            message = "Exportación columnar generada exitosamente";
+            break;
+            
+        case 10:  // PDF
+            sink.format = ReportGenerator::ReportFormat::PDF;
+            message = "Reporte PDF generado exitosamente";
+            break;
     }
     
-    if (success) {
-        QMessageBox::information(this, "Éxito", 
-                                 QString("%1\n\nArchivo: %2\n\nTotal de componentes: %3")
-                                 .arg(message)
-                                 .arg(fileName)
-                                 .arg(components.size()));
-        
-        statusLabel->setText(QString("✓ %1").arg(message));
-        statusLabel->setStyleSheet("padding: 5px; background-color: #d4edda; border: 1px solid #c3e6cb; color: #155724;");
+    // El reporte se escribe en segundo plano a partir del snapshot actual
+    ReportScheduler::ReportJob job;
+    job.description = message.toStdString();
+    job.sinks.push_back(sink);
+    job.filter = rowFilter;
+    
+    // El columnar es binario: no hay visor que abrir
+    QString openQuestion;
+    if (sink.format != ReportGenerator::ReportFormat::Columnar) {
+        openQuestion = "¿Desea abrir el reporte generado?";
+    }
+    submitReportJob(job, message, fileName, openQuestion);
+}
+
+void MainWindow::generateReportBundle(const QString& defaultDir, int threshold, ComponentQuery::PredicatePtr filter)
+{
+    QString directory = QFileDialog::getExistingDirectory(this, "Carpeta para el paquete de reportes", defaultDir);
+    if (directory.isEmpty()) {
+        return;
+    }
+    
+    QDir target(directory);
+    std::vector<ReportGenerator::ReportSink> sinks = {
+        {ReportGenerator::ReportFormat::HTML, target.filePath("reporte_inventario_completo.html").toStdString()},
+        {ReportGenerator::ReportFormat::CSV, target.filePath("reporte_inventario.csv").toStdString()},
+        {ReportGenerator::ReportFormat::Text, target.filePath("reporte_inventario.txt").toStdString()},
+        {ReportGenerator::ReportFormat::LowStock, target.filePath("alerta_stock_bajo.html").toStdString(), threshold}
+    };
+    
+    // Los cuatro reportes salen del mismo snapshot y se reemplazan juntos al terminar
+    ReportScheduler::ReportJob job;
+    job.description = "Paquete de reportes";
+    job.sinks = std::move(sinks);
+    job.filter = std::move(filter);
+    submitReportJob(job, "Paquete de reportes generado exitosamente", directory,
+                    "¿Desea abrir la carpeta de los reportes?");
+}
+
+void MainWindow::generateChangeReport(const QString& fileName, const QDate& since)
+{
+    ReportGenerator::ReportFormat format = fileName.endsWith(".csv", Qt::CaseInsensitive)
+        ? ReportGenerator::ReportFormat::CSV
+        : ReportGenerator::ReportFormat::HTML;
+    
+    // El registro de cambios se lee en segundo plano con una conexión propia; antes se
+    // confirman las escrituras que sigan encoladas para que entren en el periodo
+    inventoryManager->flushPendingWrites();
+    ReportScheduler::ReportJob job;
+    job.description = "Reporte de cambios";
+    job.changeSinks.push_back({format, fileName.toStdString()});
+    job.changeDatabase = dbManager->getDatabasePath();
+    job.changeSince = static_cast<std::time_t>(QDateTime(since, QTime(0, 0)).toSecsSinceEpoch());
+    job.changeUntil = std::time(nullptr) + 1;
+    submitReportJob(job, "Reporte de cambios generado exitosamente", fileName,
+                    "¿Desea abrir el reporte generado?");
+}
+
+void MainWindow::generatePagedReport(const QString& defaultDir, ReportGenerator::PageGrouping grouping,
+                                     ComponentQuery::PredicatePtr filter)
+{
+    QDir().mkpath(defaultDir);
+    QString directory = QFileDialog::getExistingDirectory(this, "Carpeta para el reporte paginado", defaultDir);
+    if (directory.isEmpty()) {
+        return;
+    }
+    
+    ReportScheduler::ReportJob job;
+    job.description = "Reporte HTML paginado";
+    job.pagedDirectory = directory.toStdString();
+    job.grouping = grouping;
+    job.filter = std::move(filter);
+    submitReportJob(job, "Reporte HTML paginado generado exitosamente", QDir(directory).filePath("index.html"),
+                    "¿Desea abrir el índice del reporte?");
+}
+
+void MainWindow::submitReportJob(const ReportScheduler::ReportJob& job, const QString& message,
+                                 const QString& path, const QString& openQuestion)
+{
+    // Si ya esperaba uno idéntico, el ID es el suyo y basta con un aviso al terminar
+    ReportScheduler::JobId id = reportScheduler->submit(job);
+    reportRequests[id] = {message, path, openQuestion};
+    cancelReportButton->setEnabled(true);
+}
+
+void MainWindow::cancelReports()
+{
+    // Los programados no están en reportRequests: siguen su curso
+    for (const auto& request : reportRequests) {
+        reportScheduler->cancel(request.first);
+    }
+}
+
+void MainWindow::setNightlyAlert(bool enabled)
+{
+    QSettings("GestorInventario", "GestorInventario").setValue(NIGHTLY_ALERT_SETTING, enabled);
+    
+    if (!enabled) {
+        if (nightlySchedule != 0) reportScheduler->removeSchedule(nightlySchedule);
+        nightlySchedule = 0;
+        return;
+    }
+    if (nightlySchedule != 0) return;
+    
+    // Alerta de stock bajo todas las noches a las 2:00
+    CronSchedule nightly;
+    if (!CronSchedule::parse("0 2 * * *", nightly)) return;
+    QString defaultDir = QDir::homePath() + "/Reportes_Inventario/";
+    QDir().mkpath(defaultDir);
+    ReportScheduler::ReportJob nightlyJob;
+    nightlyJob.description = "Alerta nocturna de stock bajo";
+    nightlyJob.sinks.push_back({ReportGenerator::ReportFormat::LowStock,
+                                (defaultDir + "alerta_stock_bajo_nocturna.html").toStdString()});
+    // Cada noche se reescriben solo las filas que cambiaron desde la anterior
+    nightlyJob.incremental = true;
+    nightlySchedule = reportScheduler->addSchedule(nightly, nightlyJob);
+}
+
+void MainWindow::onReportJobEvent(const ReportScheduler::JobEvent& event)
+{
+    auto request = reportRequests.find(event.id);
+    const bool interactive = request != reportRequests.end();
+    const QString description = QString::fromStdString(event.description);
+    
+    switch (event.state) {
+        case ReportScheduler::JobState::Queued:
+            statusLabel->setText(QString("⏳ %1: en cola").arg(description));
+            statusLabel->setStyleSheet("padding: 5px; background-color: #d1ecf1; border: 1px solid #bee5eb; color: #0c5460;");
+            return;
+            
+        case ReportScheduler::JobState::Running: {
+            int percent = event.rowsTotal > 0 ? static_cast<int>(event.rowsDone * 100 / event.rowsTotal) : 0;
+            statusLabel->setText(QString("⏳ %1: %2 de %3 filas (%4%)")
+                                 .arg(description)
+                                 .arg(event.rowsDone)
+                                 .arg(event.rowsTotal)
+                                 .arg(percent));
+            statusLabel->setStyleSheet("padding: 5px; background-color: #d1ecf1; border: 1px solid #bee5eb; color: #0c5460;");
+            return;
+        }
         
-        // Preguntar si abrir el archivo
-        QMessageBox::StandardButton openFile = QMessageBox::question(this, "Abrir Reporte",
-                                                                     "¿Desea abrir el reporte generado?",
-                                                                     QMessageBox::Yes | QMessageBox::No);
+        default:
+            break;
+    }
+    
+    ReportRequest finished;
+    if (interactive) {
+        finished = request->second;
+        reportRequests.erase(request);
+    }
+    cancelReportButton->setEnabled(!reportRequests.empty());
+    
+    if (event.state == ReportScheduler::JobState::Cancelled) {
+        statusLabel->setText(QString("%1: cancelado").arg(description));
+        statusLabel->setStyleSheet("padding: 5px; background-color: #f0f0f0; border: 1px solid #ccc;");
         
-        if (openFile == QMessageBox::Yes) {
-            QDesktopServices::openUrl(QUrl::fromLocalFile(fileName));
+    } else if (event.state == ReportScheduler::JobState::Failed) {
+        statusLabel->setText(QString("✗ Error al generar: %1").arg(description));
+        statusLabel->setStyleSheet("padding: 5px; background-color: #f8d7da; border: 1px solid #f5c6cb; color: #721c24;");
+        if (interactive) {
+            QMessageBox::critical(this, "Error", 
+                                  "No se pudo generar el reporte.\n"
+                                  "Verifique los permisos de escritura o espacio en disco.");
         }
         
+    } else if (!interactive) {
+        // Los programados solo se anuncian en la barra de estado
+        statusLabel->setText(QString("✓ %1 generado").arg(description));
+        statusLabel->setStyleSheet("padding: 5px; background-color: #d4edda; border: 1px solid #c3e6cb; color: #155724;");
+        
     } else {
-        QMessageBox::critical(this, "Error", 
-                              "No se pudo generar el reporte.\n"
-                              "Verifique los permisos de escritura o espacio en disco.");
-        statusLabel->setText("✗ Error al generar reporte");
-        statusLabel->setStyleSheet("padding: 5px; background-color: #f8d7da; border: 1px solid #f5c6cb; color: #721c24;");
+        statusLabel->setText(QString("✓ %1").arg(finished.message));
+        statusLabel->setStyleSheet("padding: 5px; background-color: #d4edda; border: 1px solid #c3e6cb; color: #155724;");
+        
+        if (finished.openQuestion.isEmpty()) {
+            QMessageBox::information(this, "Éxito", 
+                                     QString("%1\n\nArchivo: %2").arg(finished.message).arg(finished.path));
+        } else {
+            QMessageBox::StandardButton openFile = QMessageBox::question(this, "Abrir Reporte",
+                                                                         QString("%1\n\n%2\n\n%3")
+                                                                         .arg(finished.message)
+                                                                         .arg(finished.path)
+                                                                         .arg(finished.openQuestion),
+                                                                         QMessageBox::Yes | QMessageBox::No);
+            
+            if (openFile == QMessageBox::Yes) {
+                QDesktopServices::openUrl(QUrl::fromLocalFile(finished.path));
+            }
+        }
     }
 }
 
 void MainWindow::checkLowStock()
 {
-    auto lowStock = inventoryManager->getLowStockComponents();
-    if (!lowStock.empty()) {
-        QString warningText = QString("¡ATENCIÓN! Hay %1 componentes con stock bajo").arg(lowStock.size());
+    // El monitor mantiene la cuenta al día: leerla no recorre el inventario
+    std::size_t lowStockCount = lowStockMonitor->count();
+    if (lowStockCount > 0) {
+        QString warningText = QString("¡ATENCIÓN! Hay %1 componentes con stock bajo").arg(lowStockCount);
         statusLabel->setText(warningText);
         statusLabel->setStyleSheet("padding: 5px; background-color: #fff3cd; border: 1px solid #ffeaa7; color: #856404; font-weight: bold;");
-        
-        // Mostrar notificación ocasionalmente
-        static int notificationCount = 0;
-        if (notificationCount % 10 == 0) { // Cada 5 minutos aproximadamente
-            QMessageBox::warning(this, "Stock Bajo", 
-                                QString("Hay %1 componentes con stock bajo.\nRevise el inventario.")
-                                .arg(lowStock.size()));
-        }
-        notificationCount++;
     } else {
         // Restaurar estilo normal si no hay stock bajo
         if (!statusLabel->text().contains("Error") && 
@@ -519,6 +862,73 @@ void MainWindow::checkLowStock()
     }
 }
 
+void MainWindow::onLowStockEvent(const LowStockMonitor::LowStockEvent& event)
+{
+    for (int id : event.left) pendingLowStock.erase(id);
+    for (const Component& component : event.entered) pendingLowStock[component.getId()] = component;
+    checkLowStock();
+    
+    // Solo se avisa de componentes que acaban de quedar con stock bajo
+    if (pendingLowStock.empty()) {
+        lowStockNoticeTimer->stop();
+        return;
+    }
+    
+    const qint64 elapsed = lowStockNoticeClock.isValid() ? lowStockNoticeClock.elapsed() : LOW_STOCK_NOTICE_INTERVAL_MS;
+    if (elapsed >= LOW_STOCK_NOTICE_INTERVAL_MS) {
+        showLowStockNotice();
+    } else if (!lowStockNoticeTimer->isActive()) {
+        lowStockNoticeTimer->start(static_cast<int>(LOW_STOCK_NOTICE_INTERVAL_MS - elapsed));
+    }
+}
+
+void MainWindow::showLowStockNotice()
+{
+    if (pendingLowStock.empty()) return;
+    
+    QString text = QString("%1 componentes han quedado con stock bajo:\n").arg(pendingLowStock.size());
+    int listed = 0;
+    for (const auto& entry : pendingLowStock) {
+        if (listed++ == LOW_STOCK_NOTICE_ROWS) {
+            text += QString("... y %1 más\n").arg(pendingLowStock.size() - LOW_STOCK_NOTICE_ROWS);
+            break;
+        }
+        text += QString("• %1 (%2)\n").arg(toQString(entry.second.getName())).arg(entry.second.getQuantity());
+    }
+    text += QString("\nTotal con stock bajo: %1. Revise el inventario.").arg(lowStockMonitor->count());
+    pendingLowStock.clear();
+    lowStockNoticeClock.restart();
+    
+    // Un solo aviso no modal: si sigue abierto se actualiza en lugar de abrir otro
+    if (!lowStockNotice) {
+        lowStockNotice = new QMessageBox(QMessageBox::Warning, "Stock Bajo", QString(), QMessageBox::Ok, this);
+        lowStockNotice->setWindowModality(Qt::NonModal);
+        lowStockNotice->setAttribute(Qt::WA_DeleteOnClose);
+    }
+    lowStockNotice->setText(text);
+    lowStockNotice->show();
+    lowStockNotice->raise();
+}
+
+void MainWindow::checkExternalChanges()
+{
+    // Hay sistemas que dejan de vigilar un archivo después de ciertos cambios
+    const QString databasePath = QString::fromStdString(dbManager->getDatabasePath());
+    if (databaseWatcher->files().isEmpty() && QFileInfo::exists(databasePath)) {
+        databaseWatcher->addPath(databasePath);
+    }
+    
+    // Las escrituras propias también tocan el archivo, pero no cambian data_version
+    if (!lowStockMonitor->checkExternalChanges()) return;
+    
+    if (activeKeyword.empty()) {
+        loadComponents();
+    } else {
+        liveSearch->search(activeQuery);
+        searchRunning = true;
+    }
+}
+
 void MainWindow::clearForm()
 {
     nameEdit->clear();
@@ -531,31 +941,31 @@ void MainWindow::clearForm()
     deleteButton->setEnabled(false);
     
     // Deseleccionar en la tabla
-    tableWidget->clearSelection();
+    tableView->clearSelection();
 }
 
 void MainWindow::populateForm(const Component& component)
 {
-    nameEdit->setText(QString::fromStdString(component.getName()));
+    nameEdit->setText(toQString(component.getName()));
     
     // Buscar el tipo en el combo
-    int index = typeCombo->findText(QString::fromStdString(component.getType()));
+    int index = typeCombo->findText(toQString(component.getType()));
     if (index != -1) {
         typeCombo->setCurrentIndex(index);
     } else {
         // Si el tipo no está en la lista, agregarlo temporalmente
-        typeCombo->addItem(QString::fromStdString(component.getType()));
-        typeCombo->setCurrentText(QString::fromStdString(component.getType()));
+        typeCombo->addItem(toQString(component.getType()));
+        typeCombo->setCurrentText(toQString(component.getType()));
     }
     
     quantitySpin->setValue(component.getQuantity());
-    locationEdit->setText(QString::fromStdString(component.getLocation()));
+    locationEdit->setText(toQString(component.getLocation()));
     
     // Convertir time_t a QDate
     std::time_t purchaseTime = component.getPurchaseDate();
     if (purchaseTime > 0) {
-        std::tm* timeInfo = std::localtime(&purchaseTime);
-        QDate date(timeInfo->tm_year + 1900, timeInfo->tm_mon + 1, timeInfo->tm_mday);
+        DateFormatter::CivilTime local = DateFormatter::toLocal(purchaseTime);
+        QDate date(local.year, local.month, local.day);
         dateEdit->setDate(date);
     }
     
@@ -589,5 +999,5 @@ Component MainWindow::getFormData() const
     
     std::time_t purchaseDate = std::mktime(&timeInfo);
     
-    return Component(selectedId, nameStr, typeStr, quantitySpin->value(), locationStr, purchaseDate);
+    return Component(selectedId, std::move(nameStr), typeStr, quantitySpin->value(), locationStr, purchaseDate);
 }
\ No newline at end of file
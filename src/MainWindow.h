@@ -2,20 +2,32 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
-#include <QTableWidget>
+#include <QTableView>
 #include <QPushButton>
 #include <QLineEdit>
 #include <QSpinBox>
 #include <QDateEdit>
 #include <QLabel>
 #include <QComboBox>
+#include <QCheckBox>
 #include <QMessageBox>
 #include <QGroupBox>
 #include <QTimer>
+#include <QFileSystemWatcher>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <map>
+#include <memory>
+#include <string>
 
 #include "Component.h"
 #include "DatabaseManager.h"
 #include "InventoryManager.h"
+#include "InventoryTableModel.h"
+#include "LiveSearch.h"
+#include "LowStockMonitor.h"
+#include "ReportGenerator.h"
+#include "ReportScheduler.h"
 
 /**
  * @class MainWindow
@@ -68,9 +80,11 @@ private slots:
     void deleteComponent();
 
     /**
-     * @brief Slot que se ejecuta cuando se presiona el botón de buscar.
+     * @brief Slot que se ejecuta cuando se presiona el botón de buscar, Intro en el campo
+     * de búsqueda o cuando el texto deja de cambiar.
      * 
-     * Busca componentes en el inventario según el texto ingresado.
+     * Pide la búsqueda en segundo plano (sustituyendo a la anterior); los resultados
+     * llegan por páginas a onSearchPage.
      */
     void searchComponents();
 
@@ -89,12 +103,35 @@ private slots:
     void generateReport();
 
     /**
-     * @brief Slot que verifica si hay componentes con bajo stock.
+     * @brief Slot que se ejecuta cuando se presiona el botón de cancelar reporte.
      * 
-     * Muestra una alerta si se detectan componentes con bajo stock.
+     * Cancela los reportes pedidos desde la interfaz que estén en cola o en curso
+     * (los programados siguen su curso).
+     */
+    void cancelReports();
+
+    /**
+     * @brief Slot que muestra en la barra de estado cuántos componentes tienen stock bajo.
+     * 
+     * La cuenta la mantiene LowStockMonitor, así que no recorre el inventario.
      */
     void checkLowStock();
 
+    /**
+     * @brief Slot que muestra el aviso no modal con los componentes que han quedado con stock bajo.
+     * 
+     * Si el aviso sigue abierto se actualiza en lugar de abrir otro.
+     */
+    void showLowStockNotice();
+
+    /**
+     * @brief Slot que comprueba si otro proceso modificó la base de datos.
+     * 
+     * Se ejecuta cuando cambia el archivo de la base; si cambió PRAGMA data_version,
+     * recarga el inventario y la tabla.
+     */
+    void checkExternalChanges();
+
 private:
     /**
      * @brief Configura la interfaz gráfica de la ventana principal.
@@ -106,6 +143,44 @@ private:
      */
     void loadComponents();
 
+    /**
+     * @brief Refleja un cambio del conjunto de stock bajo (en el hilo de la interfaz).
+     * 
+     * Actualiza la cuenta y avisa de los componentes nuevos con stock bajo, como mucho una
+     * vez cada LOW_STOCK_NOTICE_INTERVAL_MS (los que llegan antes se agrupan en el siguiente).
+     * 
+     * @param event Cambio del conjunto.
+     */
+    void onLowStockEvent(const LowStockMonitor::LowStockEvent& event);
+
+    /**
+     * @brief Muestra una página de resultados de la búsqueda (en el hilo de la interfaz).
+     * 
+     * @param page Página de resultados; se ignora si su búsqueda ya fue sustituida.
+     */
+    void onSearchPage(LiveSearch::ResultPage page);
+
+    /**
+     * @brief Refleja en la tabla el cambio de un componente hecho desde la ventana.
+     * 
+     * Si hay una búsqueda en curso se repite sobre el snapshot nuevo; si no, solo se
+     * actualiza la fila afectada (InventoryTableModel::applyChange).
+     * 
+     * @param next Snapshot con el cambio ya aplicado.
+     * @param previous Valores que mostraba la tabla, o nullptr si el componente es nuevo.
+     * @param current Valores nuevos, o nullptr si se eliminó.
+     */
+    void applyTableChange(std::shared_ptr<const InventorySnapshot> next, const Component* previous,
+                          const Component* current);
+
+    /**
+     * @brief Indica si un componente debe mostrarse con la búsqueda activa.
+     * 
+     * @param component Componente a comprobar.
+     * @return true si no hay búsqueda activa o si el componente coincide con ella.
+     */
+    bool matchesSearch(const Component& component) const;
+
     /**
      * @brief Limpia los campos del formulario.
      */
@@ -125,8 +200,74 @@ private:
      */
     Component getFormData() const;
 
+    /**
+     * @brief Genera los cuatro reportes (HTML, CSV, texto y stock bajo) en una carpeta.
+     *
+     * @param defaultDir Carpeta propuesta en el diálogo.
+     * @param threshold Umbral para el reporte de stock bajo.
+     * @param filter Solo los componentes que lo cumplen (nullptr = todos).
+     */
+    void generateReportBundle(const QString& defaultDir, int threshold, ComponentQuery::PredicatePtr filter);
+
+    /**
+     * @brief Genera el reporte HTML paginado (índice y páginas) en una carpeta.
+     *
+     * @param defaultDir Carpeta propuesta en el diálogo (se crea si no existe).
+     * @param grouping Criterio de reparto en páginas.
+     * @param filter Solo los componentes que lo cumplen (nullptr = todos).
+     */
+    void generatePagedReport(const QString& defaultDir, ReportGenerator::PageGrouping grouping,
+                             ComponentQuery::PredicatePtr filter);
+
+    /**
+     * @brief Encola el reporte de cambios desde una fecha hasta ahora.
+     *
+     * @param fileName Archivo del reporte (CSV si termina en .csv, HTML en otro caso).
+     * @param since Primer día del periodo (desde las 00:00).
+     */
+    void generateChangeReport(const QString& fileName, const QDate& since);
+
+    /**
+     * @brief Encola un trabajo de reporte pedido desde la interfaz.
+     *
+     * @param job Trabajo a encolar.
+     * @param message Mensaje a mostrar cuando termine.
+     * @param path Archivo o carpeta resultante, para mostrarlo y ofrecer abrirlo.
+     * @param openQuestion Pregunta para ofrecer abrir path (vacía para no preguntar).
+     */
+    void submitReportJob(const ReportScheduler::ReportJob& job, const QString& message,
+                         const QString& path, const QString& openQuestion);
+
+    /**
+     * @brief Muestra el progreso o el resultado de un trabajo de reporte (en el hilo de la interfaz).
+     *
+     * @param event Evento del planificador.
+     */
+    void onReportJobEvent(const ReportScheduler::JobEvent& event);
+
+    /**
+     * @brief Activa o desactiva la alerta nocturna de stock bajo y guarda la preferencia.
+     * 
+     * Activada, el planificador genera cada día a las 2:00 un reporte de stock bajo en
+     * ~/Reportes_Inventario. Por defecto está desactivada.
+     * 
+     * @param enabled true para programar la alerta, false para quitarla.
+     */
+    void setNightlyAlert(bool enabled);
+
+    /**
+     * @brief Datos de un reporte pedido desde la interfaz, para cuando termine.
+     */
+    struct ReportRequest
+    {
+        QString message; /**< Mensaje de éxito. */
+        QString path; /**< Archivo o carpeta resultante. */
+        QString openQuestion; /**< Pregunta para abrir path (vacía para no preguntar). */
+    };
+
     // Widgets
-    QTableWidget *tableWidget; /**< Tabla para mostrar los componentes del inventario. */
+    QTableView *tableView; /**< Tabla para mostrar los componentes del inventario. */
+    InventoryTableModel *tableModel; /**< Modelo de la tabla: entrega solo las filas visibles. */
     QLineEdit *nameEdit; /**< Campo de texto para ingresar el nombre del componente. */
     QComboBox *typeCombo; /**< ComboBox para seleccionar el tipo del componente. */
     QSpinBox *quantitySpin; /**< Campo para ingresar la cantidad del componente. */
@@ -138,14 +279,36 @@ private:
     QPushButton *deleteButton; /**< Botón para eliminar el componente seleccionado. */
     QPushButton *searchButton; /**< Botón para buscar componentes en el inventario. */
     QPushButton *reportButton; /**< Botón para generar un reporte de los componentes. */
+    QPushButton *cancelReportButton; /**< Botón para cancelar los reportes en curso. */
+    QCheckBox *nightlyAlertCheck; /**< Activa la alerta nocturna de stock bajo. */
     QLineEdit *searchEdit; /**< Campo de texto para buscar componentes. */
+    QTimer *searchTimer; /**< Espera a que el texto de búsqueda deje de cambiar. */
+    QFileSystemWatcher *databaseWatcher; /**< Avisa cuando se modifica el archivo de la base. */
+    QTimer *externalCheckTimer; /**< Agrupa los avisos de databaseWatcher antes de comprobar la base. */
+    QTimer *lowStockNoticeTimer; /**< Muestra el aviso de stock bajo aplazado por el límite de frecuencia. */
+    QPointer<QMessageBox> lowStockNotice; /**< Aviso de stock bajo abierto, si lo hay. */
+    QElapsedTimer lowStockNoticeClock; /**< Tiempo desde el último aviso de stock bajo. */
     
     QLabel *statusLabel; /**< Etiqueta para mostrar el estado de la aplicación. */
 
     // Managers
     DatabaseManager *dbManager; /**< Gestor de la base de datos para manejar los componentes. */
     InventoryManager *inventoryManager; /**< Gestor del inventario para manejar los componentes. */
+    std::unique_ptr<ReportScheduler> reportScheduler; /**< Genera los reportes en segundo plano. */
+    std::unique_ptr<LiveSearch> liveSearch; /**< Busca en segundo plano mientras se escribe. */
+    std::unique_ptr<LowStockMonitor> lowStockMonitor; /**< Mantiene el conjunto de componentes con stock bajo. */
+    std::map<int, Component> pendingLowStock; /**< Componentes con stock bajo nuevo aún sin avisar. */
+    std::map<ReportScheduler::JobId, ReportRequest> reportRequests; /**< Reportes pedidos desde la interfaz aún sin terminar. */
     int selectedId; /**< ID del componente actualmente seleccionado en la tabla. */
+    std::string activeKeyword; /**< Texto de la búsqueda mostrada en la tabla (vacío si se muestran todos). */
+    ComponentQuery activeQuery; /**< Consulta de la búsqueda mostrada en la tabla (sin filtro si se muestran todos). */
+    bool searchRunning; /**< Aún faltan páginas de la búsqueda activa. */
+    ReportScheduler::ScheduleId nightlySchedule; /**< Programación de la alerta nocturna (0 si está desactivada). */
+    
+    static constexpr int SEARCH_DELAY_MS = 250; /**< Pausa al escribir tras la que se busca. */
+    static constexpr int EXTERNAL_CHECK_DELAY_MS = 500; /**< Espera tras modificarse el archivo de la base. */
+    static constexpr qint64 LOW_STOCK_NOTICE_INTERVAL_MS = 60000; /**< Tiempo mínimo entre avisos de stock bajo. */
+    static constexpr int LOW_STOCK_NOTICE_ROWS = 10; /**< Componentes que se nombran en un aviso. */
 };
 
 #endif // MAINWINDOW_H
\ No newline at end of file
@@ -0,0 +1,415 @@
+#include "OutputBuffer.h"
+#include <algorithm>
+#include <charconv>
+#include <vector>
+#include "DateFormatter.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define OUTPUTBUFFER_SSE2 1
+#if defined(__GNUC__) || defined(__clang__)
+#include <immintrin.h>
+#define OUTPUTBUFFER_AVX2 1
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#ifndef _WIN32
+#include <cerrno>
+#include <climits>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    std::atomic<OutputBuffer::ScanKernel> scanKernel(OutputBuffer::ScanKernel::Auto);
+
+    // Kernels de búsqueda para el escapado: devuelven la posición del primer byte igual a
+    // alguno de los cuatro de needles, o size si no hay ninguno. CSV repite la comilla.
+    const char HTML_SPECIAL[4] = {'&', '<', '>', '"'};
+    const char CSV_SPECIAL[4] = {'"', '"', '"', '"'};
+
+    std::size_t findSpecialScalar(const char* data, std::size_t size, const char* needles) {
+        for (std::size_t i = 0; i < size; ++i) {
+            const char c = data[i];
+            if (c == needles[0] || c == needles[1] || c == needles[2] || c == needles[3]) return i;
+        }
+        return size;
+    }
+
+#if defined(OUTPUTBUFFER_SSE2)
+    unsigned firstSetBit(unsigned bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctz(bits));
+#else
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return static_cast<unsigned>(index);
+#endif
+    }
+
+    std::size_t findSpecialSse2(const char* data, std::size_t size, const char* needles) {
+        const __m128i a = _mm_set1_epi8(needles[0]);
+        const __m128i b = _mm_set1_epi8(needles[1]);
+        const __m128i c = _mm_set1_epi8(needles[2]);
+        const __m128i d = _mm_set1_epi8(needles[3]);
+        std::size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, a), _mm_cmpeq_epi8(v, b)),
+                                        _mm_or_si128(_mm_cmpeq_epi8(v, c), _mm_cmpeq_epi8(v, d)));
+            unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(hits));
+            if (bits) return i + firstSetBit(bits);
+        }
+        return i + findSpecialScalar(data + i, size - i, needles);
+    }
+#endif
+
+#if defined(OUTPUTBUFFER_AVX2)
+    bool cpuHasAvx2() {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    __attribute__((target("avx2")))
+    std::size_t findSpecialAvx2(const char* data, std::size_t size, const char* needles) {
+        const __m256i a = _mm256_set1_epi8(needles[0]);
+        const __m256i b = _mm256_set1_epi8(needles[1]);
+        const __m256i c = _mm256_set1_epi8(needles[2]);
+        const __m256i d = _mm256_set1_epi8(needles[3]);
+        std::size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, a), _mm256_cmpeq_epi8(v, b)),
+                                           _mm256_or_si256(_mm256_cmpeq_epi8(v, c), _mm256_cmpeq_epi8(v, d)));
+            unsigned bits = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+            if (bits) return i + firstSetBit(bits);
+        }
+        // El resto (menos de 32 bytes) todavía aprovecha un bloque de 16. Se hace aquí y no
+        // llamando a findSpecialSse2 para no mezclar instrucciones SSE con AVX
+        if (i + 16 <= size) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i hits = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm256_castsi256_si128(a)), _mm_cmpeq_epi8(v, _mm256_castsi256_si128(b))),
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm256_castsi256_si128(c)), _mm_cmpeq_epi8(v, _mm256_castsi256_si128(d))));
+            unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(hits));
+            if (bits) return i + firstSetBit(bits);
+            i += 16;
+        }
+        return i + findSpecialScalar(data + i, size - i, needles);
+    }
+#endif
+
+    // JSON: comilla, barra invertida y caracteres de control (< 0x20)
+    bool isJSONSpecial(char c) {
+        return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+    }
+
+    std::size_t findJSONSpecial(const char* data, std::size_t size) {
+        std::size_t i = 0;
+#if defined(OUTPUTBUFFER_SSE2)
+        const std::size_t vectorEnd = scanKernel.load(std::memory_order_relaxed) == OutputBuffer::ScanKernel::Scalar ? 0 : size;
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i lastControl = _mm_set1_epi8(0x1F);
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= vectorEnd; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            // v - 0x1F con saturación sin signo es cero justo para los bytes de control
+            __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                        _mm_cmpeq_epi8(_mm_subs_epu8(v, lastControl), zero));
+            unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(hits));
+            if (bits) return i + firstSetBit(bits);
+        }
+#endif
+        for (; i < size; ++i) {
+            if (isJSONSpecial(data[i])) return i;
+        }
+        return size;
+    }
+
+    std::size_t findSpecial(const char* data, std::size_t size, const char* needles) {
+        switch (scanKernel.load(std::memory_order_relaxed)) {
+            case OutputBuffer::ScanKernel::Scalar:
+                return findSpecialScalar(data, size, needles);
+#if defined(OUTPUTBUFFER_SSE2)
+            case OutputBuffer::ScanKernel::Sse2:
+                return findSpecialSse2(data, size, needles);
+#endif
+            default:
+                break;
+        }
+#if defined(OUTPUTBUFFER_AVX2)
+        if (cpuHasAvx2()) return findSpecialAvx2(data, size, needles);
+#endif
+#if defined(OUTPUTBUFFER_SSE2)
+        return findSpecialSse2(data, size, needles);
+#else
+        return findSpecialScalar(data, size, needles);
+#endif
+    }
+}
+
+bool OutputBuffer::setScanKernel(ScanKernel kernel) {
+    switch (kernel) {
+        case ScanKernel::Sse2:
+#if defined(OUTPUTBUFFER_SSE2)
+            break;
+#else
+            return false;
+#endif
+        case ScanKernel::Avx2:
+#if defined(OUTPUTBUFFER_AVX2)
+            if (!cpuHasAvx2()) return false;
+            break;
+#else
+            return false;
+#endif
+        default:
+            break;
+    }
+    scanKernel.store(kernel);
+    return true;
+}
+
+OutputBuffer::ScanKernel OutputBuffer::getScanKernel() {
+    return scanKernel.load();
+}
+
+OutputBuffer::OutputBuffer(std::size_t capacity)
+    : file(nullptr), data(new char[std::max<std::size_t>(capacity, 64)]),
+      capacity(std::max<std::size_t>(capacity, 64)), used(0), flushed(0), failed(false) {}
+
+OutputBuffer::~OutputBuffer() {
+    close();
+}
+
+bool OutputBuffer::open(const std::string& path, bool binary) {
+    close();
+    file = std::fopen(path.c_str(), binary ? "wb" : "w");
+    if (!file) return false;
+    // El búfer propio ya agrupa las escrituras; el de stdio solo añadiría una copia
+    std::setvbuf(file, nullptr, _IONBF, 0);
+    used = 0;
+    flushed = 0;
+    failed = false;
+    return true;
+}
+
+bool OutputBuffer::openCompressed(const std::string& path, CompressionPipeline::Codec codec) {
+    close();
+    auto compressed = std::make_unique<CompressionPipeline>();
+    if (!compressed->open(path, codec, capacity)) return false;
+    pipeline = std::move(compressed);
+    used = 0;
+    flushed = 0;
+    failed = false;
+    return true;
+}
+
+bool OutputBuffer::close() {
+    if (pipeline) {
+        drain();
+        if (!pipeline->close()) failed = true;
+        pipeline.reset();
+        return !failed;
+    }
+    if (!file) return !failed;
+    drain();
+    if (std::fclose(file) != 0) failed = true;
+    file = nullptr;
+    return !failed;
+}
+
+void OutputBuffer::drain() {
+    if (used > 0 && pipeline) {
+        // El búfer lleno pasa al hilo compresor y se sigue escribiendo en otro
+        data = pipeline->exchange(std::move(data), used);
+    } else if (used > 0 && file && !failed) {
+        if (std::fwrite(data.get(), 1, used, file) != used) failed = true;
+    }
+    flushed += used;
+    used = 0;
+}
+
+void OutputBuffer::makeRoom(std::size_t size) {
+    if (pipeline) {
+        // Los búferes se intercambian con el hilo compresor y deben medir capacity; las
+        // escrituras grandes van por writeSlow y claim nunca pide más que la capacidad mínima
+        drain();
+        return;
+    }
+    if (file) {
+        drain();
+        if (size <= capacity) return;
+    }
+    std::size_t newCapacity = std::max(capacity * 2, used + size);
+    std::unique_ptr<char[]> grown(new char[newCapacity]);
+    std::memcpy(grown.get(), data.get(), used);
+    data = std::move(grown);
+    capacity = newCapacity;
+}
+
+void OutputBuffer::writeSlow(std::string_view text) {
+    if (pipeline) {
+        // Todo pasa por el búfer: se llena y se entrega tantas veces como haga falta
+        while (!text.empty()) {
+            if (used == capacity) drain();
+            const std::size_t part = std::min(text.size(), capacity - used);
+            std::memcpy(data.get() + used, text.data(), part);
+            used += part;
+            text.remove_prefix(part);
+        }
+        return;
+    }
+    if (!file) {
+        makeRoom(text.size());
+        std::memcpy(data.get() + used, text.data(), text.size());
+        used += text.size();
+        return;
+    }
+    drain();
+    if (text.size() < capacity) {
+        std::memcpy(data.get(), text.data(), text.size());
+        used = text.size();
+    } else {
+        // Bloques mayores que el búfer van directos al archivo
+        if (!failed && std::fwrite(text.data(), 1, text.size(), file) != text.size()) failed = true;
+        flushed += text.size();
+    }
+}
+
+void OutputBuffer::writeInteger(long long value) {
+    char* out = claim(24);
+    commit(static_cast<std::size_t>(std::to_chars(out, out + 24, value).ptr - out));
+}
+
+void OutputBuffer::writeUnsigned(unsigned long long value) {
+    char* out = claim(24);
+    commit(static_cast<std::size_t>(std::to_chars(out, out + 24, value).ptr - out));
+}
+
+void OutputBuffer::writeDate(std::time_t time) {
+    char* out = claim(DateFormatter::DATE_LENGTH);
+    commit(DateFormatter::formatDate(time, out));
+}
+
+void OutputBuffer::writeEscapedHTML(std::string_view text) {
+    // Los tramos sin caracteres especiales se copian de una vez; sin ninguno, es una sola copia
+    std::size_t position = 0;
+    for (;;) {
+        const std::size_t special = position + findSpecial(text.data() + position, text.size() - position,
+                                                           HTML_SPECIAL);
+        write(text.substr(position, special - position));
+        if (special == text.size()) return;
+
+        switch (text[special]) {
+            case '&': write("&amp;"); break;
+            case '<': write("&lt;"); break;
+            case '>': write("&gt;"); break;
+            default: write("&quot;"); break;
+        }
+        position = special + 1;
+    }
+}
+
+void OutputBuffer::writeEscapedCSV(std::string_view text) {
+    std::size_t position = 0;
+    for (;;) {
+        const std::size_t quote = position + findSpecial(text.data() + position, text.size() - position,
+                                                         CSV_SPECIAL);
+        if (quote == text.size()) {
+            write(text.substr(position));
+            return;
+        }
+        // Escribir hasta la comilla incluida y duplicarla
+        write(text.substr(position, quote + 1 - position));
+        put('"');
+        position = quote + 1;
+    }
+}
+
+void OutputBuffer::writeEscapedJSON(std::string_view text) {
+    std::size_t position = 0;
+    for (;;) {
+        const std::size_t special = position + findJSONSpecial(text.data() + position, text.size() - position);
+        write(text.substr(position, special - position));
+        if (special == text.size()) return;
+
+        switch (text[special]) {
+            case '"': write("\\\""); break;
+            case '\\': write("\\\\"); break;
+            case '\n': write("\\n"); break;
+            case '\r': write("\\r"); break;
+            case '\t': write("\\t"); break;
+            default: {
+                // El resto de caracteres de control como \u00XX
+                static const char HEX[] = "0123456789abcdef";
+                const unsigned char c = static_cast<unsigned char>(text[special]);
+                char* out = claim(6);
+                std::memcpy(out, "\\u00", 4);
+                out[4] = HEX[c >> 4];
+                out[5] = HEX[c & 0x0F];
+                commit(6);
+                break;
+            }
+        }
+        position = special + 1;
+    }
+}
+
+void OutputBuffer::writeBlocks(const std::string_view* blocks, std::size_t count) {
+    if (!file) {
+        // En memoria o comprimido, los bloques se copian al búfer
+        for (std::size_t i = 0; i < count; ++i) write(blocks[i]);
+        return;
+    }
+    drain();
+    for (std::size_t i = 0; i < count; ++i) flushed += blocks[i].size();
+    if (failed) return;
+
+#ifdef _WIN32
+    // Sin writev; fwrite mantiene además la traducción de fin de línea del modo texto
+    for (std::size_t i = 0; i < count; ++i) {
+        if (std::fwrite(blocks[i].data(), 1, blocks[i].size(), file) != blocks[i].size()) {
+            failed = true;
+            return;
+        }
+    }
+#else
+    // El FILE no tiene búfer propio (_IONBF), así que escribir en su descriptor no lo desordena
+    const int fd = fileno(file);
+    std::vector<iovec> vectors;
+    vectors.reserve(std::min<std::size_t>(count, IOV_MAX));
+
+    std::size_t next = 0;
+    while (next < count) {
+        vectors.clear();
+        for (; next < count && vectors.size() < IOV_MAX; ++next) {
+            if (blocks[next].empty()) continue;
+            vectors.push_back({const_cast<char*>(blocks[next].data()), blocks[next].size()});
+        }
+
+        // writev puede escribir menos de lo pedido: avanzar sobre los bloques ya escritos
+        std::size_t first = 0;
+        while (first < vectors.size()) {
+            ssize_t written = ::writev(fd, vectors.data() + first, static_cast<int>(vectors.size() - first));
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                failed = true;
+                return;
+            }
+            std::size_t remaining = static_cast<std::size_t>(written);
+            while (first < vectors.size() && remaining >= vectors[first].iov_len) {
+                remaining -= vectors[first].iov_len;
+                ++first;
+            }
+            if (remaining > 0) {
+                vectors[first].iov_base = static_cast<char*>(vectors[first].iov_base) + remaining;
+                vectors[first].iov_len -= remaining;
+            }
+        }
+    }
+#endif
+}
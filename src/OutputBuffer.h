@@ -0,0 +1,253 @@
+#ifndef OUTPUTBUFFER_H
+#define OUTPUTBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "CompressionPipeline.h"
+
+/**
+ * @class OutputBuffer
+ * @brief Escritor de archivos con un búfer grande en espacio de usuario.
+ *
+ * Sustituye a std::ofstream en la generación de reportes: cada escritura es una copia
+ * a memoria (sin formateo dependiente del locale ni llamadas virtuales) y el archivo
+ * recibe bloques grandes con fwrite. Los enteros se formatean con std::to_chars y el
+ * escapado HTML/CSV se hace directamente sobre el búfer.
+ *
+ * El archivo se abre en modo texto, igual que std::ofstream por defecto, para que la
+ * salida sea idéntica byte a byte en todas las plataformas.
+ *
+ * Sin archivo abierto el búfer trabaja en memoria: crece según haga falta y su contenido
+ * se obtiene con view(). Así se renderizan trozos de un reporte en paralelo para luego
+ * escribirlos en orden con writeBlocks().
+ *
+ * Con openCompressed() cada búfer lleno pasa a un CompressionPipeline, que lo comprime y
+ * escribe en su propio hilo mientras se sigue formateando sobre otro búfer.
+ */
+class OutputBuffer
+{
+private:
+    std::FILE* file; /**< Archivo de destino (nullptr si está cerrado o comprimido). */
+    std::unique_ptr<CompressionPipeline> pipeline; /**< Destino comprimido (nullptr si no lo hay). */
+    std::unique_ptr<char[]> data; /**< Búfer de salida. */
+    std::size_t capacity; /**< Tamaño del búfer. */
+    std::size_t used; /**< Bytes pendientes de escribir. */
+    std::uint64_t flushed; /**< Bytes ya entregados al archivo. */
+    bool failed; /**< true si alguna escritura al archivo falló. */
+
+    /**
+     * @brief Vuelca el contenido del búfer al archivo.
+     */
+    void drain();
+
+    /**
+     * @brief Deja al menos size bytes libres: vuelca al archivo o, en memoria, amplía el búfer.
+     *
+     * @param size Bytes necesarios.
+     */
+    void makeRoom(std::size_t size);
+
+    /**
+     * @brief Escribe un texto que no cabe en el espacio libre del búfer.
+     *
+     * @param text Texto a escribir.
+     */
+    void writeSlow(std::string_view text);
+
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 1 << 20; /**< 1 MiB. */
+
+    /**
+     * @brief Implementación de la búsqueda de caracteres a escapar.
+     */
+    enum class ScanKernel
+    {
+        Auto, /**< La más rápida disponible: AVX2, SSE2 o escalar. */
+        Scalar, /**< Byte a byte. */
+        Sse2, /**< 16 bytes por paso. */
+        Avx2 /**< 32 bytes por paso. */
+    };
+
+    /**
+     * @brief Elige la implementación de la búsqueda para todos los búferes.
+     *
+     * La salida es la misma con cualquiera de ellas; existe para poder comparar las
+     * implementaciones entre sí (pruebas y mediciones).
+     *
+     * @param kernel Implementación a usar (por defecto Auto).
+     * @return false si no está disponible en esta compilación o en esta CPU (no cambia nada).
+     */
+    static bool setScanKernel(ScanKernel kernel);
+
+    /**
+     * @brief Obtiene la implementación de la búsqueda elegida.
+     * @return Implementación actual.
+     */
+    static ScanKernel getScanKernel();
+
+    /**
+     * @brief Constructor.
+     *
+     * @param capacity Tamaño del búfer en bytes (mínimo 64).
+     */
+    explicit OutputBuffer(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Destructor. Vuelca y cierra el archivo si sigue abierto.
+     */
+    ~OutputBuffer();
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    /**
+     * @brief Abre (o trunca) un archivo para escribir.
+     *
+     * @param path Ruta del archivo.
+     * @param binary Si es true el archivo se abre en modo binario (sin traducir los finales
+     *        de línea en Windows), de modo que position() coincide con la posición en disco.
+     * @return true si el archivo se abrió, false en caso contrario.
+     */
+    bool open(const std::string& path, bool binary = false);
+
+    /**
+     * @brief Crea (o trunca) un archivo comprimido para escribir.
+     *
+     * La compresión y la escritura se hacen en un hilo aparte (ver CompressionPipeline).
+     *
+     * @param path Ruta del archivo.
+     * @param codec Formato de compresión.
+     * @return true si el archivo se abrió, false en caso contrario.
+     */
+    bool openCompressed(const std::string& path, CompressionPipeline::Codec codec);
+
+    /**
+     * @brief Vuelca lo pendiente y cierra el archivo.
+     *
+     * @return true si todo el contenido llegó al archivo, false si hubo algún error.
+     */
+    bool close();
+
+    /**
+     * @brief Indica si hay un archivo abierto.
+     * @return true si está abierto.
+     */
+    bool isOpen() const { return file != nullptr || pipeline != nullptr; }
+
+    /**
+     * @brief Obtiene el número de bytes escritos desde que se abrió el archivo o se vació el búfer.
+     * @return Bytes escritos (sin comprimir), incluidos los que aún están en el búfer.
+     */
+    std::uint64_t position() const { return flushed + used; }
+
+    /**
+     * @brief Obtiene el contenido aún no volcado (todo lo escrito, si no hay archivo).
+     * @return Vista válida hasta la siguiente escritura.
+     */
+    std::string_view view() const { return std::string_view(data.get(), used); }
+
+    /**
+     * @brief Descarta el contenido aún no volcado, conservando la capacidad.
+     */
+    void clear() {
+        used = 0;
+        flushed = 0;
+    }
+
+    /**
+     * @brief Escribe varios bloques seguidos, en orden.
+     *
+     * Con archivo abierto, vuelca lo pendiente y envía los bloques con una sola llamada
+     * writev por tanda, sin copiarlos al búfer. Con archivo comprimido se copian al búfer.
+     *
+     * @param blocks Bloques a escribir.
+     * @param count Número de bloques.
+     */
+    void writeBlocks(const std::string_view* blocks, std::size_t count);
+
+    /**
+     * @brief Escribe un texto tal cual.
+     * @param text Texto a escribir.
+     */
+    void write(std::string_view text) {
+        if (text.size() <= capacity - used) {
+            std::memcpy(data.get() + used, text.data(), text.size());
+            used += text.size();
+        } else {
+            writeSlow(text);
+        }
+    }
+
+    /**
+     * @brief Escribe un carácter.
+     * @param c Carácter a escribir.
+     */
+    void put(char c) {
+        if (used == capacity) makeRoom(1);
+        data[used++] = c;
+    }
+
+    /**
+     * @brief Obtiene espacio contiguo en el búfer para escribir directamente.
+     *
+     * Después de escribir hay que llamar a commit con los bytes usados.
+     *
+     * @param size Bytes necesarios.
+     * @return Puntero al espacio reservado.
+     */
+    char* claim(std::size_t size) {
+        if (size > capacity - used) makeRoom(size);
+        return data.get() + used;
+    }
+
+    /**
+     * @brief Confirma los bytes escritos tras claim.
+     * @param size Bytes escritos.
+     */
+    void commit(std::size_t size) { used += size; }
+
+    /**
+     * @brief Escribe un entero con signo en decimal.
+     * @param value Valor a escribir.
+     */
+    void writeInteger(long long value);
+
+    /**
+     * @brief Escribe un entero sin signo en decimal.
+     * @param value Valor a escribir.
+     */
+    void writeUnsigned(unsigned long long value);
+
+    /**
+     * @brief Escribe una fecha local como "YYYY-MM-DD".
+     * @param time Instante a escribir.
+     */
+    void writeDate(std::time_t time);
+
+    /**
+     * @brief Escribe un texto escapando &, <, > y " para HTML.
+     * @param text Texto a escribir.
+     */
+    void writeEscapedHTML(std::string_view text);
+
+    /**
+     * @brief Escribe un texto duplicando las comillas dobles para CSV.
+     * @param text Texto a escribir.
+     */
+    void writeEscapedCSV(std::string_view text);
+
+    /**
+     * @brief Escribe un texto como contenido de una cadena JSON (sin las comillas externas).
+     * @param text Texto a escribir (UTF-8; los bytes no ASCII se copian tal cual).
+     */
+    void writeEscapedJSON(std::string_view text);
+};
+
+#endif // OUTPUTBUFFER_H
@@ -0,0 +1,355 @@
+#include "PdfReportWriter.h"
+#include <ctime>
+#include <iostream>
+#include <zlib.h>
+#include "DateFormatter.h"
+
+namespace {
+    const int MARGIN = 36;
+    const int FONT_SIZE = 8;
+    const int TITLE_SIZE = 14;
+    const int LINE_HEIGHT = 11;
+    const double GLYPH_WIDTH = 0.6 * FONT_SIZE; // Courier: 600 milésimas de em por carácter
+
+    // Líneas base de la cabecera de cada página
+    const int TITLE_Y = 806;
+    const int GENERATED_Y = 792;
+    const int SUMMARY_Y = 770;
+    const int FIRST_TABLE_Y = 724; // Primera página: debajo del resumen
+    const int TABLE_Y = 770;
+    const int BOTTOM_Y = 40; // Ninguna fila por debajo de esta línea
+    const int FOOTER_Y = 20;
+
+    // Anchos de columna en caracteres; entre columnas va un espacio
+    const std::size_t ID_WIDTH = 7;
+    const std::size_t NAME_WIDTH = 30;
+    const std::size_t TYPE_WIDTH = 16;
+    const std::size_t QUANTITY_WIDTH = 8;
+    const std::size_t LOCATION_WIDTH = 18;
+    const std::size_t DATE_WIDTH = 10;
+    const std::size_t STATUS_WIDTH = 10;
+    const std::size_t TABLE_CHARS = ID_WIDTH + NAME_WIDTH + TYPE_WIDTH + QUANTITY_WIDTH + LOCATION_WIDTH +
+                                    DATE_WIDTH + STATUS_WIDTH + 6;
+
+    const std::uint32_t PAGES_OBJECT = 2; // Se escribe al final, con todas las páginas
+    const std::size_t XREF_ENTRY_SIZE = 20;
+    const char ELLIPSIS = '\x85'; // "…" en WinAnsi
+
+    /**
+     * Lee el siguiente carácter UTF-8 de text a partir de position y lo devuelve en
+     * WinAnsi. Latin-1 se conserva, algunos signos tipográficos tienen su propio código
+     * y el resto (o una secuencia inválida) se convierte en '?'.
+     */
+    char nextWinAnsi(std::string_view text, std::size_t& position) {
+        const unsigned char first = static_cast<unsigned char>(text[position++]);
+        if (first < 0x80) return first < 0x20 || first == 0x7F ? ' ' : static_cast<char>(first);
+
+        std::size_t extra = first >= 0xF0 ? 3 : first >= 0xE0 ? 2 : first >= 0xC0 ? 1 : 0;
+        if (extra == 0) return '?';
+        std::uint32_t codePoint = first & (0x3F >> extra);
+        for (; extra > 0; --extra) {
+            if (position == text.size() || (static_cast<unsigned char>(text[position]) & 0xC0) != 0x80) return '?';
+            codePoint = (codePoint << 6) | (static_cast<unsigned char>(text[position++]) & 0x3F);
+        }
+
+        if (codePoint >= 0xA0 && codePoint <= 0xFF) return static_cast<char>(codePoint);
+        switch (codePoint) {
+            case 0x20AC: return '\x80'; // €
+            case 0x2026: return ELLIPSIS;
+            case 0x2018: return '\x91';
+            case 0x2019: return '\x92';
+            case 0x201C: return '\x93';
+            case 0x201D: return '\x94';
+            case 0x2013: return '\x96';
+            case 0x2014: return '\x97';
+            default: return '?';
+        }
+    }
+
+    // Convierte un texto completo de UTF-8 a WinAnsi
+    std::string toWinAnsi(std::string_view text) {
+        std::string converted;
+        for (std::size_t position = 0; position < text.size();) converted.push_back(nextWinAnsi(text, position));
+        return converted;
+    }
+}
+
+PdfReportWriter::PdfReportWriter(OutputBuffer& out)
+    : out(out), xref(nullptr), page(16 * 1024), objectCount(0), pageCount(0), rowsOnPage(0), rowCount(0),
+      failed(false) {}
+
+PdfReportWriter::~PdfReportWriter() {
+    if (xref) std::fclose(xref);
+}
+
+bool PdfReportWriter::begin(std::size_t componentCount, long long totalQuantity, std::size_t lowStockCount) {
+    xref = std::tmpfile();
+    if (!xref) {
+        std::cerr << "No se pudo crear el archivo temporal del PDF" << std::endl;
+        return false;
+    }
+
+    char generatedText[DateFormatter::DATE_TIME_LENGTH];
+    generated.assign(generatedText, DateFormatter::formatDateTime(std::time(nullptr), generatedText));
+
+    // El comentario binario indica a las herramientas de transferencia que el archivo no es texto
+    out.write("%PDF-1.4\n%\xE2\xE3\xCF\xD3\n");
+
+    beginObject();
+    out.write("<< /Type /Catalog /Pages 2 0 R >>\nendobj\n");
+
+    // El árbol de páginas se escribe al final: su entrada se completa entonces
+    writeXrefEntry(0);
+    ++objectCount;
+
+    beginObject();
+    out.write("<< /Type /Font /Subtype /Type1 /BaseFont /Courier /Encoding /WinAnsiEncoding >>\nendobj\n");
+    beginObject();
+    out.write("<< /Type /Font /Subtype /Type1 /BaseFont /Courier-Bold /Encoding /WinAnsiEncoding >>\nendobj\n");
+
+    // Fecha de creación en el formato de PDF: D:AAAAMMDDHHmmSS
+    std::string creationDate = "D:";
+    for (char c : generated) {
+        if (c >= '0' && c <= '9') creationDate.push_back(c);
+    }
+    beginObject();
+    out.write("<< /Title (Reporte de Inventario) /Producer (Gestor de Inventario) /CreationDate (");
+    out.write(creationDate);
+    out.write(") >>\nendobj\n");
+
+    beginPage(componentCount, totalQuantity, lowStockCount);
+    return !failed;
+}
+
+void PdfReportWriter::addRow(const Component& component) {
+    if (rowsOnPage == pageCapacity()) {
+        finishPage();
+        beginPage(0, 0, 0);
+    }
+
+    const int baseline = rowBaseline(rowsOnPage);
+    const bool lowStock = component.isLowStock();
+    if (lowStock) {
+        // Fondo rojo claro y texto rojo oscuro, como la fila resaltada del reporte HTML
+        page.write("1 0.92 0.92 rg ");
+        page.writeInteger(MARGIN);
+        page.put(' ');
+        page.writeInteger(baseline - 3);
+        page.put(' ');
+        page.writeInteger(static_cast<long long>(TABLE_CHARS * GLYPH_WIDTH + 0.5));
+        page.put(' ');
+        page.writeInteger(LINE_HEIGHT);
+        page.write(" re f\n0.7 0 0 rg\n");
+    }
+
+    line.clear();
+    char number[24];
+    appendCell(std::string_view(number, std::snprintf(number, sizeof(number), "%d", component.getId())), ID_WIDTH);
+    line.push_back(' ');
+    appendCell(component.getName(), NAME_WIDTH);
+    line.push_back(' ');
+    appendCell(component.getType(), TYPE_WIDTH);
+    line.push_back(' ');
+    appendCell(std::string_view(number, std::snprintf(number, sizeof(number), "%d", component.getQuantity())),
+               QUANTITY_WIDTH, true);
+    line.push_back(' ');
+    appendCell(component.getLocation(), LOCATION_WIDTH);
+    line.push_back(' ');
+    if (component.getPurchaseDate() == 0) {
+        appendCell("No date", DATE_WIDTH);
+    } else {
+        appendCell(std::string_view(number, DateFormatter::formatDate(component.getPurchaseDate(), number)), DATE_WIDTH);
+    }
+    line.push_back(' ');
+    appendCell(lowStock ? "STOCK BAJO" : "OK", STATUS_WIDTH);
+
+    writeText(MARGIN, baseline, "F1", FONT_SIZE, line);
+    if (lowStock) page.write("0 g\n");
+    ++rowsOnPage;
+    ++rowCount;
+}
+
+bool PdfReportWriter::finish() {
+    if (!xref) return false;
+    if (rowCount == 0) {
+        writeText(MARGIN, rowBaseline(0), "F1", FONT_SIZE, "No hay componentes en el inventario.");
+    }
+    finishPage();
+
+    // Árbol de páginas: los números de objeto de las páginas se deducen de su posición
+    const std::uint64_t pagesOffset = out.position();
+    if (std::fseek(xref, static_cast<long>((PAGES_OBJECT - 1) * XREF_ENTRY_SIZE), SEEK_SET) != 0) failed = true;
+    writeXrefEntry(pagesOffset);
+    if (std::fseek(xref, 0, SEEK_END) != 0) failed = true;
+
+    out.write("2 0 obj\n<< /Type /Pages /Count ");
+    out.writeUnsigned(pageCount);
+    out.write("\n/Kids [");
+    for (std::size_t i = 0; i < pageCount; ++i) {
+        out.write(i % 10 == 0 ? "\n" : " ");
+        out.writeUnsigned(FIRST_PAGE_OBJECT + 2 * i);
+        out.write(" 0 R");
+    }
+    out.write("\n] >>\nendobj\n");
+
+    // Tabla xref: la entrada libre del objeto 0 y después las del archivo temporal, en orden
+    const std::uint64_t xrefOffset = out.position();
+    out.write("xref\n0 ");
+    out.writeUnsigned(objectCount + 1);
+    out.write("\n0000000000 65535 f \n");
+    std::rewind(xref);
+    std::vector<char> chunk(64 * 1024);
+    std::size_t copied = 0;
+    for (;;) {
+        const std::size_t read = std::fread(chunk.data(), 1, chunk.size(), xref);
+        if (read == 0) break;
+        out.write(std::string_view(chunk.data(), read));
+        copied += read;
+    }
+    if (std::ferror(xref) || copied != objectCount * XREF_ENTRY_SIZE) failed = true;
+
+    out.write("trailer\n<< /Size ");
+    out.writeUnsigned(objectCount + 1);
+    out.write(" /Root 1 0 R /Info 5 0 R >>\nstartxref\n");
+    out.writeUnsigned(xrefOffset);
+    out.write("\n%%EOF\n");
+
+    std::fclose(xref);
+    xref = nullptr;
+    return !failed;
+}
+
+std::uint32_t PdfReportWriter::beginObject() {
+    writeXrefEntry(out.position());
+    const std::uint32_t number = ++objectCount;
+    out.writeUnsigned(number);
+    out.write(" 0 obj\n");
+    return number;
+}
+
+void PdfReportWriter::writeXrefEntry(std::uint64_t offset) {
+    char entry[XREF_ENTRY_SIZE + 1];
+    std::snprintf(entry, sizeof(entry), "%010llu 00000 n \n", static_cast<unsigned long long>(offset));
+    if (std::fwrite(entry, 1, XREF_ENTRY_SIZE, xref) != XREF_ENTRY_SIZE) failed = true;
+}
+
+void PdfReportWriter::beginPage(std::size_t componentCount, long long totalQuantity, std::size_t lowStockCount) {
+    ++pageCount;
+    rowsOnPage = 0;
+    page.clear();
+
+    writeText(MARGIN, TITLE_Y, "F2", TITLE_SIZE, toWinAnsi("Reporte de Inventario"));
+    const std::string pageLabel = toWinAnsi("Página " + std::to_string(pageCount));
+    writeText(PAGE_WIDTH - MARGIN - static_cast<int>(pageLabel.size() * GLYPH_WIDTH), TITLE_Y, "F1", FONT_SIZE, pageLabel);
+    writeText(MARGIN, GENERATED_Y, "F1", FONT_SIZE, "Generado: " + generated);
+
+    if (pageCount == 1) {
+        writeText(MARGIN, SUMMARY_Y, "F2", FONT_SIZE, "Total de componentes: " + std::to_string(componentCount));
+        writeText(MARGIN, SUMMARY_Y - LINE_HEIGHT, "F2", FONT_SIZE, "Cantidad total: " + std::to_string(totalQuantity));
+        writeText(MARGIN, SUMMARY_Y - 2 * LINE_HEIGHT, "F2", FONT_SIZE,
+                  "Componentes con stock bajo: " + std::to_string(lowStockCount));
+    }
+
+    // Cabecera de la tabla sobre fondo gris
+    const int tableY = pageCount == 1 ? FIRST_TABLE_Y : TABLE_Y;
+    page.write("0.85 g ");
+    page.writeInteger(MARGIN);
+    page.put(' ');
+    page.writeInteger(tableY - 3);
+    page.put(' ');
+    page.writeInteger(static_cast<long long>(TABLE_CHARS * GLYPH_WIDTH + 0.5));
+    page.put(' ');
+    page.writeInteger(LINE_HEIGHT);
+    page.write(" re f\n0 g\n");
+
+    line.clear();
+    appendCell("ID", ID_WIDTH);
+    line.push_back(' ');
+    appendCell("Nombre", NAME_WIDTH);
+    line.push_back(' ');
+    appendCell("Tipo", TYPE_WIDTH);
+    line.push_back(' ');
+    appendCell("Cantidad", QUANTITY_WIDTH, true);
+    line.push_back(' ');
+    appendCell("Ubicación", LOCATION_WIDTH);
+    line.push_back(' ');
+    appendCell("Fecha", DATE_WIDTH);
+    line.push_back(' ');
+    appendCell("Estado", STATUS_WIDTH);
+    writeText(MARGIN, tableY, "F2", FONT_SIZE, line);
+}
+
+void PdfReportWriter::finishPage() {
+    writeText(MARGIN, FOOTER_Y, "F1", FONT_SIZE,
+              toWinAnsi("Gestor de Inventario - Página " + std::to_string(pageCount)));
+
+    const std::string_view content = page.view();
+    uLongf compressedSize = compressBound(static_cast<uLong>(content.size()));
+    compressed.resize(compressedSize);
+    if (compress2(compressed.data(), &compressedSize, reinterpret_cast<const Bytef*>(content.data()),
+                  static_cast<uLong>(content.size()), Z_BEST_SPEED) != Z_OK) {
+        failed = true;
+        compressedSize = 0;
+    }
+
+    const std::uint32_t pageObject = beginObject();
+    out.write("<< /Type /Page /Parent 2 0 R /MediaBox [0 0 ");
+    out.writeInteger(PAGE_WIDTH);
+    out.put(' ');
+    out.writeInteger(PAGE_HEIGHT);
+    out.write("]\n/Resources << /Font << /F1 3 0 R /F2 4 0 R >> >>\n/Contents ");
+    out.writeUnsigned(pageObject + 1);
+    out.write(" 0 R >>\nendobj\n");
+
+    beginObject();
+    out.write("<< /Length ");
+    out.writeUnsigned(compressedSize);
+    out.write(" /Filter /FlateDecode >>\nstream\n");
+    out.write(std::string_view(reinterpret_cast<const char*>(compressed.data()), compressedSize));
+    out.write("\nendstream\nendobj\n");
+}
+
+void PdfReportWriter::writeText(int x, int y, std::string_view font, int size, std::string_view text) {
+    page.write("BT /");
+    page.write(font);
+    page.put(' ');
+    page.writeInteger(size);
+    page.write(" Tf ");
+    page.writeInteger(x);
+    page.put(' ');
+    page.writeInteger(y);
+    page.write(" Td (");
+    for (char c : text) {
+        if (c == '(' || c == ')' || c == '\\') page.put('\\');
+        page.put(c);
+    }
+    page.write(") Tj ET\n");
+}
+
+void PdfReportWriter::appendCell(std::string_view text, std::size_t width, bool alignRight) {
+    // En WinAnsi cada carácter ocupa un byte: la longitud es el ancho en Courier
+    const std::size_t start = line.size();
+    for (std::size_t position = 0; position < text.size() && line.size() - start <= width;) {
+        line.push_back(nextWinAnsi(text, position));
+    }
+
+    const std::size_t length = line.size() - start;
+    if (length > width) {
+        line.resize(start + width - 1);
+        line.push_back(ELLIPSIS);
+    } else if (alignRight) {
+        line.insert(start, width - length, ' ');
+    } else {
+        line.append(width - length, ' ');
+    }
+}
+
+int PdfReportWriter::rowBaseline(std::size_t row) const {
+    const int tableY = pageCount == 1 ? FIRST_TABLE_Y : TABLE_Y;
+    return tableY - static_cast<int>(row + 1) * LINE_HEIGHT;
+}
+
+std::size_t PdfReportWriter::pageCapacity() const {
+    const int tableY = pageCount == 1 ? FIRST_TABLE_Y : TABLE_Y;
+    return static_cast<std::size_t>((tableY - BOTTOM_Y) / LINE_HEIGHT);
+}
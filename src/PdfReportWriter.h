@@ -0,0 +1,155 @@
+#ifndef PDFREPORTWRITER_H
+#define PDFREPORTWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Component.h"
+#include "OutputBuffer.h"
+
+/**
+ * @class PdfReportWriter
+ * @brief Escribe el reporte de inventario en PDF a medida que llegan los componentes.
+ *
+ * Cada página se escribe (con su contenido comprimido con zlib) en cuanto se llena, así
+ * que en memoria solo está la página en curso. La tabla usa las fuentes Courier y
+ * Courier-Bold, que todo visor de PDF trae incorporadas: al ser de ancho fijo, cada
+ * columna es un número fijo de caracteres y no hace falta medir texto.
+ *
+ * Los números de objeto se conocen de antemano (la página i usa FIRST_PAGE_OBJECT + 2i y
+ * su contenido el siguiente), por lo que el árbol de páginas se escribe al final sin
+ * recordar nada. Las entradas de la tabla xref, de 20 bytes cada una, se guardan en un
+ * archivo temporal y se copian al cerrar el documento: la memoria no crece con el número
+ * de páginas.
+ *
+ * El texto se convierte de UTF-8 a WinAnsiEncoding; los caracteres que no existen en esa
+ * codificación se muestran como '?'.
+ */
+class PdfReportWriter
+{
+private:
+    OutputBuffer& out; /**< Destino del documento, ya abierto. */
+    std::FILE* xref; /**< Archivo temporal con las entradas de la tabla xref. */
+    OutputBuffer page; /**< Contenido sin comprimir de la página en curso. */
+    std::vector<unsigned char> compressed; /**< Contenido comprimido de la página (se reutiliza). */
+    std::string line; /**< Línea de la tabla en WinAnsi (se reutiliza). */
+    std::string generated; /**< Fecha y hora de generación. */
+    std::uint32_t objectCount; /**< Objetos escritos o reservados (el siguiente es objectCount + 1). */
+    std::size_t pageCount; /**< Páginas empezadas. */
+    std::size_t rowsOnPage; /**< Filas de la página en curso. */
+    std::size_t rowCount; /**< Filas escritas en total. */
+    bool failed; /**< true si falló el archivo temporal o la compresión. */
+
+    /**
+     * @brief Anota la posición del siguiente objeto en la tabla xref y escribe su cabecera.
+     *
+     * @return Número del objeto.
+     */
+    std::uint32_t beginObject();
+
+    /**
+     * @brief Escribe una entrada de la tabla xref en el archivo temporal.
+     *
+     * @param offset Posición del objeto en el documento.
+     */
+    void writeXrefEntry(std::uint64_t offset);
+
+    /**
+     * @brief Empieza una página: título, fecha, resumen (solo la primera) y cabecera de la tabla.
+     *
+     * @param componentCount Número de componentes (solo para la primera página).
+     * @param totalQuantity Suma de las cantidades (solo para la primera página).
+     * @param lowStockCount Componentes con stock bajo (solo para la primera página).
+     */
+    void beginPage(std::size_t componentCount, long long totalQuantity, std::size_t lowStockCount);
+
+    /**
+     * @brief Cierra la página en curso y la escribe: objeto de página y contenido comprimido.
+     */
+    void finishPage();
+
+    /**
+     * @brief Escribe una línea de texto en la página.
+     *
+     * @param x Posición horizontal en puntos.
+     * @param y Línea base en puntos.
+     * @param font Recurso de fuente ("F1" normal, "F2" negrita).
+     * @param size Tamaño de letra en puntos.
+     * @param text Texto en WinAnsi.
+     */
+    void writeText(int x, int y, std::string_view font, int size, std::string_view text);
+
+    /**
+     * @brief Agrega a line un texto UTF-8 convertido a WinAnsi, recortado o rellenado a width caracteres.
+     *
+     * @param text Texto en UTF-8.
+     * @param width Ancho de la columna en caracteres.
+     * @param alignRight Si es true el relleno va a la izquierda.
+     */
+    void appendCell(std::string_view text, std::size_t width, bool alignRight = false);
+
+    /**
+     * @brief Línea base de la fila row de la página en curso.
+     *
+     * @param row Fila dentro de la página (0 es la primera bajo la cabecera).
+     * @return Posición vertical en puntos.
+     */
+    int rowBaseline(std::size_t row) const;
+
+    /**
+     * @brief Número máximo de filas de la página en curso.
+     * @return Filas que caben (la primera página tiene menos por el resumen).
+     */
+    std::size_t pageCapacity() const;
+
+public:
+    static constexpr int PAGE_WIDTH = 595; /**< Ancho de página A4 en puntos. */
+    static constexpr int PAGE_HEIGHT = 842; /**< Alto de página A4 en puntos. */
+    static constexpr std::uint32_t FIRST_PAGE_OBJECT = 6; /**< Número de objeto de la primera página. */
+
+    /**
+     * @brief Constructor.
+     *
+     * @param out Destino del documento, abierto en modo binario (o comprimido).
+     */
+    explicit PdfReportWriter(OutputBuffer& out);
+
+    /**
+     * @brief Destructor. Elimina el archivo temporal.
+     */
+    ~PdfReportWriter();
+
+    PdfReportWriter(const PdfReportWriter&) = delete;
+    PdfReportWriter& operator=(const PdfReportWriter&) = delete;
+
+    /**
+     * @brief Escribe el principio del documento y empieza la primera página.
+     *
+     * @param componentCount Número de componentes del resumen.
+     * @param totalQuantity Suma de las cantidades del resumen.
+     * @param lowStockCount Componentes con stock bajo del resumen.
+     * @return true si se pudo crear el archivo temporal de la tabla xref, false en caso contrario.
+     */
+    bool begin(std::size_t componentCount, long long totalQuantity, std::size_t lowStockCount);
+
+    /**
+     * @brief Agrega la fila de un componente; si la página está llena, la escribe y empieza otra.
+     *
+     * @param component Componente a agregar.
+     */
+    void addRow(const Component& component);
+
+    /**
+     * @brief Escribe la última página, el árbol de páginas, la tabla xref y el trailer.
+     *
+     * El destino queda sin cerrar: después hay que llamar a OutputBuffer::close().
+     *
+     * @return true si el documento se escribió completo, false en caso contrario.
+     */
+    bool finish();
+};
+
+#endif // PDFREPORTWRITER_H
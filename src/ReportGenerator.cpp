@@ -1,413 +1,1798 @@
 #include "ReportGenerator.h"
-#include <fstream>
-#include <iomanip>
-#include <ctime>
-#include <sstream>
+#include "BinarySnapshot.h"
+#include "CompressionPipeline.h"
+#include "DatabaseManager.h"
+#include "DateFormatter.h"
+#include "InventorySnapshot.h"
+#include "OutputBuffer.h"
+#include "PdfReportWriter.h"
+#include "ReportManifest.h"
+#include "ReportTemplate.h"
+#include "ThreadPool.h"
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
 
-bool ReportGenerator::generateCSVReport(const std::vector<Component>& components, const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        return false;
+namespace {
+    /**
+     * Campos que pueden aparecer en las plantillas de reportes. El orden coincide con
+     * FIELD_NAMES: el índice que recibe la función de relleno es el valor del enum.
+     */
+    enum Field
+    {
+        Id, Name, Type, Quantity, Location, PurchaseDate,
+        RowClass, QuantityClass, Status, LowStockMark, LowStockFlag,
+        Generated, ComponentCount, TotalQuantity, WarningClass, LowStockCount, Threshold,
+        Section, PageNumber, PageCount, PageFile, Navigation,
+        PurchaseTimestamp, LowStockValue,
+        Change, QuantityBefore, LocationBefore, PeriodStart, PeriodEnd, TrackingNote,
+        AddedCount, RemovedCount, QuantityChangedCount, MovedCount
+    };
+
+    const std::initializer_list<std::string_view> FIELD_NAMES = {
+        "id", "name", "type", "quantity", "location", "purchaseDate",
+        "rowClass", "quantityClass", "status", "lowStockMark", "lowStockFlag",
+        "generated", "componentCount", "totalQuantity", "warningClass", "lowStockCount", "threshold",
+        "section", "pageNumber", "pageCount", "pageFile", "navigation",
+        "purchaseTimestamp", "lowStock",
+        "change", "quantityBefore", "locationBefore", "periodStart", "periodEnd", "trackingNote",
+        "addedCount", "removedCount", "quantityChangedCount", "movedCount"
+    };
+
+    enum class Escape { None, CSV, HTML, JSON };
+
+    // Piezas comunes del reporte HTML completo y del paginado (índice y páginas)
+    const std::string_view HTML_HEAD = R"html(<!DOCTYPE html>
+<html lang="es">
+<head>
+    <meta charset="UTF-8">
+    <meta name="viewport" content="width=device-width, initial-scale=1.0">
+)html";
+
+    const std::string_view HTML_STYLE = R"html(    <style>
+        * {
+            margin: 0;
+            padding: 0;
+            box-sizing: border-box;
+            font-family: 'Segoe UI', Tahoma, Geneva, Verdana, sans-serif;
+        }
+        body {
+            background-color: #f5f5f5;
+            color: #333;
+            line-height: 1.6;
+            padding: 20px;
+        }
+        .container {
+            max-width: 1200px;
+            margin: 0 auto;
+            background: white;
+            border-radius: 10px;
+            box-shadow: 0 0 20px rgba(0,0,0,0.1);
+            padding: 30px;
+        }
+        .header {
+            text-align: center;
+            margin-bottom: 30px;
+            border-bottom: 3px solid #4CAF50;
+            padding-bottom: 20px;
+        }
+        h1 {
+            color: #2c3e50;
+            font-size: 2.5em;
+            margin-bottom: 10px;
+        }
+        .subtitle {
+            color: #7f8c8d;
+            font-size: 1.1em;
+        }
+        .summary {
+            display: grid;
+            grid-template-columns: repeat(auto-fit, minmax(200px, 1fr));
+            gap: 20px;
+            margin-bottom: 30px;
+        }
+        .summary-card {
+            background: #f8f9fa;
+            border-radius: 8px;
+            padding: 20px;
+            text-align: center;
+            border-left: 4px solid #4CAF50;
+        }
+        .summary-card.warning {
+            border-left-color: #e74c3c;
+        }
+        .summary-card h3 {
+            font-size: 1.2em;
+            color: #2c3e50;
+            margin-bottom: 10px;
+        }
+        .summary-card .number {
+            font-size: 2em;
+            font-weight: bold;
+            color: #4CAF50;
+        }
+        .summary-card.warning .number {
+            color: #e74c3c;
+        }
+        table {
+            width: 100%;
+            border-collapse: collapse;
+            margin-top: 20px;
+            font-size: 0.95em;
+        }
+        th {
+            background-color: #4CAF50;
+            color: white;
+            padding: 12px 15px;
+            text-align: left;
+            font-weight: 600;
+        }
+        td {
+            padding: 10px 15px;
+            border-bottom: 1px solid #ddd;
+        }
+        tr:hover {
+            background-color: #f5f5f5;
+        }
+        .low-stock {
+            background-color: #ffeaea !important;
+            font-weight: bold;
+        }
+        .quantity-low {
+            color: #e74c3c;
+            font-weight: bold;
+        }
+        .footer {
+            margin-top: 40px;
+            text-align: center;
+            color: #7f8c8d;
+            font-size: 0.9em;
+            border-top: 1px solid #eee;
+            padding-top: 20px;
+        }
+        @media print {
+            body {
+                background: white;
+            }
+            .container {
+                box-shadow: none;
+            }
+        }
+    </style>
+)html";
+
+    // Estilos extra del reporte paginado: barra de navegación y enlaces del índice
+    const std::string_view HTML_PAGER_STYLE = R"html(    <style>
+        .pager {
+            display: flex;
+            justify-content: space-between;
+            align-items: center;
+            gap: 10px;
+            margin: 20px 0;
+        }
+        .pager a, .pager span {
+            padding: 8px 14px;
+            border-radius: 6px;
+        }
+        .pager a {
+            background-color: #4CAF50;
+            color: white;
+            text-decoration: none;
+        }
+        .pager .disabled {
+            color: #bbb;
+        }
+        td a {
+            color: #2c3e50;
+            font-weight: 600;
+        }
+    </style>
+)html";
+
+    const std::string_view HTML_SUMMARY = R"html(        <div class="summary">
+            <div class="summary-card">
+                <h3>Total de Componentes</h3>
+                <div class="number">{{componentCount}}</div>
+            </div>
+            <div class="summary-card">
+                <h3>Cantidad Total</h3>
+                <div class="number">{{totalQuantity}}</div>
+            </div>
+            <div class="summary-card{{warningClass}}">
+                <h3>Componentes con Stock Bajo</h3>
+                <div class="number">{{lowStockCount}}</div>
+            </div>
+        </div>
+)html";
+
+    const std::string_view HTML_TABLE_START = R"html(        <table>
+            <thead>
+                <tr>
+                    <th>ID</th>
+                    <th>Nombre</th>
+                    <th>Tipo</th>
+                    <th>Cantidad</th>
+                    <th>Ubicación</th>
+                    <th>Fecha Compra</th>
+                    <th>Estado</th>
+                </tr>
+            </thead>
+            <tbody>
+)html";
+
+    const std::string_view HTML_TABLE_END = R"html(            </tbody>
+        </table>
+        
+)html";
+
+    const std::string_view HTML_CREDITS = R"html(        <div class="footer">
+            <p>Sistema desarrollado en C++ con Qt y SQLite</p>
+            <p>© 2024 - Gestor de Inventario para Hogar/Laboratorio</p>
+            <p>Reporte generado automáticamente</p>
+        </div>
+    </div>
+</body>
+</html>
+)html";
+
+    // Une las piezas de una plantilla
+    std::string concat(std::initializer_list<std::string_view> parts) {
+        std::string text;
+        for (std::string_view part : parts) text.append(part);
+        return text;
     }
+
+    /**
+     * Plantillas de todos los reportes, compiladas la primera vez que se usan.
+     */
+    struct ReportTemplates
+    {
+        ReportTemplate csvRow{
+            "{{id}},\"{{name}}\",\"{{type}}\",{{quantity}},\"{{location}}\",\"{{purchaseDate}}\",{{lowStockFlag}}\n",
+            FIELD_NAMES};
+
+        ReportTemplate jsonRow{
+            "{\"id\":{{id}},\"name\":\"{{name}}\",\"type\":\"{{type}}\",\"quantity\":{{quantity}},"
+            "\"location\":\"{{location}}\",\"purchase_date\":{{purchaseTimestamp}},\"low_stock\":{{lowStock}}}\n",
+            FIELD_NAMES};
+
+        ReportTemplate htmlHeader{concat({HTML_HEAD, "    <title>Reporte de Inventario</title>\n", HTML_STYLE, R"html(</head>
+<body>
+    <div class="container">
+        <div class="header">
+            <h1>📦 Reporte de Inventario</h1>
+            <p class="subtitle">Sistema de Gestión para Hogar/Laboratorio</p>
+            <p>Generado: {{generated}}</p>
+        </div>
+        
+)html",
+                                          HTML_SUMMARY, R"html(        
+        <h2>📋 Lista de Componentes</h2>
+)html", HTML_TABLE_START}),
+                                  FIELD_NAMES};
+
+        ReportTemplate htmlRow{R"html(                <tr{{rowClass}}>
+                    <td>{{id}}</td>
+                    <td>{{name}}</td>
+                    <td>{{type}}</td>
+                    <td class="{{quantityClass}}">{{quantity}}</td>
+                    <td>{{location}}</td>
+                    <td>{{purchaseDate}}</td>
+                    <td>{{status}}</td>
+                </tr>
+)html", FIELD_NAMES};
+
+        ReportTemplate htmlFooter{concat({HTML_TABLE_END, HTML_CREDITS}), FIELD_NAMES};
+
+        ReportTemplate pageHeader{concat({HTML_HEAD, "    <title>Reporte de Inventario - Página {{pageNumber}} de {{pageCount}}</title>\n",
+                                          HTML_STYLE, HTML_PAGER_STYLE, R"html(</head>
+<body>
+    <div class="container">
+        <div class="header">
+            <h1>📦 Reporte de Inventario</h1>
+            <p class="subtitle">{{section}}</p>
+            <p>Generado: {{generated}}</p>
+        </div>
+        
+)html",
+                                          "{{navigation}}", HTML_TABLE_START}),
+                                  FIELD_NAMES};
+
+        ReportTemplate pageFooter{concat({HTML_TABLE_END, "{{navigation}}", HTML_CREDITS}), FIELD_NAMES};
+
+        ReportTemplate indexHeader{concat({HTML_HEAD, "    <title>Reporte de Inventario - Índice</title>\n", HTML_STYLE,
+                                           HTML_PAGER_STYLE, R"html(</head>
+<body>
+    <div class="container">
+        <div class="header">
+            <h1>📦 Reporte de Inventario</h1>
+            <p class="subtitle">Sistema de Gestión para Hogar/Laboratorio</p>
+            <p>Generado: {{generated}}</p>
+        </div>
+        
+)html", HTML_SUMMARY,
+                                           R"html(        
+        <h2>📑 Páginas del Reporte</h2>
+        <table>
+            <thead>
+                <tr>
+                    <th>Página</th>
+                    <th>Sección</th>
+                    <th>Componentes</th>
+                    <th>Con Stock Bajo</th>
+                </tr>
+            </thead>
+            <tbody>
+)html"}),
+                                   FIELD_NAMES};
+
+        ReportTemplate indexRow{R"html(                <tr>
+                    <td><a href="{{pageFile}}">Página {{pageNumber}}</a></td>
+                    <td>{{section}}</td>
+                    <td>{{componentCount}}</td>
+                    <td class="{{quantityClass}}">{{lowStockCount}}</td>
+                </tr>
+)html", FIELD_NAMES};
+
+        ReportTemplate textHeader{R"(=========================================
+      REPORTE DE INVENTARIO
+=========================================
+Generado: {{generated}}
+Total de componentes: {{componentCount}}
+=========================================
+
+)", FIELD_NAMES};
+
+        ReportTemplate textRow{R"(ID: {{id}}
+Nombre: {{name}}
+Tipo: {{type}}
+Cantidad: {{quantity}}{{lowStockMark}}
+Ubicación: {{location}}
+Fecha Compra: {{purchaseDate}}
+-----------------------------------------
+)", FIELD_NAMES};
+
+        ReportTemplate lowStockEmpty{R"(REPORTE DE STOCK BAJO
+=====================
+Fecha: {{generated}}
+Umbral: {{threshold}} unidades
+=====================
+
+✅ No hay componentes con stock bajo.
+Todo el inventario está en niveles adecuados.
+)", FIELD_NAMES};
+
+        ReportTemplate lowStockHeader{R"html(<!DOCTYPE html>
+<html lang="es">
+<head>
+    <meta charset="UTF-8">
+    <title>Alerta: Stock Bajo</title>
+    <style>
+        body { font-family: Arial, sans-serif; margin: 40px; }
+        .alert { background-color: #fff3cd; border: 1px solid #ffeaa7; padding: 20px; margin: 20px 0; }
+        .warning { color: #856404; }
+        table { border-collapse: collapse; width: 100%; margin-top: 20px; }
+        th, td { border: 1px solid #ddd; padding: 8px; text-align: left; }
+        th { background-color: #dc3545; color: white; }
+        tr:nth-child(even) { background-color: #f8d7da; }
+    </style>
+</head>
+<body>
+    <h1 class="warning">⚠️ ALERTA: COMPONENTES CON STOCK BAJO</h1>
+    <div class="alert">
+        <p><strong>Fecha:</strong> {{generated}}</p>
+        <p><strong>Umbral de stock bajo:</strong> {{threshold}} unidades</p>
+        <p><strong>Total de componentes afectados:</strong> {{lowStockCount}}</p>
+    </div>
     
-    // Encabezado del CSV
-    file << "ID,Nombre,Tipo,Cantidad,Ubicación,Fecha Compra,Stock Bajo\n";
+    <table>
+        <tr>
+            <th>ID</th>
+            <th>Nombre</th>
+            <th>Tipo</th>
+            <th>Cantidad Actual</th>
+            <th>Ubicación</th>
+            <th>Acción Recomendada</th>
+        </tr>
+)html", FIELD_NAMES};
+
+        ReportTemplate lowStockRow{R"html(        <tr>
+            <td>{{id}}</td>
+            <td>{{name}}</td>
+            <td>{{type}}</td>
+            <td><strong>{{quantity}}</strong> unidades</td>
+            <td>{{location}}</td>
+            <td>REABASTECER URGENTE</td>
+        </tr>
+)html", FIELD_NAMES};
+
+        ReportTemplate lowStockFooter{R"html(    </table>
     
-    // Datos
-    for (const auto& component : components) {
-        file << component.getId() << ","
-             << "\"" << escapeCSV(component.getName()) << "\","
-             << "\"" << escapeCSV(component.getType()) << "\","
-             << component.getQuantity() << ","
-             << "\"" << escapeCSV(component.getLocation()) << "\","
-             << "\"" << component.getPurchaseDateString() << "\","
-             << (component.isLowStock() ? "SI" : "NO") << "\n";
+    <div style="margin-top: 30px; padding: 15px; background-color: #d4edda; border: 1px solid #c3e6cb;">
+        <h3>Recomendaciones:</h3>
+        <ul>
+            <li>Verificar inventario de estos componentes</li>
+            <li>Realizar pedido de reposición</li>
+            <li>Actualizar niveles mínimos de stock si es necesario</li>
+        </ul>
+    </div>
+</body>
+</html>
+)html", FIELD_NAMES};
+
+        ReportTemplate changeHeader{concat({HTML_HEAD, "    <title>Reporte de Cambios del Inventario</title>\n", HTML_STYLE, R"html(</head>
+<body>
+    <div class="container">
+        <div class="header">
+            <h1>🔄 Reporte de Cambios del Inventario</h1>
+            <p class="subtitle">Del {{periodStart}} al {{periodEnd}}</p>
+            <p>Generado: {{generated}}</p>
+{{trackingNote}}        </div>
+        
+        <div class="summary">
+            <div class="summary-card">
+                <h3>Agregados</h3>
+                <div class="number">{{addedCount}}</div>
+            </div>
+            <div class="summary-card warning">
+                <h3>Eliminados</h3>
+                <div class="number">{{removedCount}}</div>
+            </div>
+            <div class="summary-card">
+                <h3>Cambios de Cantidad</h3>
+                <div class="number">{{quantityChangedCount}}</div>
+            </div>
+            <div class="summary-card">
+                <h3>Cambios de Ubicación</h3>
+                <div class="number">{{movedCount}}</div>
+            </div>
+        </div>
+        
+        <h2>📋 Componentes Cambiados</h2>
+        <table>
+            <thead>
+                <tr>
+                    <th>ID</th>
+                    <th>Nombre</th>
+                    <th>Tipo</th>
+                    <th>Cambio</th>
+                    <th>Cantidad</th>
+                    <th>Ubicación</th>
+                </tr>
+            </thead>
+            <tbody>
+)html"}),
+                                    FIELD_NAMES};
+
+        ReportTemplate changeRow{R"html(                <tr>
+                    <td>{{id}}</td>
+                    <td>{{name}}</td>
+                    <td>{{type}}</td>
+                    <td>{{change}}</td>
+                    <td>{{quantity}}</td>
+                    <td>{{location}}</td>
+                </tr>
+)html", FIELD_NAMES};
+
+        ReportTemplate changeCsvRow{
+            "{{id}},\"{{name}}\",\"{{type}}\",\"{{change}}\",{{quantityBefore}},{{quantity}},\"{{locationBefore}}\",\"{{location}}\"\n",
+            FIELD_NAMES};
+    };
+
+    const ReportTemplates& templates() {
+        static const ReportTemplates compiled;
+        return compiled;
     }
-    
-    file.close();
-    return true;
+
+    void writeText(OutputBuffer& out, std::string_view text, Escape escape) {
+        switch (escape) {
+            case Escape::None: out.write(text); break;
+            case Escape::CSV: out.writeEscapedCSV(text); break;
+            case Escape::HTML: out.writeEscapedHTML(text); break;
+            case Escape::JSON: out.writeEscapedJSON(text); break;
+        }
+    }
+
+    // Escribe un campo de fila; los campos de cabecera los resuelve cada reporte
+    void writeComponentField(OutputBuffer& out, const Component& component, int field, Escape escape) {
+        switch (field) {
+            case Id: out.writeInteger(component.getId()); break;
+            case Name: writeText(out, component.getName(), escape); break;
+            case Type: writeText(out, component.getType(), escape); break;
+            case Quantity: out.writeInteger(component.getQuantity()); break;
+            case Location: writeText(out, component.getLocation(), escape); break;
+            case PurchaseDate:
+                if (component.getPurchaseDate() == 0) {
+                    out.write("No date");
+                } else {
+                    out.writeDate(component.getPurchaseDate());
+                }
+                break;
+            case RowClass: if (component.isLowStock()) out.write(" class=\"low-stock\""); break;
+            case QuantityClass: if (component.isLowStock()) out.write("quantity-low"); break;
+            case Status: out.write(component.isLowStock() ? "⚠️ STOCK BAJO" : "✅ OK"); break;
+            case LowStockMark: if (component.isLowStock()) out.write(" [STOCK BAJO!]"); break;
+            case LowStockFlag: out.write(component.isLowStock() ? "SI" : "NO"); break;
+            case PurchaseTimestamp:
+                if (component.getPurchaseDate() == 0) {
+                    out.write("null");
+                } else {
+                    out.writeInteger(static_cast<long long>(component.getPurchaseDate()));
+                }
+                break;
+            case LowStockValue: out.write(component.isLowStock() ? "true" : "false"); break;
+            default: break;
+        }
+    }
+
+    // Escribe la fecha y hora actual directamente en el búfer
+    void writeCurrentDateTime(OutputBuffer& out) {
+        char* target = out.claim(DateFormatter::DATE_TIME_LENGTH);
+        out.commit(DateFormatter::formatDateTime(std::time(nullptr), target));
+    }
+
+    /**
+     * Un reporte en curso: su formato y los totales que necesita la cabecera, que se
+     * calculan antes de recorrer las filas. Sabe escribir cabecera, fila y pie.
+     */
+    struct ReportWriter
+    {
+        ReportGenerator::ReportFormat format;
+        int threshold; // Solo LowStock
+        std::size_t componentCount; // HTML y Text
+        long long totalQuantity; // HTML
+        std::size_t lowStockCount; // HTML: con stock bajo; LowStock: afectados por el umbral
+
+        void writeHeader(OutputBuffer& out) const {
+            const ReportTemplates& compiled = templates();
+            auto fill = [this](int field, OutputBuffer& target) {
+                switch (field) {
+                    case Generated: writeCurrentDateTime(target); break;
+                    case ComponentCount: target.writeUnsigned(componentCount); break;
+                    case TotalQuantity: target.writeInteger(totalQuantity); break;
+                    case WarningClass: if (lowStockCount > 0) target.write(" warning"); break;
+                    case LowStockCount: target.writeUnsigned(lowStockCount); break;
+                    case Threshold: target.writeInteger(threshold); break;
+                    default: break;
+                }
+            };
+
+            switch (format) {
+                case ReportGenerator::ReportFormat::HTML: compiled.htmlHeader.render(out, fill); break;
+                case ReportGenerator::ReportFormat::CSV:
+                    out.write("ID,Nombre,Tipo,Cantidad,Ubicación,Fecha Compra,Stock Bajo\n");
+                    break;
+                case ReportGenerator::ReportFormat::Text: compiled.textHeader.render(out, fill); break;
+                case ReportGenerator::ReportFormat::LowStock:
+                    // Sin componentes afectados el reporte es un aviso en texto, sin filas ni pie
+                    if (lowStockCount == 0) {
+                        compiled.lowStockEmpty.render(out, fill);
+                    } else {
+                        compiled.lowStockHeader.render(out, fill);
+                    }
+                    break;
+                case ReportGenerator::ReportFormat::JSONLines:
+                case ReportGenerator::ReportFormat::Columnar:
+                case ReportGenerator::ReportFormat::PDF:
+                    break;
+            }
+        }
+
+        // Indica si el componente produce una fila (el reporte de stock bajo filtra por umbral)
+        bool includes(const Component& component) const {
+            return format != ReportGenerator::ReportFormat::LowStock || component.getQuantity() <= threshold;
+        }
+
+        void writeRow(OutputBuffer& out, const Component& component) const {
+            const ReportTemplates& compiled = templates();
+            switch (format) {
+                case ReportGenerator::ReportFormat::HTML:
+                    compiled.htmlRow.render(out, [&component](int field, OutputBuffer& target) {
+                        writeComponentField(target, component, field, Escape::HTML);
+                    });
+                    break;
+                case ReportGenerator::ReportFormat::CSV:
+                    compiled.csvRow.render(out, [&component](int field, OutputBuffer& target) {
+                        writeComponentField(target, component, field, Escape::CSV);
+                    });
+                    break;
+                case ReportGenerator::ReportFormat::Text:
+                    compiled.textRow.render(out, [&component](int field, OutputBuffer& target) {
+                        writeComponentField(target, component, field, Escape::None);
+                    });
+                    break;
+                case ReportGenerator::ReportFormat::LowStock:
+                    if (includes(component)) {
+                        compiled.lowStockRow.render(out, [&component](int field, OutputBuffer& target) {
+                            writeComponentField(target, component, field, Escape::HTML);
+                        });
+                    }
+                    break;
+                case ReportGenerator::ReportFormat::JSONLines:
+                    compiled.jsonRow.render(out, [&component](int field, OutputBuffer& target) {
+                        writeComponentField(target, component, field, Escape::JSON);
+                    });
+                    break;
+                case ReportGenerator::ReportFormat::Columnar:
+                case ReportGenerator::ReportFormat::PDF:
+                    // Se escriben aparte (writeColumnar, writePDF): no son filas de texto independientes
+                    break;
+            }
+        }
+
+        void writeFooter(OutputBuffer& out) const {
+            const ReportTemplates& compiled = templates();
+            auto noFields = [](int, OutputBuffer&) {};
+            switch (format) {
+                case ReportGenerator::ReportFormat::HTML: compiled.htmlFooter.render(out, noFields); break;
+                case ReportGenerator::ReportFormat::LowStock:
+                    if (lowStockCount > 0) compiled.lowStockFooter.render(out, noFields);
+                    break;
+                default: break;
+            }
+        }
+    };
+
+    // Prepara el escritor de un destino con los totales de la tabla columnar
+    ReportWriter makeWriter(const ReportGenerator::ReportSink& sink, const std::vector<Component>& components,
+                            const ComponentTable& table) {
+        ReportWriter writer{sink.format, sink.threshold, components.size(), 0, 0};
+        if (sink.format == ReportGenerator::ReportFormat::HTML) {
+            writer.totalQuantity = table.sumQuantities();
+            writer.lowStockCount = table.countAtOrBelow(5);
+        } else if (sink.format == ReportGenerator::ReportFormat::LowStock) {
+            writer.lowStockCount = table.countAtOrBelow(sink.threshold);
+        }
+        return writer;
+    }
+
+    // Tamaño de un archivo, o -1 si no se puede abrir
+    std::int64_t fileSize(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        return file.is_open() ? static_cast<std::int64_t>(file.tellg()) : -1;
+    }
+
+    // Lee un archivo completo
+    bool readFile(const std::string& path, std::vector<char>& bytes) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return false;
+        bytes.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        return static_cast<bool>(file.read(bytes.data(), static_cast<std::streamsize>(bytes.size())));
+    }
+
+    // Reemplaza destination por source
+    bool replaceFile(const std::string& source, const std::string& destination) {
+#ifdef _WIN32
+        // rename no reemplaza un archivo existente en Windows
+        std::remove(destination.c_str());
+#endif
+        if (std::rename(source.c_str(), destination.c_str()) != 0) {
+            std::remove(source.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    const std::size_t CHUNK_ROWS = 2048; // Filas por trozo en el modo paralelo
+    const std::size_t CHUNK_BUFFER_SIZE = 256 * 1024; // Tamaño inicial del búfer de cada trozo
+    const std::size_t STREAM_BATCH_ROWS = 8 * CHUNK_ROWS; // Filas por lote en los reportes en streaming
+
+    /**
+     * Escribe rowCount filas en outputCount salidas con renderRow(salidas, fila), que
+     * escribe la fila en cada salida. En modo paralelo las filas se reparten en trozos de
+     * CHUNK_ROWS que se renderizan en el ThreadPool compartido, cada uno en sus propios
+     * búferes en memoria; los trozos terminados se escriben en orden, juntando en una sola
+     * llamada los consecutivos que ya estén listos. Como mucho hay dos trozos por hilo en
+     * vuelo, así que la memoria no depende del tamaño del reporte.
+     */
+    template <typename RenderRow>
+    void renderRows(OutputBuffer* const* outputs, std::size_t outputCount, std::size_t rowCount,
+                    bool parallel, const RenderRow& renderRow) {
+        ThreadPool* pool = parallel && rowCount > CHUNK_ROWS ? &ThreadPool::shared() : nullptr;
+        if (!pool || pool->size() < 2) {
+            for (std::size_t row = 0; row < rowCount; ++row) renderRow(outputs, row);
+            return;
+        }
+
+        const std::size_t chunkCount = (rowCount + CHUNK_ROWS - 1) / CHUNK_ROWS;
+        const std::size_t window = std::min(chunkCount, pool->size() * 2);
+
+        // Búferes del trozo en la posición slot: slot * outputCount + salida
+        std::vector<std::unique_ptr<OutputBuffer>> buffers;
+        std::vector<OutputBuffer*> bufferPointers;
+        for (std::size_t i = 0; i < window * outputCount; ++i) {
+            buffers.push_back(std::make_unique<OutputBuffer>(CHUNK_BUFFER_SIZE));
+            bufferPointers.push_back(buffers.back().get());
+        }
+        std::vector<std::future<void>> pending(window);
+
+        auto submit = [&](std::size_t chunk) {
+            OutputBuffer* const* targets = bufferPointers.data() + (chunk % window) * outputCount;
+            for (std::size_t output = 0; output < outputCount; ++output) targets[output]->clear();
+            pending[chunk % window] = pool->submit([targets, &renderRow, chunk, rowCount]() {
+                const std::size_t end = std::min(rowCount, (chunk + 1) * CHUNK_ROWS);
+                for (std::size_t row = chunk * CHUNK_ROWS; row < end; ++row) renderRow(targets, row);
+            });
+        };
+
+        try {
+            std::size_t next = 0;
+            for (; next < window; ++next) submit(next);
+
+            std::vector<std::string_view> blocks;
+            std::size_t written = 0;
+            while (written < chunkCount) {
+                pending[written % window].get();
+                std::size_t ready = written + 1;
+                while (ready < next &&
+                       pending[ready % window].wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                    pending[ready % window].get();
+                    ++ready;
+                }
+
+                for (std::size_t output = 0; output < outputCount; ++output) {
+                    blocks.clear();
+                    for (std::size_t chunk = written; chunk < ready; ++chunk) {
+                        blocks.push_back(bufferPointers[(chunk % window) * outputCount + output]->view());
+                    }
+                    outputs[output]->writeBlocks(blocks.data(), blocks.size());
+                }
+
+                // Los búferes ya escritos quedan libres para los trozos siguientes
+                for (std::size_t chunk = written; chunk < ready && next < chunkCount; ++chunk) {
+                    submit(next++);
+                }
+                written = ready;
+            }
+        } catch (...) {
+            // Las tareas en vuelo usan los búferes locales: esperarlas antes de salir
+            for (std::future<void>& task : pending) {
+                if (task.valid()) task.wait();
+            }
+            throw;
+        }
+    }
+
+    // Abre la salida de un reporte; si el nombre termina en .gz o .zst se comprime al vuelo.
+    // Los formatos binarios (columnar, PDF) se abren sin traducir los finales de línea
+    bool openReport(OutputBuffer& out, const std::string& filename, bool binary = false) {
+        CompressionPipeline::Codec codec;
+        if (CompressionPipeline::codecFor(filename, codec)) {
+            return out.openCompressed(filename, codec);
+        }
+        return out.open(filename, binary);
+    }
+
+    // Escribe la exportación columnar de una tabla
+    bool writeColumnar(const ComponentTable& table, const std::string& filename) {
+        const std::vector<unsigned char> bytes = BinarySnapshotWriter::serialize(table);
+        if (bytes.empty()) {
+            std::cerr << "La tabla no cabe en el formato columnar: " << filename << std::endl;
+            return false;
+        }
+
+        OutputBuffer out;
+        if (!openReport(out, filename, true)) {
+            return false;
+        }
+        out.write(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+        return out.close();
+    }
+
+    // Escribe el reporte PDF; source(visitante) entrega los componentes en orden
+    template <typename Source>
+    bool writePDF(const std::string& filename, const ReportGenerator::ReportTotals& totals, const Source& source) {
+        OutputBuffer out;
+        if (!openReport(out, filename, true)) {
+            return false;
+        }
+
+        PdfReportWriter writer(out);
+        if (!writer.begin(totals.componentCount, totals.totalQuantity, totals.lowStockCount)) {
+            return false;
+        }
+        const bool complete = source([&writer](const Component& component) {
+            writer.addRow(component);
+            return true;
+        });
+        const bool finished = writer.finish();
+        return out.close() && finished && complete;
+    }
+
+    // Escribe un reporte completo; componentAt(fila) devuelve el componente de cada fila
+    template <typename ComponentAt>
+    bool writeReport(const ReportWriter& writer, const std::string& filename, std::size_t rowCount,
+                     const ComponentAt& componentAt) {
+        OutputBuffer out;
+        if (!openReport(out, filename)) {
+            return false;
+        }
+
+        OutputBuffer* outputs[] = {&out};
+        writer.writeHeader(out);
+        renderRows(outputs, 1, rowCount, ReportGenerator::getRenderMode() == ReportGenerator::RenderMode::Parallel,
+                   [&writer, &componentAt](OutputBuffer* const* targets, std::size_t row) {
+            writer.writeRow(*targets[0], componentAt(row));
+        });
+        writer.writeFooter(out);
+
+        return out.close();
+    }
+
+    /**
+     * Página de un reporte paginado: un tramo de order (índices de fila) dentro de su sección.
+     */
+    struct ReportPage
+    {
+        std::string section; // Texto sin escapar
+        std::size_t begin; // Primer índice en order
+        std::size_t end; // Uno después del último
+        std::size_t lowStockCount;
+    };
+
+    std::string pageFileName(std::size_t number) {
+        char name[40];
+        std::snprintf(name, sizeof(name), "pagina_%04zu.html", number);
+        return name;
+    }
+
+    std::string joinPath(const std::string& directory, const std::string& name) {
+        if (directory.empty() || directory.back() == '/' || directory.back() == '\\') return directory + name;
+        return directory + '/' + name;
+    }
+
+    // Filas de un reporte paginado a partir de un vector de componentes
+    struct VectorRows
+    {
+        const std::vector<Component>& components;
+
+        std::size_t size() const { return components.size(); }
+        const Component& at(std::size_t row) const { return components[row]; }
+    };
+
+    // Agrega a pages las páginas de una sección (order[begin, end)), partida en tramos de pageSize
+    template <typename Rows>
+    void addSectionPages(std::vector<ReportPage>& pages, const Rows& rows, const std::vector<std::uint32_t>& order,
+                         std::string_view title, std::size_t begin, std::size_t end, std::size_t pageSize) {
+        const std::size_t parts = (end - begin + pageSize - 1) / pageSize;
+        for (std::size_t part = 0; part < parts; ++part) {
+            ReportPage page{std::string(title), begin + part * pageSize, std::min(end, begin + (part + 1) * pageSize), 0};
+            if (parts > 1) {
+                page.section += " (parte " + std::to_string(part + 1) + " de " + std::to_string(parts) + ")";
+            }
+            for (std::size_t i = page.begin; i < page.end; ++i) {
+                if (rows.at(order[i]).getQuantity() <= 5) ++page.lowStockCount;
+            }
+            pages.push_back(std::move(page));
+        }
+    }
+
+    /**
+     * Reparte las filas en páginas; order recibe los índices de fila en el orden de las
+     * páginas. rows da el componente de cada fila (VectorRows o un InventorySnapshot): aparte
+     * de order, no se copia nada por fila.
+     */
+    template <typename Rows>
+    std::vector<ReportPage> paginate(const Rows& rows, ReportGenerator::PageGrouping grouping,
+                                     std::size_t pageSize, std::vector<std::uint32_t>& order) {
+        std::vector<ReportPage> pages;
+        const std::size_t rowCount = rows.size();
+        order.clear();
+        order.reserve(rowCount);
+
+        if (grouping == ReportGenerator::PageGrouping::Fixed) {
+            for (std::size_t row = 0; row < rowCount; ++row) order.push_back(static_cast<std::uint32_t>(row));
+            for (std::size_t begin = 0; begin < rowCount; begin += pageSize) {
+                const std::size_t end = std::min(rowCount, begin + pageSize);
+                std::string title = "Componentes " + std::to_string(begin + 1) + " a " + std::to_string(end) +
+                                    " de " + std::to_string(rowCount);
+                addSectionPages(pages, rows, order, title, begin, end, pageSize);
+            }
+            return pages;
+        }
+
+        // Por tipo o ubicación: cada texto distinto recibe un código en el primer recorrido;
+        // las filas se agrupan por código conservando su orden, y las secciones se ordenan
+        // alfabéticamente
+        const bool byType = grouping == ReportGenerator::PageGrouping::ByType;
+        auto sectionOf = [&rows, byType](std::size_t row) -> std::string_view {
+            const Component& component = rows.at(row);
+            return byType ? component.getType() : component.getLocation();
+        };
+        std::unordered_map<std::string_view, std::uint32_t> codes;
+        std::vector<std::string_view> dictionary;
+        std::vector<std::size_t> sectionStart(1, 0);
+        for (std::size_t row = 0; row < rowCount; ++row) {
+            auto inserted = codes.emplace(sectionOf(row), static_cast<std::uint32_t>(dictionary.size()));
+            if (inserted.second) {
+                dictionary.push_back(inserted.first->first);
+                sectionStart.push_back(0);
+            }
+            ++sectionStart[inserted.first->second + 1];
+        }
+        for (std::size_t code = 0; code < dictionary.size(); ++code) sectionStart[code + 1] += sectionStart[code];
+
+        order.resize(rowCount);
+        std::vector<std::size_t> fill(sectionStart.begin(), sectionStart.end() - 1);
+        for (std::size_t row = 0; row < rowCount; ++row) {
+            order[fill[codes.find(sectionOf(row))->second]++] = static_cast<std::uint32_t>(row);
+        }
+
+        std::vector<std::size_t> sorted(dictionary.size());
+        for (std::size_t code = 0; code < sorted.size(); ++code) sorted[code] = code;
+        std::sort(sorted.begin(), sorted.end(),
+                  [&dictionary](std::size_t a, std::size_t b) { return dictionary[a] < dictionary[b]; });
+
+        for (std::size_t code : sorted) {
+            std::string_view name = dictionary[code];
+            std::string title = byType ? "Tipo: " : "Ubicación: ";
+            title += name.empty() ? std::string_view(byType ? "(sin tipo)" : "(sin ubicación)") : name;
+            addSectionPages(pages, rows, order, title, sectionStart[code], sectionStart[code + 1], pageSize);
+        }
+        return pages;
+    }
+
+    // Barra de navegación de la página number (de 1 a count)
+    void writeNavigation(OutputBuffer& out, std::size_t number, std::size_t count) {
+        out.write("        <nav class=\"pager\">\n            <a href=\"index.html\">🏠 Índice</a>\n");
+        if (number > 1) {
+            out.write("            <a href=\"");
+            out.write(pageFileName(number - 1));
+            out.write("\">‹ Anterior</a>\n");
+        } else {
+            out.write("            <span class=\"disabled\">‹ Anterior</span>\n");
+        }
+        out.write("            <span>Página ");
+        out.writeUnsigned(number);
+        out.write(" de ");
+        out.writeUnsigned(count);
+        out.write("</span>\n");
+        if (number < count) {
+            out.write("            <a href=\"");
+            out.write(pageFileName(number + 1));
+            out.write("\">Siguiente ›</a>\n");
+        } else {
+            out.write("            <span class=\"disabled\">Siguiente ›</span>\n");
+        }
+        out.write("        </nav>\n");
+    }
+
+    // Escribe la página number (de 1 a count) de un reporte paginado
+    template <typename Rows>
+    bool writePage(const std::string& path, const ReportPage& page, std::size_t number, std::size_t count,
+                   std::string_view generated, const Rows& rows, const std::vector<std::uint32_t>& order) {
+        OutputBuffer out;
+        if (!out.open(path)) {
+            return false;
+        }
+
+        const ReportTemplates& compiled = templates();
+        auto fill = [&](int field, OutputBuffer& target) {
+            switch (field) {
+                case Generated: target.write(generated); break;
+                case Section: target.writeEscapedHTML(page.section); break;
+                case PageNumber: target.writeUnsigned(number); break;
+                case PageCount: target.writeUnsigned(count); break;
+                case Navigation: writeNavigation(target, number, count); break;
+                default: break;
+            }
+        };
+
+        ReportWriter writer{ReportGenerator::ReportFormat::HTML, 5, 0, 0, 0};
+        compiled.pageHeader.render(out, fill);
+        for (std::size_t i = page.begin; i < page.end; ++i) {
+            writer.writeRow(out, rows.at(order[i]));
+        }
+        compiled.pageFooter.render(out, fill);
+
+        return out.close();
+    }
+
+    // Escribe el índice de un reporte paginado: totales y una fila por página
+    bool writeIndex(const std::string& path, const std::vector<ReportPage>& pages, std::string_view generated,
+                    const ReportGenerator::ReportTotals& totals) {
+        OutputBuffer out;
+        if (!out.open(path)) {
+            return false;
+        }
+
+        const ReportTemplates& compiled = templates();
+        compiled.indexHeader.render(out, [&](int field, OutputBuffer& target) {
+            switch (field) {
+                case Generated: target.write(generated); break;
+                case ComponentCount: target.writeUnsigned(totals.componentCount); break;
+                case TotalQuantity: target.writeInteger(totals.totalQuantity); break;
+                case WarningClass: if (totals.lowStockCount > 0) target.write(" warning"); break;
+                case LowStockCount: target.writeUnsigned(totals.lowStockCount); break;
+                default: break;
+            }
+        });
+
+        for (std::size_t i = 0; i < pages.size(); ++i) {
+            const ReportPage& page = pages[i];
+            compiled.indexRow.render(out, [&](int field, OutputBuffer& target) {
+                switch (field) {
+                    case PageFile: target.write(pageFileName(i + 1)); break;
+                    case PageNumber: target.writeUnsigned(i + 1); break;
+                    case Section: target.writeEscapedHTML(page.section); break;
+                    case ComponentCount: target.writeUnsigned(page.end - page.begin); break;
+                    case QuantityClass: if (page.lowStockCount > 0) target.write("quantity-low"); break;
+                    case LowStockCount: target.writeUnsigned(page.lowStockCount); break;
+                    default: break;
+                }
+            });
+        }
+        compiled.htmlFooter.render(out, [](int, OutputBuffer&) {});
+
+        return out.close();
+    }
+
+    // Escribe el índice y las páginas de un reporte paginado con las filas de rows
+    template <typename Rows>
+    bool writePagedReport(const Rows& rows, const ReportGenerator::ReportTotals& totals, const std::string& directory,
+                              ReportGenerator::PageGrouping grouping, std::size_t pageSize) {
+        pageSize = std::min(std::max<std::size_t>(pageSize, 1), ReportGenerator::MAX_PAGE_SIZE);
+
+        std::vector<std::uint32_t> order;
+        const std::vector<ReportPage> pages = paginate(rows, grouping, pageSize, order);
+
+        // Todas las páginas muestran la misma fecha de generación
+        char generatedText[DateFormatter::DATE_TIME_LENGTH];
+        const std::string_view generated(generatedText, DateFormatter::formatDateTime(std::time(nullptr), generatedText));
+
+        // char y no bool: cada tarea escribe su propio elemento
+        std::vector<char> written(pages.size(), 0);
+        auto writePageAt = [&](std::size_t i) {
+            written[i] = writePage(joinPath(directory, pageFileName(i + 1)), pages[i], i + 1, pages.size(),
+                                   generated, rows, order);
+        };
+
+        bool indexWritten = false;
+        ThreadPool& pool = ThreadPool::shared();
+        if (ReportGenerator::getRenderMode() == ReportGenerator::RenderMode::Parallel && pages.size() > 1 &&
+            pool.size() >= 2) {
+            std::vector<std::future<void>> pending;
+            pending.reserve(pages.size());
+            try {
+                for (std::size_t i = 0; i < pages.size(); ++i) {
+                    pending.push_back(pool.submit([&writePageAt, i]() { writePageAt(i); }));
+                }
+                indexWritten = writeIndex(joinPath(directory, "index.html"), pages, generated, totals);
+                for (std::future<void>& task : pending) task.get();
+            } catch (...) {
+                // Las tareas en vuelo usan variables locales: esperarlas antes de salir
+                for (std::future<void>& task : pending) {
+                    if (task.valid()) task.wait();
+                }
+                throw;
+            }
+        } else {
+            indexWritten = writeIndex(joinPath(directory, "index.html"), pages, generated, totals);
+            for (std::size_t i = 0; i < pages.size(); ++i) writePageAt(i);
+        }
+
+        return indexWritten && std::all_of(written.begin(), written.end(), [](char ok) { return ok != 0; });
+    }
+
+    /**
+     * Parte común de ReportGenerator::updateReport: actualiza el reporte de texto de sink
+     * con el escritor writer. forEachRow(visitante) entrega cada componente, en orden, con
+     * su resumen de contenido (Component::contentHash); los componentes deben seguir vivos
+     * hasta que termine la llamada. rowCount es una estimación para reservar memoria.
+     */
+    template <typename ForEachRow>
+    bool updateRows(const ReportWriter& writer, const ReportGenerator::ReportSink& sink, std::int64_t changeCounter,
+                    std::size_t rowCount, const ForEachRow& forEachRow) {
+        const std::string manifestPath = ReportManifest::pathFor(sink.filename);
+        ReportManifest previous;
+        bool reusable = previous.load(manifestPath, false) &&
+                        previous.format == static_cast<std::uint32_t>(sink.format) &&
+                        previous.threshold == sink.threshold &&
+                        fileSize(sink.filename) == static_cast<std::int64_t>(previous.reportSize);
+
+        // La base no cambió desde la última vez: el reporte sigue vigente (basta la cabecera)
+        if (reusable && changeCounter >= 0 && previous.changeCounter == changeCounter) {
+            return true;
+        }
+        reusable = reusable && previous.load(manifestPath);
+
+        ReportManifest next;
+        next.format = static_cast<std::uint32_t>(sink.format);
+        next.threshold = sink.threshold;
+        next.changeCounter = changeCounter;
+
+        // Filas del nuevo reporte y, para cada una, la fila anterior idéntica (o -1 si hay que renderizarla)
+        std::vector<const Component*> rowComponents;
+        std::vector<long> sources;
+        rowComponents.reserve(rowCount);
+        sources.reserve(rowCount);
+        next.rows.reserve(rowCount);
+
+        // Las filas conservan su orden relativo (un cambio de nombre solo mueve la fila
+        // renombrada), así que cada una se busca justo después de la anterior. El índice por
+        // ID solo se construye si se pierde el hilo muchas veces seguidas (p. ej. un borrado masivo)
+        const std::size_t lookahead = 16;
+        const std::size_t missesBeforeIndex = 64;
+        std::size_t cursor = 0, misses = 0;
+        std::unordered_map<int, std::size_t> previousRows;
+        forEachRow([&](const Component& component, std::uint64_t hash) {
+            if (!writer.includes(component)) return;
+            next.rows.push_back({component.getId(), 0, hash});
+            rowComponents.push_back(&component);
+
+            long source = -1;
+            if (reusable) {
+                std::size_t candidate = previous.rows.size();
+                const std::size_t end = std::min(previous.rows.size(), cursor + lookahead);
+                for (std::size_t i = cursor; i < end; ++i) {
+                    if (previous.rows[i].id == component.getId()) {
+                        candidate = i;
+                        break;
+                    }
+                }
+                if (candidate == previous.rows.size()) {
+                    if (previousRows.empty() && ++misses >= missesBeforeIndex) {
+                        previousRows.reserve(previous.rows.size());
+                        for (std::size_t i = 0; i < previous.rows.size(); ++i) {
+                            previousRows.emplace(previous.rows[i].id, i);
+                        }
+                    }
+                    auto found = previousRows.find(component.getId());
+                    if (found != previousRows.end()) candidate = found->second;
+                } else {
+                    misses = 0;
+                }
+                if (candidate < previous.rows.size()) {
+                    cursor = candidate + 1;
+                    if (previous.rows[candidate].hash == next.rows.back().hash) source = static_cast<long>(candidate);
+                }
+            }
+            sources.push_back(source);
+        });
+
+        OutputBuffer header(4096), footer(4096);
+        writer.writeHeader(header);
+        writer.writeFooter(footer);
+        next.headerLength = header.view().size();
+        next.footerLength = footer.view().size();
+
+        if (reusable) {
+            // Renderizar solo las filas que cambiaron
+            OutputBuffer fresh(64 * 1024);
+            std::vector<std::pair<std::size_t, std::size_t>> freshRanges(next.rows.size());
+            bool samePlaces = next.rows.size() == previous.rows.size() && next.headerLength == previous.headerLength &&
+                              next.footerLength == previous.footerLength;
+            for (std::size_t row = 0; row < next.rows.size(); ++row) {
+                if (sources[row] >= 0) {
+                    next.rows[row].length = previous.rows[static_cast<std::size_t>(sources[row])].length;
+                    samePlaces = samePlaces && sources[row] == static_cast<long>(row);
+                    continue;
+                }
+                const std::size_t start = fresh.view().size();
+                writer.writeRow(fresh, *rowComponents[row]);
+                freshRanges[row] = {start, fresh.view().size() - start};
+                next.rows[row].length = static_cast<std::uint32_t>(freshRanges[row].second);
+                samePlaces = samePlaces && previous.rows[row].id == next.rows[row].id &&
+                             previous.rows[row].length == next.rows[row].length;
+            }
+            const std::string_view freshBytes = fresh.view();
+
+            if (samePlaces) {
+                // Cada fila ocupa el mismo lugar que antes: se sobrescriben solo las partes nuevas.
+                // Se retira antes el manifiesto para que una interrupción no deje uno que no cuadre
+                std::remove(manifestPath.c_str());
+                std::FILE* file = std::fopen(sink.filename.c_str(), "r+b");
+                if (!file) return false;
+
+                bool written = std::fwrite(header.view().data(), 1, next.headerLength, file) == next.headerLength;
+                std::uint64_t offset = next.headerLength;
+                for (std::size_t row = 0; row < next.rows.size() && written; ++row) {
+                    if (sources[row] < 0) {
+                        written = std::fseek(file, static_cast<long>(offset), SEEK_SET) == 0 &&
+                                  std::fwrite(freshBytes.data() + freshRanges[row].first, 1, freshRanges[row].second,
+                                              file) == freshRanges[row].second;
+                    }
+                    offset += next.rows[row].length;
+                }
+                written = written && std::fseek(file, static_cast<long>(offset), SEEK_SET) == 0 &&
+                          std::fwrite(footer.view().data(), 1, next.footerLength, file) == next.footerLength;
+                written = std::fclose(file) == 0 && written;
+                if (!written) return false;
+
+                next.reportSize = previous.reportSize;
+                return next.save(manifestPath);
+            }
+
+            // Reconstruir copiando del reporte anterior las filas que no cambiaron
+            std::vector<char> previousBytes;
+            if (!readFile(sink.filename, previousBytes) || previousBytes.size() != previous.reportSize) {
+                return false;
+            }
+            std::vector<std::uint64_t> previousOffsets(previous.rows.size());
+            std::uint64_t offset = previous.headerLength;
+            for (std::size_t i = 0; i < previous.rows.size(); ++i) {
+                previousOffsets[i] = offset;
+                offset += previous.rows[i].length;
+            }
+
+            const std::string tempPath = sink.filename + ".tmp";
+            OutputBuffer out;
+            if (!out.open(tempPath, true)) return false;
+            out.write(header.view());
+
+            // Las filas copiadas que siguen contiguas en el archivo anterior se copian de una vez
+            std::uint64_t runStart = 0, runEnd = 0;
+            for (std::size_t row = 0; row < next.rows.size(); ++row) {
+                if (sources[row] >= 0) {
+                    const std::size_t source = static_cast<std::size_t>(sources[row]);
+                    if (runEnd != previousOffsets[source]) {
+                        out.write(std::string_view(previousBytes.data() + runStart, runEnd - runStart));
+                        runStart = previousOffsets[source];
+                    }
+                    runEnd = previousOffsets[source] + previous.rows[source].length;
+                } else {
+                    out.write(std::string_view(previousBytes.data() + runStart, runEnd - runStart));
+                    runStart = runEnd = 0;
+                    out.write(freshBytes.substr(freshRanges[row].first, freshRanges[row].second));
+                }
+            }
+            out.write(std::string_view(previousBytes.data() + runStart, runEnd - runStart));
+            out.write(footer.view());
+
+            next.reportSize = out.position();
+            if (!out.close() || !replaceFile(tempPath, sink.filename)) return false;
+            return next.save(manifestPath);
+        }
+
+        // Sin manifiesto válido: generar el reporte completo midiendo cada fila
+        const std::string tempPath = sink.filename + ".tmp";
+        OutputBuffer out;
+        if (!out.open(tempPath, true)) return false;
+        out.write(header.view());
+
+        OutputBuffer* outputs[] = {&out};
+        renderRows(outputs, 1, rowComponents.size(), ReportGenerator::getRenderMode() == ReportGenerator::RenderMode::Parallel,
+                   [&writer, &rowComponents, &next](OutputBuffer* const* targets, std::size_t row) {
+            const std::uint64_t start = targets[0]->position();
+            writer.writeRow(*targets[0], *rowComponents[row]);
+            next.rows[row].length = static_cast<std::uint32_t>(targets[0]->position() - start);
+        });
+        out.write(footer.view());
+
+        next.reportSize = out.position();
+        if (!out.close() || !replaceFile(tempPath, sink.filename)) {
+            std::cerr << "Error al escribir el reporte: " << sink.filename << std::endl;
+            return false;
+        }
+        return next.save(manifestPath);
+    }
+
+    /**
+     * Efecto neto de los cambios de un componente en un periodo: sus valores al comienzo
+     * (del primer cambio) y al final (del último).
+     */
+    struct ComponentDelta
+    {
+        bool existedBefore; // Existía al comienzo del periodo
+        bool existsAfter; // Existe al final del periodo
+        Component before; // Valores al comienzo (si existedBefore)
+        Component after; // Valores al final (si existsAfter)
+
+        // Valores con que se identifica en el reporte: los actuales o, si se eliminó, los últimos
+        const Component& current() const { return existsAfter ? after : before; }
+    };
+
+    enum class DeltaKind { Added, Removed, Modified, Unchanged };
+
+    DeltaKind deltaKind(const ComponentDelta& delta) {
+        if (!delta.existedBefore) return delta.existsAfter ? DeltaKind::Added : DeltaKind::Unchanged;
+        if (!delta.existsAfter) return DeltaKind::Removed;
+        const Component& before = delta.before;
+        const Component& after = delta.after;
+        // Un cambio deshecho dentro del periodo no es un cambio
+        const bool same = before.getName() == after.getName() && before.getType() == after.getType() &&
+                          before.getQuantity() == after.getQuantity() && before.getLocation() == after.getLocation() &&
+                          before.getPurchaseDate() == after.getPurchaseDate();
+        return same ? DeltaKind::Unchanged : DeltaKind::Modified;
+    }
+
+    // Escribe en qué consistió el cambio de un componente ("Cantidad, Ubicación", etc.)
+    void writeChange(OutputBuffer& out, const ComponentDelta& delta, DeltaKind kind) {
+        if (kind == DeltaKind::Added) {
+            out.write("Agregado");
+            return;
+        }
+        if (kind == DeltaKind::Removed) {
+            out.write("Eliminado");
+            return;
+        }
+        const Component& before = delta.before;
+        const Component& after = delta.after;
+        std::string_view separator;
+        if (before.getQuantity() != after.getQuantity()) {
+            out.write("Cantidad");
+            separator = ", ";
+        }
+        if (before.getLocation() != after.getLocation()) {
+            out.write(separator);
+            out.write("Ubicación");
+            separator = ", ";
+        }
+        if (before.getName() != after.getName() || before.getType() != after.getType() ||
+            before.getPurchaseDate() != after.getPurchaseDate()) {
+            out.write(separator);
+            out.write("Datos");
+        }
+    }
+}
+
+std::atomic<ReportGenerator::RenderMode> ReportGenerator::renderMode(ReportGenerator::RenderMode::Parallel);
+
+void ReportGenerator::setRenderMode(RenderMode mode) {
+    renderMode.store(mode);
+}
+
+ReportGenerator::RenderMode ReportGenerator::getRenderMode() {
+    return renderMode.load();
+}
+
+bool ReportGenerator::generateCSVReport(const std::vector<Component>& components, const std::string& filename) {
+    ReportWriter writer{ReportFormat::CSV, 0, components.size(), 0, 0};
+    return writeReport(writer, filename, components.size(),
+                       [&components](std::size_t row) -> const Component& { return components[row]; });
 }
 
 bool ReportGenerator::generateHTMLReport(const std::vector<Component>& components, const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        return false;
-    }
-    
     // Contar componentes con stock bajo
     int lowStockCount = std::count_if(components.begin(), components.end(),
                                       [](const Component& c) { return c.isLowStock(); });
-    
+
     // Calcular valor total del inventario (asumiendo un valor promedio por tipo)
     // Esta es una implementación simple - puedes mejorarla
-    int totalQuantity = 0;
+    long long totalQuantity = 0;
     for (const auto& component : components) {
         totalQuantity += component.getQuantity();
     }
-    
-    // Generar HTML
-    file << "<!DOCTYPE html>\n"
-         << "<html lang=\"es\">\n"
-         << "<head>\n"
-         << "    <meta charset=\"UTF-8\">\n"
-         << "    <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">\n"
-         << "    <title>Reporte de Inventario</title>\n"
-         << "    <style>\n"
-         << "        * {\n"
-         << "            margin: 0;\n"
-         << "            padding: 0;\n"
-         << "            box-sizing: border-box;\n"
-         << "            font-family: 'Segoe UI', Tahoma, Geneva, Verdana, sans-serif;\n"
-         << "        }\n"
-         << "        body {\n"
-         << "            background-color: #f5f5f5;\n"
-         << "            color: #333;\n"
-         << "            line-height: 1.6;\n"
-         << "            padding: 20px;\n"
-         << "        }\n"
-         << "        .container {\n"
-         << "            max-width: 1200px;\n"
-         << "            margin: 0 auto;\n"
-         << "            background: white;\n"
-         << "            border-radius: 10px;\n"
-         << "            box-shadow: 0 0 20px rgba(0,0,0,0.1);\n"
-         << "            padding: 30px;\n"
-         << "        }\n"
-         << "        .header {\n"
-         << "            text-align: center;\n"
-         << "            margin-bottom: 30px;\n"
-         << "            border-bottom: 3px solid #4CAF50;\n"
-         << "            padding-bottom: 20px;\n"
-         << "        }\n"
-         << "        h1 {\n"
-         << "            color: #2c3e50;\n"
-         << "            font-size: 2.5em;\n"
-         << "            margin-bottom: 10px;\n"
-         << "        }\n"
-         << "        .subtitle {\n"
-         << "            color: #7f8c8d;\n"
-         << "            font-size: 1.1em;\n"
-         << "        }\n"
-         << "        .summary {\n"
-         << "            display: grid;\n"
-         << "            grid-template-columns: repeat(auto-fit, minmax(200px, 1fr));\n"
-         << "            gap: 20px;\n"
-         << "            margin-bottom: 30px;\n"
-         << "        }\n"
-         << "        .summary-card {\n"
-         << "            background: #f8f9fa;\n"
-         << "            border-radius: 8px;\n"
-         << "            padding: 20px;\n"
-         << "            text-align: center;\n"
-         << "            border-left: 4px solid #4CAF50;\n"
-         << "        }\n"
-         << "        .summary-card.warning {\n"
-         << "            border-left-color: #e74c3c;\n"
-         << "        }\n"
-         << "        .summary-card h3 {\n"
-         << "            font-size: 1.2em;\n"
-         << "            color: #2c3e50;\n"
-         << "            margin-bottom: 10px;\n"
-         << "        }\n"
-         << "        .summary-card .number {\n"
-         << "            font-size: 2em;\n"
-         << "            font-weight: bold;\n"
-         << "            color: #4CAF50;\n"
-         << "        }\n"
-         << "        .summary-card.warning .number {\n"
-         << "            color: #e74c3c;\n"
-         << "        }\n"
-         << "        table {\n"
-         << "            width: 100%;\n"
-         << "            border-collapse: collapse;\n"
-         << "            margin-top: 20px;\n"
-         << "            font-size: 0.95em;\n"
-         << "        }\n"
-         << "        th {\n"
-         << "            background-color: #4CAF50;\n"
-         << "            color: white;\n"
-         << "            padding: 12px 15px;\n"
-         << "            text-align: left;\n"
-         << "            font-weight: 600;\n"
-         << "        }\n"
-         << "        td {\n"
-         << "            padding: 10px 15px;\n"
-         << "            border-bottom: 1px solid #ddd;\n"
-         << "        }\n"
-         << "        tr:hover {\n"
-         << "            background-color: #f5f5f5;\n"
-         << "        }\n"
-         << "        .low-stock {\n"
-         << "            background-color: #ffeaea !important;\n"
-         << "            font-weight: bold;\n"
-         << "        }\n"
-         << "        .quantity-low {\n"
-         << "            color: #e74c3c;\n"
-         << "            font-weight: bold;\n"
-         << "        }\n"
-         << "        .footer {\n"
-         << "            margin-top: 40px;\n"
-         << "            text-align: center;\n"
-         << "            color: #7f8c8d;\n"
-         << "            font-size: 0.9em;\n"
-         << "            border-top: 1px solid #eee;\n"
-         << "            padding-top: 20px;\n"
-         << "        }\n"
-         << "        @media print {\n"
-         << "            body {\n"
-         << "                background: white;\n"
-                 << "            }\n"
-                 << "            .container {\n"
-                 << "                box-shadow: none;\n"
-                 << "            }\n"
-                 << "        }\n"
-                 << "    </style>\n"
-                 << "</head>\n"
-                 << "<body>\n"
-                 << "    <div class=\"container\">\n"
-                 << "        <div class=\"header\">\n"
-                 << "            <h1>📦 Reporte de Inventario</h1>\n"
-                 << "            <p class=\"subtitle\">Sistema de Gestión para Hogar/Laboratorio</p>\n"
-                 << "            <p>Generado: " << getCurrentDateTime() << "</p>\n"
-                 << "        </div>\n"
-                 << "        \n"
-                 << "        <div class=\"summary\">\n"
-                 << "            <div class=\"summary-card\">\n"
-                 << "                <h3>Total de Componentes</h3>\n"
-                 << "                <div class=\"number\">" << components.size() << "</div>\n"
-                 << "            </div>\n"
-                 << "            <div class=\"summary-card\">\n"
-                 << "                <h3>Cantidad Total</h3>\n"
-                 << "                <div class=\"number\">" << totalQuantity << "</div>\n"
-                 << "            </div>\n"
-                 << "            <div class=\"summary-card" << (lowStockCount > 0 ? " warning" : "") << "\">\n"
-                 << "                <h3>Componentes con Stock Bajo</h3>\n"
-                 << "                <div class=\"number\">" << lowStockCount << "</div>\n"
-                 << "            </div>\n"
-                 << "        </div>\n"
-                 << "        \n"
-                 << "        <h2>📋 Lista de Componentes</h2>\n"
-                 << "        <table>\n"
-                 << "            <thead>\n"
-                 << "                <tr>\n"
-                 << "                    <th>ID</th>\n"
-                 << "                    <th>Nombre</th>\n"
-                 << "                    <th>Tipo</th>\n"
-                 << "                    <th>Cantidad</th>\n"
-                 << "                    <th>Ubicación</th>\n"
-                 << "                    <th>Fecha Compra</th>\n"
-                 << "                    <th>Estado</th>\n"
-                 << "                </tr>\n"
-                 << "            </thead>\n"
-                 << "            <tbody>\n";
-    
-    // Filas de datos
-    for (const auto& component : components) {
-        bool isLowStock = component.isLowStock();
-        std::string rowClass = isLowStock ? " class=\"low-stock\"" : "";
-        
-        file << "                <tr" << rowClass << ">\n"
-             << "                    <td>" << component.getId() << "</td>\n"
-             << "                    <td>" << escapeHTML(component.getName()) << "</td>\n"
-             << "                    <td>" << escapeHTML(component.getType()) << "</td>\n"
-             << "                    <td class=\"" << (isLowStock ? "quantity-low" : "") << "\">"
-             << component.getQuantity() << "</td>\n"
-             << "                    <td>" << escapeHTML(component.getLocation()) << "</td>\n"
-             << "                    <td>" << component.getPurchaseDateString() << "</td>\n"
-             << "                    <td>" << (isLowStock ? "⚠️ STOCK BAJO" : "✅ OK") << "</td>\n"
-             << "                </tr>\n";
+
+    return writeHTMLReport(components, filename, lowStockCount, totalQuantity);
+}
+
+bool ReportGenerator::generateJSONLinesReport(const std::vector<Component>& components, const std::string& filename) {
+    ReportWriter writer{ReportFormat::JSONLines, 0, components.size(), 0, 0};
+    return writeReport(writer, filename, components.size(),
+                       [&components](std::size_t row) -> const Component& { return components[row]; });
+}
+
+bool ReportGenerator::generateColumnarExport(const ComponentTable& table, const std::string& filename) {
+    return writeColumnar(table, filename);
+}
+
+bool ReportGenerator::generatePDFReport(const std::vector<Component>& components, const std::string& filename) {
+    ReportTotals totals{components.size(), 0, 0};
+    for (const Component& component : components) {
+        totals.totalQuantity += component.getQuantity();
+        if (component.isLowStock()) ++totals.lowStockCount;
     }
-    
-    file << "            </tbody>\n"
-         << "        </table>\n"
-         << "        \n"
-         << "        <div class=\"footer\">\n"
-         << "            <p>Sistema desarrollado en C++ con Qt y SQLite</p>\n"
-         << "            <p>© 2024 - Gestor de Inventario para Hogar/Laboratorio</p>\n"
-         << "            <p>Reporte generado automáticamente</p>\n"
-         << "        </div>\n"
-         << "    </div>\n"
-         << "</body>\n"
-         << "</html>\n";
-    
-    file.close();
-    return true;
+
+    return writePDF(filename, totals, [&components](const RowVisitor& visitor) {
+        for (const Component& component : components) visitor(component);
+        return true;
+    });
+}
+
+bool ReportGenerator::generateHTMLReport(const std::vector<Component>& components, const ComponentTable& table,
+                                         const std::string& filename) {
+    // Los totales salen de la tabla columnar sin recorrer los objetos Component
+    return writeHTMLReport(components, filename, table.countAtOrBelow(5), table.sumQuantities());
+}
+
+bool ReportGenerator::writeHTMLReport(const std::vector<Component>& components, const std::string& filename,
+                                      std::size_t lowStockCount, long long totalQuantity) {
+    ReportWriter writer{ReportFormat::HTML, 5, components.size(), totalQuantity, lowStockCount};
+    return writeReport(writer, filename, components.size(),
+                       [&components](std::size_t row) -> const Component& { return components[row]; });
 }
 
 bool ReportGenerator::generateTextReport(const std::vector<Component>& components, const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        return false;
-    }
-    
-    file << "=========================================\n";
-    file << "      REPORTE DE INVENTARIO\n";
-    file << "=========================================\n";
-    file << "Generado: " << getCurrentDateTime() << "\n";
-    file << "Total de componentes: " << components.size() << "\n";
-    file << "=========================================\n\n";
-    
+    ReportWriter writer{ReportFormat::Text, 0, components.size(), 0, 0};
+    return writeReport(writer, filename, components.size(),
+                       [&components](std::size_t row) -> const Component& { return components[row]; });
+}
+
+bool ReportGenerator::generateLowStockReport(const std::vector<Component>& components, const std::string& filename, int threshold) {
+    // Filtrar componentes con stock bajo
+    std::vector<const Component*> lowStockComponents;
     for (const auto& component : components) {
-        file << "ID: " << component.getId() << "\n";
-        file << "Nombre: " << component.getName() << "\n";
-        file << "Tipo: " << component.getType() << "\n";
-        file << "Cantidad: " << component.getQuantity();
-        
-        if (component.isLowStock()) {
-            file << " [STOCK BAJO!]";
+        if (component.getQuantity() <= threshold) {
+            lowStockComponents.push_back(&component);
         }
-        file << "\n";
-        
-        file << "Ubicación: " << component.getLocation() << "\n";
-        file << "Fecha Compra: " << component.getPurchaseDateString() << "\n";
-        file << "-----------------------------------------\n";
     }
-    
-    file.close();
-    return true;
+
+    return writeLowStockReport(lowStockComponents, filename, threshold);
 }
 
-bool ReportGenerator::generateLowStockReport(const std::vector<Component>& components, const std::string& filename, int threshold) {
-    // Filtrar componentes con stock bajo
-    std::vector<Component> lowStockComponents;
-    std::copy_if(components.begin(), components.end(),
-                 std::back_inserter(lowStockComponents),
-                 [threshold](const Component& c) { return c.getQuantity() <= threshold; });
-    
-    if (lowStockComponents.empty()) {
-        // Si no hay componentes con stock bajo, crear un reporte indicándolo
-        std::ofstream file(filename);
-        if (!file.is_open()) return false;
-        
-        file << "REPORTE DE STOCK BAJO\n";
-        file << "=====================\n";
-        file << "Fecha: " << getCurrentDateTime() << "\n";
-        file << "Umbral: " << threshold << " unidades\n";
-        file << "=====================\n\n";
-        file << "✅ No hay componentes con stock bajo.\n";
-        file << "Todo el inventario está en niveles adecuados.\n";
-        
-        file.close();
-        return true;
+bool ReportGenerator::generateLowStockReport(const std::vector<Component>& components, const ComponentTable& table,
+                                             const std::string& filename, int threshold) {
+    // El filtro recorre solo la columna de cantidades
+    std::vector<const Component*> lowStockComponents;
+    for (std::uint32_t row : table.filterAtOrBelow(threshold)) {
+        lowStockComponents.push_back(&components[row]);
     }
-    
-    // Generar reporte HTML específico para stock bajo
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        return false;
+
+    return writeLowStockReport(lowStockComponents, filename, threshold);
+}
+
+bool ReportGenerator::writeLowStockReport(const std::vector<const Component*>& lowStockComponents,
+                                          const std::string& filename, int threshold) {
+    ReportWriter writer{ReportFormat::LowStock, threshold, 0, 0, lowStockComponents.size()};
+    return writeReport(writer, filename, lowStockComponents.size(),
+                       [&lowStockComponents](std::size_t row) -> const Component& { return *lowStockComponents[row]; });
+}
+
+bool ReportGenerator::generateReports(const std::vector<Component>& components, const ComponentTable& table,
+                                      const std::vector<ReportSink>& sinks) {
+    // Los totales de todas las cabeceras salen de la tabla columnar antes del recorrido
+    const long long totalQuantity = table.sumQuantities();
+    const std::size_t htmlLowStockCount = table.countAtOrBelow(5);
+
+    std::vector<ReportWriter> writers;
+    std::vector<std::unique_ptr<OutputBuffer>> buffers;
+    std::vector<OutputBuffer*> outputs;
+    std::vector<const ReportSink*> rowSinks;
+    std::vector<const ReportSink*> wholeSinks;
+    for (const ReportSink& sink : sinks) {
+        // Columnar y PDF no se componen de filas de texto independientes: se escriben al
+        // final, cada uno con su propio recorrido
+        if (sink.format == ReportFormat::Columnar || sink.format == ReportFormat::PDF) {
+            wholeSinks.push_back(&sink);
+            continue;
+        }
+
+        ReportWriter writer{sink.format, sink.threshold, components.size(), totalQuantity, 0};
+        if (sink.format == ReportFormat::HTML) {
+            writer.lowStockCount = htmlLowStockCount;
+        } else if (sink.format == ReportFormat::LowStock) {
+            writer.lowStockCount = sink.threshold == 5 ? htmlLowStockCount : table.countAtOrBelow(sink.threshold);
+        }
+
+        buffers.push_back(std::make_unique<OutputBuffer>());
+        if (!openReport(*buffers.back(), sink.filename)) {
+            std::cerr << "No se pudo crear el reporte: " << sink.filename << std::endl;
+            return false;
+        }
+        outputs.push_back(buffers.back().get());
+        writers.push_back(writer);
+        rowSinks.push_back(&sink);
     }
-    
-    file << "<!DOCTYPE html>\n"
-         << "<html lang=\"es\">\n"
-         << "<head>\n"
-         << "    <meta charset=\"UTF-8\">\n"
-         << "    <title>Alerta: Stock Bajo</title>\n"
-         << "    <style>\n"
-         << "        body { font-family: Arial, sans-serif; margin: 40px; }\n"
-         << "        .alert { background-color: #fff3cd; border: 1px solid #ffeaa7; padding: 20px; margin: 20px 0; }\n"
-         << "        .warning { color: #856404; }\n"
-         << "        table { border-collapse: collapse; width: 100%; margin-top: 20px; }\n"
-         << "        th, td { border: 1px solid #ddd; padding: 8px; text-align: left; }\n"
-         << "        th { background-color: #dc3545; color: white; }\n"
-         << "        tr:nth-child(even) { background-color: #f8d7da; }\n"
-         << "    </style>\n"
-         << "</head>\n"
-         << "<body>\n"
-         << "    <h1 class=\"warning\">⚠️ ALERTA: COMPONENTES CON STOCK BAJO</h1>\n"
-         << "    <div class=\"alert\">\n"
-         << "        <p><strong>Fecha:</strong> " << getCurrentDateTime() << "</p>\n"
-         << "        <p><strong>Umbral de stock bajo:</strong> " << threshold << " unidades</p>\n"
-         << "        <p><strong>Total de componentes afectados:</strong> " << lowStockComponents.size() << "</p>\n"
-         << "    </div>\n"
-         << "    \n"
-         << "    <table>\n"
-         << "        <tr>\n"
-         << "            <th>ID</th>\n"
-         << "            <th>Nombre</th>\n"
-         << "            <th>Tipo</th>\n"
-         << "            <th>Cantidad Actual</th>\n"
-         << "            <th>Ubicación</th>\n"
-         << "            <th>Acción Recomendada</th>\n"
-         << "        </tr>\n";
-    
-    for (const auto& component : lowStockComponents) {
-        file << "        <tr>\n"
-             << "            <td>" << component.getId() << "</td>\n"
-             << "            <td>" << escapeHTML(component.getName()) << "</td>\n"
-             << "            <td>" << escapeHTML(component.getType()) << "</td>\n"
-             << "            <td><strong>" << component.getQuantity() << "</strong> unidades</td>\n"
-             << "            <td>" << escapeHTML(component.getLocation()) << "</td>\n"
-             << "            <td>REABASTECER URGENTE</td>\n"
-             << "        </tr>\n";
+
+    for (std::size_t i = 0; i < writers.size(); ++i) {
+        writers[i].writeHeader(*outputs[i]);
     }
-    
-    file << "    </table>\n"
-         << "    \n"
-         << "    <div style=\"margin-top: 30px; padding: 15px; background-color: #d4edda; border: 1px solid #c3e6cb;\">\n"
-         << "        <h3>Recomendaciones:</h3>\n"
-         << "        <ul>\n"
-         << "            <li>Verificar inventario de estos componentes</li>\n"
-         << "            <li>Realizar pedido de reposición</li>\n"
-         << "            <li>Actualizar niveles mínimos de stock si es necesario</li>\n"
-         << "        </ul>\n"
-         << "    </div>\n"
-         << "</body>\n"
-         << "</html>\n";
-    
-    file.close();
-    return true;
+
+    // Un solo recorrido de los componentes alimenta a todos los reportes
+    renderRows(outputs.data(), outputs.size(), components.size(), getRenderMode() == RenderMode::Parallel,
+               [&writers, &components](OutputBuffer* const* targets, std::size_t row) {
+        const Component& component = components[row];
+        for (std::size_t i = 0; i < writers.size(); ++i) {
+            writers[i].writeRow(*targets[i], component);
+        }
+    });
+
+    bool success = true;
+    for (std::size_t i = 0; i < writers.size(); ++i) {
+        writers[i].writeFooter(*outputs[i]);
+        if (!outputs[i]->close()) {
+            std::cerr << "Error al escribir el reporte: " << rowSinks[i]->filename << std::endl;
+            success = false;
+        }
+    }
+    for (const ReportSink* sink : wholeSinks) {
+        const bool written = sink->format == ReportFormat::Columnar
+            ? writeColumnar(table, sink->filename)
+            : writePDF(sink->filename, ReportTotals{components.size(), totalQuantity, htmlLowStockCount},
+                       [&components](const RowVisitor& visitor) {
+                           for (const Component& component : components) visitor(component);
+                           return true;
+                       });
+        if (!written) {
+            std::cerr << "Error al escribir el reporte: " << sink->filename << std::endl;
+            success = false;
+        }
+    }
+    return success;
 }
 
-// Métodos privados
-std::string ReportGenerator::getCurrentDateTime() {
-    std::time_t now = std::time(nullptr);
-    std::tm* timeinfo = std::localtime(&now);
-    char buffer[80];
-    std::strftime(buffer, 80, "%Y-%m-%d %H:%M:%S", timeinfo);
-    return std::string(buffer);
+bool ReportGenerator::streamReport(const ReportSink& sink, const ReportTotals& totals, const RowSource& source) {
+    return streamReports({sink}, {totals}, source);
 }
 
-std::string ReportGenerator::escapeCSV(const std::string& input) {
-    std::string output = input;
-    
-    // Reemplazar comillas dobles por dos comillas dobles (escapado CSV)
-    size_t pos = 0;
-    while ((pos = output.find("\"", pos)) != std::string::npos) {
-        output.replace(pos, 1, "\"\"");
-        pos += 2;
+bool ReportGenerator::streamReports(const std::vector<ReportSink>& sinks, const std::vector<ReportTotals>& totals,
+                                    const RowSource& source) {
+    // Destinos de filas de texto (renderizadas por lotes), columnares (acumulados en una
+    // tabla) y PDF (cada fila va directamente a su página)
+    std::vector<ReportWriter> writers;
+    std::vector<std::unique_ptr<OutputBuffer>> buffers;
+    std::vector<OutputBuffer*> outputs;
+    std::vector<const ReportSink*> rowSinks;
+    std::vector<std::unique_ptr<ComponentTable>> tables;
+    std::vector<const ReportSink*> tableSinks;
+    std::vector<std::unique_ptr<OutputBuffer>> pdfBuffers;
+    std::vector<std::unique_ptr<PdfReportWriter>> pdfWriters;
+    std::vector<const ReportSink*> pdfSinks;
+    bool success = true;
+
+    for (std::size_t i = 0; i < sinks.size(); ++i) {
+        const ReportSink& sink = sinks[i];
+        const ReportTotals& sinkTotals = totals[i];
+        if (sink.format == ReportFormat::Columnar) {
+            // Las columnas y los diccionarios se completan con la última fila
+            tables.push_back(std::make_unique<ComponentTable>());
+            tables.back()->reserve(sinkTotals.componentCount);
+            tableSinks.push_back(&sink);
+            continue;
+        }
+
+        auto out = std::make_unique<OutputBuffer>();
+        if (!openReport(*out, sink.filename, sink.format == ReportFormat::PDF)) {
+            std::cerr << "No se pudo crear el reporte: " << sink.filename << std::endl;
+            return false;
+        }
+        if (sink.format == ReportFormat::PDF) {
+            auto writer = std::make_unique<PdfReportWriter>(*out);
+            if (!writer->begin(sinkTotals.componentCount, sinkTotals.totalQuantity, sinkTotals.lowStockCount)) {
+                std::cerr << "No se pudo crear el reporte: " << sink.filename << std::endl;
+                return false;
+            }
+            pdfBuffers.push_back(std::move(out));
+            pdfWriters.push_back(std::move(writer));
+            pdfSinks.push_back(&sink);
+            continue;
+        }
+
+        writers.push_back({sink.format, sink.threshold, sinkTotals.componentCount, sinkTotals.totalQuantity,
+                           sinkTotals.lowStockCount});
+        writers.back().writeHeader(*out);
+        outputs.push_back(out.get());
+        buffers.push_back(std::move(out));
+        rowSinks.push_back(&sink);
     }
-    
-    return output;
+
+    // Los Component del lote se reutilizan: la asignación conserva la memoria de los textos
+    std::vector<Component> batch(writers.empty() ? 0 : STREAM_BATCH_ROWS);
+    std::size_t batchSize = 0;
+    const bool parallel = getRenderMode() == RenderMode::Parallel;
+    auto renderBatch = [&]() {
+        renderRows(outputs.data(), outputs.size(), batchSize, parallel,
+                   [&writers, &batch](OutputBuffer* const* targets, std::size_t row) {
+            for (std::size_t i = 0; i < writers.size(); ++i) writers[i].writeRow(*targets[i], batch[row]);
+        });
+        batchSize = 0;
+    };
+
+    // Un solo recorrido de la fuente alimenta a todos los reportes. Una fila que no produce
+    // ninguna de texto (p. ej. por encima del umbral en un LowStock solo) no se copia al lote
+    const bool complete = source([&](const Component& component) {
+        for (const std::unique_ptr<ComponentTable>& table : tables) table->append(component);
+        for (const std::unique_ptr<PdfReportWriter>& writer : pdfWriters) writer->addRow(component);
+        if (std::any_of(writers.begin(), writers.end(),
+                        [&component](const ReportWriter& writer) { return writer.includes(component); })) {
+            batch[batchSize++] = component;
+            if (batchSize == batch.size()) renderBatch();
+        }
+        return true;
+    });
+    if (!complete) {
+        std::cerr << "No se pudieron leer todas las filas de los reportes" << std::endl;
+    }
+
+    renderBatch();
+    for (std::size_t i = 0; i < writers.size(); ++i) {
+        writers[i].writeFooter(*outputs[i]);
+        if (!outputs[i]->close()) {
+            std::cerr << "Error al escribir el reporte: " << rowSinks[i]->filename << std::endl;
+            success = false;
+        }
+    }
+    for (std::size_t i = 0; i < pdfWriters.size(); ++i) {
+        const bool finished = pdfWriters[i]->finish();
+        if (!pdfBuffers[i]->close() || !finished) {
+            std::cerr << "Error al escribir el reporte: " << pdfSinks[i]->filename << std::endl;
+            success = false;
+        }
+    }
+    // Una tabla incompleta no se escribe: el columnar no tiene filas que puedan quedar a medias
+    for (std::size_t i = 0; i < tables.size() && complete; ++i) {
+        if (!writeColumnar(*tables[i], tableSinks[i]->filename)) {
+            std::cerr << "No se pudo crear el reporte: " << tableSinks[i]->filename << std::endl;
+            success = false;
+        }
+    }
+    return success && complete;
 }
 
-std::string ReportGenerator::escapeHTML(const std::string& input) {
-    std::string output = input;
-    
-    // Reemplazar caracteres especiales HTML
-    size_t pos = 0;
-    while ((pos = output.find("&", pos)) != std::string::npos) {
-        output.replace(pos, 1, "&amp;");
-        pos += 5;
+bool ReportGenerator::generatePagedHTMLReport(const std::vector<Component>& components, const ComponentTable& table,
+                                              const std::string& directory, PageGrouping grouping, std::size_t pageSize) {
+    const ReportTotals totals{components.size(), table.sumQuantities(), table.countAtOrBelow(5)};
+    return writePagedReport(VectorRows{components}, totals, directory, grouping, pageSize);
+}
+
+bool ReportGenerator::generatePagedHTMLReport(const InventorySnapshot& snapshot, const std::string& directory,
+                                              PageGrouping grouping, std::size_t pageSize) {
+    const ReportTotals totals{snapshot.size(), snapshot.sumQuantities(), snapshot.countAtOrBelow(5)};
+    return writePagedReport(snapshot, totals, directory, grouping, pageSize);
+}
+
+bool ReportGenerator::generateChangeReport(DatabaseManager& database, std::time_t since, std::time_t until,
+                                           ReportFormat format, const std::string& filename) {
+    if (format != ReportFormat::HTML && format != ReportFormat::CSV) {
+        std::cerr << "El reporte de cambios solo se genera en HTML o CSV: " << filename << std::endl;
+        return false;
     }
-    
-    pos = 0;
-    while ((pos = output.find("<", pos)) != std::string::npos) {
-        output.replace(pos, 1, "&lt;");
-        pos += 4;
+
+    // Los cambios del periodo se reducen a uno por componente: la memoria y el tiempo
+    // dependen de cuántos componentes cambiaron, no del tamaño del inventario
+    std::vector<ComponentDelta> deltas;
+    std::unordered_map<int, std::size_t> positions;
+    std::time_t trackingStart;
+    bool read;
+    {
+        auto lock = database.lockConnection();
+        const bool snapshot = database.beginReadTransaction();
+        trackingStart = database.getChangeTrackingStart();
+        read = database.forEachChange(since, until, [&](const DatabaseManager::ComponentChange& change) {
+            auto position = positions.emplace(change.componentId, deltas.size());
+            if (position.second) {
+                deltas.push_back({change.existedBefore, false, change.before, Component()});
+            }
+            ComponentDelta& delta = deltas[position.first->second];
+            delta.existsAfter = change.existsAfter;
+            if (change.existsAfter) delta.after = change.after;
+            return true;
+        });
+        if (snapshot) database.commitTransaction();
     }
-    
-    pos = 0;
-    while ((pos = output.find(">", pos)) != std::string::npos) {
-        output.replace(pos, 1, "&gt;");
-        pos += 4;
+    if (!read) {
+        std::cerr << "No se pudo leer el registro de cambios" << std::endl;
+        return false;
     }
-    
-    pos = 0;
-    while ((pos = output.find("\"", pos)) != std::string::npos) {
-        output.replace(pos, 1, "&quot;");
-        pos += 6;
+
+    // Agregados, eliminados y modificados, cada grupo por nombre
+    std::vector<std::pair<DeltaKind, const ComponentDelta*>> rows;
+    rows.reserve(deltas.size());
+    std::size_t addedCount = 0, removedCount = 0, quantityChangedCount = 0, movedCount = 0;
+    for (const ComponentDelta& delta : deltas) {
+        const DeltaKind kind = deltaKind(delta);
+        if (kind == DeltaKind::Unchanged) continue;
+        rows.emplace_back(kind, &delta);
+        if (kind == DeltaKind::Added) ++addedCount;
+        if (kind == DeltaKind::Removed) ++removedCount;
+        if (kind == DeltaKind::Modified) {
+            if (delta.before.getQuantity() != delta.after.getQuantity()) ++quantityChangedCount;
+            if (delta.before.getLocation() != delta.after.getLocation()) ++movedCount;
+        }
     }
-    
-    return output;
-}
\ No newline at end of file
+    std::stable_sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        if (a.first != b.first) return a.first < b.first;
+        return a.second->current().getName() < b.second->current().getName();
+    });
+
+    OutputBuffer out;
+    if (!openReport(out, filename)) {
+        std::cerr << "No se pudo crear el reporte: " << filename << std::endl;
+        return false;
+    }
+
+    const ReportTemplates& compiled = templates();
+    const bool html = format == ReportFormat::HTML;
+    if (html) {
+        compiled.changeHeader.render(out, [&](int field, OutputBuffer& target) {
+            switch (field) {
+                case Generated: writeCurrentDateTime(target); break;
+                case PeriodStart: target.write(DateFormatter::formatDateTime(since)); break;
+                case PeriodEnd: target.write(DateFormatter::formatDateTime(until)); break;
+                case TrackingNote:
+                    // Lo anterior al registro de cambios no se conoce: el reporte podría estar incompleto
+                    if (trackingStart > since) {
+                        target.write("            <p class=\"quantity-low\">Los cambios se registran desde el ");
+                        target.write(DateFormatter::formatDateTime(trackingStart));
+                        target.write(": los anteriores no aparecen en este reporte.</p>\n");
+                    }
+                    break;
+                case AddedCount: target.writeUnsigned(addedCount); break;
+                case RemovedCount: target.writeUnsigned(removedCount); break;
+                case QuantityChangedCount: target.writeUnsigned(quantityChangedCount); break;
+                case MovedCount: target.writeUnsigned(movedCount); break;
+                default: break;
+            }
+        });
+    } else {
+        out.write("ID,Nombre,Tipo,Cambio,Cantidad Anterior,Cantidad,Ubicación Anterior,Ubicación\n");
+    }
+
+    const Escape escape = html ? Escape::HTML : Escape::CSV;
+    for (const auto& row : rows) {
+        const DeltaKind kind = row.first;
+        const ComponentDelta& delta = *row.second;
+        const Component& current = delta.current();
+        const ReportTemplate& rowTemplate = html ? compiled.changeRow : compiled.changeCsvRow;
+        rowTemplate.render(out, [&](int field, OutputBuffer& target) {
+            switch (field) {
+                case Id: target.writeInteger(current.getId()); break;
+                case Name: writeText(target, current.getName(), escape); break;
+                case Type: writeText(target, current.getType(), escape); break;
+                case Change: writeChange(target, delta, kind); break;
+                case QuantityBefore: if (delta.existedBefore) target.writeInteger(delta.before.getQuantity()); break;
+                case LocationBefore: if (delta.existedBefore) writeText(target, delta.before.getLocation(), escape); break;
+                case Quantity:
+                    // En HTML una sola celda muestra "antes → después"; en CSV son dos columnas
+                    if (html && kind == DeltaKind::Modified && delta.before.getQuantity() != delta.after.getQuantity()) {
+                        target.writeInteger(delta.before.getQuantity());
+                        target.write(" → ");
+                    }
+                    if (html || delta.existsAfter) target.writeInteger(current.getQuantity());
+                    break;
+                case Location:
+                    if (html && kind == DeltaKind::Modified && delta.before.getLocation() != delta.after.getLocation()) {
+                        writeText(target, delta.before.getLocation(), escape);
+                        target.write(" → ");
+                    }
+                    if (html || delta.existsAfter) writeText(target, current.getLocation(), escape);
+                    break;
+                default: break;
+            }
+        });
+    }
+
+    if (html) compiled.htmlFooter.render(out, [](int, OutputBuffer&) {});
+    return out.close();
+}
+
+bool ReportGenerator::isIncremental(const ReportSink& sink) {
+    // Un archivo comprimido no se puede parchear por tramos, y el columnar y el PDF no
+    // tienen filas separables
+    CompressionPipeline::Codec codec;
+    return !CompressionPipeline::codecFor(sink.filename, codec) && sink.format != ReportFormat::Columnar &&
+           sink.format != ReportFormat::PDF;
+}
+
+bool ReportGenerator::updateReport(const std::vector<Component>& components, const ComponentTable& table,
+                                   const ReportSink& sink, std::int64_t changeCounter) {
+    if (!isIncremental(sink)) {
+        return generateReports(components, table, {sink});
+    }
+
+    return updateRows(makeWriter(sink, components, table), sink, changeCounter, components.size(),
+                      [&components](const auto& visitor) {
+                          for (const Component& component : components) visitor(component, component.contentHash());
+                      });
+}
+
+bool ReportGenerator::updateReport(const InventorySnapshot& snapshot, const ReportSink& sink,
+                                   std::int64_t changeCounter) {
+    const bool lowStock = sink.format == ReportFormat::LowStock;
+    const ReportTotals totals{snapshot.size(), snapshot.sumQuantities(),
+                              snapshot.countAtOrBelow(lowStock ? sink.threshold : 5)};
+
+    if (!isIncremental(sink)) {
+        return streamReport(sink, totals, [&snapshot](const RowVisitor& visitor) {
+            for (const Component& component : snapshot) visitor(component);
+            return true;
+        });
+    }
+
+    // Los resúmenes salen de los bloques del snapshot: solo se calculan los de los bloques
+    // que cambiaron desde el snapshot anterior
+    const ReportWriter writer{sink.format, sink.threshold, totals.componentCount, totals.totalQuantity,
+                              totals.lowStockCount};
+    return updateRows(writer, sink, changeCounter, lowStock ? totals.lowStockCount : snapshot.size(),
+                      [&snapshot](const auto& visitor) { snapshot.forEachWithHash(visitor); });
+}
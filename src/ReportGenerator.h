@@ -1,20 +1,114 @@
 #ifndef REPORTGENERATOR_H
 #define REPORTGENERATOR_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
 #include <vector>
 #include <string>
 #include "Component.h"
+#include "ComponentTable.h"
+
+class DatabaseManager;
+class InventorySnapshot;
 
 /**
  * @class ReportGenerator
  * @brief Genera diferentes tipos de reportes para los componentes del inventario.
  * 
  * La clase ReportGenerator proporciona métodos estáticos para generar reportes en formatos CSV, HTML,
- * texto plano y reportes específicos de bajo stock.
+ * texto plano, PDF, reportes específicos de bajo stock y de cambios entre dos fechas, además de
+ * exportaciones para herramientas de análisis (JSON Lines y columnar binario).
+ *
+ * Las filas pueden renderizarse en paralelo (ver RenderMode); la salida es la misma byte a
+ * byte en ambos modos. Si el nombre de archivo termina en .gz o .zst el reporte se comprime
+ * al vuelo en un hilo aparte (ver CompressionPipeline).
  */
 class ReportGenerator
 {
 public:
+    /**
+     * @brief Modo de renderizado de las filas de los reportes.
+     */
+    enum class RenderMode
+    {
+        Serial, /**< Todas las filas en el hilo que genera el reporte. */
+        Parallel /**< Por trozos en el ThreadPool compartido, escritos en orden con writev. */
+    };
+
+    /**
+     * @brief Formatos de reporte disponibles.
+     */
+    enum class ReportFormat
+    {
+        HTML, /**< Reporte completo en HTML. */
+        CSV, /**< Reporte en CSV. */
+        Text, /**< Reporte en texto plano. */
+        LowStock, /**< Alerta de stock bajo en HTML (o aviso en texto si no hay ninguno). */
+        JSONLines, /**< Un objeto JSON por línea, con la fecha de compra en segundos desde epoch. */
+        Columnar, /**< Snapshot binario por columnas (BinarySnapshot), legible sin parsear con BinarySnapshotReader. */
+        PDF /**< Reporte completo en PDF, escrito página a página (ver PdfReportWriter). */
+    };
+
+    /**
+     * @brief Destino de una exportación múltiple: formato y archivo.
+     */
+    struct ReportSink
+    {
+        ReportFormat format; /**< Formato del reporte. */
+        std::string filename; /**< Ruta del archivo donde guardar el reporte. */
+        int threshold = 5; /**< Umbral de stock bajo (solo para LowStock). */
+    };
+
+    /**
+     * @brief Totales que necesitan las cabeceras de un reporte generado en streaming.
+     */
+    struct ReportTotals
+    {
+        std::size_t componentCount = 0; /**< Número de componentes (HTML, texto y PDF). */
+        long long totalQuantity = 0; /**< Suma de las cantidades (HTML y PDF). */
+        std::size_t lowStockCount = 0; /**< HTML y PDF: cantidad <= 5; LowStock: cantidad <= umbral del destino. */
+    };
+
+    /**
+     * @brief Recibe cada fila de una fuente; si devuelve false la fuente debe detenerse.
+     */
+    using RowVisitor = std::function<bool(const Component&)>;
+
+    /**
+     * @brief Fuente de filas: entrega cada componente, en orden, al visitante y devuelve
+     * true si pudo recorrerlas todas (un snapshot, un iterador por lotes, etc.).
+     */
+    using RowSource = std::function<bool(const RowVisitor&)>;
+
+    /**
+     * @brief Criterio para repartir los componentes en las páginas de un reporte HTML paginado.
+     */
+    enum class PageGrouping
+    {
+        Fixed, /**< Páginas consecutivas de pageSize componentes en el orden del inventario. */
+        ByType, /**< Una sección por tipo, dividida en páginas de hasta pageSize componentes. */
+        ByLocation /**< Una sección por ubicación, dividida en páginas de hasta pageSize componentes. */
+    };
+
+    static constexpr std::size_t DEFAULT_PAGE_SIZE = 1000; /**< Componentes por página por defecto. */
+    static constexpr std::size_t MAX_PAGE_SIZE = 5000; /**< Máximo de componentes por página. */
+
+    /**
+     * @brief Cambia el modo de renderizado para los reportes siguientes.
+     *
+     * @param mode Nuevo modo (por defecto Parallel; los reportes pequeños siempre se renderizan en serie).
+     */
+    static void setRenderMode(RenderMode mode);
+
+    /**
+     * @brief Obtiene el modo de renderizado actual.
+     * @return Modo de renderizado.
+     */
+    static RenderMode getRenderMode();
+
     /**
      * @brief Genera un reporte en formato CSV.
      * 
@@ -33,6 +127,57 @@ public:
      */
     static bool generateHTMLReport(const std::vector<Component>& components, const std::string& filename);
     
+    /**
+     * @brief Genera el reporte completo en PDF.
+     * 
+     * Cada página se escribe en cuanto se llena y la tabla xref se acumula en un archivo
+     * temporal, así que la memoria no depende del número de páginas (ver PdfReportWriter).
+     * 
+     * @param components Vector de componentes a incluir en el reporte.
+     * @param filename Ruta del archivo donde guardar el reporte.
+     * @return true si se generó correctamente, false en caso contrario.
+     */
+    static bool generatePDFReport(const std::vector<Component>& components, const std::string& filename);
+    
+    /**
+     * @brief Exporta los componentes en formato JSON Lines.
+     * 
+     * Cada línea es un objeto con id, name, type, quantity, location, purchase_date
+     * (segundos desde epoch, o null si no tiene fecha) y low_stock (booleano). No hay
+     * cabecera ni pie, así que el archivo puede leerse o partirse línea a línea.
+     * 
+     * @param components Vector de componentes a exportar.
+     * @param filename Ruta del archivo donde guardar la exportación.
+     * @return true si se generó correctamente, false en caso contrario.
+     */
+    static bool generateJSONLinesReport(const std::vector<Component>& components, const std::string& filename);
+    
+    /**
+     * @brief Exporta la tabla columnar como snapshot binario.
+     * 
+     * El archivo tiene el formato de BinarySnapshot: un directorio de columnas tipadas
+     * (IDs, cantidades, fechas en epoch), tipo y ubicación codificados con diccionario y
+     * un montón de cadenas. BinarySnapshotReader lo abre mapeándolo en memoria y lee cada
+     * campo sin parsear. Si el nombre termina en .gz o .zst se comprime como los demás
+     * reportes (y hay que descomprimirlo antes de abrirlo).
+     * 
+     * @param table Tabla columnar con los componentes a exportar.
+     * @param filename Ruta del archivo donde guardar la exportación.
+     * @return true si se generó correctamente, false en caso contrario.
+     */
+    static bool generateColumnarExport(const ComponentTable& table, const std::string& filename);
+    
+    /**
+     * @brief Genera un reporte en formato HTML usando la tabla columnar para los totales.
+     * 
+     * @param components Vector de componentes a incluir en el reporte.
+     * @param table Tabla columnar construida a partir de components (misma fila, mismo componente).
+     * @param filename Ruta del archivo donde guardar el reporte.
+     * @return true si se generó correctamente, false en caso contrario.
+     */
+    static bool generateHTMLReport(const std::vector<Component>& components, const ComponentTable& table,
+                                   const std::string& filename);
+    
     /**
      * @brief Genera un reporte en formato de texto plano.
      * 
@@ -52,29 +197,202 @@ public:
      */
     static bool generateLowStockReport(const std::vector<Component>& components, const std::string& filename, int threshold = 5);
     
-private:
     /**
-     * @brief Obtiene la fecha y hora actual formateada.
+     * @brief Genera un reporte de stock bajo filtrando sobre la tabla columnar.
      * 
-     * @return String con la fecha y hora actual.
+     * @param components Vector de componentes a verificar.
+     * @param table Tabla columnar construida a partir de components (misma fila, mismo componente).
+     * @param filename Ruta del archivo donde guardar el reporte.
+     * @param threshold Umbral para considerar stock bajo (por defecto 5).
+     * @return true si se generó correctamente, false en caso contrario.
+     */
+    static bool generateLowStockReport(const std::vector<Component>& components, const ComponentTable& table,
+                                       const std::string& filename, int threshold = 5);
+    
+    /**
+     * @brief Genera varios reportes con un solo recorrido de los componentes.
+     * 
+     * Los totales de las cabeceras salen de la tabla columnar; después cada componente se
+     * escribe en todos los reportes a la vez. Cada archivo queda idéntico al que generaría
+     * la función individual de su formato. Los destinos Columnar se escriben directamente
+     * desde la tabla y los PDF con un recorrido propio.
+     * 
+     * @param components Vector de componentes a incluir en los reportes.
+     * @param table Tabla columnar construida a partir de components (misma fila, mismo componente).
+     * @param sinks Reportes a generar (formato y archivo de cada uno).
+     * @return true si se generaron todos correctamente, false en caso contrario.
+     */
+    static bool generateReports(const std::vector<Component>& components, const ComponentTable& table,
+                                const std::vector<ReportSink>& sinks);
+    
+    /**
+     * @brief Genera un reporte consumiendo las filas a medida que llegan de una fuente.
+     * 
+     * Las filas no se guardan: se copian a un lote de tamaño fijo que se renderiza (en
+     * paralelo, según RenderMode) cada vez que se llena, así que la memoria no depende del
+     * número de componentes. La salida es idéntica a la de la función individual del
+     * formato con los mismos componentes. Para LowStock las filas por encima del umbral se
+     * descartan, aunque lo ideal es que la fuente ya no las entregue. Columnar es la
+     * excepción: sus columnas se acumulan en una ComponentTable y se escriben al final. Un
+     * PDF tampoco usa lotes: cada fila va directamente a su página.
+     * 
+     * @param sink Formato y archivo del reporte.
+     * @param totals Totales de la cabecera, calculados de antemano.
+     * @param source Fuente de las filas.
+     * @return true si se generó correctamente y la fuente entregó todas las filas, false en caso contrario.
+     */
+    static bool streamReport(const ReportSink& sink, const ReportTotals& totals, const RowSource& source);
+    
+    /**
+     * @brief Genera varios reportes con un solo recorrido de una fuente de filas.
+     * 
+     * Como streamReport, pero cada fila que entrega la fuente se escribe en todos los
+     * destinos a la vez: los de texto comparten el mismo lote (y el renderizado en
+     * paralelo), los PDF reciben la fila en su página y los Columnar la acumulan. Cada
+     * archivo queda idéntico al que generaría streamReport con la misma fuente. Los
+     * LowStock descartan las filas por encima de su umbral.
+     * 
+     * @param sinks Formato y archivo de cada reporte.
+     * @param totals Totales de la cabecera de cada reporte (totals[i] para sinks[i]).
+     * @param source Fuente de las filas; se recorre una sola vez.
+     * @return true si se generaron todos y la fuente entregó todas las filas, false en caso contrario.
+     */
+    static bool streamReports(const std::vector<ReportSink>& sinks, const std::vector<ReportTotals>& totals,
+                              const RowSource& source);
+    
+    /**
+     * @brief Genera un reporte HTML dividido en un índice y varias páginas.
+     * 
+     * En directory se escriben index.html, con las tarjetas de resumen y la lista de
+     * páginas, y pagina_0001.html, pagina_0002.html, etc., cada una con su parte de la
+     * tabla y enlaces al índice y a las páginas anterior y siguiente. Ninguna página
+     * supera pageSize filas, así que el navegador las abre al instante aunque el
+     * inventario sea muy grande. Las páginas se escriben en paralelo en el ThreadPool
+     * compartido (en serie si el modo de renderizado es Serial).
+     * 
+     * @param components Vector de componentes a incluir en el reporte.
+     * @param table Tabla columnar construida a partir de components (misma fila, mismo componente).
+     * @param directory Carpeta (ya existente) donde escribir los archivos.
+     * @param grouping Criterio de reparto en páginas.
+     * @param pageSize Máximo de componentes por página (entre 1 y MAX_PAGE_SIZE).
+     * @return true si se escribieron el índice y todas las páginas, false en caso contrario.
+     */
+    static bool generatePagedHTMLReport(const std::vector<Component>& components, const ComponentTable& table,
+                                        const std::string& directory, PageGrouping grouping = PageGrouping::Fixed,
+                                        std::size_t pageSize = DEFAULT_PAGE_SIZE);
+    
+    /**
+     * @brief Genera el reporte HTML paginado directamente desde un snapshot.
+     * 
+     * Igual que la versión con vector y tabla, pero los componentes se leen del snapshot
+     * y los totales salen de sus tablas por bloque: no se copia el inventario. Solo se
+     * guarda el orden de las filas en las páginas (un índice de 4 bytes por componente).
+     * 
+     * @param snapshot Snapshot del inventario; debe vivir hasta que termine la llamada.
+     * @param directory Carpeta (ya existente) donde escribir los archivos.
+     * @param grouping Criterio de reparto en páginas.
+     * @param pageSize Máximo de componentes por página (entre 1 y MAX_PAGE_SIZE).
+     * @return true si se escribieron el índice y todas las páginas, false en caso contrario.
+     */
+    static bool generatePagedHTMLReport(const InventorySnapshot& snapshot, const std::string& directory,
+                                        PageGrouping grouping = PageGrouping::Fixed,
+                                        std::size_t pageSize = DEFAULT_PAGE_SIZE);
+    
+    /**
+     * @brief Genera el reporte de los cambios del inventario en un periodo.
+     *
+     * Se lee el registro de cambios de la base (DatabaseManager::forEachChange), no el
+     * inventario: el coste depende del número de cambios del periodo. Los cambios de cada
+     * componente se reducen a su efecto neto entre el comienzo y el final del periodo, y
+     * se clasifica como agregado, eliminado o modificado (cantidad, ubicación u otros
+     * datos). Uno creado y eliminado dentro del periodo, o cuyo cambio se deshizo, no
+     * aparece. Si el periodo empieza antes de que existiera el registro de cambios, el
+     * reporte HTML lo advierte.
+     *
+     * @param database Base de datos conectada.
+     * @param since Comienzo del periodo (incluido).
+     * @param until Fin del periodo (excluido).
+     * @param format HTML (con resumen y "antes → después") o CSV (columnas de antes y de después).
+     * @param filename Ruta del archivo donde guardar el reporte (.gz o .zst para comprimirlo).
+     * @return true si se generó correctamente, false en caso contrario.
+     */
+    static bool generateChangeReport(DatabaseManager& database, std::time_t since, std::time_t until,
+                                     ReportFormat format, const std::string& filename);
+
+    /**
+     * @brief Indica si updateReport puede actualizar un reporte por filas.
+     * 
+     * @param sink Formato y archivo del reporte.
+     * @return false para los comprimidos (.gz, .zst), Columnar y PDF, que siempre se generan completos.
+     */
+    static bool isIncremental(const ReportSink& sink);
+
+    /**
+     * @brief Actualiza un reporte regenerando solo las filas que cambiaron.
+     * 
+     * Junto al reporte se guarda un manifiesto (ReportManifest) con el contador de cambios
+     * y, por fila, el ID, un resumen del componente y la longitud de su salida. En la
+     * siguiente llamada:
+     *  - si changeCounter coincide con el del manifiesto, el reporte no se toca;
+     *  - si las filas siguen en su sitio y las cambiadas ocupan lo mismo, se sobrescriben
+     *    en el archivo solo la cabecera y esas filas;
+     *  - si no, se reconstruye copiando del reporte anterior las filas que no cambiaron.
+     * Sin manifiesto válido (o si el reporte se modificó por fuera) se genera completo.
+     * 
+     * Los reportes incrementales se escriben en modo binario: usan '\n' como fin de línea
+     * en todas las plataformas. Los comprimidos (.gz, .zst), las exportaciones Columnar y
+     * los PDF siempre se generan completos.
+     * 
+     * @param components Vector de componentes a incluir en el reporte.
+     * @param table Tabla columnar construida a partir de components (misma fila, mismo componente).
+     * @param sink Formato y archivo del reporte.
+     * @param changeCounter Contador de cambios de la base que reflejan los componentes
+     *        (DatabaseManager::getChangeCounter), o -1 si no se conoce.
+     * @return true si el reporte quedó al día, false en caso contrario.
+     */
+    static bool updateReport(const std::vector<Component>& components, const ComponentTable& table,
+                             const ReportSink& sink, std::int64_t changeCounter);
+    
+    /**
+     * @brief Actualiza un reporte regenerando solo las filas que cambiaron, a partir de un snapshot.
+     * 
+     * Igual que la versión con vector y tabla, pero los totales salen de las tablas por
+     * bloque del snapshot y los resúmenes de cada componente de InventorySnapshot::forEachWithHash:
+     * entre dos snapshots seguidos solo se calculan los de los bloques que cambiaron. Los
+     * comprimidos, Columnar y PDF se generan completos con streamReport.
+     * 
+     * @param snapshot Snapshot del inventario; debe vivir hasta que termine la llamada.
+     * @param sink Formato y archivo del reporte.
+     * @param changeCounter Contador de cambios que refleja el snapshot, o -1 si no se conoce.
+     * @return true si el reporte quedó al día, false en caso contrario.
      */
-    static std::string getCurrentDateTime();
+    static bool updateReport(const InventorySnapshot& snapshot, const ReportSink& sink, std::int64_t changeCounter);
     
+private:
+    static std::atomic<RenderMode> renderMode; /**< Modo de renderizado de las filas. */
+
     /**
-     * @brief Escapa comillas dobles en un string para CSV.
+     * @brief Escribe el reporte HTML completo con los totales ya calculados.
      * 
-     * @param input String a escapar.
-     * @return String con comillas escapadas.
+     * @param components Componentes a listar.
+     * @param filename Ruta del archivo donde guardar el reporte.
+     * @param lowStockCount Número de componentes con stock bajo.
+     * @param totalQuantity Suma de todas las cantidades.
+     * @return true si se generó correctamente, false en caso contrario.
      */
-    static std::string escapeCSV(const std::string& input);
+    static bool writeHTMLReport(const std::vector<Component>& components, const std::string& filename,
+                                std::size_t lowStockCount, long long totalQuantity);
     
     /**
-     * @brief Escapa caracteres HTML especiales.
+     * @brief Escribe el reporte de stock bajo con los componentes ya filtrados.
      * 
-     * @param input String a escapar.
-     * @return String con caracteres HTML escapados.
+     * @param lowStockComponents Componentes con stock bajo, en orden.
+     * @param filename Ruta del archivo donde guardar el reporte.
+     * @param threshold Umbral usado para el filtro.
+     * @return true si se generó correctamente, false en caso contrario.
      */
-    static std::string escapeHTML(const std::string& input);
+    static bool writeLowStockReport(const std::vector<const Component*>& lowStockComponents,
+                                    const std::string& filename, int threshold);
     
     /**
      * @brief Formatea una cantidad para resaltar stock bajo.
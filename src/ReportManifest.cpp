@@ -0,0 +1,131 @@
+#include "ReportManifest.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "BinarySnapshot.h"
+
+const char ReportManifest::MAGIC[8] = {'I', 'N', 'V', 'M', 'A', 'N', 'I', '\0'};
+
+namespace {
+    // Posiciones de los campos de la cabecera
+    const std::size_t VERSION_AT = 8;
+    const std::size_t ENDIAN_AT = 12;
+    const std::size_t FORMAT_AT = 16;
+    const std::size_t THRESHOLD_AT = 20;
+    const std::size_t CHANGE_COUNTER_AT = 24;
+    const std::size_t REPORT_SIZE_AT = 32;
+    const std::size_t HEADER_LENGTH_AT = 40;
+    const std::size_t FOOTER_LENGTH_AT = 48;
+    const std::size_t ROW_COUNT_AT = 56;
+    const std::size_t HEADER_CHECKSUM_AT = 64;
+
+    static_assert(sizeof(ReportManifest::Row) == 16, "Row debe ocupar 16 bytes en disco");
+
+    template <typename T>
+    void put(std::vector<unsigned char>& out, std::size_t at, T value) {
+        std::memcpy(out.data() + at, &value, sizeof(T));
+    }
+
+    template <typename T>
+    T get(const unsigned char* data, std::size_t at) {
+        T value;
+        std::memcpy(&value, data + at, sizeof(T));
+        return value;
+    }
+}
+
+std::string ReportManifest::pathFor(const std::string& reportPath) {
+    return reportPath + ".manifest";
+}
+
+bool ReportManifest::load(const std::string& path, bool withRows) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+
+    const std::streamoff size = file.tellg();
+    if (size < static_cast<std::streamoff>(HEADER_SIZE + sizeof(std::uint64_t))) return false;
+    std::vector<unsigned char> bytes(withRows ? static_cast<std::size_t>(size) : HEADER_SIZE);
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) return false;
+
+    const unsigned char* data = bytes.data();
+    if (std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 ||
+        get<std::uint32_t>(data, VERSION_AT) != FORMAT_VERSION ||
+        get<std::uint32_t>(data, ENDIAN_AT) != ENDIAN_TAG ||
+        get<std::uint64_t>(data, HEADER_CHECKSUM_AT) != BinarySnapshot::checksum(data, HEADER_CHECKSUM_AT)) {
+        return false;
+    }
+
+    const std::uint64_t rowCount = get<std::uint64_t>(data, ROW_COUNT_AT);
+    const std::uint64_t expectedSize = HEADER_SIZE + rowCount * sizeof(Row) + sizeof(std::uint64_t);
+    if (rowCount > static_cast<std::uint64_t>(size) / sizeof(Row) || expectedSize != static_cast<std::uint64_t>(size)) {
+        return false;
+    }
+
+    if (withRows) {
+        const std::size_t checksumAt = bytes.size() - sizeof(std::uint64_t);
+        if (get<std::uint64_t>(data, checksumAt) != BinarySnapshot::checksum(data, checksumAt)) return false;
+    }
+
+    format = get<std::uint32_t>(data, FORMAT_AT);
+    threshold = get<std::int32_t>(data, THRESHOLD_AT);
+    changeCounter = get<std::int64_t>(data, CHANGE_COUNTER_AT);
+    reportSize = get<std::uint64_t>(data, REPORT_SIZE_AT);
+    headerLength = get<std::uint64_t>(data, HEADER_LENGTH_AT);
+    footerLength = get<std::uint64_t>(data, FOOTER_LENGTH_AT);
+    rows.resize(withRows ? static_cast<std::size_t>(rowCount) : 0);
+    if (!rows.empty()) {
+        std::memcpy(rows.data(), data + HEADER_SIZE, rows.size() * sizeof(Row));
+    }
+    return true;
+}
+
+bool ReportManifest::save(const std::string& path) const {
+    const std::size_t checksumAt = HEADER_SIZE + rows.size() * sizeof(Row);
+    std::vector<unsigned char> bytes(checksumAt + sizeof(std::uint64_t), 0);
+
+    std::memcpy(bytes.data(), MAGIC, sizeof(MAGIC));
+    put<std::uint32_t>(bytes, VERSION_AT, FORMAT_VERSION);
+    put<std::uint32_t>(bytes, ENDIAN_AT, ENDIAN_TAG);
+    put<std::uint32_t>(bytes, FORMAT_AT, format);
+    put<std::int32_t>(bytes, THRESHOLD_AT, threshold);
+    put<std::int64_t>(bytes, CHANGE_COUNTER_AT, changeCounter);
+    put<std::uint64_t>(bytes, REPORT_SIZE_AT, reportSize);
+    put<std::uint64_t>(bytes, HEADER_LENGTH_AT, headerLength);
+    put<std::uint64_t>(bytes, FOOTER_LENGTH_AT, footerLength);
+    put<std::uint64_t>(bytes, ROW_COUNT_AT, rows.size());
+    put<std::uint64_t>(bytes, HEADER_CHECKSUM_AT, BinarySnapshot::checksum(bytes.data(), HEADER_CHECKSUM_AT));
+    if (!rows.empty()) {
+        std::memcpy(bytes.data() + HEADER_SIZE, rows.data(), rows.size() * sizeof(Row));
+    }
+    put<std::uint64_t>(bytes, checksumAt, BinarySnapshot::checksum(bytes.data(), checksumAt));
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Error al crear el manifiesto: " << tempPath << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        file.flush();
+        if (!file) {
+            std::cerr << "Error al escribir el manifiesto: " << tempPath << std::endl;
+            file.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+#ifdef _WIN32
+    // rename no reemplaza un archivo existente en Windows
+    std::remove(path.c_str());
+#endif
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error al reemplazar el manifiesto: " << path << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,73 @@
+#ifndef REPORTMANIFEST_H
+#define REPORTMANIFEST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ReportManifest
+ * @brief Describe cómo está compuesto un reporte ya escrito, para regenerarlo por partes.
+ *
+ * Guarda la longitud de la cabecera y del pie y, por cada fila del reporte, el ID del
+ * componente, un resumen de su contenido y la longitud de su salida. Con eso se sabe qué
+ * filas cambiaron y dónde está cada una en el archivo sin volver a leerlo.
+ *
+ * Formato en disco (little-endian): cabecera de HEADER_SIZE bytes con su propia suma de
+ * verificación, una entrada Row por fila y al final la suma de verificación de todo lo
+ * anterior. La suma de la cabecera permite consultar el contador de cambios sin leer las filas.
+ */
+class ReportManifest
+{
+public:
+    static const char MAGIC[8]; /**< Firma al inicio del archivo. */
+    static constexpr std::uint32_t FORMAT_VERSION = 1; /**< Versión actual del formato. */
+    static constexpr std::uint32_t ENDIAN_TAG = 0x01020304; /**< Detecta archivos de otra endianness. */
+    static constexpr std::size_t HEADER_SIZE = 72; /**< Tamaño de la cabecera en bytes. */
+
+    /**
+     * @brief Fila del reporte, tal como se guarda en disco.
+     */
+    struct Row
+    {
+        std::int32_t id; /**< ID del componente. */
+        std::uint32_t length; /**< Bytes de la fila en el reporte. */
+        std::uint64_t hash; /**< Resumen del contenido del componente. */
+    };
+
+    std::uint32_t format = 0; /**< Formato del reporte (ReportGenerator::ReportFormat). */
+    std::int32_t threshold = 0; /**< Umbral de stock bajo con que se generó. */
+    std::int64_t changeCounter = -1; /**< Contador de cambios de la base que refleja el reporte. */
+    std::uint64_t reportSize = 0; /**< Tamaño del reporte en bytes. */
+    std::uint64_t headerLength = 0; /**< Bytes de la cabecera del reporte. */
+    std::uint64_t footerLength = 0; /**< Bytes del pie del reporte. */
+    std::vector<Row> rows; /**< Filas en el orden del reporte. */
+
+    /**
+     * @brief Obtiene la ruta del manifiesto de un reporte.
+     *
+     * @param reportPath Ruta del reporte.
+     * @return Ruta del manifiesto (la del reporte con ".manifest" añadido).
+     */
+    static std::string pathFor(const std::string& reportPath);
+
+    /**
+     * @brief Lee y valida un manifiesto.
+     *
+     * @param path Ruta del manifiesto.
+     * @param withRows Si es false solo se lee y valida la cabecera (rows queda vacío).
+     * @return true si el archivo existe y es válido, false en caso contrario.
+     */
+    bool load(const std::string& path, bool withRows = true);
+
+    /**
+     * @brief Escribe el manifiesto (primero en un .tmp que luego se renombra).
+     *
+     * @param path Ruta del manifiesto.
+     * @return true si se escribió completo, false en caso contrario.
+     */
+    bool save(const std::string& path) const;
+};
+
+#endif // REPORTMANIFEST_H
@@ -0,0 +1,385 @@
+#include "ReportScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include "DatabaseManager.h"
+#include "ReportManifest.h"
+
+namespace {
+    // Archivo temporal junto al destino: "~" delante del nombre, para conservar la
+    // extensión (de ella depende la compresión) y quedar en el mismo sistema de archivos
+    std::string temporaryPath(const std::string& filename) {
+        const std::size_t slash = filename.find_last_of("/\\");
+        const std::size_t nameStart = slash == std::string::npos ? 0 : slash + 1;
+        return filename.substr(0, nameStart) + "~" + filename.substr(nameStart);
+    }
+
+    // Clave de un trabajo: dos trabajos con la misma escriben exactamente los mismos archivos
+    std::string jobKey(const ReportScheduler::ReportJob& job) {
+        std::string key;
+        for (const ReportGenerator::ReportSink& sink : job.sinks) {
+            key += std::to_string(static_cast<int>(sink.format));
+            key += '|';
+            key += std::to_string(sink.threshold);
+            key += '|';
+            key += sink.filename;
+            key += '\n';
+        }
+        if (job.incremental) key += "incremental\n";
+        if (job.filter) {
+            // El SQL del filtro y sus valores lo identifican
+            std::vector<ComponentQuery::SqlParam> params;
+            key += ComponentQuery().where(job.filter).toSql(params);
+            for (const ComponentQuery::SqlParam& param : params) {
+                key += '|';
+                key += param.isText ? param.text : std::to_string(param.number);
+            }
+            key += '\n';
+        }
+        if (!job.pagedDirectory.empty()) {
+            key += std::to_string(static_cast<int>(job.grouping));
+            key += '|';
+            key += job.pagedDirectory;
+            key += '\n';
+        }
+        for (const ReportGenerator::ReportSink& sink : job.changeSinks) {
+            key += std::to_string(static_cast<int>(sink.format));
+            key += '|';
+            key += std::to_string(static_cast<long long>(job.changeSince));
+            key += '|';
+            key += std::to_string(static_cast<long long>(job.changeUntil));
+            key += '|';
+            key += job.changeDatabase;
+            key += '|';
+            key += sink.filename;
+            key += '\n';
+        }
+        return key;
+    }
+}
+
+ReportScheduler::ReportScheduler(SnapshotSource snapshotSource, Listener listener, std::size_t workerCount)
+    : snapshotSource(std::move(snapshotSource)), listener(std::move(listener)),
+      nextJobId(1), nextScheduleId(1), stopping(false) {
+    workerCount = std::max<std::size_t>(workerCount, 1);
+    workers.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+    timer = std::thread([this]() { timerLoop(); });
+}
+
+ReportScheduler::~ReportScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        // Los trabajos en curso se detienen en la siguiente fila y borran sus temporales
+        for (const std::shared_ptr<Job>& job : running) job->cancelled = true;
+        queue.clear();
+        schedules.clear();
+    }
+    workCondition.notify_all();
+    timerCondition.notify_all();
+    for (std::thread& worker : workers) worker.join();
+    timer.join();
+}
+
+ReportScheduler::JobId ReportScheduler::submit(const ReportJob& job) {
+    return enqueue(job, false);
+}
+
+ReportScheduler::JobId ReportScheduler::enqueue(const ReportJob& job, bool scheduled) {
+    auto entry = std::make_shared<Job>();
+    entry->job = job;
+    entry->key = jobKey(job);
+    entry->scheduled = scheduled;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Uno idéntico que aún no ha empezado escribirá lo mismo con datos igual de recientes
+        for (const std::shared_ptr<Job>& pending : queue) {
+            if (pending->key == entry->key) return pending->id;
+        }
+        entry->id = nextJobId++;
+        queue.push_back(entry);
+    }
+    workCondition.notify_one();
+    notify({entry->id, JobState::Queued, 0, 0, job.description, scheduled});
+    return entry->id;
+}
+
+bool ReportScheduler::cancel(JobId id) {
+    std::shared_ptr<Job> removed;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const std::shared_ptr<Job>& job : running) {
+            if (job->id == id) {
+                // El hilo que lo ejecuta notificará la cancelación al detenerse
+                job->cancelled = true;
+                return true;
+            }
+        }
+        auto it = std::find_if(queue.begin(), queue.end(),
+                               [id](const std::shared_ptr<Job>& job) { return job->id == id; });
+        if (it == queue.end()) return false;
+        removed = *it;
+        queue.erase(it);
+    }
+    notify({removed->id, JobState::Cancelled, 0, 0, removed->job.description, removed->scheduled});
+    return true;
+}
+
+ReportScheduler::ScheduleId ReportScheduler::addSchedule(const CronSchedule& cron, const ReportJob& job) {
+    ScheduleId id;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        id = nextScheduleId++;
+        schedules.push_back({id, cron, job, cron.nextAfter(std::time(nullptr))});
+    }
+    timerCondition.notify_all();
+    return id;
+}
+
+bool ReportScheduler::removeSchedule(ScheduleId id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = std::find_if(schedules.begin(), schedules.end(),
+                           [id](const Schedule& schedule) { return schedule.id == id; });
+    if (it == schedules.end()) return false;
+    schedules.erase(it);
+    // El hilo de programaciones recalcula su espera la próxima vez que despierte
+    return true;
+}
+
+std::size_t ReportScheduler::pendingCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.size() + running.size();
+}
+
+void ReportScheduler::notify(const JobEvent& event) const {
+    if (listener) listener(event);
+}
+
+void ReportScheduler::workerLoop() {
+    for (;;) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workCondition.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (stopping) return;
+            job = queue.front();
+            queue.pop_front();
+            running.push_back(job);
+        }
+
+        JobState state;
+        try {
+            state = run(*job);
+        } catch (const std::exception& e) {
+            std::cerr << "Error en el trabajo de reporte '" << job->job.description << "': " << e.what() << std::endl;
+            state = JobState::Failed;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running.erase(std::find(running.begin(), running.end(), job));
+        }
+        notify({job->id, state, 0, 0, job->job.description, job->scheduled});
+    }
+}
+
+void ReportScheduler::timerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        std::time_t next = std::numeric_limits<std::time_t>::max();
+        for (const Schedule& schedule : schedules) {
+            if (schedule.nextRun >= 0) next = std::min(next, schedule.nextRun);
+        }
+
+        if (next == std::numeric_limits<std::time_t>::max()) {
+            timerCondition.wait(lock);
+            continue;
+        }
+        if (std::time(nullptr) < next) {
+            // Despierta antes si se agrega una programación o al destruir el planificador
+            timerCondition.wait_until(lock, std::chrono::system_clock::from_time_t(next));
+            continue;
+        }
+
+        // Los trabajos vencidos se encolan fuera del candado (enqueue lo toma y notifica)
+        const std::time_t now = std::time(nullptr);
+        std::vector<ReportJob> due;
+        for (Schedule& schedule : schedules) {
+            if (schedule.nextRun >= 0 && schedule.nextRun <= now) {
+                due.push_back(schedule.job);
+                schedule.nextRun = schedule.cron.nextAfter(now);
+            }
+        }
+        lock.unlock();
+        for (const ReportJob& job : due) enqueue(job, true);
+        lock.lock();
+    }
+}
+
+ReportScheduler::JobState ReportScheduler::run(Job& job) {
+    const ReportJob& definition = job.job;
+    if (job.cancelled) return JobState::Cancelled;
+
+    // Todos los reportes del trabajo salen del mismo snapshot. Los totales y el filtro de
+    // stock bajo usan sus tablas por bloque: el trabajo no copia el inventario
+    std::shared_ptr<const InventorySnapshot> snapshot = snapshotSource();
+    if (definition.filter) {
+        // Con filtro, los reportes salen de un snapshot con solo las filas que lo cumplen
+        snapshot = std::make_shared<const InventorySnapshot>(ComponentQuery().where(definition.filter).apply(*snapshot),
+                                                             snapshot->getVersion());
+    }
+    const InventorySnapshot& components = *snapshot;
+    const long long totalQuantity = components.sumQuantities();
+    const std::size_t htmlLowStockCount = components.countAtOrBelow(5);
+
+    // Un destino con manifiesto (o de un trabajo incremental) se actualiza en su sitio
+    // reescribiendo solo las filas que cambiaron; el resto, y los formatos que no admiten
+    // actualización por filas, se escriben completos
+    std::vector<ReportGenerator::ReportSink> sinks;
+    std::vector<ReportGenerator::ReportSink> incrementalSinks;
+    for (const ReportGenerator::ReportSink& sink : definition.sinks) {
+        ReportManifest manifest;
+        const bool incremental = ReportGenerator::isIncremental(sink) &&
+                                 (definition.incremental ||
+                                  manifest.load(ReportManifest::pathFor(sink.filename), false));
+        (incremental ? incrementalSinks : sinks).push_back(sink);
+    }
+
+    // Un solo recorrido del snapshot escribe todos los destinos completos. Si todos son
+    // LowStock basta con las filas que pasan el umbral mayor (cada destino descarta las
+    // que pasan del suyo); si no, se recorren todas
+    bool onlyLowStock = !sinks.empty();
+    int maxThreshold = std::numeric_limits<int>::min();
+    std::vector<ReportGenerator::ReportTotals> totals;
+    std::vector<std::string> temporaries;
+    std::vector<std::string> targets;
+    for (ReportGenerator::ReportSink& sink : sinks) {
+        const bool lowStock = sink.format == ReportGenerator::ReportFormat::LowStock;
+        onlyLowStock = onlyLowStock && lowStock;
+        if (lowStock) maxThreshold = std::max(maxThreshold, sink.threshold);
+        totals.push_back({components.size(), totalQuantity,
+                          lowStock ? components.countAtOrBelow(sink.threshold) : htmlLowStockCount});
+        targets.push_back(sink.filename);
+        sink.filename = temporaryPath(sink.filename);
+        temporaries.push_back(sink.filename);
+    }
+    std::vector<std::uint32_t> lowStockRows;
+    if (onlyLowStock) lowStockRows = components.filterAtOrBelow(maxThreshold);
+
+    std::size_t rowsTotal = definition.pagedDirectory.empty() ? 0 : components.size();
+    if (!sinks.empty()) rowsTotal += onlyLowStock ? lowStockRows.size() : components.size();
+
+    std::size_t rowsDone = 0;
+    std::size_t nextProgress = PROGRESS_ROWS;
+    notify({job.id, JobState::Running, rowsDone, rowsTotal, definition.description, job.scheduled});
+
+    // Cuenta las filas, emite el progreso y detiene la fuente si se cancela el trabajo
+    auto track = [&](const ReportGenerator::RowVisitor& visitor, const Component& component) {
+        if (job.cancelled) return false;
+        if (++rowsDone >= nextProgress) {
+            nextProgress += PROGRESS_ROWS;
+            notify({job.id, JobState::Running, rowsDone, rowsTotal, definition.description, job.scheduled});
+        }
+        return visitor(component);
+    };
+
+    // Los destinos se reemplazan todos juntos al final: un trabajo cancelado no deja
+    // ningún reporte a medias ni mezcla reportes nuevos con antiguos
+    auto discard = [&temporaries]() {
+        for (const std::string& path : temporaries) std::remove(path.c_str());
+    };
+
+    if (!sinks.empty()) {
+        const bool written = ReportGenerator::streamReports(sinks, totals,
+            [&](const ReportGenerator::RowVisitor& visitor) {
+                if (onlyLowStock) {
+                    for (std::uint32_t row : lowStockRows) {
+                        if (!track(visitor, components.at(row))) return false;
+                    }
+                } else {
+                    for (const Component& component : components) {
+                        if (!track(visitor, component)) return false;
+                    }
+                }
+                return true;
+            });
+
+        if (!written || job.cancelled) {
+            discard();
+            if (job.cancelled) return JobState::Cancelled;
+            std::cerr << "Error al generar los reportes de '" << definition.description << "'" << std::endl;
+            return JobState::Failed;
+        }
+    }
+
+    if (!definition.changeSinks.empty()) {
+        if (job.cancelled) {
+            discard();
+            return JobState::Cancelled;
+        }
+        // Conexión propia: las escrituras de la interfaz no esperan a la lectura del registro.
+        // Cada reporte lee solo los cambios del periodo, así que no admite cancelación a medias
+        DatabaseManager database(definition.changeDatabase);
+        if (!database.connect()) {
+            discard();
+            return JobState::Failed;
+        }
+        for (const ReportGenerator::ReportSink& sink : definition.changeSinks) {
+            targets.push_back(sink.filename);
+            temporaries.push_back(temporaryPath(sink.filename));
+            if (!ReportGenerator::generateChangeReport(database, definition.changeSince, definition.changeUntil,
+                                                       sink.format, temporaries.back())) {
+                discard();
+                return JobState::Failed;
+            }
+        }
+    }
+
+    if (!definition.pagedDirectory.empty()) {
+        if (job.cancelled) {
+            discard();
+            return JobState::Cancelled;
+        }
+        // El paginado se escribe de una vez en el ThreadPool compartido, leyendo del snapshot:
+        // no admite cancelación a medias
+        if (!ReportGenerator::generatePagedHTMLReport(components, definition.pagedDirectory, definition.grouping)) {
+            discard();
+            return JobState::Failed;
+        }
+        rowsDone += components.size();
+        notify({job.id, JobState::Running, rowsDone, rowsTotal, definition.description, job.scheduled});
+    }
+
+    // Los incrementales se actualizan al final, cuando el resto ya está escrito: se reescriben
+    // solo las filas cambiadas (o el archivo por un temporal), sin cancelación a medias
+    if (!incrementalSinks.empty() && job.cancelled) {
+        discard();
+        return JobState::Cancelled;
+    }
+    bool replaced = true;
+    for (const ReportGenerator::ReportSink& sink : incrementalSinks) {
+        if (!ReportGenerator::updateReport(components, sink, -1)) {
+            std::cerr << "Error al actualizar el reporte: " << sink.filename << std::endl;
+            replaced = false;
+        }
+    }
+
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+        const std::string& target = targets[i];
+#ifdef _WIN32
+        // rename no reemplaza un archivo existente en Windows
+        std::remove(target.c_str());
+#endif
+        if (std::rename(temporaries[i].c_str(), target.c_str()) != 0) {
+            std::cerr << "Error al reemplazar el reporte: " << target << std::endl;
+            std::remove(temporaries[i].c_str());
+            replaced = false;
+        }
+    }
+    return replaced ? JobState::Finished : JobState::Failed;
+}
@@ -0,0 +1,238 @@
+#ifndef REPORTSCHEDULER_H
+#define REPORTSCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ComponentQuery.h"
+#include "CronSchedule.h"
+#include "InventorySnapshot.h"
+#include "ReportGenerator.h"
+
+/**
+ * @class ReportScheduler
+ * @brief Cola de trabajos de reporte que se ejecutan en hilos propios, con progreso,
+ * cancelación y programaciones periódicas.
+ *
+ * Cada trabajo toma el snapshot vigente del inventario al empezar y escribe sus reportes
+ * a partir de él con un solo recorrido para todos los destinos
+ * (ReportGenerator::streamReports), sin usar la conexión a la base de datos: las
+ * escrituras de la interfaz nunca esperan a un reporte. Los reportes de cambios, que
+ * leen el registro de cambios y no el inventario, abren su propia conexión a la base.
+ * Los hilos son propios y no del ThreadPool compartido, que sigue libre para el
+ * renderizado en paralelo de las filas.
+ *
+ * Cada reporte se escribe primero en un archivo temporal junto al destino ("~nombre") y
+ * se renombra al terminar, así que cancelar o fallar nunca deja un reporte a medias ni
+ * destruye el anterior.
+ *
+ * Un trabajo con filtro (ComponentQuery) escribe sus reportes, totales incluidos, con
+ * solo los componentes que lo cumplen; el filtro no afecta a los reportes de cambios.
+ *
+ * Un destino que ya tiene manifiesto (ReportManifest), o cualquiera de un trabajo
+ * incremental, no se escribe completo: se actualiza con ReportGenerator::updateReport
+ * después de escribir los demás, reescribiendo solo las filas que cambiaron.
+ *
+ * Un trabajo idéntico (mismos destinos) a otro que todavía espera en la cola no se
+ * vuelve a encolar: submit() devuelve el ID del que ya está esperando.
+ *
+ * Los eventos se entregan al Listener desde los hilos del planificador (o desde el hilo
+ * que llama a submit() o cancel()); una interfaz gráfica debe reenviarlos a su propio hilo.
+ */
+class ReportScheduler
+{
+public:
+    using JobId = std::uint64_t; /**< Identificador de un trabajo (nunca 0). */
+    using ScheduleId = std::uint64_t; /**< Identificador de una programación (nunca 0). */
+
+    /**
+     * @brief Estados de un trabajo.
+     */
+    enum class JobState
+    {
+        Queued, /**< En la cola. */
+        Running, /**< Escribiendo; los eventos de progreso llevan este estado. */
+        Finished, /**< Todos los reportes se escribieron. */
+        Failed, /**< Algún reporte no se pudo escribir. */
+        Cancelled /**< Cancelado antes de terminar. */
+    };
+
+    /**
+     * @brief Trabajo de reporte: uno o varios destinos y, opcionalmente, un HTML paginado y
+     * reportes de cambios.
+     */
+    struct ReportJob
+    {
+        std::string description; /**< Texto para mostrar al usuario. */
+        std::vector<ReportGenerator::ReportSink> sinks; /**< Reportes a escribir, en orden. */
+        bool incremental = false; /**< Guardar un manifiesto junto a cada reporte (ver ReportGenerator::updateReport). */
+        ComponentQuery::PredicatePtr filter; /**< Solo los componentes que lo cumplen (nullptr = todos). */
+        std::string pagedDirectory; /**< Carpeta del reporte paginado (vacío si no hay). */
+        ReportGenerator::PageGrouping grouping = ReportGenerator::PageGrouping::Fixed; /**< Reparto del paginado. */
+        std::vector<ReportGenerator::ReportSink> changeSinks; /**< Reportes de cambios (HTML o CSV) a escribir. */
+        std::string changeDatabase; /**< Archivo de la base de datos cuyo registro de cambios se reporta. */
+        std::time_t changeSince = 0; /**< Comienzo del periodo de los reportes de cambios (incluido). */
+        std::time_t changeUntil = 0; /**< Fin del periodo de los reportes de cambios (excluido). */
+    };
+
+    /**
+     * @brief Cambio de estado o progreso de un trabajo.
+     */
+    struct JobEvent
+    {
+        JobId id; /**< Trabajo. */
+        JobState state; /**< Estado nuevo (Running también para el progreso). */
+        std::size_t rowsDone; /**< Filas escritas hasta ahora. */
+        std::size_t rowsTotal; /**< Filas que escribirá el trabajo (0 si aún no se sabe). */
+        std::string description; /**< Descripción del trabajo. */
+        bool scheduled; /**< true si lo lanzó una programación. */
+    };
+
+    using Listener = std::function<void(const JobEvent&)>; /**< Receptor de eventos. */
+    using SnapshotSource = std::function<std::shared_ptr<const InventorySnapshot>()>; /**< Snapshot vigente. */
+
+    static constexpr std::size_t PROGRESS_ROWS = 16384; /**< Filas entre eventos de progreso. */
+
+private:
+    /**
+     * @brief Trabajo encolado o en ejecución.
+     */
+    struct Job
+    {
+        JobId id; /**< Identificador. */
+        ReportJob job; /**< Definición. */
+        std::string key; /**< Destinos del trabajo, para detectar duplicados. */
+        bool scheduled; /**< Lanzado por una programación. */
+        std::atomic<bool> cancelled{false}; /**< Se pidió cancelarlo. */
+    };
+
+    /**
+     * @brief Programación periódica de un trabajo.
+     */
+    struct Schedule
+    {
+        ScheduleId id; /**< Identificador. */
+        CronSchedule cron; /**< Cuándo se lanza. */
+        ReportJob job; /**< Qué se lanza. */
+        std::time_t nextRun; /**< Siguiente lanzamiento, o -1 si no hay. */
+    };
+
+    SnapshotSource snapshotSource; /**< Obtiene el snapshot con que se escribe cada trabajo. */
+    Listener listener; /**< Receptor de eventos (puede estar vacío). */
+    std::mutex mutex; /**< Protege la cola, los trabajos en curso, las programaciones y stopping. */
+    std::condition_variable workCondition; /**< Despierta a los hilos cuando hay trabajos o al parar. */
+    std::condition_variable timerCondition; /**< Despierta al hilo de programaciones cuando cambian o al parar. */
+    std::deque<std::shared_ptr<Job>> queue; /**< Trabajos en espera, en orden. */
+    std::vector<std::shared_ptr<Job>> running; /**< Trabajos en ejecución. */
+    std::vector<Schedule> schedules; /**< Programaciones activas. */
+    JobId nextJobId; /**< Siguiente ID de trabajo. */
+    ScheduleId nextScheduleId; /**< Siguiente ID de programación. */
+    bool stopping; /**< Indica que el planificador se está destruyendo. */
+    std::vector<std::thread> workers; /**< Hilos que ejecutan los trabajos. */
+    std::thread timer; /**< Hilo que lanza las programaciones. */
+
+    /**
+     * @brief Bucle de un hilo de trabajo.
+     */
+    void workerLoop();
+
+    /**
+     * @brief Bucle del hilo de programaciones.
+     */
+    void timerLoop();
+
+    /**
+     * @brief Encola un trabajo, salvo que ya espere uno idéntico.
+     *
+     * @param job Trabajo a encolar.
+     * @param scheduled true si lo lanza una programación.
+     * @return ID del trabajo encolado o del idéntico que ya esperaba.
+     */
+    JobId enqueue(const ReportJob& job, bool scheduled);
+
+    /**
+     * @brief Escribe los reportes de un trabajo.
+     *
+     * @param job Trabajo a ejecutar.
+     * @return Estado final (Finished, Failed o Cancelled).
+     */
+    JobState run(Job& job);
+
+    /**
+     * @brief Entrega un evento al receptor, si lo hay.
+     *
+     * @param event Evento a entregar.
+     */
+    void notify(const JobEvent& event) const;
+
+public:
+    /**
+     * @brief Constructor. Arranca los hilos de trabajo y el de programaciones.
+     *
+     * @param snapshotSource Devuelve el snapshot vigente del inventario (p. ej. InventoryManager::snapshot).
+     * @param listener Receptor de eventos; se llama desde los hilos del planificador.
+     * @param workerCount Número de trabajos que pueden ejecutarse a la vez (mínimo 1).
+     */
+    ReportScheduler(SnapshotSource snapshotSource, Listener listener, std::size_t workerCount = 1);
+
+    /**
+     * @brief Destructor. Cancela los trabajos pendientes y en curso y espera a los hilos.
+     */
+    ~ReportScheduler();
+
+    ReportScheduler(const ReportScheduler&) = delete;
+    ReportScheduler& operator=(const ReportScheduler&) = delete;
+
+    /**
+     * @brief Encola un trabajo.
+     *
+     * @param job Trabajo a encolar.
+     * @return ID del trabajo, o el de uno idéntico que ya esperaba en la cola.
+     */
+    JobId submit(const ReportJob& job);
+
+    /**
+     * @brief Cancela un trabajo en espera o en ejecución.
+     *
+     * Uno en espera se retira de la cola; uno en ejecución se detiene en la siguiente fila
+     * y descarta sus archivos temporales.
+     *
+     * @param id Trabajo a cancelar.
+     * @return true si el trabajo existía y no había terminado.
+     */
+    bool cancel(JobId id);
+
+    /**
+     * @brief Programa un trabajo periódico.
+     *
+     * @param cron Momentos en que se lanza.
+     * @param job Trabajo a lanzar cada vez.
+     * @return ID de la programación.
+     */
+    ScheduleId addSchedule(const CronSchedule& cron, const ReportJob& job);
+
+    /**
+     * @brief Elimina una programación (los trabajos ya lanzados siguen su curso).
+     *
+     * @param id Programación a eliminar.
+     * @return true si existía.
+     */
+    bool removeSchedule(ScheduleId id);
+
+    /**
+     * @brief Obtiene el número de trabajos en espera o en ejecución.
+     * @return Trabajos pendientes.
+     */
+    std::size_t pendingCount();
+};
+
+#endif // REPORTSCHEDULER_H
@@ -0,0 +1,44 @@
+#include "ReportTemplate.h"
+#include <iostream>
+
+ReportTemplate::ReportTemplate(std::string_view source, std::initializer_list<std::string_view> fields) {
+    text.reserve(source.size());
+
+    // Añade texto estático, fusionándolo con el segmento anterior si también es estático
+    auto appendStatic = [this](std::string_view part) {
+        if (part.empty()) return;
+        if (!segments.empty() && segments.back().field < 0) {
+            segments.back().length += part.size();
+        } else {
+            segments.push_back({text.size(), part.size(), -1});
+        }
+        text.append(part);
+    };
+
+    std::size_t position = 0;
+    while (position < source.size()) {
+        std::size_t open = source.find("{{", position);
+        std::size_t close = open == std::string_view::npos ? open : source.find("}}", open + 2);
+        if (close == std::string_view::npos) {
+            appendStatic(source.substr(position));
+            break;
+        }
+
+        appendStatic(source.substr(position, open - position));
+
+        std::string_view name = source.substr(open + 2, close - open - 2);
+        int field = 0;
+        for (std::string_view candidate : fields) {
+            if (candidate == name) break;
+            ++field;
+        }
+
+        if (field < static_cast<int>(fields.size())) {
+            segments.push_back({text.size(), 0, field});
+        } else {
+            std::cerr << "ReportTemplate: campo desconocido '" << name << "'" << std::endl;
+            appendStatic(source.substr(open, close + 2 - open));
+        }
+        position = close + 2;
+    }
+}
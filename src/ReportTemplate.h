@@ -0,0 +1,66 @@
+#ifndef REPORTTEMPLATE_H
+#define REPORTTEMPLATE_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "OutputBuffer.h"
+
+/**
+ * @class ReportTemplate
+ * @brief Plantilla de texto compilada en segmentos estáticos y marcadores.
+ *
+ * El texto se analiza una sola vez: los marcadores {{nombre}} se sustituyen por el índice
+ * del campo correspondiente y el texto entre ellos queda como segmentos estáticos que se
+ * emiten con una única escritura cada uno. Al renderizar, cada marcador se resuelve con
+ * una función que recibe el índice del campo y el búfer de salida.
+ */
+class ReportTemplate
+{
+private:
+    /**
+     * @brief Tramo de la plantilla: texto estático o referencia a un campo.
+     */
+    struct Segment
+    {
+        std::size_t offset; /**< Inicio del texto estático dentro de text. */
+        std::size_t length; /**< Longitud del texto estático. */
+        int field; /**< Índice del campo, o -1 si es texto estático. */
+    };
+
+    std::string text; /**< Texto estático concatenado. */
+    std::vector<Segment> segments; /**< Segmentos en orden de salida. */
+
+public:
+    /**
+     * @brief Compila una plantilla.
+     *
+     * Un marcador cuyo nombre no está en fields se conserva como texto literal y se
+     * informa por std::cerr.
+     *
+     * @param source Texto de la plantilla con marcadores {{nombre}}.
+     * @param fields Nombres de los campos; el índice en la lista es el que recibe fill.
+     */
+    ReportTemplate(std::string_view source, std::initializer_list<std::string_view> fields);
+
+    /**
+     * @brief Escribe la plantilla en el búfer.
+     *
+     * @param out Búfer de salida.
+     * @param fill Función void(int field, OutputBuffer& out) que escribe cada campo.
+     */
+    template <typename Fill>
+    void render(OutputBuffer& out, Fill&& fill) const {
+        for (const Segment& segment : segments) {
+            if (segment.field < 0) {
+                out.write(std::string_view(text.data() + segment.offset, segment.length));
+            } else {
+                fill(segment.field, out);
+            }
+        }
+    }
+};
+
+#endif // REPORTTEMPLATE_H
@@ -0,0 +1,55 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <memory>
+
+ThreadPool::ThreadPool(std::size_t threadCount) : stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::run, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task) {
+    // packaged_task no es copiable y std::function sí debe serlo
+    auto packaged = std::make_shared<std::packaged_task<void()>>(std::move(task));
+    std::future<void> result = packaged->get_future();
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        tasks.emplace_back([packaged]() { (*packaged)(); });
+    }
+    queueCondition.notify_one();
+    return result;
+}
+
+void ThreadPool::run() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
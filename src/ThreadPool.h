@@ -0,0 +1,72 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Conjunto fijo de hilos que ejecutan tareas en orden de llegada.
+ *
+ * Cada tarea devuelve un std::future que se resuelve al terminar; si la tarea lanza una
+ * excepción, el future la relanza en get(). La instancia compartida (shared()) tiene un
+ * hilo por núcleo y vive hasta el final del programa.
+ */
+class ThreadPool
+{
+private:
+    std::deque<std::function<void()>> tasks; /**< Tareas pendientes en orden de llegada. */
+    std::mutex queueMutex; /**< Protege la cola y stopping. */
+    std::condition_variable queueCondition; /**< Despierta a los hilos cuando hay trabajo. */
+    bool stopping; /**< Indica que los hilos deben terminar. */
+    std::vector<std::thread> workers; /**< Hilos del conjunto. */
+
+    /**
+     * @brief Bucle principal de cada hilo.
+     */
+    void run();
+
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param threadCount Número de hilos; 0 usa uno por núcleo.
+     */
+    explicit ThreadPool(std::size_t threadCount = 0);
+
+    /**
+     * @brief Destructor. Ejecuta las tareas pendientes y detiene los hilos.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Obtiene el conjunto compartido por toda la aplicación.
+     * @return Conjunto con un hilo por núcleo.
+     */
+    static ThreadPool& shared();
+
+    /**
+     * @brief Obtiene el número de hilos.
+     * @return Número de hilos del conjunto.
+     */
+    std::size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Encola una tarea.
+     *
+     * @param task Tarea a ejecutar en algún hilo del conjunto.
+     * @return Future que se resuelve cuando la tarea termina.
+     */
+    std::future<void> submit(std::function<void()> task);
+};
+
+#endif // THREADPOOL_H
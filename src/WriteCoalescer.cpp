@@ -0,0 +1,191 @@
+#include "WriteCoalescer.h"
+#include <algorithm>
+#include <iostream>
+
+WriteCoalescer::WriteCoalescer(DatabaseManager* dbManager,
+                               std::size_t maxBatchSize,
+                               std::chrono::milliseconds maxDelay,
+                               CommitListener listener)
+    : dbManager(dbManager), maxBatchSize(std::max<std::size_t>(1, maxBatchSize)),
+      maxDelay(maxDelay), listener(std::move(listener)), enqueuedCount(0),
+      committedCount(0), flushTarget(0), stopping(false) {
+    worker = std::thread(&WriteCoalescer::run, this);
+}
+
+WriteCoalescer::~WriteCoalescer() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+std::future<int> WriteCoalescer::enqueueAdd(const Component& component) {
+    PendingWrite write;
+    write.kind = WriteKind::Add;
+    write.component = component;
+    write.id = component.getId();
+    std::future<int> result = write.added.get_future();
+    enqueue(std::move(write));
+    return result;
+}
+
+std::future<bool> WriteCoalescer::enqueueUpdate(const Component& component) {
+    PendingWrite write;
+    write.kind = WriteKind::Update;
+    write.component = component;
+    write.id = component.getId();
+    std::future<bool> result = write.done.get_future();
+    enqueue(std::move(write));
+    return result;
+}
+
+std::future<bool> WriteCoalescer::enqueueDelete(int id) {
+    PendingWrite write;
+    write.kind = WriteKind::Delete;
+    write.id = id;
+    std::future<bool> result = write.done.get_future();
+    enqueue(std::move(write));
+    return result;
+}
+
+void WriteCoalescer::enqueue(PendingWrite write) {
+    bool wakeWorker = false;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        write.enqueuedAt = std::chrono::steady_clock::now();
+        queue.push_back(std::move(write));
+        ++enqueuedCount;
+        // El hilo escritor solo necesita despertar al llegar la primera operación
+        // (para fijar el plazo) o al completarse un lote
+        wakeWorker = queue.size() == 1 || queue.size() >= maxBatchSize;
+    }
+    if (wakeWorker) {
+        queueCondition.notify_one();
+    }
+}
+
+void WriteCoalescer::flush() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    std::uint64_t target = enqueuedCount;
+    if (committedCount >= target) return;
+
+    flushTarget = std::max(flushTarget, target);
+    queueCondition.notify_one();
+    committedCondition.wait(lock, [this, target]() { return committedCount >= target; });
+}
+
+bool WriteCoalescer::hasPendingWrites() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return committedCount < enqueuedCount;
+}
+
+void WriteCoalescer::run() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+
+    while (true) {
+        queueCondition.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty()) break; // stopping y sin trabajo pendiente
+
+        // Esperar a que se llene el lote, venza el plazo de la operación más antigua
+        // o alguien pida confirmar ya
+        auto deadline = queue.front().enqueuedAt + maxDelay;
+        queueCondition.wait_until(lock, deadline, [this]() {
+            return stopping || queue.size() >= maxBatchSize || flushTarget > committedCount;
+        });
+
+        std::size_t count = std::min(queue.size(), maxBatchSize);
+        std::vector<PendingWrite> batch;
+        batch.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            batch.push_back(std::move(queue.front()));
+            queue.pop_front();
+        }
+
+        lock.unlock();
+        commitBatch(batch);
+        lock.lock();
+
+        committedCount += batch.size();
+        committedCondition.notify_all();
+    }
+}
+
+void WriteCoalescer::commitBatch(std::vector<PendingWrite>& batch) {
+    std::vector<bool> results(batch.size(), false);
+
+    if (dbManager && dbManager->isConnected()) {
+        // Mantener la conexión tomada durante todo el lote para que ningún otro hilo
+        // intercale sentencias dentro de la transacción
+        auto connectionLock = dbManager->lockConnection();
+
+        // Sin transacción no se escribe nada: en autocommit cada operación se confirmaría
+        // por separado y el lote dejaría de ser atómico
+        bool inTransaction = dbManager->beginTransaction();
+        if (!inTransaction) {
+            std::cerr << "No se pudo iniciar la transacción de un lote de " << batch.size()
+                      << " escrituras" << std::endl;
+        }
+
+        std::size_t transactionStart = 0; // Primera escritura de la transacción abierta
+        for (std::size_t i = 0; inTransaction && i < batch.size(); ++i) {
+            PendingWrite& write = batch[i];
+            switch (write.kind) {
+                case WriteKind::Add:
+                    results[i] = dbManager->addComponent(write.component);
+                    if (results[i]) {
+                        write.id = dbManager->getLastInsertId();
+                        write.component.setId(write.id);
+                    }
+                    break;
+                // Sobre un ID que no existe la sentencia termina bien sin cambiar nada: no se aplicó
+                case WriteKind::Update:
+                    results[i] = dbManager->updateComponent(write.component) && dbManager->getChangedRows() > 0;
+                    break;
+                case WriteKind::Delete:
+                    results[i] = dbManager->deleteComponent(write.id) && dbManager->getChangedRows() > 0;
+                    break;
+            }
+
+            if (!results[i] && !dbManager->isInTransaction()) {
+                // SQLite deshizo la transacción entera: las escrituras anteriores también se
+                // perdieron. Las que faltan van en una transacción nueva
+                std::cerr << "Lote deshecho por un error; se pierden " << (i - transactionStart)
+                          << " escrituras anteriores" << std::endl;
+                std::fill(results.begin() + static_cast<std::ptrdiff_t>(transactionStart),
+                          results.begin() + static_cast<std::ptrdiff_t>(i), false);
+                transactionStart = i + 1;
+                inTransaction = dbManager->beginTransaction();
+            }
+        }
+
+        if (inTransaction && !dbManager->commitTransaction()) {
+            std::cerr << "Error al confirmar lote de " << (batch.size() - transactionStart) << " escrituras" << std::endl;
+            if (dbManager->isInTransaction()) dbManager->rollbackTransaction();
+            std::fill(results.begin() + static_cast<std::ptrdiff_t>(transactionStart), results.end(), false);
+        }
+
+        if (listener) {
+            std::vector<CommittedWrite> committed;
+            committed.reserve(batch.size());
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                if (!results[i]) continue;
+                committed.push_back({batch[i].kind, batch[i].component, batch[i].id});
+            }
+            if (!committed.empty()) {
+                listener(committed);
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        if (batch[i].kind == WriteKind::Add) {
+            batch[i].added.set_value(results[i] ? batch[i].id : -1);
+        } else {
+            batch[i].done.set_value(results[i]);
+        }
+    }
+}
@@ -0,0 +1,169 @@
+#ifndef WRITECOALESCER_H
+#define WRITECOALESCER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Component.h"
+#include "DatabaseManager.h"
+
+/**
+ * @class WriteCoalescer
+ * @brief Agrupa escrituras pequeñas en una sola transacción SQLite (group commit).
+ *
+ * Las operaciones de alta, modificación y baja se encolan en orden de llegada y un hilo
+ * de fondo las confirma en una única transacción cada maxDelay milisegundos o cada
+ * maxBatchSize operaciones, lo que ocurra primero. Cada operación devuelve un std::future
+ * que se resuelve cuando su lote ha sido confirmado; el de una alta entrega el ID asignado.
+ */
+class WriteCoalescer
+{
+public:
+    /**
+     * @brief Tipo de operación de escritura.
+     */
+    enum class WriteKind { Add, Update, Delete };
+
+    /**
+     * @brief Escritura ya confirmada en la base de datos.
+     */
+    struct CommittedWrite
+    {
+        WriteKind kind; /**< Tipo de operación. */
+        Component component; /**< Componente escrito (con su ID definitivo en las altas). */
+        int id; /**< ID del componente afectado. */
+    };
+
+    /**
+     * @brief Función que recibe cada lote confirmado, en orden.
+     */
+    using CommitListener = std::function<void(const std::vector<CommittedWrite>&)>;
+
+private:
+    /**
+     * @brief Operación de escritura pendiente de confirmar.
+     */
+    struct PendingWrite
+    {
+        WriteKind kind; /**< Tipo de operación. */
+        Component component; /**< Componente a insertar o actualizar. */
+        int id; /**< ID del componente a eliminar (en las altas, el asignado al confirmar). */
+        std::promise<bool> done; /**< Resultado entregado al llamador (modificaciones y bajas). */
+        std::promise<int> added; /**< ID asignado, o -1 si falló (altas). */
+        std::chrono::steady_clock::time_point enqueuedAt; /**< Momento en que se encoló. */
+    };
+
+    DatabaseManager* dbManager; /**< Gestor de base de datos sobre el que se escribe. */
+    std::size_t maxBatchSize; /**< Número máximo de operaciones por transacción. */
+    std::chrono::milliseconds maxDelay; /**< Espera máxima antes de confirmar un lote. */
+    CommitListener listener; /**< Se notifica tras cada lote confirmado. */
+
+    std::deque<PendingWrite> queue; /**< Operaciones pendientes en orden de llegada. */
+    std::mutex queueMutex; /**< Protege la cola y los contadores. */
+    std::condition_variable queueCondition; /**< Despierta al hilo escritor. */
+    std::condition_variable committedCondition; /**< Despierta a quienes esperan en flush(). */
+    std::uint64_t enqueuedCount; /**< Operaciones encoladas desde el inicio. */
+    std::uint64_t committedCount; /**< Operaciones ya confirmadas desde el inicio. */
+    std::uint64_t flushTarget; /**< Operaciones que deben confirmarse sin esperar el plazo. */
+    bool stopping; /**< Indica que el hilo escritor debe terminar. */
+    std::thread worker; /**< Hilo que confirma los lotes. */
+
+    /**
+     * @brief Bucle principal del hilo escritor.
+     */
+    void run();
+
+    /**
+     * @brief Aplica un lote de operaciones dentro de una transacción.
+     *
+     * Cada operación informa de si quedó confirmada: una que falla sin deshacer la
+     * transacción no afecta a las demás; si SQLite deshace la transacción entera, las
+     * anteriores también cuentan como fallidas y las siguientes van en otra transacción.
+     * Si no se puede abrir la transacción (la base sigue bloqueada tras la espera de la
+     * conexión) o el COMMIT falla, no se confirma ninguna.
+     *
+     * @param batch Operaciones a aplicar, en orden.
+     */
+    void commitBatch(std::vector<PendingWrite>& batch);
+
+    /**
+     * @brief Encola una operación y despierta al hilo escritor si es necesario.
+     *
+     * El llamador obtiene antes el future de la promesa que corresponda al tipo.
+     *
+     * @param write Operación a encolar.
+     */
+    void enqueue(PendingWrite write);
+
+public:
+    /**
+     * @brief Constructor parametrizado.
+     *
+     * @param dbManager Gestor de base de datos (debe sobrevivir al WriteCoalescer).
+     * @param maxBatchSize Número máximo de operaciones por transacción.
+     * @param maxDelay Tiempo máximo que una operación espera antes de confirmarse.
+     * @param listener Función invocada con las escrituras de cada lote confirmado, antes de
+     *        resolver sus futures y con la conexión aún tomada.
+     */
+    WriteCoalescer(DatabaseManager* dbManager,
+                   std::size_t maxBatchSize = 256,
+                   std::chrono::milliseconds maxDelay = std::chrono::milliseconds(20),
+                   CommitListener listener = nullptr);
+
+    /**
+     * @brief Destructor.
+     *
+     * Confirma las operaciones pendientes y detiene el hilo escritor.
+     */
+    ~WriteCoalescer();
+
+    WriteCoalescer(const WriteCoalescer&) = delete;
+    WriteCoalescer& operator=(const WriteCoalescer&) = delete;
+
+    /**
+     * @brief Encola la inserción de un componente.
+     *
+     * @param component Componente a agregar.
+     * @return Future con el ID asignado si la inserción se confirmó, o -1 si falló.
+     */
+    std::future<int> enqueueAdd(const Component& component);
+
+    /**
+     * @brief Encola la actualización de un componente.
+     *
+     * @param component Componente con los datos actualizados.
+     * @return Future que vale true si la actualización se confirmó; false también si el ID no existe.
+     */
+    std::future<bool> enqueueUpdate(const Component& component);
+
+    /**
+     * @brief Encola la eliminación de un componente.
+     *
+     * @param id ID del componente a eliminar.
+     * @return Future que vale true si la eliminación se confirmó; false también si el ID no existe.
+     */
+    std::future<bool> enqueueDelete(int id);
+
+    /**
+     * @brief Confirma de inmediato todo lo encolado hasta ahora y espera a que termine.
+     *
+     * Tras volver, cualquier lectura sobre la base de datos observa las escrituras
+     * encoladas antes de la llamada.
+     */
+    void flush();
+
+    /**
+     * @brief Indica si hay operaciones encoladas aún sin confirmar.
+     *
+     * @return true si existen escrituras pendientes.
+     */
+    bool hasPendingWrites();
+};
+
+#endif // WRITECOALESCER_H
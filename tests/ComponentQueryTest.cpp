@@ -0,0 +1,182 @@
+/**
+ * @file ComponentQueryTest.cpp
+ * @brief Comprueba que ComponentQuery da lo mismo traducida a SQL que evaluada en memoria.
+ *
+ * - La base tiene ubicaciones y fechas de compra NULL, además de vacías, con comodines de
+ *   LIKE y con mayúsculas distintas. Cada consulta al azar (árbol de predicados con Y/O/NO,
+ *   orden y límite) debe devolver los mismos componentes, en el mismo orden, con
+ *   DatabaseManager::queryComponents, con InventoryManager::query y con una evaluación
+ *   sin MatchMemo.
+ * - La búsqueda por texto y el stock bajo de DatabaseManager, que pasan por la consulta,
+ *   coinciden con los de InventoryManager.
+ */
+#include <climits>
+#include <cstdio>
+#include <random>
+#include <sqlite3.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "DatabaseManager.h"
+#include "InventoryManager.h"
+
+namespace {
+    int failures = 0;
+
+    void check(bool ok, const char* step, const char* what) {
+        if (!ok && ++failures <= 10) std::fprintf(stderr, "%s: %s\n", step, what);
+    }
+
+    std::vector<int> idsOf(const std::vector<Component>& components) {
+        std::vector<int> ids;
+        for (const Component& component : components) ids.push_back(component.getId());
+        return ids;
+    }
+
+    const char* const TYPES[] = {"Resistor", "LED", "Sensor", "Otro", "Módulo"};
+    const char* const TEXTS[] = {"", "caj", "Cajón", "estante_", "10%", "a", "LED", "r", "\\", "x", "ó"};
+    const long long QUANTITIES[] = {INT_MIN, -5, 0, 3, 5, 10, 40, INT_MAX};
+    const long long DATES[] = {-1, 0, 1, 1600000000, 1650000000, 1700000000, LLONG_MAX};
+
+    template <typename T, std::size_t N>
+    T pick(std::mt19937& random, const T (&values)[N]) {
+        return values[random() % N];
+    }
+
+    // Árbol de predicados al azar; depth limita el anidamiento de Y/O/NO
+    ComponentQuery::PredicatePtr randomPredicate(std::mt19937& random, int depth) {
+        switch (random() % (depth > 0 ? 12 : 7)) {
+            case 0: {
+                std::vector<std::string> types;
+                const std::size_t count = random() % 3;
+                for (std::size_t i = 0; i < count; ++i) types.push_back(pick(random, TYPES));
+                if (random() % 4 == 0) types.push_back("Inexistente");
+                return ComponentQuery::typeIn(types);
+            }
+            case 1: return ComponentQuery::locationPrefix(pick(random, TEXTS));
+            case 2: {
+                long long low = pick(random, QUANTITIES), high = pick(random, QUANTITIES);
+                return ComponentQuery::quantityBetween(static_cast<int>(low), static_cast<int>(high));
+            }
+            case 3: return ComponentQuery::purchasedBetween(static_cast<std::time_t>(pick(random, DATES)),
+                                                            static_cast<std::time_t>(pick(random, DATES)));
+            case 4: return ComponentQuery::nameContains(pick(random, TEXTS));
+            case 5: return ComponentQuery::typeContains(pick(random, TEXTS));
+            case 6: return ComponentQuery::locationContains(pick(random, TEXTS));
+            case 7:
+            case 8: {
+                std::vector<ComponentQuery::PredicatePtr> operands;
+                const std::size_t count = random() % 4;
+                for (std::size_t i = 0; i < count; ++i) operands.push_back(randomPredicate(random, depth - 1));
+                return random() % 2 ? ComponentQuery::allOf(operands) : ComponentQuery::anyOf(operands);
+            }
+            default: return ComponentQuery::negate(randomPredicate(random, depth - 1));
+        }
+    }
+
+    ComponentQuery randomQuery(std::mt19937& random) {
+        ComponentQuery query;
+        if (random() % 8 != 0) query.where(randomPredicate(random, 3));
+        const std::size_t keys = random() % 3;
+        for (std::size_t i = 0; i < keys; ++i) {
+            query.orderBy(static_cast<ComponentQuery::SortKey>(random() % 6), random() % 2 == 0);
+        }
+        if (random() % 3 == 0) query.limit(1 + random() % 30);
+        return query;
+    }
+
+    /**
+     * Inserta las filas con otra conexión para poder dejar columnas en NULL.
+     */
+    bool insertRows(const std::string& path, std::mt19937& random, int count) {
+        const char* names[] = {"Resistor 10k", "resistor 1k", "LED rojo", "Led_verde", "Sensor 50%", "Capacitor",
+                               "Módulo Wi-Fi", "Caja\\B"};
+        const char* locations[] = {nullptr, "", "Cajón A", "cajón a2", "CAJÓN B", "Estante_1", "Estante 10%", "Caja\\B"};
+        const long long dates[] = {-1, 0, 1600000000, 1650000000, 1700000000}; // -1: NULL
+
+        sqlite3* db = nullptr;
+        if (sqlite3_open(path.c_str(), &db) != SQLITE_OK) return false;
+        sqlite3_stmt* stmt = nullptr;
+        bool ok = sqlite3_exec(db, "BEGIN", nullptr, nullptr, nullptr) == SQLITE_OK &&
+                  sqlite3_prepare_v2(db, "INSERT INTO components (name, type, quantity, location, purchase_date) "
+                                         "VALUES (?, ?, ?, ?, ?)", -1, &stmt, nullptr) == SQLITE_OK;
+        for (int i = 0; i < count && ok; ++i) {
+            const char* location = pick(random, locations);
+            const long long date = pick(random, dates);
+            sqlite3_bind_text(stmt, 1, pick(random, names), -1, SQLITE_STATIC);
+            sqlite3_bind_text(stmt, 2, pick(random, TYPES), -1, SQLITE_STATIC);
+            sqlite3_bind_int(stmt, 3, static_cast<int>(random() % 45) - 4);
+            if (location) {
+                sqlite3_bind_text(stmt, 4, location, -1, SQLITE_STATIC);
+            } else {
+                sqlite3_bind_null(stmt, 4);
+            }
+            if (date >= 0) {
+                sqlite3_bind_int64(stmt, 5, date);
+            } else {
+                sqlite3_bind_null(stmt, 5);
+            }
+            ok = sqlite3_step(stmt) == SQLITE_DONE;
+            sqlite3_reset(stmt);
+        }
+        sqlite3_finalize(stmt);
+        ok = ok && sqlite3_exec(db, "COMMIT", nullptr, nullptr, nullptr) == SQLITE_OK;
+        sqlite3_close(db);
+        return ok;
+    }
+}
+
+int main() {
+    const std::string path = "consulta_" + std::to_string(static_cast<long>(getpid())) + ".db";
+    DatabaseManager dbManager(path);
+    if (!dbManager.connect()) {
+        std::fprintf(stderr, "no se pudo crear %s\n", path.c_str());
+        return 1;
+    }
+
+    std::mt19937 random(28);
+    check(insertRows(path, random, 400), "datos", "no se pudieron insertar las filas");
+
+    {
+        InventoryManager inventoryManager(&dbManager);
+        auto snapshot = inventoryManager.snapshot();
+        check(snapshot->size() == 400, "datos", "el inventario no tiene las filas de la base");
+
+        for (int round = 0; round < 3000; ++round) {
+            const ComponentQuery query = randomQuery(random);
+            const std::vector<int> fromSql = idsOf(dbManager.queryComponents(query));
+            const std::vector<int> fromMemory = idsOf(inventoryManager.query(query));
+            check(fromSql == fromMemory, "consulta al azar", "SQL y memoria no coinciden");
+
+            // Sin MatchMemo: cada comparación de texto se hace de nuevo
+            std::vector<int> direct;
+            for (const Component& component : *snapshot) {
+                if (query.matches(component)) direct.push_back(component.getId());
+            }
+            std::vector<int> filtered = idsOf(ComponentQuery().where(query.getFilter()).apply(*snapshot));
+            check(direct == filtered, "consulta al azar", "matches con y sin MatchMemo no coinciden");
+        }
+
+        for (const char* keyword : TEXTS) {
+            check(idsOf(dbManager.searchComponents(keyword)) == idsOf(inventoryManager.searchComponents(keyword)),
+                  keyword, "la búsqueda por texto no coincide");
+        }
+        for (int threshold : {-5, 0, 5, 40}) {
+            ComponentQuery lowStock;
+            lowStock.where(ComponentQuery::quantityBetween(INT_MIN, threshold))
+                    .orderBy(ComponentQuery::SortKey::Quantity);
+            check(idsOf(dbManager.getLowStockComponents(threshold)) == idsOf(inventoryManager.query(lowStock)),
+                  "stock bajo", "no coincide con la consulta en memoria");
+        }
+    }
+
+    dbManager.disconnect();
+    for (const char* suffix : {"", ".image", "-journal"}) std::remove((path + suffix).c_str());
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d comprobaciones fallidas\n", failures);
+        return 1;
+    }
+    std::printf("consultas: SQL y memoria coinciden, también con columnas NULL\n");
+    return 0;
+}
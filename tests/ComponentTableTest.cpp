@@ -0,0 +1,153 @@
+/**
+ * @file ComponentTableTest.cpp
+ * @brief Comprueba los kernels de ComponentTable y las tablas por bloque del snapshot.
+ *
+ * - Cada kernel (escalar, SSE2, AVX2, NEON; los que haya en esta CPU) debe dar lo mismo
+ *   que un recorrido simple en countAtOrBelow, filterAtOrBelow y sumQuantities, con
+ *   longitudes que dejan restos de cualquier tamaño y umbrales en los extremos de int.
+ * - Los recuentos de un snapshot, derivados por bloques y heredados de un snapshot al
+ *   siguiente en withWrites, deben coincidir con recorrer sus componentes tras cada lote.
+ */
+#include <climits>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "ComponentTable.h"
+#include "InventorySnapshot.h"
+
+namespace {
+    int failures = 0;
+
+    void check(bool ok, const char* step, const char* what) {
+        if (!ok && ++failures <= 10) std::fprintf(stderr, "%s: %s\n", step, what);
+    }
+
+    const char* kernelName(ComponentTable::Kernel kernel) {
+        switch (kernel) {
+            case ComponentTable::Kernel::Scalar: return "escalar";
+            case ComponentTable::Kernel::Sse2: return "SSE2";
+            case ComponentTable::Kernel::Avx2: return "AVX2";
+            case ComponentTable::Kernel::Neon: return "NEON";
+            default: return "auto";
+        }
+    }
+
+    // Cantidades al azar con algunos valores extremos
+    std::vector<std::int32_t> randomQuantities(std::mt19937& random, std::size_t count) {
+        std::vector<std::int32_t> quantities(count);
+        for (std::int32_t& quantity : quantities) {
+            switch (random() % 8) {
+                case 0: quantity = INT_MIN; break;
+                case 1: quantity = INT_MAX; break;
+                case 2: quantity = -static_cast<std::int32_t>(random() % 100); break;
+                default: quantity = static_cast<std::int32_t>(random() % 20); break;
+            }
+        }
+        return quantities;
+    }
+
+    void checkKernel(const std::vector<std::int32_t>& quantities, int threshold, const char* step) {
+        ComponentTable table;
+        for (std::size_t row = 0; row < quantities.size(); ++row) {
+            table.append(static_cast<int>(row), "componente", "Otro", quantities[row], "Cajón A", 0);
+        }
+        std::vector<std::uint32_t> rows;
+        long long sum = 0;
+        for (std::size_t row = 0; row < quantities.size(); ++row) {
+            if (quantities[row] <= threshold) rows.push_back(static_cast<std::uint32_t>(row));
+            sum += quantities[row];
+        }
+        check(table.countAtOrBelow(threshold) == rows.size(), step, "countAtOrBelow");
+        check(table.filterAtOrBelow(threshold) == rows, step, "filterAtOrBelow");
+        check(table.sumQuantities() == sum, step, "sumQuantities");
+    }
+
+    // Recuentos del snapshot contra un recorrido de sus componentes
+    void checkSnapshot(const InventorySnapshot& snapshot, int threshold, const char* step) {
+        std::vector<std::uint32_t> rows;
+        long long sum = 0;
+        for (std::size_t row = 0; row < snapshot.size(); ++row) {
+            if (snapshot.at(row).getQuantity() <= threshold) rows.push_back(static_cast<std::uint32_t>(row));
+            sum += snapshot.at(row).getQuantity();
+        }
+        check(snapshot.countAtOrBelow(threshold) == rows.size(), step, "countAtOrBelow");
+        check(snapshot.filterAtOrBelow(threshold) == rows, step, "filterAtOrBelow");
+        check(snapshot.sumQuantities() == sum, step, "sumQuantities");
+    }
+
+    Component randomComponent(std::mt19937& random, int id) {
+        const char* names[] = {"Resistor", "Capacitor", "LED", "Arduino Nano", "Sensor DHT22"};
+        return Component(id, std::string(names[random() % 5]) + " " + std::to_string(random() % 300), "Otro",
+                         static_cast<int>(random() % 12), "Cajón A", 0);
+    }
+}
+
+int main() {
+    std::mt19937 random(29);
+    const ComponentTable::Kernel kernels[] = {ComponentTable::Kernel::Scalar, ComponentTable::Kernel::Sse2,
+                                              ComponentTable::Kernel::Avx2, ComponentTable::Kernel::Neon};
+    std::vector<std::vector<std::int32_t>> inputs;
+    for (std::size_t count = 0; count <= 70; ++count) inputs.push_back(randomQuantities(random, count));
+    inputs.push_back(randomQuantities(random, 10007));
+    const int thresholds[] = {INT_MIN, -1, 0, 5, 11, INT_MAX - 1, INT_MAX};
+
+    for (ComponentTable::Kernel kernel : kernels) {
+        if (!ComponentTable::setKernel(kernel)) {
+            std::printf("%s: no disponible, se omite\n", kernelName(kernel));
+            continue;
+        }
+        for (const std::vector<std::int32_t>& quantities : inputs) {
+            for (int threshold : thresholds) checkKernel(quantities, threshold, kernelName(kernel));
+        }
+        std::printf("%s: %zu tablas comprobadas\n", kernelName(kernel), inputs.size());
+    }
+    ComponentTable::setKernel(ComponentTable::Kernel::Auto);
+
+    // Tablas por bloque: una serie de snapshots con las tablas ya construidas y otra sin ellas
+    std::vector<Component> components;
+    int nextId = 1;
+    for (; nextId <= 5000; ++nextId) components.push_back(randomComponent(random, nextId));
+    auto derived = std::make_shared<const InventorySnapshot>(components, 1);
+    auto lazy = std::make_shared<const InventorySnapshot>(components, 1);
+    checkSnapshot(*derived, 5, "inicial");
+
+    std::vector<int> ids;
+    for (const Component& component : components) ids.push_back(component.getId());
+    for (std::uint64_t version = 2; version < 300; ++version) {
+        std::vector<WriteCoalescer::CommittedWrite> writes;
+        const std::size_t batch = 1 + random() % 20;
+        for (std::size_t i = 0; i < batch; ++i) {
+            const int action = ids.empty() ? 0 : static_cast<int>(random() % 4);
+            const std::size_t target = ids.empty() ? 0 : random() % ids.size();
+            if (action == 0) {
+                Component added = randomComponent(random, nextId);
+                ids.push_back(nextId);
+                writes.push_back({WriteCoalescer::WriteKind::Add, added, nextId++});
+            } else if (action == 1) {
+                // Solo la cantidad: el componente se queda en su bloque
+                const Component* current = derived->findById(ids[target]);
+                Component updated = current ? *current : randomComponent(random, ids[target]);
+                updated.setQuantity(static_cast<int>(random() % 12));
+                writes.push_back({WriteCoalescer::WriteKind::Update, updated, ids[target]});
+            } else if (action == 2) {
+                writes.push_back({WriteCoalescer::WriteKind::Update, randomComponent(random, ids[target]), ids[target]});
+            } else {
+                writes.push_back({WriteCoalescer::WriteKind::Delete, Component(), ids[target]});
+                ids.erase(ids.begin() + static_cast<std::ptrdiff_t>(target));
+            }
+        }
+        derived = derived->withWrites(writes, version);
+        lazy = lazy->withWrites(writes, version);
+        checkSnapshot(*derived, 5, "heredadas");
+    }
+    checkSnapshot(*lazy, 5, "construidas al final");
+    checkSnapshot(*derived, INT_MAX, "umbral máximo");
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d comprobaciones fallidas\n", failures);
+        return 1;
+    }
+    std::printf("tabla columnar: kernels y tablas por bloque correctos\n");
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file ExportBenchmark.cpp
+ * @brief Mide las exportaciones CSV, JSON Lines y columnar, y la lectura del columnar.
+ *
+ * No es una prueba: se ejecuta a mano, con el número de filas como argumento opcional
+ * (por defecto 1 000 000). Informa del tiempo y del tamaño de cada archivo.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+#include "BinarySnapshot.h"
+#include "ComponentTable.h"
+#include "ReportGenerator.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    long long fileSize(const std::string& path) {
+        struct stat info;
+        return stat(path.c_str(), &info) == 0 ? static_cast<long long>(info.st_size) : -1;
+    }
+
+    template <typename Export>
+    void measure(const char* label, const std::string& path, Export exportFile) {
+        Clock::time_point start = Clock::now();
+        const bool ok = exportFile();
+        const double elapsed = millisecondsSince(start);
+        std::printf("%-14s %10.1f ms %12lld bytes%s\n", label, elapsed, fileSize(path), ok ? "" : "  (falló)");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t rows = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    std::mt19937 random(42);
+    const char* types[] = {"Resistor", "Capacitor", "Diodo", "Transistor", "Microcontrolador"};
+    const char* locations[] = {"Cajón A1", "Cajón A2", "Estante B", "Caja \"C\""};
+    std::vector<Component> components;
+    components.reserve(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        components.emplace_back(static_cast<int>(i + 1), "Componente " + std::to_string(random() % 100000),
+                                types[random() % 5], static_cast<int>(random() % 100), locations[random() % 4],
+                                static_cast<std::time_t>(1500000000 + random() % 300000000));
+    }
+    ComponentTable table;
+    table.reserve(rows);
+    for (const Component& component : components) table.append(component);
+
+    std::printf("%zu filas\n", rows);
+    measure("CSV", "benchmark.csv", [&]() { return ReportGenerator::generateCSVReport(components, "benchmark.csv"); });
+    measure("JSONL", "benchmark.jsonl", [&]() {
+        return ReportGenerator::generateJSONLinesReport(components, "benchmark.jsonl");
+    });
+    measure("columnar", "benchmark.bin", [&]() {
+        return ReportGenerator::generateColumnarExport(table, "benchmark.bin");
+    });
+
+    // Lectura: abrir (con suma de comprobación) y sumar una columna sin materializar filas
+    Clock::time_point start = Clock::now();
+    BinarySnapshotReader reader;
+    long long total = 0;
+    if (reader.open("benchmark.bin", true)) {
+        for (std::size_t row = 0; row < reader.size(); ++row) total += reader.getQuantity(row);
+    }
+    std::printf("%-14s %10.1f ms (cantidad total %lld)\n", "lectura", millisecondsSince(start), total);
+
+    start = Clock::now();
+    std::vector<Component> restored = reader.readComponents();
+    std::printf("%-14s %10.1f ms (%zu componentes)\n", "readComponents", millisecondsSince(start), restored.size());
+
+    for (const char* path : {"benchmark.csv", "benchmark.jsonl", "benchmark.bin"}) std::remove(path);
+    return 0;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file ExportRoundTripTest.cpp
+ * @brief Exporta componentes en columnar y JSON Lines, los vuelve a leer y compara cada campo.
+ *
+ * El columnar se lee con BinarySnapshotReader (con la suma de comprobación); el JSON Lines
+ * se interpreta con un lector mínimo de objetos planos, suficiente para el formato de
+ * ReportGenerator. Los nombres incluyen comillas, barras, caracteres de control y UTF-8.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unistd.h>
+#include "BinarySnapshot.h"
+#include "ComponentTable.h"
+#include "ReportGenerator.h"
+
+namespace {
+    int failures = 0;
+
+    void fail(std::size_t row, const char* what) {
+        if (++failures <= 10) std::fprintf(stderr, "fila %zu: %s no coincide\n", row, what);
+    }
+
+    std::vector<Component> randomComponents(std::size_t count) {
+        std::mt19937 random(7);
+        const char* types[] = {"Resistor", "Capacitor", "Diodo", "Microcontrolador \"MCU\""};
+        const char* locations[] = {"Cajón A1", "Estante <2>", "Caja \\ 3", ""};
+        const char* pieces[] = {"R", "1kΩ", "\"", "\\", "\n", "\t", "\x01", "&", " ", "µF", "ñ", "abc"};
+
+        std::vector<Component> components;
+        components.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string name;
+            const std::size_t length = random() % 8;
+            for (std::size_t j = 0; j < length; ++j) name += pieces[random() % (sizeof(pieces) / sizeof(pieces[0]))];
+            // Sin fecha (0) en una de cada cinco filas: JSON la escribe como null
+            const std::time_t date = random() % 5 == 0 ? 0 : static_cast<std::time_t>(1500000000 + random() % 300000000);
+            components.emplace_back(static_cast<int>(i * 3 + 1), name, types[random() % 4],
+                                    static_cast<int>(random() % 20), locations[random() % 4], date);
+        }
+        return components;
+    }
+
+    void checkColumnar(const std::vector<Component>& components, const std::string& path) {
+        ComponentTable table;
+        table.reserve(components.size());
+        for (const Component& component : components) table.append(component);
+        if (!ReportGenerator::generateColumnarExport(table, path)) {
+            std::fprintf(stderr, "no se pudo exportar %s\n", path.c_str());
+            ++failures;
+            return;
+        }
+
+        BinarySnapshotReader reader;
+        if (!reader.open(path, true)) {
+            std::fprintf(stderr, "no se pudo abrir %s\n", path.c_str());
+            ++failures;
+            return;
+        }
+        if (reader.size() != components.size()) {
+            std::fprintf(stderr, "columnar: %zu filas en lugar de %zu\n", reader.size(), components.size());
+            ++failures;
+            return;
+        }
+        for (std::size_t row = 0; row < components.size(); ++row) {
+            const Component& expected = components[row];
+            if (reader.getId(row) != expected.getId()) fail(row, "id (columnar)");
+            if (reader.getName(row) != expected.getName()) fail(row, "name (columnar)");
+            if (reader.getType(row) != expected.getType()) fail(row, "type (columnar)");
+            if (reader.getQuantity(row) != expected.getQuantity()) fail(row, "quantity (columnar)");
+            if (reader.getLocation(row) != expected.getLocation()) fail(row, "location (columnar)");
+            if (reader.getPurchaseDate(row) != static_cast<std::int64_t>(expected.getPurchaseDate())) {
+                fail(row, "purchase_date (columnar)");
+            }
+            if (reader.findRow(expected.getId()) != static_cast<long>(row)) fail(row, "findRow (columnar)");
+        }
+    }
+
+    /**
+     * Lector de una línea JSON Lines: un objeto plano con cadenas, enteros, null y booleanos.
+     */
+    class JsonLine
+    {
+    private:
+        std::string_view text;
+        std::size_t position = 0;
+        bool valid = true;
+
+        bool consume(char expected) {
+            if (position < text.size() && text[position] == expected) {
+                ++position;
+                return true;
+            }
+            valid = false;
+            return false;
+        }
+
+        std::string readString() {
+            std::string value;
+            if (!consume('"')) return value;
+            while (position < text.size() && text[position] != '"') {
+                char c = text[position++];
+                if (c != '\\') {
+                    value += c;
+                    continue;
+                }
+                if (position >= text.size()) break;
+                switch (text[position++]) {
+                    case '"': value += '"'; break;
+                    case '\\': value += '\\'; break;
+                    case '/': value += '/'; break;
+                    case 'n': value += '\n'; break;
+                    case 'r': value += '\r'; break;
+                    case 't': value += '\t'; break;
+                    case 'u': {
+                        // ReportGenerator solo usa \u00XX, para caracteres de control
+                        if (position + 4 > text.size() || text.substr(position, 2) != "00") {
+                            valid = false;
+                            return value;
+                        }
+                        value += static_cast<char>(std::strtol(std::string(text.substr(position + 2, 2)).c_str(), nullptr, 16));
+                        position += 4;
+                        break;
+                    }
+                    default: valid = false; return value;
+                }
+            }
+            consume('"');
+            return value;
+        }
+
+        std::string readLiteral() {
+            std::size_t start = position;
+            while (position < text.size() && text[position] != ',' && text[position] != '}') ++position;
+            return std::string(text.substr(start, position - start));
+        }
+
+    public:
+        std::string id, name, type, quantity, location, purchaseDate, lowStock;
+
+        explicit JsonLine(std::string_view line) : text(line) {
+            consume('{');
+            while (valid && position < text.size() && text[position] != '}') {
+                const std::string key = readString();
+                consume(':');
+                if (key == "name") name = readString();
+                else if (key == "type") type = readString();
+                else if (key == "location") location = readString();
+                else if (key == "id") id = readLiteral();
+                else if (key == "quantity") quantity = readLiteral();
+                else if (key == "purchase_date") purchaseDate = readLiteral();
+                else if (key == "low_stock") lowStock = readLiteral();
+                else valid = false;
+                if (position < text.size() && text[position] == ',') ++position;
+            }
+            consume('}');
+            if (position != text.size()) valid = false;
+        }
+
+        bool isValid() const { return valid; }
+    };
+
+    void checkJsonLines(const std::vector<Component>& components, const std::string& path) {
+        if (!ReportGenerator::generateJSONLinesReport(components, path)) {
+            std::fprintf(stderr, "no se pudo exportar %s\n", path.c_str());
+            ++failures;
+            return;
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        std::string line;
+        std::size_t row = 0;
+        while (std::getline(file, line)) {
+            if (row >= components.size()) {
+                ++row;
+                continue;
+            }
+            const Component& expected = components[row];
+            JsonLine parsed(line);
+            if (!parsed.isValid()) {
+                fail(row, "JSON válido");
+            } else {
+                const std::string date = expected.getPurchaseDate() == 0
+                    ? std::string("null") : std::to_string(static_cast<long long>(expected.getPurchaseDate()));
+                if (parsed.id != std::to_string(expected.getId())) fail(row, "id (JSON)");
+                if (parsed.name != expected.getName()) fail(row, "name (JSON)");
+                if (parsed.type != expected.getType()) fail(row, "type (JSON)");
+                if (parsed.quantity != std::to_string(expected.getQuantity())) fail(row, "quantity (JSON)");
+                if (parsed.location != expected.getLocation()) fail(row, "location (JSON)");
+                if (parsed.purchaseDate != date) fail(row, "purchase_date (JSON)");
+                if (parsed.lowStock != (expected.isLowStock() ? "true" : "false")) fail(row, "low_stock (JSON)");
+            }
+            ++row;
+        }
+        if (row != components.size()) {
+            std::fprintf(stderr, "JSON Lines: %zu líneas en lugar de %zu\n", row, components.size());
+            ++failures;
+        }
+    }
+}
+
+int main() {
+    const std::vector<Component> components = randomComponents(5000);
+    const std::string base = "exportacion_" + std::to_string(static_cast<long>(getpid()));
+
+    checkColumnar(components, base + ".bin");
+    checkJsonLines(components, base + ".jsonl");
+    // También sin filas
+    checkColumnar({}, base + "_vacia.bin");
+    checkJsonLines({}, base + "_vacia.jsonl");
+
+    for (const char* suffix : {".bin", ".jsonl", "_vacia.bin", "_vacia.jsonl"}) {
+        std::remove((base + suffix).c_str());
+    }
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d diferencias\n", failures);
+        return 1;
+    }
+    std::printf("columnar y JSON Lines: %zu componentes leídos sin diferencias\n", components.size());
+    return 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file InventoryTableModelTest.cpp
+ * @brief Comprueba InventoryTableModel con QAbstractItemModelTester.
+ *
+ * Recorre lo que hace la ventana principal: cargar un snapshot, mostrar una búsqueda
+ * por páginas, seleccionar filas y aplicar altas, cambios (en su sitio o moviendo la
+ * fila) y bajas con applyChange. Tras cada paso las filas del modelo deben ser las del
+ * snapshot nuevo (o las que coinciden con la búsqueda), en orden, y QAbstractItemModelTester
+ * aborta si alguna notificación no cuadra con el contenido. Un QPersistentModelIndex hace
+ * de selección: debe seguir al componente cambiado hasta su nueva fila.
+ */
+#include <QAbstractItemModelTester>
+#include <QPersistentModelIndex>
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "InventorySnapshot.h"
+#include "InventoryTableModel.h"
+
+namespace {
+    int failures = 0;
+
+    void check(bool ok, const char* step, const char* what) {
+        if (!ok && ++failures <= 10) std::fprintf(stderr, "%s: %s\n", step, what);
+    }
+
+    // Mismo criterio que MainWindow::matchesSearch
+    bool matches(const Component& component, const std::string& keyword) {
+        return keyword.empty() ||
+               InventorySnapshot::containsIgnoreCase(component.getName(), keyword) ||
+               InventorySnapshot::containsIgnoreCase(component.getType(), keyword) ||
+               InventorySnapshot::containsIgnoreCase(component.getLocation(), keyword);
+    }
+
+    // Filas que debe mostrar el modelo: el snapshot entero o solo las que coinciden
+    std::vector<int> expectedIds(const InventorySnapshot& snapshot, const std::string& keyword) {
+        std::vector<int> ids;
+        for (const Component& component : snapshot) {
+            if (matches(component, keyword)) ids.push_back(component.getId());
+        }
+        return ids;
+    }
+
+    void checkRows(const InventoryTableModel& model, const std::vector<int>& ids, const char* step) {
+        check(model.rowCount() == static_cast<int>(ids.size()), step, "número de filas");
+        for (std::size_t row = 0; row < ids.size() && row < static_cast<std::size_t>(model.rowCount()); ++row) {
+            const Component* shown = model.componentAt(static_cast<int>(row));
+            if (!shown || shown->getId() != ids[row]) {
+                check(false, step, "fila fuera de orden");
+                return;
+            }
+        }
+        check(model.componentAt(model.rowCount()) == nullptr, step, "componentAt fuera de rango");
+    }
+
+    Component randomComponent(std::mt19937& random, int id) {
+        const char* names[] = {"Resistor 1k", "Resistor 10k", "Capacitor 100nF", "LED rojo", "Arduino Nano", "Sensor DHT22"};
+        const char* types[] = {"Resistor", "Capacitor", "LED", "Microcontrolador", "Sensor"};
+        const char* locations[] = {"Cajón A", "Cajón B", "Estante 2"};
+        return Component(id, names[random() % 6], types[random() % 5], static_cast<int>(random() % 12),
+                         locations[random() % 3], static_cast<std::time_t>(1600000000 + random() % 100000000));
+    }
+
+    /**
+     * Aplica cambios al azar como lo hace MainWindow: el componente anterior es el que
+     * muestra la tabla y el nuevo solo se pasa si coincide con la búsqueda activa.
+     */
+    void applyRandomChanges(InventoryTableModel& model, std::vector<Component>& components, std::uint64_t& version,
+                            int& nextId, const std::string& keyword, std::mt19937& random, const char* step) {
+        for (int i = 0; i < 300; ++i) {
+            const int action = components.empty() ? 0 : static_cast<int>(random() % 4);
+            const std::size_t target = components.empty() ? 0 : random() % components.size();
+            Component previous;
+            bool hasPrevious = false;
+            Component current;
+            bool hasCurrent = true;
+
+            if (action == 0) {
+                current = randomComponent(random, nextId++);
+                components.push_back(current);
+            } else if (action == 1) {
+                // Solo la cantidad: la fila no se mueve
+                previous = components[target];
+                hasPrevious = true;
+                current = previous;
+                current.setQuantity(static_cast<int>(random() % 12));
+                components[target] = current;
+            } else if (action == 2) {
+                // Nombre nuevo: la fila puede cambiar de posición o dejar de coincidir
+                previous = components[target];
+                hasPrevious = true;
+                current = randomComponent(random, previous.getId());
+                components[target] = current;
+            } else {
+                previous = components[target];
+                hasPrevious = true;
+                hasCurrent = false;
+                components.erase(components.begin() + static_cast<std::ptrdiff_t>(target));
+            }
+
+            auto next = std::make_shared<const InventorySnapshot>(components, ++version);
+            // Solo se conoce la fila anterior si la tabla la mostraba; la vista la tendría seleccionada
+            const bool shown = hasPrevious && matches(previous, keyword);
+            const bool showCurrent = hasCurrent && matches(current, keyword);
+            int selectedRow = -1;
+            for (int row = 0; shown && row < model.rowCount(); ++row) {
+                if (model.componentAt(row)->getId() == previous.getId()) selectedRow = row;
+            }
+            QPersistentModelIndex selection(model.index(selectedRow, 0));
+
+            model.applyChange(next, shown ? &previous : nullptr, showCurrent ? &current : nullptr);
+            checkRows(model, expectedIds(*next, keyword), step);
+            if (shown && showCurrent) {
+                const Component* selected = selection.isValid() ? model.componentAt(selection.row()) : nullptr;
+                check(selected && selected->getId() == current.getId(), step, "la selección no sigue a la fila");
+            } else if (shown) {
+                check(!selection.isValid(), step, "selección de una fila quitada");
+            }
+        }
+    }
+}
+
+int main() {
+    std::mt19937 random(11);
+    std::vector<Component> components;
+    int nextId = 1;
+    for (; nextId <= 3000; ++nextId) components.push_back(randomComponent(random, nextId));
+    std::uint64_t version = 1;
+
+    InventoryTableModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::Fatal);
+
+    // Carga: el modelo muestra el snapshot sin copiarlo
+    auto snapshot = std::make_shared<const InventorySnapshot>(components, version);
+    model.setSnapshot(snapshot);
+    checkRows(model, expectedIds(*snapshot, ""), "carga");
+    check(model.columnCount() == InventoryTableModel::ColumnCount, "carga", "número de columnas");
+    check(model.data(model.index(0, InventoryTableModel::IdColumn)).toInt() == snapshot->at(0).getId(),
+          "carga", "ID de la primera fila");
+    check(!model.data(model.index(model.rowCount(), 0)).isValid(), "carga", "dato fuera de rango");
+
+    // Selección: la fila elegida en la vista da su componente
+    const int selectedRow = model.rowCount() / 2;
+    const Component* selected = model.componentAt(selectedRow);
+    check(selected && selected->getId() == snapshot->at(static_cast<std::size_t>(selectedRow)).getId(),
+          "selección", "componente de la fila");
+
+    applyRandomChanges(model, components, version, nextId, "", random, "cambios sobre el snapshot");
+
+    // Búsqueda por páginas, como la entrega LiveSearch: la primera sustituye, las demás se añaden
+    const std::string keyword = "resistor";
+    snapshot = std::make_shared<const InventorySnapshot>(components, ++version);
+    std::vector<Component> found;
+    for (const Component& component : *snapshot) {
+        if (matches(component, keyword)) found.push_back(component);
+    }
+    const std::size_t firstPage = std::min<std::size_t>(200, found.size());
+    model.setComponents(std::vector<Component>(found.begin(), found.begin() + static_cast<std::ptrdiff_t>(firstPage)));
+    std::vector<int> firstIds;
+    for (std::size_t row = 0; row < firstPage; ++row) firstIds.push_back(found[row].getId());
+    checkRows(model, firstIds, "primera página");
+    for (std::size_t start = firstPage; start < found.size(); start += 500) {
+        const std::size_t end = std::min(start + 500, found.size());
+        model.appendComponents(std::vector<Component>(found.begin() + static_cast<std::ptrdiff_t>(start),
+                                                      found.begin() + static_cast<std::ptrdiff_t>(end)));
+    }
+    checkRows(model, expectedIds(*snapshot, keyword), "búsqueda");
+
+    applyRandomChanges(model, components, version, nextId, keyword, random, "cambios sobre la búsqueda");
+
+    // Volver a mostrar todo
+    snapshot = std::make_shared<const InventorySnapshot>(components, ++version);
+    model.setSnapshot(snapshot);
+    checkRows(model, expectedIds(*snapshot, ""), "mostrar todos");
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d comprobaciones fallidas\n", failures);
+        return 1;
+    }
+    std::printf("modelo: carga, búsqueda, selección y %d cambios sin errores\n", 2 * 300);
+    return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file LiveSearchTest.cpp
+ * @brief Comprueba las páginas, la sustitución y la cancelación de LiveSearch.
+ *
+ * El receptor puede quedarse esperando en la primera página de una búsqueda: mientras
+ * tanto el hilo de búsqueda está parado en un punto conocido, así que las búsquedas que
+ * se pidan entonces son deterministas. Se comprueba que:
+ * - las páginas juntas dan lo mismo que InventorySnapshot::search, con first, last y
+ *   matched coherentes;
+ * - las búsquedas pedidas mientras otra corre se agrupan: solo se ejecuta la última,
+ *   como al escribir deprisa;
+ * - una búsqueda sustituida o cancelada no entrega más páginas ni la última.
+ */
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "InventorySnapshot.h"
+#include "LiveSearch.h"
+
+namespace {
+    int failures = 0;
+
+    void check(bool ok, const char* step, const char* what) {
+        if (!ok && ++failures <= 10) std::fprintf(stderr, "%s: %s\n", step, what);
+    }
+
+    struct ReceivedPage
+    {
+        LiveSearch::Generation generation;
+        std::vector<int> ids;
+        bool first;
+        bool last;
+        std::size_t matched;
+    };
+
+    /**
+     * Receptor de páginas que puede retener al hilo de búsqueda en la primera página de una generación.
+     */
+    class Recorder
+    {
+    private:
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::vector<ReceivedPage> pages;
+        LiveSearch::Generation holdGeneration = 0;
+        bool holding = false;
+
+    public:
+        void onPage(LiveSearch::ResultPage page) {
+            std::unique_lock<std::mutex> lock(mutex);
+            ReceivedPage received{page.generation, {}, page.first, page.last, page.matched};
+            for (const Component& component : page.components) received.ids.push_back(component.getId());
+            pages.push_back(std::move(received));
+            if (page.generation == holdGeneration && page.first) {
+                holding = true;
+                condition.notify_all();
+                condition.wait(lock, [this]() { return holdGeneration == 0; });
+                holding = false;
+            }
+            condition.notify_all();
+        }
+
+        void hold(LiveSearch::Generation generation) {
+            std::lock_guard<std::mutex> lock(mutex);
+            holdGeneration = generation;
+        }
+
+        bool waitHeld() {
+            std::unique_lock<std::mutex> lock(mutex);
+            return condition.wait_for(lock, std::chrono::seconds(10), [this]() { return holding; });
+        }
+
+        void release() {
+            std::lock_guard<std::mutex> lock(mutex);
+            holdGeneration = 0;
+            condition.notify_all();
+        }
+
+        bool waitLast(LiveSearch::Generation generation) {
+            std::unique_lock<std::mutex> lock(mutex);
+            return condition.wait_for(lock, std::chrono::seconds(10), [&]() {
+                for (const ReceivedPage& page : pages) {
+                    if (page.generation == generation && page.last) return true;
+                }
+                return false;
+            });
+        }
+
+        std::vector<ReceivedPage> pagesOf(LiveSearch::Generation generation) {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<ReceivedPage> result;
+            for (const ReceivedPage& page : pages) {
+                if (page.generation == generation) result.push_back(page);
+            }
+            return result;
+        }
+    };
+
+    // Las páginas de una búsqueda terminada deben sumar exactamente el resultado esperado
+    void checkComplete(const std::vector<ReceivedPage>& pages, const std::vector<Component>& expected, const char* step) {
+        std::vector<int> ids;
+        for (std::size_t i = 0; i < pages.size(); ++i) {
+            check(pages[i].first == (i == 0), step, "first solo en la primera página");
+            check(pages[i].last == (i + 1 == pages.size()), step, "last solo en la última página");
+            ids.insert(ids.end(), pages[i].ids.begin(), pages[i].ids.end());
+            check(pages[i].matched == ids.size(), step, "matched no cuenta las filas entregadas");
+        }
+        if (!pages.empty() && expected.size() > LiveSearch::FIRST_PAGE_ROWS) {
+            check(pages[0].ids.size() == LiveSearch::FIRST_PAGE_ROWS, step, "tamaño de la primera página");
+        }
+        check(ids.size() == expected.size(), step, "número de coincidencias");
+        for (std::size_t i = 0; i < ids.size() && i < expected.size(); ++i) {
+            if (ids[i] != expected[i].getId()) {
+                check(false, step, "coincidencias fuera de orden");
+                break;
+            }
+        }
+    }
+}
+
+int main() {
+    const char* names[] = {"Resistor 1k", "Capacitor 100nF", "LED rojo", "Arduino Nano", "Sensor DHT22", "Cable dupont"};
+    const char* types[] = {"Resistor", "Capacitor", "LED", "Microcontrolador", "Sensor", "Cable"};
+    const char* locations[] = {"Cajón A", "Cajón B", "Estante 2"};
+    std::vector<Component> components;
+    for (int id = 1; id <= 200000; ++id) {
+        components.emplace_back(id, names[id % 6], types[(id / 6) % 6], id % 20, locations[id % 3], 0);
+    }
+    auto snapshot = std::make_shared<const InventorySnapshot>(std::move(components), 1);
+
+    Recorder recorder;
+    LiveSearch search([&]() { return snapshot; },
+                      [&](LiveSearch::ResultPage page) { recorder.onPage(std::move(page)); });
+
+    // Búsqueda completa: el texto coincide con nombre, tipo o ubicación
+    LiveSearch::Generation full = search.search("ESTANTE");
+    check(recorder.waitLast(full), "completa", "no terminó");
+    checkComplete(recorder.pagesOf(full), snapshot->search("ESTANTE"), "completa");
+
+    // Escribir deprisa: mientras la primera búsqueda entrega su primera página llegan dos más
+    recorder.hold(search.currentGeneration() + 1);
+    LiveSearch::Generation typed1 = search.search("s");
+    check(recorder.waitHeld(), "sustitución", "la primera búsqueda no entregó su primera página");
+    LiveSearch::Generation typed2 = search.search("se");
+    LiveSearch::Generation typed3 = search.search("sen");
+    check(search.currentGeneration() == typed3, "sustitución", "currentGeneration no es la última");
+    recorder.release();
+    check(recorder.waitLast(typed3), "sustitución", "la última búsqueda no terminó");
+
+    std::vector<ReceivedPage> stale = recorder.pagesOf(typed1);
+    check(stale.size() == 1 && !stale[0].last, "sustitución", "la búsqueda sustituida siguió entregando páginas");
+    check(recorder.pagesOf(typed2).empty(), "sustitución", "se ejecutó una búsqueda que nunca fue la última");
+    checkComplete(recorder.pagesOf(typed3), snapshot->search("sen"), "sustitución");
+
+    // Cancelar a mitad: no llegan más páginas de esa búsqueda
+    recorder.hold(search.currentGeneration() + 1);
+    LiveSearch::Generation cancelled = search.search("a");
+    check(recorder.waitHeld(), "cancelación", "la búsqueda no entregó su primera página");
+    search.cancel();
+    check(search.currentGeneration() != cancelled, "cancelación", "cancel no cambió la generación");
+    recorder.release();
+    // Una búsqueda posterior garantiza que el hilo ya dejó la cancelada
+    LiveSearch::Generation after = search.search("nano");
+    check(recorder.waitLast(after), "cancelación", "la búsqueda posterior no terminó");
+    std::vector<ReceivedPage> dropped = recorder.pagesOf(cancelled);
+    check(dropped.size() == 1 && !dropped[0].last, "cancelación", "la búsqueda cancelada siguió entregando páginas");
+    checkComplete(recorder.pagesOf(after), snapshot->search("nano"), "cancelación");
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d comprobaciones fallidas\n", failures);
+        return 1;
+    }
+    std::printf("búsqueda en vivo: páginas, sustitución y cancelación correctas\n");
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file LowStockMonitorTest.cpp
+ * @brief Comprueba LowStockMonitor con escrituras propias y con las de otro proceso.
+ *
+ * Las escrituras hechas con el InventoryManager deben actualizar el conjunto al confirmarse
+ * sin que checkExternalChanges() vea cambios. Después el propio ejecutable se relanza como
+ * segundo proceso (--escribir) y modifica el mismo archivo con su propia conexión:
+ * checkExternalChanges() debe notar el cambio de PRAGMA data_version, recargar el inventario
+ * y avisar de los componentes que entraron y salieron del conjunto. Los cambios sobre IDs
+ * que no existen no deben confirmarse ni llegar al monitor.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "DatabaseManager.h"
+#include "InventoryManager.h"
+#include "LowStockMonitor.h"
+
+namespace {
+    int failures = 0;
+
+    void check(bool ok, const char* step, const char* what) {
+        if (!ok && ++failures <= 10) std::fprintf(stderr, "%s: %s\n", step, what);
+    }
+
+    bool contains(const std::vector<int>& ids, int id) {
+        return std::find(ids.begin(), ids.end(), id) != ids.end();
+    }
+
+    /**
+     * Segundo proceso: baja a stock bajo un componente, saca otro y agrega uno nuevo con stock bajo.
+     */
+    int writeFromOtherProcess(const std::string& path, int enterId, int leaveId) {
+        DatabaseManager dbManager(path);
+        if (!dbManager.connect()) return 2;
+        bool ok = true;
+        for (Component component : dbManager.getAllComponents()) {
+            if (component.getId() == enterId) {
+                component.setQuantity(2);
+                ok = dbManager.updateComponent(component) && ok;
+            } else if (component.getId() == leaveId) {
+                component.setQuantity(30);
+                ok = dbManager.updateComponent(component) && ok;
+            }
+        }
+        ok = dbManager.addComponent(Component(0, "Regulador 7805", "Otro", 0, "Cajón C", 0)) && ok;
+        return ok ? 0 : 3;
+    }
+
+    bool runOtherProcess(const std::string& path, int enterId, int leaveId) {
+        const std::string enter = std::to_string(enterId);
+        const std::string leave = std::to_string(leaveId);
+        pid_t child = fork();
+        if (child < 0) return false;
+        if (child == 0) {
+            // Proceso nuevo de verdad: sin los hilos ni la conexión del padre
+            execl("/proc/self/exe", "LowStockMonitorTest", "--escribir", path.c_str(), enter.c_str(), leave.c_str(),
+                  static_cast<char*>(nullptr));
+            _exit(127);
+        }
+        int status = 0;
+        return waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 5 && std::strcmp(argv[1], "--escribir") == 0) {
+        return writeFromOtherProcess(argv[2], std::atoi(argv[3]), std::atoi(argv[4]));
+    }
+
+    const std::string path = "stock_bajo_" + std::to_string(static_cast<long>(getpid())) + ".db";
+    {
+        DatabaseManager dbManager(path);
+        if (!dbManager.connect()) {
+            std::fprintf(stderr, "no se pudo crear %s\n", path.c_str());
+            return 1;
+        }
+        InventoryManager inventoryManager(&dbManager);
+
+        std::mutex mutex;
+        std::vector<LowStockMonitor::LowStockEvent> events;
+        LowStockMonitor monitor(&inventoryManager, [&](const LowStockMonitor::LowStockEvent& event) {
+            std::lock_guard<std::mutex> lock(mutex);
+            events.push_back(event);
+        });
+
+        // Escrituras propias: cantidades 1..10, así que las cinco primeras tienen stock bajo
+        std::vector<int> ids;
+        for (int quantity = 1; quantity <= 10; ++quantity) {
+            int id = -1;
+            inventoryManager.addComponent(Component(0, "Resistor " + std::to_string(quantity), "Resistor",
+                                                    quantity, "Cajón A", 0), &id);
+            ids.push_back(id);
+        }
+        check(monitor.count() == 5, "propias", "cuenta tras las altas");
+        Component raised;
+        inventoryManager.getComponent(ids[0], raised);
+        raised.setQuantity(20);
+        inventoryManager.updateComponent(raised);
+        check(monitor.count() == 4, "propias", "cuenta tras sacar uno");
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::size_t entered = 0;
+            for (const auto& event : events) entered += event.entered.size();
+            check(entered == 5 && !events.empty() && contains(events.back().left, ids[0]), "propias", "eventos");
+            events.clear();
+        }
+        check(!monitor.checkExternalChanges(), "propias", "las escrituras propias cuentan como externas");
+
+        // Cambios sobre un ID que no existe: no se aplican y el conjunto sigue igual
+        Component missing(ids.back() + 1000, "Fantasma", "Otro", 1, "Cajón A", 0);
+        check(!inventoryManager.updateComponent(missing), "inexistente", "la actualización de un ID inexistente se confirmó");
+        check(!inventoryManager.deleteComponent(missing.getId()), "inexistente", "la eliminación de un ID inexistente se confirmó");
+        check(monitor.count() == 4, "inexistente", "el monitor contó un componente que no existe");
+        check(inventoryManager.snapshot()->size() == 10, "inexistente", "el snapshot cambió");
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            check(events.empty(), "inexistente", "evento por un ID que no existe");
+        }
+
+        // Otro proceso: ids[7] (cantidad 8) entra, ids[1] (cantidad 2) sale y se agrega uno con 0
+        check(runOtherProcess(path, ids[7], ids[1]), "externas", "el segundo proceso falló");
+        check(monitor.checkExternalChanges(), "externas", "no se detectó la escritura del otro proceso");
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            check(events.size() == 1, "externas", "se esperaba un evento");
+            if (!events.empty()) {
+                const LowStockMonitor::LowStockEvent& event = events.back();
+                std::vector<int> entered;
+                for (const Component& component : event.entered) entered.push_back(component.getId());
+                check(entered.size() == 2 && contains(entered, ids[7]), "externas", "componentes que entraron");
+                check(event.left.size() == 1 && contains(event.left, ids[1]), "externas", "componentes que salieron");
+                check(event.count == 5, "externas", "cuenta del evento");
+            }
+        }
+        check(monitor.count() == 5, "externas", "cuenta tras recargar");
+        auto snapshot = inventoryManager.snapshot();
+        const Component* changed = snapshot->findById(ids[7]);
+        check(snapshot->size() == 11 && changed && changed->getQuantity() == 2, "externas", "el inventario no se recargó");
+        check(!monitor.checkExternalChanges(), "externas", "el mismo cambio se detectó dos veces");
+    }
+
+    for (const char* suffix : {"", ".image", "-journal"}) std::remove((path + suffix).c_str());
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d comprobaciones fallidas\n", failures);
+        return 1;
+    }
+    std::printf("stock bajo: escrituras propias y de otro proceso detectadas\n");
+    return 0;
+}
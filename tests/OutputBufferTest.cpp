@@ -0,0 +1,162 @@
+/**
+ * @file OutputBufferTest.cpp
+ * @brief Compara el escapado HTML/CSV de OutputBuffer con el original de ReportGenerator.
+ *
+ * Cada implementación de la búsqueda (escalar, SSE2 y AVX2, las que haya en esta CPU) se
+ * prueba con textos aleatorios de todos los bytes y con un carácter especial en cada
+ * posición de textos cortos, para cubrir los restos de menos de 16 y 32 bytes.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "OutputBuffer.h"
+
+namespace {
+    // Escapado de ReportGenerator antes de OutputBuffer (buscar y reemplazar)
+    std::string escapeCSV(const std::string& input) {
+        std::string output = input;
+        size_t pos = 0;
+        while ((pos = output.find("\"", pos)) != std::string::npos) {
+            output.replace(pos, 1, "\"\"");
+            pos += 2;
+        }
+        return output;
+    }
+
+    std::string escapeHTML(const std::string& input) {
+        std::string output = input;
+        size_t pos = 0;
+        while ((pos = output.find("&", pos)) != std::string::npos) {
+            output.replace(pos, 1, "&amp;");
+            pos += 5;
+        }
+        pos = 0;
+        while ((pos = output.find("<", pos)) != std::string::npos) {
+            output.replace(pos, 1, "&lt;");
+            pos += 4;
+        }
+        pos = 0;
+        while ((pos = output.find(">", pos)) != std::string::npos) {
+            output.replace(pos, 1, "&gt;");
+            pos += 4;
+        }
+        pos = 0;
+        while ((pos = output.find("\"", pos)) != std::string::npos) {
+            output.replace(pos, 1, "&quot;");
+            pos += 6;
+        }
+        return output;
+    }
+
+    const char* kernelName(OutputBuffer::ScanKernel kernel) {
+        switch (kernel) {
+            case OutputBuffer::ScanKernel::Scalar: return "escalar";
+            case OutputBuffer::ScanKernel::Sse2: return "SSE2";
+            case OutputBuffer::ScanKernel::Avx2: return "AVX2";
+            default: return "auto";
+        }
+    }
+
+    int failures = 0;
+
+    void expectEqual(std::string_view got, const std::string& expected, const char* what,
+                     OutputBuffer::ScanKernel kernel, std::string_view input) {
+        if (got == expected) return;
+        if (++failures <= 10) {
+            std::fprintf(stderr, "%s (%s) difiere para una entrada de %zu bytes\n",
+                         what, kernelName(kernel), input.size());
+        }
+    }
+
+    // Escapa text, que empieza en una posición arbitraria de un búfer (sin alinear)
+    void check(OutputBuffer::ScanKernel kernel, std::string_view text, std::string& reference) {
+        const std::string input(text);
+        OutputBuffer out(64);
+        out.writeEscapedHTML(text);
+        expectEqual(out.view(), escapeHTML(input), "HTML", kernel, text);
+        out.clear();
+        out.writeEscapedCSV(text);
+        expectEqual(out.view(), escapeCSV(input), "CSV", kernel, text);
+
+        // JSON no tiene versión antigua: todas las implementaciones deben dar lo mismo que la escalar
+        out.clear();
+        out.writeEscapedJSON(text);
+        if (kernel == OutputBuffer::ScanKernel::Scalar) {
+            reference.assign(out.view());
+        } else {
+            expectEqual(out.view(), reference, "JSON", kernel, text);
+        }
+    }
+
+    std::vector<std::string> randomInputs() {
+        std::mt19937 random(20240611);
+        std::uniform_int_distribution<int> anyByte(0, 255);
+        std::uniform_int_distribution<int> percent(0, 99);
+        const char special[] = {'&', '<', '>', '"', '\\', '\n', '\x01'};
+
+        std::vector<std::string> inputs;
+        for (int i = 0; i < 20000; ++i) {
+            // La mitad, más cortos que un bloque AVX2; el resto hasta varios bloques
+            const std::size_t length = i % 2 == 0 ? random() % 40 : random() % 300;
+            // Densidad de caracteres especiales variable: ninguno, pocos o muchos
+            const int density = i % 3 == 0 ? 0 : (i % 3 == 1 ? 2 : 30);
+            std::string text(length, ' ');
+            for (char& c : text) {
+                c = percent(random) < density ? special[random() % sizeof(special)]
+                                              : static_cast<char>(anyByte(random));
+                // Sin densidad, ningún carácter especial de HTML o CSV
+                if (density == 0 && (c == '&' || c == '<' || c == '>' || c == '"')) c = 'x';
+            }
+            inputs.push_back(std::move(text));
+        }
+        return inputs;
+    }
+}
+
+int main() {
+    const OutputBuffer::ScanKernel kernels[] = {OutputBuffer::ScanKernel::Scalar, OutputBuffer::ScanKernel::Sse2,
+                                                OutputBuffer::ScanKernel::Avx2};
+    const std::vector<std::string> inputs = randomInputs();
+    std::vector<std::string> jsonReference(inputs.size());
+
+    // Un carácter especial en cada posición de textos de hasta 70 bytes, con 0 a 3 bytes de desfase
+    std::vector<std::string> placed;
+    for (std::size_t length = 1; length <= 70; ++length) {
+        for (std::size_t at = 0; at < length; ++at) {
+            for (char c : {'&', '"'}) {
+                std::string text(length + 3, 'a');
+                text[3 + at] = c;
+                placed.push_back(std::move(text));
+            }
+        }
+    }
+    std::vector<std::string> placedReference(placed.size() * 4);
+
+    for (OutputBuffer::ScanKernel kernel : kernels) {
+        if (!OutputBuffer::setScanKernel(kernel)) {
+            std::printf("%s: no disponible, se omite\n", kernelName(kernel));
+            continue;
+        }
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            const std::size_t offset = i % 7;
+            const std::string_view text(inputs[i]);
+            check(kernel, text.substr(std::min(offset, text.size())), jsonReference[i]);
+        }
+        for (std::size_t i = 0; i < placed.size(); ++i) {
+            for (std::size_t offset = 0; offset < 4; ++offset) {
+                check(kernel, std::string_view(placed[i]).substr(offset), placedReference[i * 4 + offset]);
+            }
+        }
+        std::printf("%s: %zu textos comprobados\n", kernelName(kernel), inputs.size() + placed.size() * 4);
+    }
+    OutputBuffer::setScanKernel(OutputBuffer::ScanKernel::Auto);
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d diferencias\n", failures);
+        return 1;
+    }
+    return 0;
+}
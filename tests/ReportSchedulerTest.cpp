@@ -0,0 +1,251 @@
+/**
+ * @file ReportSchedulerTest.cpp
+ * @brief Comprueba los trabajos de ReportScheduler con varios destinos y con reportes de cambios.
+ *
+ * - Un trabajo con todos los formatos recorre el snapshot una sola vez (el progreso
+ *   anuncia tantas filas como componentes) y cada archivo coincide con el que escribe la
+ *   función individual de su formato a partir de una copia del inventario.
+ * - Un trabajo solo de LowStock, con dos umbrales, recorre solo las filas que pasan el
+ *   umbral mayor y cada archivo tiene las filas de su propio umbral.
+ * - Un trabajo con filtro escribe, totales incluidos, lo mismo que las funciones
+ *   individuales con solo los componentes que cumplen el filtro.
+ * - Un reporte de cambios encolado en el planificador, que lee la base con su propia
+ *   conexión, coincide con el que se genera directamente.
+ * La fecha de generación se descarta al comparar: los archivos se escriben en momentos distintos.
+ */
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "ComponentTable.h"
+#include "DatabaseManager.h"
+#include "InventoryManager.h"
+#include "ReportScheduler.h"
+
+namespace {
+    int failures = 0;
+
+    void check(bool ok, const char* step, const char* what) {
+        if (!ok && ++failures <= 10) std::fprintf(stderr, "%s: %s\n", step, what);
+    }
+
+    std::string readFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // Contenido de un reporte con cada fecha y hora ("2024-01-31 12:00:00") en blanco
+    std::string withoutTimes(const std::string& path) {
+        std::string text = readFile(path);
+        auto digits = [&text](std::size_t at, std::size_t count) {
+            for (std::size_t i = at; i < at + count; ++i) {
+                if (text[i] < '0' || text[i] > '9') return false;
+            }
+            return true;
+        };
+        for (std::size_t i = 0; i + 19 <= text.size(); ++i) {
+            if (digits(i, 4) && text[i + 4] == '-' && digits(i + 5, 2) && text[i + 7] == '-' && digits(i + 8, 2) &&
+                text[i + 10] == ' ' && digits(i + 11, 2) && text[i + 13] == ':' && digits(i + 14, 2) &&
+                text[i + 16] == ':' && digits(i + 17, 2)) {
+                text.replace(i, 19, 19, '#');
+            }
+        }
+        return text;
+    }
+
+    /**
+     * Recoge los eventos del planificador y permite esperar el final de un trabajo.
+     */
+    class Recorder
+    {
+    private:
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::map<ReportScheduler::JobId, ReportScheduler::JobState> finalStates;
+        std::map<ReportScheduler::JobId, std::size_t> rowsTotals;
+
+    public:
+        void onEvent(const ReportScheduler::JobEvent& event) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (event.state == ReportScheduler::JobState::Running) {
+                rowsTotals[event.id] = event.rowsTotal;
+            } else if (event.state != ReportScheduler::JobState::Queued) {
+                finalStates[event.id] = event.state;
+                condition.notify_all();
+            }
+        }
+
+        // Estado final del trabajo, o Queued si no termina a tiempo
+        ReportScheduler::JobState wait(ReportScheduler::JobId id) {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait_for(lock, std::chrono::seconds(30), [&]() { return finalStates.count(id) != 0; });
+            return finalStates.count(id) != 0 ? finalStates[id] : ReportScheduler::JobState::Queued;
+        }
+
+        std::size_t rowsTotal(ReportScheduler::JobId id) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return rowsTotals[id];
+        }
+    };
+}
+
+int main() {
+    const std::string base = "planificador_" + std::to_string(static_cast<long>(getpid()));
+    const std::string path = base + ".db";
+    std::vector<std::string> created;
+    auto file = [&](const std::string& suffix) {
+        created.push_back(base + suffix);
+        return created.back();
+    };
+
+    DatabaseManager dbManager(path);
+    if (!dbManager.connect()) {
+        std::fprintf(stderr, "no se pudo crear %s\n", path.c_str());
+        return 1;
+    }
+
+    {
+        InventoryManager inventoryManager(&dbManager);
+        const char* names[] = {"Resistor", "Capacitor <cerámico>", "LED \"rojo\"", "Arduino Nano", "Sensor DHT22"};
+        const char* locations[] = {"Cajón A", "Cajón B", "Estante 2", ""};
+        std::mt19937 random(45);
+        std::vector<std::future<int>> added;
+        for (int i = 0; i < 20000; ++i) {
+            std::string name = std::string(names[random() % 5]) + " " + std::to_string(random() % 1000);
+            added.push_back(inventoryManager.addComponentAsync(
+                Component(0, name, "Otro", static_cast<int>(random() % 30), locations[random() % 4], 0)));
+        }
+        inventoryManager.flushPendingWrites();
+        std::vector<int> ids;
+        for (auto& future : added) ids.push_back(future.get());
+        check(ids.front() > 0 && ids.back() > 0, "altas", "no se confirmaron");
+        // El periodo empieza después de las altas: así los cambios son modificaciones y una eliminación
+        const std::time_t since = std::time(nullptr) + 1;
+        while (std::time(nullptr) < since) std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        for (int i = 0; i < 50; ++i) {
+            Component changed;
+            inventoryManager.getComponent(ids[static_cast<std::size_t>(i) * 7], changed);
+            changed.setQuantity(changed.getQuantity() + 100);
+            inventoryManager.updateComponent(changed);
+        }
+        inventoryManager.deleteComponent(ids[3]);
+
+        Recorder recorder;
+        ReportScheduler scheduler([&]() { return inventoryManager.snapshot(); },
+                                  [&](const ReportScheduler::JobEvent& event) { recorder.onEvent(event); });
+        auto snapshot = inventoryManager.snapshot();
+        const std::vector<Component> components = snapshot->toVector();
+
+        // Todos los formatos en un solo trabajo
+        ReportScheduler::ReportJob bundle;
+        bundle.description = "paquete";
+        bundle.sinks = {
+            {ReportGenerator::ReportFormat::HTML, file(".html")},
+            {ReportGenerator::ReportFormat::CSV, file(".csv")},
+            {ReportGenerator::ReportFormat::Text, file(".txt")},
+            {ReportGenerator::ReportFormat::LowStock, file("_bajo.html"), 7},
+            {ReportGenerator::ReportFormat::JSONLines, file(".jsonl")},
+            {ReportGenerator::ReportFormat::Columnar, file(".invsnap")},
+            {ReportGenerator::ReportFormat::PDF, file(".pdf")}
+        };
+        ReportScheduler::JobId id = scheduler.submit(bundle);
+        check(recorder.wait(id) == ReportScheduler::JobState::Finished, "paquete", "el trabajo no terminó bien");
+        check(recorder.rowsTotal(id) == components.size(), "paquete", "el snapshot se recorrió más de una vez");
+
+        ComponentTable table;
+        for (const Component& component : components) table.append(component);
+        ReportGenerator::generateHTMLReport(components, file("_ref.html"));
+        ReportGenerator::generateCSVReport(components, file("_ref.csv"));
+        ReportGenerator::generateTextReport(components, file("_ref.txt"));
+        ReportGenerator::generateLowStockReport(components, file("_ref_bajo.html"), 7);
+        ReportGenerator::generateJSONLinesReport(components, file("_ref.jsonl"));
+        ReportGenerator::generateColumnarExport(table, file("_ref.invsnap"));
+        for (const char* suffix : {".html", ".csv", ".txt", "_bajo.html", ".jsonl", ".invsnap"}) {
+            const std::string written = withoutTimes(base + suffix);
+            check(!written.empty() && written == withoutTimes(base + "_ref" + suffix), suffix,
+                  "distinto del reporte individual");
+        }
+        const std::string pdf = readFile(base + ".pdf");
+        check(pdf.compare(0, 5, "%PDF-") == 0 && pdf.find("%%EOF") != std::string::npos, ".pdf", "PDF incompleto");
+
+        // Solo LowStock: se recorren las filas del umbral mayor y cada destino filtra el suyo
+        ReportScheduler::ReportJob lowStock;
+        lowStock.description = "stock bajo";
+        lowStock.sinks = {
+            {ReportGenerator::ReportFormat::LowStock, file("_bajo3.html"), 3},
+            {ReportGenerator::ReportFormat::LowStock, file("_bajo9.html"), 9}
+        };
+        id = scheduler.submit(lowStock);
+        check(recorder.wait(id) == ReportScheduler::JobState::Finished, "stock bajo", "el trabajo no terminó bien");
+        check(recorder.rowsTotal(id) == snapshot->countAtOrBelow(9), "stock bajo", "no se recorrió solo el umbral mayor");
+        ReportGenerator::generateLowStockReport(components, file("_ref_bajo3.html"), 3);
+        ReportGenerator::generateLowStockReport(components, file("_ref_bajo9.html"), 9);
+        for (const char* suffix : {"_bajo3.html", "_bajo9.html"}) {
+            check(withoutTimes(base + suffix) == withoutTimes(base + "_ref" + suffix), suffix,
+                  "distinto del reporte individual");
+        }
+
+        // Con filtro: solo los componentes de una búsqueda
+        ReportScheduler::ReportJob filtered;
+        filtered.description = "búsqueda";
+        filtered.sinks = {
+            {ReportGenerator::ReportFormat::HTML, file("_busqueda.html")},
+            {ReportGenerator::ReportFormat::LowStock, file("_busqueda_bajo.html"), 7}
+        };
+        filtered.filter = ComponentQuery::matchesKeyword("led");
+        id = scheduler.submit(filtered);
+        check(recorder.wait(id) == ReportScheduler::JobState::Finished, "búsqueda", "el trabajo no terminó bien");
+        const std::vector<Component> matched = ComponentQuery().where(filtered.filter).apply(components);
+        check(!matched.empty() && matched.size() < components.size(), "búsqueda", "el filtro no separa componentes");
+        ReportGenerator::generateHTMLReport(matched, file("_ref_busqueda.html"));
+        ReportGenerator::generateLowStockReport(matched, file("_ref_busqueda_bajo.html"), 7);
+        for (const char* suffix : {"_busqueda.html", "_busqueda_bajo.html"}) {
+            check(withoutTimes(base + suffix) == withoutTimes(base + "_ref" + suffix), suffix,
+                  "distinto del reporte individual filtrado");
+        }
+
+        // Reporte de cambios desde el planificador
+        inventoryManager.flushPendingWrites();
+        const std::time_t until = std::time(nullptr) + 1;
+        ReportScheduler::ReportJob changes;
+        changes.description = "cambios";
+        changes.changeSinks = {{ReportGenerator::ReportFormat::HTML, file("_cambios.html")},
+                               {ReportGenerator::ReportFormat::CSV, file("_cambios.csv")}};
+        changes.changeDatabase = path;
+        changes.changeSince = since;
+        changes.changeUntil = until;
+        id = scheduler.submit(changes);
+        check(recorder.wait(id) == ReportScheduler::JobState::Finished, "cambios", "el trabajo no terminó bien");
+        ReportGenerator::generateChangeReport(dbManager, since, until, ReportGenerator::ReportFormat::HTML,
+                                              file("_ref_cambios.html"));
+        ReportGenerator::generateChangeReport(dbManager, since, until, ReportGenerator::ReportFormat::CSV,
+                                              file("_ref_cambios.csv"));
+        for (const char* suffix : {"_cambios.html", "_cambios.csv"}) {
+            const std::string written = withoutTimes(base + suffix);
+            check(!written.empty() && written == withoutTimes(base + "_ref" + suffix), suffix,
+                  "distinto del reporte de cambios directo");
+        }
+        check(readFile(base + "_cambios.csv").find("Eliminado") != std::string::npos, "cambios", "falta la eliminación");
+    }
+
+    dbManager.disconnect();
+    for (const std::string& name : created) std::remove(name.c_str());
+    for (const char* suffix : {"", ".image", "-journal"}) std::remove((path + suffix).c_str());
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d comprobaciones fallidas\n", failures);
+        return 1;
+    }
+    std::printf("planificador: un recorrido por trabajo y reportes de cambios correctos\n");
+    return 0;
+}
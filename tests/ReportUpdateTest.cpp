@@ -0,0 +1,211 @@
+/**
+ * @file ReportUpdateTest.cpp
+ * @brief Comprueba que ReportGenerator::updateReport deja cada reporte igual que uno completo.
+ *
+ * Para HTML, CSV, texto, stock bajo y JSON Lines se parte de un reporte con manifiesto y se
+ * aplican rondas de escrituras a un snapshot: altas, cambios de cantidad que no cambian la
+ * longitud de la fila (el reporte se parchea en su sitio), cambios que sí la cambian,
+ * cambios de nombre (la fila se mueve) y eliminaciones. Tras cada ronda el reporte
+ * actualizado debe coincidir byte a byte con el que genera la función individual del
+ * formato a partir de una copia del snapshot; solo se descarta la fecha de generación de
+ * las cabeceras.
+ *
+ * Al final un trabajo de ReportScheduler que escribe sobre un reporte con manifiesto debe
+ * actualizarlo con updateReport: el manifiesto queda al día con el archivo.
+ */
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "InventorySnapshot.h"
+#include "ReportGenerator.h"
+#include "ReportManifest.h"
+#include "ReportScheduler.h"
+
+namespace {
+    int failures = 0;
+
+    void check(bool ok, const char* step, const char* what) {
+        if (!ok && ++failures <= 10) std::fprintf(stderr, "%s: %s\n", step, what);
+    }
+
+    std::string readFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // Contenido de un reporte con cada fecha y hora ("2024-01-31 12:00:00") en blanco
+    std::string withoutTimes(const std::string& path) {
+        std::string text = readFile(path);
+        auto digits = [&text](std::size_t at, std::size_t count) {
+            for (std::size_t i = at; i < at + count; ++i) {
+                if (text[i] < '0' || text[i] > '9') return false;
+            }
+            return true;
+        };
+        for (std::size_t i = 0; i + 19 <= text.size(); ++i) {
+            if (digits(i, 4) && text[i + 4] == '-' && digits(i + 5, 2) && text[i + 7] == '-' && digits(i + 8, 2) &&
+                text[i + 10] == ' ' && digits(i + 11, 2) && text[i + 13] == ':' && digits(i + 14, 2) &&
+                text[i + 16] == ':' && digits(i + 17, 2)) {
+                text.replace(i, 19, 19, '#');
+            }
+        }
+        return text;
+    }
+
+    // Reporte completo del formato de sink con la función individual
+    bool renderFull(const ReportGenerator::ReportSink& sink, const std::vector<Component>& components,
+                    const std::string& filename) {
+        switch (sink.format) {
+            case ReportGenerator::ReportFormat::HTML: return ReportGenerator::generateHTMLReport(components, filename);
+            case ReportGenerator::ReportFormat::CSV: return ReportGenerator::generateCSVReport(components, filename);
+            case ReportGenerator::ReportFormat::Text: return ReportGenerator::generateTextReport(components, filename);
+            case ReportGenerator::ReportFormat::LowStock:
+                return ReportGenerator::generateLowStockReport(components, filename, sink.threshold);
+            case ReportGenerator::ReportFormat::JSONLines:
+                return ReportGenerator::generateJSONLinesReport(components, filename);
+            default: return false;
+        }
+    }
+
+    Component randomComponent(std::mt19937& random, int id) {
+        const char* names[] = {"Resistor", "Capacitor <cerámico>", "LED \"rojo\"", "Arduino Nano", "Sensor DHT22"};
+        const char* locations[] = {"Cajón A", "Cajón B", "Estante 2", ""};
+        return Component(id, std::string(names[random() % 5]) + " " + std::to_string(random() % 300), "Otro",
+                         static_cast<int>(random() % 12), locations[random() % 4],
+                         random() % 3 == 0 ? 0 : static_cast<std::time_t>(1600000000 + random() % 100000000));
+    }
+
+    // Lote de escrituras al azar sobre snapshot; kind elige qué tipo de cambios lleva
+    std::vector<WriteCoalescer::CommittedWrite> randomWrites(std::mt19937& random, const InventorySnapshot& snapshot,
+                                                             std::vector<int>& ids, int& nextId, int kind) {
+        std::vector<WriteCoalescer::CommittedWrite> writes;
+        const std::size_t count = 1 + random() % 12;
+        for (std::size_t i = 0; i < count && !ids.empty(); ++i) {
+            const std::size_t target = random() % ids.size();
+            const Component* current = snapshot.findById(ids[target]);
+            const int action = kind == 0 ? 0 : static_cast<int>(random() % 4);
+            if (action == 0 && current) {
+                // Cantidad de una cifra a otra de una cifra: la fila ocupa lo mismo
+                Component updated = *current;
+                updated.setQuantity(static_cast<int>(random() % 10));
+                writes.push_back({WriteCoalescer::WriteKind::Update, updated, ids[target]});
+            } else if (action == 1) {
+                Component added = randomComponent(random, nextId);
+                ids.push_back(nextId);
+                writes.push_back({WriteCoalescer::WriteKind::Add, added, nextId++});
+            } else if (action == 2) {
+                // Todos los campos: cambia la longitud de la fila y, con el nombre, su posición
+                writes.push_back({WriteCoalescer::WriteKind::Update, randomComponent(random, ids[target]), ids[target]});
+            } else {
+                writes.push_back({WriteCoalescer::WriteKind::Delete, Component(), ids[target]});
+                ids.erase(ids.begin() + static_cast<std::ptrdiff_t>(target));
+            }
+        }
+        return writes;
+    }
+}
+
+int main() {
+    const std::string base = "actualizado_" + std::to_string(static_cast<long>(getpid()));
+    const std::vector<ReportGenerator::ReportSink> sinks = {
+        {ReportGenerator::ReportFormat::HTML, base + ".html"},
+        {ReportGenerator::ReportFormat::CSV, base + ".csv"},
+        {ReportGenerator::ReportFormat::Text, base + ".txt"},
+        {ReportGenerator::ReportFormat::LowStock, base + "_bajo.html", 4},
+        {ReportGenerator::ReportFormat::JSONLines, base + ".jsonl"}
+    };
+    const std::string reference = base + "_completo";
+
+    std::mt19937 random(39);
+    std::vector<Component> initial;
+    std::vector<int> ids;
+    int nextId = 1;
+    for (; nextId <= 3000; ++nextId) {
+        initial.push_back(randomComponent(random, nextId));
+        ids.push_back(nextId);
+    }
+    auto snapshot = std::make_shared<const InventorySnapshot>(initial, 1);
+
+    for (std::uint64_t round = 0; round <= 40; ++round) {
+        if (round > 0) {
+            // Una de cada tres rondas solo cambia cantidades sin cambiar la longitud de las filas
+            const int kind = round % 3 == 0 ? 0 : 1;
+            snapshot = snapshot->withWrites(randomWrites(random, *snapshot, ids, nextId, kind), round + 1);
+        }
+        const std::vector<Component> components = snapshot->toVector();
+        const std::string step = "ronda " + std::to_string(round);
+        for (const ReportGenerator::ReportSink& sink : sinks) {
+            check(ReportGenerator::updateReport(*snapshot, sink, -1), step.c_str(), "updateReport falló");
+            check(renderFull(sink, components, reference), step.c_str(), "no se pudo generar el reporte completo");
+            const bool exact = sink.format == ReportGenerator::ReportFormat::CSV ||
+                               sink.format == ReportGenerator::ReportFormat::JSONLines;
+            const bool same = exact ? readFile(sink.filename) == readFile(reference)
+                                    : withoutTimes(sink.filename) == withoutTimes(reference);
+            if (!same) {
+                check(false, step.c_str(), ("distinto del reporte completo: " + sink.filename).c_str());
+            }
+            ReportManifest manifest;
+            check(manifest.load(ReportManifest::pathFor(sink.filename)) &&
+                  manifest.reportSize == readFile(sink.filename).size(), step.c_str(), "manifiesto desfasado");
+        }
+    }
+
+    // Un trabajo del planificador sobre reportes con manifiesto los actualiza con updateReport
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool finished = false;
+        ReportScheduler::JobState state = ReportScheduler::JobState::Queued;
+        snapshot = snapshot->withWrites(randomWrites(random, *snapshot, ids, nextId, 1), 100);
+        ReportScheduler scheduler([&]() { return snapshot; }, [&](const ReportScheduler::JobEvent& event) {
+            if (event.state == ReportScheduler::JobState::Queued || event.state == ReportScheduler::JobState::Running) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            state = event.state;
+            finished = true;
+            condition.notify_all();
+        });
+        ReportScheduler::ReportJob job;
+        job.description = "actualización";
+        job.sinks = sinks;
+        scheduler.submit(job);
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait_for(lock, std::chrono::seconds(30), [&]() { return finished; });
+        check(state == ReportScheduler::JobState::Finished, "planificador", "el trabajo no terminó bien");
+
+        const std::vector<Component> components = snapshot->toVector();
+        for (const ReportGenerator::ReportSink& sink : sinks) {
+            ReportManifest manifest;
+            check(manifest.load(ReportManifest::pathFor(sink.filename)) &&
+                  manifest.reportSize == readFile(sink.filename).size() &&
+                  manifest.rows.size() == (sink.format == ReportGenerator::ReportFormat::LowStock
+                                               ? snapshot->countAtOrBelow(sink.threshold) : snapshot->size()),
+                  "planificador", "el reporte no se actualizó con su manifiesto");
+            renderFull(sink, components, reference);
+            check(withoutTimes(sink.filename) == withoutTimes(reference), "planificador", "distinto del reporte completo");
+        }
+    }
+
+    for (const ReportGenerator::ReportSink& sink : sinks) {
+        std::remove(sink.filename.c_str());
+        std::remove(ReportManifest::pathFor(sink.filename).c_str());
+    }
+    std::remove(reference.c_str());
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d comprobaciones fallidas\n", failures);
+        return 1;
+    }
+    std::printf("reportes incrementales: iguales al reporte completo tras altas, cambios y eliminaciones\n");
+    return 0;
+}
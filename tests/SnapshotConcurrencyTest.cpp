@@ -0,0 +1,188 @@
+/**
+ * @file SnapshotConcurrencyTest.cpp
+ * @brief Somete a InventoryManager a varios lectores mientras un escritor cambia el inventario.
+ *
+ * Un hilo escribe (altas, cambios, eliminaciones y alguna recarga completa) y varios
+ * lectores recorren a la vez los snapshots publicados. Cada componente lleva su cantidad
+ * escrita también en el nombre, de modo que un componente a medio escribir se nota. En
+ * cada snapshot que ve, un lector comprueba:
+ * - el orden por (nombre, ID), findById de cada componente y que ningún componente esté a medias;
+ * - countAtOrBelow, filterAtOrBelow y sumQuantities, cuyas tablas por bloque construyen
+ *   a la vez varios lectores, contra un recorrido de los componentes;
+ * - los resúmenes de forEachWithHash, también construidos a la vez, contra contentHash;
+ * - que la versión nunca retrocede y que getComponent y countLowStock, que pasan por la
+ *   caché de cada hilo, coinciden con el snapshot publicado mientras no se publique otro.
+ * Al final el snapshot debe coincidir con la base.
+ */
+#include <atomic>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "DatabaseManager.h"
+#include "InventoryManager.h"
+
+namespace {
+    std::atomic<int> failures{0};
+
+    void check(bool ok, const char* step, const char* what) {
+        if (!ok && ++failures <= 10) std::fprintf(stderr, "%s: %s\n", step, what);
+    }
+
+    // La cantidad va también en el nombre: "Componente 17 q 9"
+    Component versioned(int id, int serial, int quantity) {
+        return Component(id, "Componente " + std::to_string(serial) + " q " + std::to_string(quantity), "Otro",
+                         quantity, "Cajón A", 0);
+    }
+
+    bool consistent(const Component& component) {
+        const std::string_view name = component.getName();
+        const std::size_t mark = name.rfind(" q ");
+        return mark != std::string_view::npos && name.substr(mark + 3) == std::to_string(component.getQuantity());
+    }
+
+    /**
+     * Comprueba un snapshot entero; devuelve false en cuanto algo no cuadra.
+     */
+    bool checkSnapshot(const InventorySnapshot& snapshot, int threshold) {
+        const Component* previous = nullptr;
+        std::vector<std::uint32_t> rows;
+        long long sum = 0;
+        std::size_t row = 0;
+        for (const Component& component : snapshot) {
+            if (previous && !InventorySnapshot::orderBefore(*previous, component)) return false;
+            if (!consistent(component) || snapshot.findById(component.getId()) != &component) return false;
+            if (component.getQuantity() <= threshold) rows.push_back(static_cast<std::uint32_t>(row));
+            sum += component.getQuantity();
+            previous = &component;
+            ++row;
+        }
+        if (row != snapshot.size() || snapshot.countAtOrBelow(threshold) != rows.size() ||
+            snapshot.filterAtOrBelow(threshold) != rows || snapshot.sumQuantities() != sum) {
+            return false;
+        }
+        bool hashes = true;
+        snapshot.forEachWithHash([&hashes](const Component& component, std::uint64_t hash) {
+            hashes = hashes && hash == component.contentHash();
+        });
+        return hashes;
+    }
+}
+
+int main() {
+    const std::string path = "concurrencia_" + std::to_string(static_cast<long>(getpid())) + ".db";
+    DatabaseManager dbManager(path);
+    if (!dbManager.connect()) {
+        std::fprintf(stderr, "no se pudo crear %s\n", path.c_str());
+        return 1;
+    }
+
+    {
+        InventoryManager inventoryManager(&dbManager);
+        std::mt19937 random(27);
+        std::vector<std::future<int>> added;
+        for (int serial = 0; serial < 4000; ++serial) {
+            added.push_back(inventoryManager.addComponentAsync(versioned(0, serial, static_cast<int>(random() % 20))));
+        }
+        inventoryManager.flushPendingWrites();
+        std::vector<int> ids;
+        for (auto& future : added) ids.push_back(future.get());
+        check(ids.front() > 0 && ids.back() > 0, "altas", "no se confirmaron");
+
+        std::atomic<bool> writing{true};
+        std::atomic<std::size_t> snapshotsChecked{0};
+        std::vector<std::thread> readers;
+        for (int reader = 0; reader < 4; ++reader) {
+            readers.emplace_back([&, reader]() {
+                std::mt19937 readerRandom(static_cast<unsigned>(reader));
+                std::uint64_t lastVersion = 0;
+                const InventorySnapshot* lastChecked = nullptr;
+                do {
+                    std::shared_ptr<const InventorySnapshot> snapshot = inventoryManager.snapshot();
+                    check(snapshot->getVersion() >= lastVersion, "lector", "la versión retrocedió");
+                    lastVersion = snapshot->getVersion();
+                    if (snapshot.get() != lastChecked) {
+                        check(checkSnapshot(*snapshot, static_cast<int>(readerRandom() % 20)), "lector",
+                              "snapshot inconsistente");
+                        lastChecked = snapshot.get();
+                        ++snapshotsChecked;
+                    }
+                    // Lecturas sueltas por la caché de cada hilo. Si no se publicó nada entre
+                    // snapshot() y la siguiente, deben coincidir con ese snapshot
+                    for (int i = 0; i < 200; ++i) {
+                        const int id = ids[readerRandom() % ids.size()];
+                        const int threshold = static_cast<int>(readerRandom() % 20);
+                        Component found;
+                        const bool exists = inventoryManager.getComponent(id, found);
+                        const std::size_t lowStock = inventoryManager.countLowStock(threshold);
+                        check(!exists || consistent(found), "lector", "componente a medias en getComponent");
+                        if (inventoryManager.snapshot() != snapshot) break;
+                        const Component* expected = snapshot->findById(id);
+                        check(exists == (expected != nullptr) && (!exists || found.getName() == expected->getName()),
+                              "lector", "getComponent no coincide con el snapshot publicado");
+                        check(lowStock == snapshot->countAtOrBelow(threshold), "lector",
+                              "countLowStock no coincide con el snapshot publicado");
+                    }
+                } while (writing.load());
+            });
+        }
+
+        // Un solo escritor: lotes de cambios, altas y eliminaciones, y de vez en cuando una recarga
+        int serial = 4000;
+        for (int batch = 0; batch < 60; ++batch) {
+            std::vector<std::future<bool>> changed;
+            for (int i = 0; i < 40; ++i) {
+                const std::size_t target = random() % ids.size();
+                switch (random() % 4) {
+                    case 0:
+                        added.push_back(inventoryManager.addComponentAsync(
+                            versioned(0, serial++, static_cast<int>(random() % 20))));
+                        break;
+                    case 1:
+                        changed.push_back(inventoryManager.deleteComponentAsync(ids[target]));
+                        break;
+                    default:
+                        // Cambia también el nombre: el componente se mueve en el orden
+                        changed.push_back(inventoryManager.updateComponentAsync(
+                            versioned(ids[target], serial++, static_cast<int>(random() % 20))));
+                        break;
+                }
+            }
+            inventoryManager.flushPendingWrites();
+            for (auto& future : changed) future.get();
+            if (batch % 20 == 19) inventoryManager.reload();
+        }
+        writing.store(false);
+        for (std::thread& reader : readers) reader.join();
+        check(snapshotsChecked.load() >= 4, "lectores", "no llegaron a ver snapshots");
+
+        // El último snapshot coincide con la base
+        std::vector<Component> expected = dbManager.getAllComponents();
+        auto snapshot = inventoryManager.snapshot();
+        check(checkSnapshot(*snapshot, 10), "final", "snapshot inconsistente");
+        check(snapshot->size() == expected.size(), "final", "número de componentes");
+        for (const Component& component : expected) {
+            const Component* found = snapshot->findById(component.getId());
+            if (!found || found->getName() != component.getName() || found->getQuantity() != component.getQuantity()) {
+                check(false, "final", "el snapshot no coincide con la base");
+                break;
+            }
+        }
+        std::printf("%zu snapshots comprobados por los lectores\n", snapshotsChecked.load());
+    }
+
+    dbManager.disconnect();
+    for (const char* suffix : {"", ".image", "-journal"}) std::remove((path + suffix).c_str());
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d comprobaciones fallidas\n", failures.load());
+        return 1;
+    }
+    std::printf("lectores concurrentes: snapshots consistentes mientras se escribe\n");
+    return 0;
+}
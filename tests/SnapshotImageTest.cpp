@@ -0,0 +1,117 @@
+/**
+ * @file SnapshotImageTest.cpp
+ * @brief Comprueba la imagen de arranque rápido de InventoryManager.
+ *
+ * - Tras cerrar el gestor, la imagen guardada da al reabrir el mismo snapshot que la
+ *   base: mismas filas en el mismo orden, findById para cada ID y escrituras encima.
+ * - Si otra conexión escribe antes que un lote propio, el snapshot ya no refleja la
+ *   base: al cerrar no se debe guardar la imagen, y al reabrir el inventario debe
+ *   coincidir con la base y no con lo que el gestor tenía en memoria.
+ */
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "DatabaseManager.h"
+#include "InventoryManager.h"
+
+namespace {
+    int failures = 0;
+
+    void check(bool ok, const char* step, const char* what) {
+        if (!ok && ++failures <= 10) std::fprintf(stderr, "%s: %s\n", step, what);
+    }
+
+    bool fileExists(const std::string& path) {
+        return access(path.c_str(), F_OK) == 0;
+    }
+
+    // El snapshot debe tener las filas de la base, en su orden, y encontrar cada una por ID
+    void checkMatchesDatabase(InventoryManager& inventoryManager, DatabaseManager& dbManager, const char* step) {
+        std::vector<Component> expected = dbManager.getAllComponents();
+        auto snapshot = inventoryManager.snapshot();
+        check(snapshot->size() == expected.size(), step, "número de componentes");
+        std::size_t row = 0;
+        for (const Component& component : *snapshot) {
+            if (row >= expected.size() || component.getId() != expected[row].getId() ||
+                component.getName() != expected[row].getName() || component.getQuantity() != expected[row].getQuantity()) {
+                check(false, step, "fila distinta de la base");
+                return;
+            }
+            ++row;
+        }
+        for (const Component& component : expected) {
+            const Component* found = snapshot->findById(component.getId());
+            if (!found || found->getId() != component.getId()) {
+                check(false, step, "findById no encuentra un componente");
+                return;
+            }
+        }
+        check(snapshot->findById(-1) == nullptr, step, "findById de un ID inexistente");
+    }
+}
+
+int main() {
+    const std::string path = "imagen_" + std::to_string(static_cast<long>(getpid())) + ".db";
+    const std::string imagePath = path + ".image";
+    const char* names[] = {"Resistor", "Capacitor", "LED", "Arduino Nano", "Sensor DHT22", "Cable dupont largo"};
+
+    DatabaseManager dbManager(path);
+    if (!dbManager.connect()) {
+        std::fprintf(stderr, "no se pudo crear %s\n", path.c_str());
+        return 1;
+    }
+
+    // Varios bloques de ChunkedVector y nombres en un orden distinto al de los IDs
+    {
+        InventoryManager inventoryManager(&dbManager);
+        std::mt19937 random(5);
+        std::vector<std::future<int>> added;
+        for (int i = 0; i < 3000; ++i) {
+            std::string name = std::string(names[random() % 6]) + " " + std::to_string(random() % 500);
+            added.push_back(inventoryManager.addComponentAsync(
+                Component(0, name, "Otro", static_cast<int>(random() % 20), "Cajón A", 0)));
+        }
+        inventoryManager.flushPendingWrites();
+        for (auto& future : added) check(future.get() > 0, "alta", "una alta no se confirmó");
+    }
+    check(fileExists(imagePath), "cierre", "no se guardó la imagen");
+
+    // Reabrir desde la imagen y escribir encima
+    {
+        InventoryManager inventoryManager(&dbManager);
+        checkMatchesDatabase(inventoryManager, dbManager, "imagen");
+        Component changed = inventoryManager.snapshot()->at(10);
+        changed.setName("AAA primero");
+        check(inventoryManager.updateComponent(changed), "imagen", "la actualización falló");
+        check(inventoryManager.deleteComponent(inventoryManager.snapshot()->at(20).getId()), "imagen", "la eliminación falló");
+        checkMatchesDatabase(inventoryManager, dbManager, "escrituras sobre la imagen");
+    }
+    check(fileExists(imagePath), "cierre", "no se guardó la imagen tras escribir");
+
+    // Otra conexión escribe antes que un lote propio: la imagen no puede quedar guardada
+    {
+        InventoryManager inventoryManager(&dbManager);
+        DatabaseManager other(path);
+        check(other.connect() && other.addComponent(Component(0, "Otro proceso", "Otro", 4, "Cajón B", 0)),
+              "externa", "la otra conexión no pudo escribir");
+        check(inventoryManager.addComponent(Component(0, "Propio", "Otro", 6, "Cajón B", 0)), "externa", "alta propia");
+        check(!inventoryManager.saveImage(), "externa", "se guardó una imagen que no refleja la base");
+    }
+    check(!fileExists(imagePath), "externa", "quedó una imagen vieja");
+    {
+        InventoryManager inventoryManager(&dbManager);
+        checkMatchesDatabase(inventoryManager, dbManager, "reabrir tras la escritura externa");
+    }
+
+    dbManager.disconnect();
+    for (const char* suffix : {"", ".image", "-journal"}) std::remove((path + suffix).c_str());
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d comprobaciones fallidas\n", failures);
+        return 1;
+    }
+    std::printf("imagen de arranque: carga, escrituras y escritura externa correctas\n");
+    return 0;
+}
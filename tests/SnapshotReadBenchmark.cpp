@@ -0,0 +1,148 @@
+/**
+ * @file SnapshotReadBenchmark.cpp
+ * @brief Mide cómo escalan las lecturas de InventoryManager con el número de hilos lectores.
+ *
+ * No es una prueba: se ejecuta a mano, con el número de filas como argumento opcional
+ * (por defecto 100 000) y la duración de cada medición en milisegundos como segundo
+ * argumento (por defecto 300). Para 1, 2, 4 y 8 lectores informa de las lecturas por
+ * segundo de getComponent (caché por hilo), de snapshot() con findById (std::atomic_load)
+ * y de countLowStock, primero sin escrituras y después con un escritor que confirma
+ * lotes sin parar. El escalado se da respecto a un solo lector; con menos núcleos que
+ * lectores solo puede medir que repartir el tiempo entre hilos no cuesta lecturas.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <random>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "DatabaseManager.h"
+#include "InventoryManager.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /**
+     * Lanza readers hilos que repiten read durante duration y devuelve las lecturas por segundo.
+     */
+    template <typename Read>
+    double readsPerSecond(int readers, std::chrono::milliseconds duration, Read read) {
+        std::atomic<bool> running{true};
+        std::atomic<long long> total{0};
+        std::vector<std::thread> threads;
+        for (int reader = 0; reader < readers; ++reader) {
+            threads.emplace_back([&, reader]() {
+                std::mt19937 random(static_cast<unsigned>(reader + 1));
+                long long reads = 0;
+                while (running.load(std::memory_order_relaxed)) {
+                    for (int i = 0; i < 64; ++i) read(random);
+                    reads += 64;
+                }
+                total += reads;
+            });
+        }
+        Clock::time_point start = Clock::now();
+        std::this_thread::sleep_for(duration);
+        running.store(false);
+        for (std::thread& thread : threads) thread.join();
+        return static_cast<double>(total.load()) * 1000.0 / millisecondsSince(start);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t rows = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const std::chrono::milliseconds duration(argc > 2 ? std::strtol(argv[2], nullptr, 10) : 300);
+    const std::string path = "lecturas_" + std::to_string(static_cast<long>(getpid())) + ".db";
+
+    DatabaseManager dbManager(path);
+    if (!dbManager.connect()) {
+        std::fprintf(stderr, "no se pudo crear %s\n", path.c_str());
+        return 1;
+    }
+
+    {
+        InventoryManager inventoryManager(&dbManager);
+        std::mt19937 random(42);
+        const char* types[] = {"Resistor", "Capacitor", "Diodo", "Transistor", "Microcontrolador"};
+        std::vector<std::future<int>> added;
+        added.reserve(rows);
+        for (std::size_t i = 0; i < rows; ++i) {
+            added.push_back(inventoryManager.addComponentAsync(
+                Component(0, "Componente " + std::to_string(random() % 100000), types[random() % 5],
+                          static_cast<int>(random() % 100), "Cajón A1", 0)));
+        }
+        inventoryManager.flushPendingWrites();
+        std::vector<int> ids;
+        ids.reserve(rows);
+        for (auto& future : added) ids.push_back(future.get());
+
+        std::printf("%zu filas, %u hilos de hardware, %lld ms por medición\n", rows,
+                    std::thread::hardware_concurrency(), static_cast<long long>(duration.count()));
+
+        auto getComponent = [&](std::mt19937& random) {
+            Component component;
+            inventoryManager.getComponent(ids[random() % ids.size()], component);
+        };
+        auto findById = [&](std::mt19937& random) {
+            volatile bool found = inventoryManager.snapshot()->findById(ids[random() % ids.size()]) != nullptr;
+            (void)found;
+        };
+        auto countLowStock = [&](std::mt19937& random) {
+            volatile std::size_t count = inventoryManager.countLowStock(static_cast<int>(random() % 100));
+            (void)count;
+        };
+
+        for (bool withWriter : {false, true}) {
+            // El escritor cambia cantidades en lotes de 50 y publica un snapshot por lote
+            std::atomic<bool> writing{withWriter};
+            std::atomic<long long> batches{0};
+            std::thread writer([&]() {
+                std::mt19937 writerRandom(7);
+                while (writing.load()) {
+                    for (int i = 0; i < 50; ++i) {
+                        Component component;
+                        if (inventoryManager.getComponent(ids[writerRandom() % ids.size()], component)) {
+                            component.setQuantity(static_cast<int>(writerRandom() % 100));
+                            inventoryManager.updateComponentAsync(component);
+                        }
+                    }
+                    inventoryManager.flushPendingWrites();
+                    ++batches;
+                }
+            });
+
+            std::printf("\n%s\n", withWriter ? "con un escritor" : "sin escrituras");
+            std::printf("%-8s %16s %8s %16s %8s %16s %8s\n", "lectores", "getComponent/s", "escala",
+                        "findById/s", "escala", "countLowStock/s", "escala");
+            double base[3] = {0, 0, 0};
+            Clock::time_point start = Clock::now();
+            for (int readers : {1, 2, 4, 8}) {
+                const double rates[3] = {readsPerSecond(readers, duration, getComponent),
+                                         readsPerSecond(readers, duration, findById),
+                                         readsPerSecond(readers, duration, countLowStock)};
+                if (readers == 1) std::copy(rates, rates + 3, base);
+                std::printf("%-8d %16.0f %7.2fx %16.0f %7.2fx %16.0f %7.2fx\n", readers, rates[0], rates[0] / base[0],
+                            rates[1], rates[1] / base[1], rates[2], rates[2] / base[2]);
+            }
+            writing.store(false);
+            writer.join();
+            if (withWriter) {
+                std::printf("%lld lotes publicados (%.1f por segundo)\n", batches.load(),
+                            static_cast<double>(batches.load()) * 1000.0 / millisecondsSince(start));
+            }
+        }
+    }
+
+    dbManager.disconnect();
+    for (const char* suffix : {"", ".image", "-journal"}) std::remove((path + suffix).c_str());
+    return 0;
+}
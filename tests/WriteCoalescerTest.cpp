@@ -0,0 +1,167 @@
+/**
+ * @file WriteCoalescerTest.cpp
+ * @brief Comprueba WriteCoalescer contra otro escritor y con errores dentro de un lote.
+ *
+ * - Mientras otra conexión tiene el candado de escritura, el lote espera (busy timeout) y
+ *   se confirma entero cuando la otra termina.
+ * - Si la espera se agota, no se confirma ninguna escritura del lote: nada se escribe
+ *   fuera de la transacción.
+ * - Una escritura que falla sin deshacer la transacción (RAISE(ABORT)) no afecta a las
+ *   demás; una que la deshace entera (RAISE(ROLLBACK)) hace fallar también las anteriores,
+ *   y las siguientes se confirman en otra transacción.
+ * En todos los casos el resultado de cada future y el aviso al listener coinciden con lo
+ * que quedó en la base.
+ */
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <mutex>
+#include <sqlite3.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "DatabaseManager.h"
+#include "WriteCoalescer.h"
+
+namespace {
+    int failures = 0;
+
+    void check(bool ok, const char* step, const char* what) {
+        if (!ok && ++failures <= 10) std::fprintf(stderr, "%s: %s\n", step, what);
+    }
+
+    int countNamed(sqlite3* db, const std::string& name) {
+        sqlite3_stmt* stmt = nullptr;
+        sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM components WHERE name = ?", -1, &stmt, nullptr);
+        sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+        int count = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int(stmt, 0) : -1;
+        sqlite3_finalize(stmt);
+        return count;
+    }
+
+    /**
+     * Otra conexión que toma el candado de escritura, inserta una fila y lo suelta pasado un tiempo.
+     */
+    std::thread holdWriteLock(const std::string& path, std::chrono::milliseconds duration, std::promise<void>& locked) {
+        return std::thread([path, duration, &locked]() {
+            sqlite3* other = nullptr;
+            sqlite3_open(path.c_str(), &other);
+            sqlite3_exec(other, "BEGIN IMMEDIATE; INSERT INTO components (name, type, quantity) VALUES ('otro', 'Otro', 1);",
+                         nullptr, nullptr, nullptr);
+            locked.set_value();
+            std::this_thread::sleep_for(duration);
+            sqlite3_exec(other, "COMMIT;", nullptr, nullptr, nullptr);
+            sqlite3_close(other);
+        });
+    }
+
+    Component named(const std::string& name) {
+        return Component(0, name, "Resistor", 3, "Cajón A", 0);
+    }
+}
+
+int main() {
+    const std::string path = "coalescer_" + std::to_string(static_cast<long>(getpid())) + ".db";
+    {
+        DatabaseManager dbManager(path);
+        if (!dbManager.connect()) {
+            std::fprintf(stderr, "no se pudo crear %s\n", path.c_str());
+            return 1;
+        }
+        sqlite3* direct = nullptr;
+        sqlite3_open(path.c_str(), &direct);
+
+        std::mutex mutex;
+        std::vector<int> notified;
+        WriteCoalescer coalescer(&dbManager, 256, std::chrono::milliseconds(1000),
+            [&](const std::vector<WriteCoalescer::CommittedWrite>& writes) {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (const auto& write : writes) notified.push_back(write.id);
+            });
+        auto takeNotified = [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<int> ids;
+            ids.swap(notified);
+            return ids;
+        };
+
+        // Otro escritor con el candado durante 300 ms: el lote espera y se confirma entero
+        {
+            std::promise<void> locked;
+            std::thread other = holdWriteLock(path, std::chrono::milliseconds(300), locked);
+            locked.get_future().wait();
+            std::vector<std::future<int>> added;
+            for (int i = 0; i < 20; ++i) added.push_back(coalescer.enqueueAdd(named("espera")));
+            coalescer.flush();
+            other.join();
+            int confirmed = 0;
+            for (auto& future : added) confirmed += future.get() > 0 ? 1 : 0;
+            check(confirmed == 20, "espera", "no se confirmaron todas las altas");
+            check(countNamed(direct, "espera") == 20 && countNamed(direct, "otro") == 1, "espera", "filas en la base");
+            check(takeNotified().size() == 20, "espera", "avisos al listener");
+        }
+
+        // La espera se agota: el lote falla entero y no escribe nada
+        {
+            dbManager.setBusyTimeout(100);
+            std::promise<void> locked;
+            std::thread other = holdWriteLock(path, std::chrono::milliseconds(800), locked);
+            locked.get_future().wait();
+            std::vector<std::future<int>> added;
+            for (int i = 0; i < 5; ++i) added.push_back(coalescer.enqueueAdd(named("bloqueada")));
+            coalescer.flush();
+            other.join();
+            for (auto& future : added) check(future.get() == -1, "bloqueo", "alta confirmada sin transacción");
+            check(countNamed(direct, "bloqueada") == 0, "bloqueo", "se escribió fuera de la transacción");
+            check(takeNotified().empty(), "bloqueo", "aviso de escrituras no confirmadas");
+            dbManager.setBusyTimeout(DatabaseManager::DEFAULT_BUSY_TIMEOUT_MS);
+        }
+
+        // Errores dentro del lote
+        sqlite3_exec(direct,
+            "CREATE TRIGGER prueba_abort BEFORE INSERT ON components WHEN NEW.name = 'aborta' "
+            "BEGIN SELECT RAISE(ABORT, 'prueba'); END;"
+            "CREATE TRIGGER prueba_rollback BEFORE INSERT ON components WHEN NEW.name = 'deshace' "
+            "BEGIN SELECT RAISE(ROLLBACK, 'prueba'); END;",
+            nullptr, nullptr, nullptr);
+
+        {
+            std::future<int> first = coalescer.enqueueAdd(named("antes"));
+            std::future<int> failed = coalescer.enqueueAdd(named("aborta"));
+            std::future<int> last = coalescer.enqueueAdd(named("despues"));
+            coalescer.flush();
+            const int firstId = first.get();
+            const int lastId = last.get();
+            check(firstId > 0 && lastId > 0, "abort", "las altas válidas deben confirmarse");
+            check(failed.get() == -1, "abort", "la alta rechazada debe fallar");
+            check(countNamed(direct, "antes") == 1 && countNamed(direct, "despues") == 1 && countNamed(direct, "aborta") == 0,
+                  "abort", "filas en la base");
+            check(takeNotified() == std::vector<int>({firstId, lastId}), "abort", "avisos al listener");
+        }
+
+        {
+            std::future<int> lost = coalescer.enqueueAdd(named("perdida"));
+            std::future<int> failed = coalescer.enqueueAdd(named("deshace"));
+            std::future<int> after = coalescer.enqueueAdd(named("nueva"));
+            coalescer.flush();
+            const int afterId = after.get();
+            check(lost.get() == -1, "rollback", "la alta deshecha por SQLite no debe contar como confirmada");
+            check(failed.get() == -1, "rollback", "la alta que deshizo el lote debe fallar");
+            check(afterId > 0, "rollback", "la alta posterior debe confirmarse en otra transacción");
+            check(countNamed(direct, "perdida") == 0 && countNamed(direct, "nueva") == 1, "rollback", "filas en la base");
+            check(takeNotified() == std::vector<int>({afterId}), "rollback", "avisos al listener");
+        }
+
+        sqlite3_close(direct);
+    }
+
+    for (const char* suffix : {"", "-journal"}) std::remove((path + suffix).c_str());
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d comprobaciones fallidas\n", failures);
+        return 1;
+    }
+    std::printf("escrituras agrupadas: espera, bloqueo y errores parciales correctos\n");
+    return 0;
+}